@@ -38,6 +38,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <stddef.h>
 #include <stdint.h>
@@ -91,8 +92,51 @@ public:
      *
      */
     virtual void Log(LogLevel aLevel, const std::string &aRegion, const std::string &aMsg) = 0;
+
+    /**
+     * @brief The function returns the most verbose level written by this logger.
+     *
+     * Log messages more verbose than this level are dropped
+     * before they are formatted.
+     *
+     * @return The log level.
+     *
+     */
+    virtual LogLevel GetLogLevel() const { return LogLevel::kDebug; }
+
+    /**
+     * @brief The function returns whether this logger accepts binary log records.
+     *
+     * If it returns true, log messages of the commissioner library are passed
+     * to LogRecord() as binary records instead of formatted text messages.
+     *
+     */
+    virtual bool IsBinary() const { return false; }
+
+    /**
+     * @brief The function writes a single binary log record.
+     *
+     * A binary record includes the ID of the format string, a monotonic
+     * timestamp and the raw arguments of the log message.
+     *
+     * @param[in] aLevel   A logging level.
+     * @param[in] aRegion  A logging region.
+     * @param[in] aRecord  A binary log record.
+     *
+     */
+    virtual void LogRecord(LogLevel aLevel, const std::string &aRegion, const ByteArray &aRecord)
+    {
+        (void)aLevel;
+        (void)aRegion;
+        (void)aRecord;
+    }
 };
 
+/**
+ * An executor runs the given task, typically in its own threads.
+ */
+using Executor = std::function<void(std::function<void()> aTask)>;
+
 /**
  * @brief Configuration of a commissioner.
  */
@@ -104,6 +148,10 @@ struct Config
     uint32_t mKeepAliveInterval = 40;  ///< The interval of keep-alive message. In seconds.
     uint32_t mMaxConnectionNum  = 100; ///< Max number of parallel connection from joiner.
 
+    // When connecting to one of several border agents, the DTLS handshake with
+    // the next one is started if the previous ones do not complete in time.
+    uint32_t mConnectAttemptDelay = 1000; ///< The delay between DTLS handshakes. In milliseconds.
+
     std::shared_ptr<Logger> mLogger;
     bool                    mEnableDtlsDebugLogging = false;
 
@@ -124,6 +172,14 @@ struct Config
 
     // Mandatory for CCM Thread network.
     ByteArray mTrustAnchor; ///< The trust anchor of 'mCertificate'.
+
+    // Optional for CCM Thread network. The COSE sequence numbers
+    // restart from 0 after a restart if not provided.
+    std::string mSequenceNumberJournal; ///< The journal file of COSE sequence numbers.
+
+    // The CommissionerHandler callbacks are dispatched to this executor
+    // if provided; otherwise, they are called in the event-loop thread.
+    Executor mHandlerExecutor; ///< The executor of CommissionerHandler callbacks.
 };
 
 /**
@@ -134,15 +190,31 @@ struct Config
  *
  * @note Those handlers will be called in another threads and synchronization
  *       is needed if user data is accessed there.
- * @note No more than one handler will be called concurrently.
+ * @note No more than one handler will be called concurrently, unless the
+ *       handlers are dispatched to a concurrent executor by
+ *       Config::mHandlerExecutor.
  * @note Keep the handlers simple and light, no heavy jobs or blocking operations
  *       (e.g. those synchronized APIs provided by the Commissioner) should be
- *       executed in those handlers.
+ *       executed in those handlers. Slow handlers should either be dispatched
+ *       to an executor or use the asynchronous variants, which answer through
+ *       a completion callback.
  *
  */
 class CommissionerHandler
 {
 public:
+    /**
+     * The completion callback of OnJoinerRequestAsync. It takes the PSKd of
+     * the joiner and can be called in any thread, exactly once.
+     */
+    using PSKdHandler = std::function<void(const std::string &aPSKd)>;
+
+    /**
+     * The completion callback of OnJoinerFinalizeAsync. It takes whether the
+     * joiner is accepted and can be called in any thread, exactly once.
+     */
+    using AcceptHandler = std::function<void(bool aAccepted)>;
+
     /**
      * The function notifies the start of a joining request from given joiner.
      *
@@ -158,6 +230,22 @@ public:
         return "";
     }
 
+    /**
+     * The asynchronous variant of OnJoinerRequest.
+     *
+     * The commissioner keeps serving other joiners until @p aHandler is
+     * called, the default implementation answers with OnJoinerRequest.
+     *
+     * @param[in]  aJoinerId  A joiner ID.
+     * @param[in]  aHandler   A handler called with the PSKd of the joiner. An
+     *                        empty PSKd indicates that the joiner is not enabled.
+     *
+     */
+    virtual void OnJoinerRequestAsync(const ByteArray &aJoinerId, PSKdHandler aHandler)
+    {
+        aHandler(OnJoinerRequest(aJoinerId));
+    }
+
     /**
      * This function notifies a joiner DTLS session is connected or not.
      *
@@ -213,6 +301,29 @@ public:
         return false;
     }
 
+    /**
+     * The asynchronous variant of OnJoinerFinalize.
+     *
+     * JOIN_FIN.rsp is sent when @p aHandler is called, the default
+     * implementation answers with OnJoinerFinalize. See OnJoinerFinalize
+     * for the other parameters.
+     *
+     * @param[in]  aHandler  A handler called with whether the joiner is accepted.
+     *
+     */
+    virtual void OnJoinerFinalizeAsync(const ByteArray &  aJoinerId,
+                                       const std::string &aVendorName,
+                                       const std::string &aVendorModel,
+                                       const std::string &aVendorSwVersion,
+                                       const ByteArray &  aVendorStackVersion,
+                                       const std::string &aProvisioningUrl,
+                                       const ByteArray &  aVendorData,
+                                       AcceptHandler      aHandler)
+    {
+        aHandler(OnJoinerFinalize(aJoinerId, aVendorName, aVendorModel, aVendorSwVersion, aVendorStackVersion,
+                                  aProvisioningUrl, aVendorData));
+    }
+
     /**
      * This funtions notifies the response of a keep-alive message.
      *
@@ -266,6 +377,35 @@ public:
     virtual ~CommissionerHandler() = default;
 };
 
+/**
+ * @brief The inputs of PSKc generation.
+ */
+struct PSKcParams
+{
+    std::string mPassphrase;    ///< The Thread defined commissioning passphrase.
+    std::string mNetworkName;   ///< The network name the PSKc will be used for.
+    ByteArray   mExtendedPanId; ///< The extended PAN ID.
+};
+
+/**
+ * @brief The address of a border agent.
+ */
+struct BorderAgentAddr
+{
+    std::string mAddr;     ///< The border agent address.
+    uint16_t    mPort = 0; ///< The border agent port.
+};
+
+/**
+ * @brief The border agent connected out of several candidates.
+ */
+struct ConnectResult
+{
+    BorderAgentAddr mBorderAgent;       ///< The connected border agent.
+    uint32_t        mHandshakeTime = 0; ///< The time of the DTLS handshake with it. In milliseconds.
+    uint32_t        mConnectTime   = 0; ///< The time since the first DTLS handshake started. In milliseconds.
+};
+
 /**
  * @brief The interface of a Thread commissioner.
  *
@@ -386,6 +526,36 @@ public:
      */
     virtual Error Connect(const std::string &aAddr, uint16_t aPort) = 0;
 
+    /**
+     * @brief Asynchronously connect to a Thread network through one of several border agents.
+     *
+     * This method starts DTLS handshakes with the border agents one after another, each
+     * Config::mConnectAttemptDelay after the previous one or as soon as it fails, and keeps
+     * the earlier handshakes going. The first border agent which completes the handshake is
+     * connected and the other handshakes are cancelled.
+     * It always returns immediately without waiting for the completion.
+     *
+     * @param[in, out] aHandler       A handler of the connected border agent and the handshake
+     *                                time; Guaranteed to be called.
+     * @param[in]      aBorderAgents  The border agents in the order of preference.
+     *
+     * @note The error of the last failed border agent is reported if none is connected.
+     */
+    virtual void Connect(Handler<ConnectResult> aHandler, const std::vector<BorderAgentAddr> &aBorderAgents) = 0;
+
+    /**
+     * @brief Synchronously connect to a Thread network through one of several border agents.
+     *
+     * This method connects to the first of the border agents which completes the DTLS handshake,
+     * as the asynchronous variant does. It will not return until all of them failed or one got connected.
+     *
+     * @param[out] aResult        The connected border agent and the handshake time.
+     * @param[in]  aBorderAgents  The border agents in the order of preference.
+     *
+     * @return Error::kNone, succeed; otherwise, failed;
+     */
+    virtual Error Connect(ConnectResult &aResult, const std::vector<BorderAgentAddr> &aBorderAgents) = 0;
+
     /**
      * @brief Disconnect from current Thread network.
      *
@@ -1131,6 +1301,26 @@ public:
                               const std::string &aNetworkName,
                               const ByteArray &  aExtendedPanId);
 
+    /**
+     * @brief Generate PSKc for a batch of networks.
+     *
+     * The PSKc derivations are distributed across a pool of worker threads.
+     * When @p aUseCache is true, results are looked up in and saved to a
+     * process-wide LRU cache keyed by the hash of the inputs, so that
+     * deriving the PSKc of a known network again is almost free.
+     *
+     * @param[out] aPSKcList    The output PSKc list, in the same order as @p aParamsList.
+     * @param[in]  aParamsList  A list of PSKc generation inputs.
+     * @param[in]  aThreadNum   The number of worker threads. 0 means the number of hardware threads.
+     * @param[in]  aUseCache    If the PSKc cache is used.
+     *
+     * @return Error::kNone, succeed; Otherwise, failed and none of the PSKc is generated;
+     */
+    static Error GeneratePSKc(std::vector<ByteArray> &       aPSKcList,
+                              const std::vector<PSKcParams> &aParamsList,
+                              size_t                         aThreadNum = 0,
+                              bool                           aUseCache  = false);
+
     /**
      * @brief Compute joiner ID with its IEEE EUI-64 value.
      *
@@ -1162,6 +1352,70 @@ public:
                                   uint16_t           aLocator16);
 };
 
+/**
+ * @brief The host of commissioners of many Thread networks.
+ *
+ * Instead of running a background thread for each commissioner, the
+ * commissioners created by a host run on a small fixed pool of event
+ * loops, each running in its own thread. A commissioner is assigned
+ * to an event loop by the hash of its network ID. Commissioners on the
+ * same event loop share the DTLS random number generator and parsed
+ * DTLS credentials.
+ *
+ * @note Handlers of commissioners on the same event loop are called in
+ *       the same thread, a slow handler delays all of those commissioners.
+ *
+ */
+class CommissionerHost
+{
+public:
+    /**
+     * @brief Create an instance of the commissioner host.
+     *
+     * @return A shared_ptr of the created CommissionerHost instance.
+     *
+     */
+    static std::shared_ptr<CommissionerHost> Create();
+
+    virtual ~CommissionerHost() = default;
+
+    /**
+     * @brief Initialize and start the event loops.
+     *
+     * @param[in]  aEventLoopCount  The number of event loops, must be greater than 0.
+     *
+     * @retval Error::kNone  Successfully started the event loops.
+     * @retval ...           Failed to start the event loops.
+     *
+     */
+    virtual Error Init(size_t aEventLoopCount) = 0;
+
+    /**
+     * @brief Get the number of event loops.
+     *
+     * @return The number of event loops, 0 if not initialized.
+     *
+     */
+    virtual size_t GetEventLoopCount() const = 0;
+
+    /**
+     * @brief Create a commissioner running on an event loop of the host.
+     *
+     * @param[in]  aHandler    A handler of commissioner events.
+     * @param[in]  aNetworkId  The ID of the Thread network to be commissioned
+     *                         (e.g. the Extended PAN ID), which decides the
+     *                         event loop of the commissioner.
+     *
+     * @return A shared_ptr of the created Commissioner instance, which should be
+     *         initialized with Commissioner::Init. nullptr if the host is not initialized.
+     *
+     * @note A commissioner keeps its event loop running even if the host is destroyed.
+     *
+     */
+    virtual std::shared_ptr<Commissioner> CreateCommissioner(CommissionerHandler &aHandler,
+                                                             const std::string &  aNetworkId) = 0;
+};
+
 } // namespace commissioner
 
 } // namespace ot
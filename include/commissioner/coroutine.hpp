@@ -0,0 +1,395 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   The file defines the C++20 coroutine interface of a Thread Commissioner.
+ *
+ *   The interface is available only when compiling with C++20 coroutines,
+ *   this header is empty otherwise.
+ */
+
+#ifndef OT_COMM_COROUTINE_HPP_
+#define OT_COMM_COROUTINE_HPP_
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <commissioner/commissioner.hpp>
+
+namespace ot {
+
+namespace commissioner {
+
+namespace coroutine {
+
+/**
+ * The executor which resumes coroutines awaiting commissioner requests.
+ *
+ * The executor is called in the commissioner's event-loop thread with a
+ * task which resumes the coroutine, it should queue the task to be run
+ * in the executor's own thread(s). A null executor resumes coroutines
+ * right in the event-loop thread.
+ *
+ */
+using commissioner::Executor;
+
+/**
+ * The result of a commissioner request which has response data.
+ */
+template <typename T> struct Result
+{
+    Error mError;
+    T     mValue; ///< Meaningful only when @p mError is Error::kNone.
+};
+
+/**
+ * @brief The base of awaitables, which resumes the awaiting coroutine.
+ */
+class AwaitableBase
+{
+public:
+    bool await_ready() const noexcept { return false; }
+
+protected:
+    explicit AwaitableBase(Executor aExecutor)
+        : mExecutor(std::move(aExecutor))
+    {
+    }
+
+    void Resume(std::coroutine_handle<> aCoroutine) const
+    {
+        if (mExecutor != nullptr)
+        {
+            mExecutor([aCoroutine]() { aCoroutine.resume(); });
+        }
+        else
+        {
+            aCoroutine.resume();
+        }
+    }
+
+private:
+    Executor mExecutor;
+};
+
+/**
+ * @brief The awaitable of a commissioner request.
+ *
+ * It starts the request when awaited and resumes the awaiting coroutine
+ * on the executor when the request completes. `co_await` returns
+ * Result<T>, or Error if @p T is void.
+ *
+ */
+template <typename T> class Awaitable : public AwaitableBase
+{
+public:
+    using Starter = std::function<void(Commissioner::Handler<T> aHandler)>;
+
+    Awaitable(Starter aStarter, Executor aExecutor)
+        : AwaitableBase(std::move(aExecutor))
+        , mStarter(std::move(aStarter))
+    {
+    }
+
+    void await_suspend(std::coroutine_handle<> aCoroutine)
+    {
+        // The handler may be called in another thread even before the
+        // starter returns, nothing should be done after starting.
+        mStarter([this, aCoroutine](const T *aValue, Error aError) {
+            if (aValue != nullptr)
+            {
+                mResult.mValue = *aValue;
+            }
+            mResult.mError = aError;
+            Resume(aCoroutine);
+        });
+    }
+
+    Result<T> await_resume() { return std::move(mResult); }
+
+private:
+    Starter   mStarter;
+    Result<T> mResult;
+};
+
+template <> class Awaitable<void> : public AwaitableBase
+{
+public:
+    using Starter = std::function<void(Commissioner::ErrorHandler aHandler)>;
+
+    Awaitable(Starter aStarter, Executor aExecutor)
+        : AwaitableBase(std::move(aExecutor))
+        , mStarter(std::move(aStarter))
+    {
+    }
+
+    void await_suspend(std::coroutine_handle<> aCoroutine)
+    {
+        mStarter([this, aCoroutine](Error aError) {
+            mError = aError;
+            Resume(aCoroutine);
+        });
+    }
+
+    Error await_resume() { return mError; }
+
+private:
+    Starter mStarter;
+    Error   mError;
+};
+
+/**
+ * @brief A coroutine which runs eagerly and is never awaited.
+ *
+ * This is the return type of top-level coroutines, e.g. those started
+ * for each Thread network. The coroutine frame is destroyed when it
+ * completes.
+ *
+ */
+struct DetachedTask
+{
+    struct promise_type
+    {
+        DetachedTask       get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void               return_void() noexcept {}
+        void               unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+/**
+ * @brief The coroutine interface of a commissioner.
+ *
+ * Each method wraps the async method of the Commissioner with the same
+ * name, the request is sent when the returned awaitable is awaited:
+ *
+ *     auto [error, dataset] = co_await commissioner.GetActiveDataset(0xFFFF);
+ *
+ * @note The awaitable must be awaited before the commissioner is destroyed.
+ *
+ */
+class AsyncCommissioner
+{
+public:
+    AsyncCommissioner(std::shared_ptr<Commissioner> aCommissioner, Executor aExecutor = nullptr)
+        : mCommissioner(std::move(aCommissioner))
+        , mExecutor(std::move(aExecutor))
+    {
+    }
+
+    Commissioner &Get() { return *mCommissioner; }
+
+    Awaitable<void> Connect(std::string aAddr, uint16_t aPort)
+    {
+        return MakeAwaitable<void>([=, this](Commissioner::ErrorHandler aHandler) {
+            mCommissioner->Connect(aHandler, aAddr, aPort);
+        });
+    }
+
+    Awaitable<ConnectResult> Connect(std::vector<BorderAgentAddr> aBorderAgents)
+    {
+        return MakeAwaitable<ConnectResult>([=, this](Commissioner::Handler<ConnectResult> aHandler) {
+            mCommissioner->Connect(aHandler, aBorderAgents);
+        });
+    }
+
+    // Returns the ID of the existing commissioner if rejected.
+    Awaitable<std::string> Petition(std::string aAddr, uint16_t aPort)
+    {
+        return MakeAwaitable<std::string>([=, this](Commissioner::Handler<std::string> aHandler) {
+            mCommissioner->Petition(aHandler, aAddr, aPort);
+        });
+    }
+
+    Awaitable<void> Resign()
+    {
+        return MakeAwaitable<void>([this](Commissioner::ErrorHandler aHandler) { mCommissioner->Resign(aHandler); });
+    }
+
+    Awaitable<CommissionerDataset> GetCommissionerDataset(uint16_t aDatasetFlags)
+    {
+        return MakeAwaitable<CommissionerDataset>([=, this](Commissioner::Handler<CommissionerDataset> aHandler) {
+            mCommissioner->GetCommissionerDataset(aHandler, aDatasetFlags);
+        });
+    }
+
+    Awaitable<void> SetCommissionerDataset(CommissionerDataset aDataset)
+    {
+        return MakeAwaitable<void>([=, this](Commissioner::ErrorHandler aHandler) {
+            mCommissioner->SetCommissionerDataset(aHandler, aDataset);
+        });
+    }
+
+    Awaitable<BbrDataset> GetBbrDataset(uint16_t aDatasetFlags)
+    {
+        return MakeAwaitable<BbrDataset>([=, this](Commissioner::Handler<BbrDataset> aHandler) {
+            mCommissioner->GetBbrDataset(aHandler, aDatasetFlags);
+        });
+    }
+
+    Awaitable<void> SetBbrDataset(BbrDataset aDataset)
+    {
+        return MakeAwaitable<void>(
+            [=, this](Commissioner::ErrorHandler aHandler) { mCommissioner->SetBbrDataset(aHandler, aDataset); });
+    }
+
+    Awaitable<ActiveOperationalDataset> GetActiveDataset(uint16_t aDatasetFlags)
+    {
+        return MakeAwaitable<ActiveOperationalDataset>(
+            [=, this](Commissioner::Handler<ActiveOperationalDataset> aHandler) {
+                mCommissioner->GetActiveDataset(aHandler, aDatasetFlags);
+            });
+    }
+
+    Awaitable<ByteArray> GetRawActiveDataset(uint16_t aDatasetFlags)
+    {
+        return MakeAwaitable<ByteArray>([=, this](Commissioner::Handler<ByteArray> aHandler) {
+            mCommissioner->GetRawActiveDataset(aHandler, aDatasetFlags);
+        });
+    }
+
+    Awaitable<void> SetActiveDataset(ActiveOperationalDataset aDataset)
+    {
+        return MakeAwaitable<void>(
+            [=, this](Commissioner::ErrorHandler aHandler) { mCommissioner->SetActiveDataset(aHandler, aDataset); });
+    }
+
+    Awaitable<PendingOperationalDataset> GetPendingDataset(uint16_t aDatasetFlags)
+    {
+        return MakeAwaitable<PendingOperationalDataset>(
+            [=, this](Commissioner::Handler<PendingOperationalDataset> aHandler) {
+                mCommissioner->GetPendingDataset(aHandler, aDatasetFlags);
+            });
+    }
+
+    Awaitable<void> SetPendingDataset(PendingOperationalDataset aDataset)
+    {
+        return MakeAwaitable<void>(
+            [=, this](Commissioner::ErrorHandler aHandler) { mCommissioner->SetPendingDataset(aHandler, aDataset); });
+    }
+
+    Awaitable<void> SetSecurePendingDataset(std::string               aPbbrAddr,
+                                            uint32_t                  aMaxRetrievalTimer,
+                                            PendingOperationalDataset aDataset)
+    {
+        return MakeAwaitable<void>([=, this](Commissioner::ErrorHandler aHandler) {
+            mCommissioner->SetSecurePendingDataset(aHandler, aPbbrAddr, aMaxRetrievalTimer, aDataset);
+        });
+    }
+
+    Awaitable<void> CommandReenroll(std::string aDstAddr)
+    {
+        return MakeAwaitable<void>(
+            [=, this](Commissioner::ErrorHandler aHandler) { mCommissioner->CommandReenroll(aHandler, aDstAddr); });
+    }
+
+    Awaitable<void> CommandDomainReset(std::string aDstAddr)
+    {
+        return MakeAwaitable<void>([=, this](Commissioner::ErrorHandler aHandler) {
+            mCommissioner->CommandDomainReset(aHandler, aDstAddr);
+        });
+    }
+
+    Awaitable<void> CommandMigrate(std::string aDstAddr, std::string aDesignatedNetwork)
+    {
+        return MakeAwaitable<void>([=, this](Commissioner::ErrorHandler aHandler) {
+            mCommissioner->CommandMigrate(aHandler, aDstAddr, aDesignatedNetwork);
+        });
+    }
+
+    Awaitable<void> AnnounceBegin(uint32_t aChannelMask, uint8_t aCount, uint16_t aPeriod, std::string aDstAddr)
+    {
+        return MakeAwaitable<void>([=, this](Commissioner::ErrorHandler aHandler) {
+            mCommissioner->AnnounceBegin(aHandler, aChannelMask, aCount, aPeriod, aDstAddr);
+        });
+    }
+
+    Awaitable<void> PanIdQuery(uint32_t aChannelMask, uint16_t aPanId, std::string aDstAddr)
+    {
+        return MakeAwaitable<void>([=, this](Commissioner::ErrorHandler aHandler) {
+            mCommissioner->PanIdQuery(aHandler, aChannelMask, aPanId, aDstAddr);
+        });
+    }
+
+    Awaitable<void> EnergyScan(uint32_t    aChannelMask,
+                               uint8_t     aCount,
+                               uint16_t    aPeriod,
+                               uint16_t    aScanDuration,
+                               std::string aDstAddr)
+    {
+        return MakeAwaitable<void>([=, this](Commissioner::ErrorHandler aHandler) {
+            mCommissioner->EnergyScan(aHandler, aChannelMask, aCount, aPeriod, aScanDuration, aDstAddr);
+        });
+    }
+
+    Awaitable<uint8_t> RegisterMulticastListener(std::string              aPbbrAddr,
+                                                 std::vector<std::string> aMulticastAddrList,
+                                                 uint32_t                 aTimeout)
+    {
+        return MakeAwaitable<uint8_t>([=, this](Commissioner::Handler<uint8_t> aHandler) {
+            mCommissioner->RegisterMulticastListener(aHandler, aPbbrAddr, aMulticastAddrList, aTimeout);
+        });
+    }
+
+    Awaitable<ByteArray> RequestToken(std::string aAddr, uint16_t aPort)
+    {
+        return MakeAwaitable<ByteArray>([=, this](Commissioner::Handler<ByteArray> aHandler) {
+            mCommissioner->RequestToken(aHandler, aAddr, aPort);
+        });
+    }
+
+private:
+    template <typename T> Awaitable<T> MakeAwaitable(typename Awaitable<T>::Starter aStarter)
+    {
+        return Awaitable<T>(std::move(aStarter), mExecutor);
+    }
+
+    std::shared_ptr<Commissioner> mCommissioner;
+    Executor                      mExecutor;
+};
+
+} // namespace coroutine
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // __has_include(<coroutine>)
+#endif // defined(__cpp_impl_coroutine) && defined(__has_include)
+
+#endif // OT_COMM_COROUTINE_HPP_
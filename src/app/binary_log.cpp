@@ -0,0 +1,290 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *  This file implements the binary log file format written by FileLogger.
+ *
+ */
+
+#include "app/binary_log.hpp"
+
+#include <algorithm>
+#include <map>
+
+#include <string.h>
+
+#include "common/error_macros.hpp"
+#include "common/time.hpp"
+#include "common/utils.hpp"
+#include "library/logging.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+static constexpr size_t kFrameHeaderLength = sizeof(uint8_t) + sizeof(uint32_t);
+
+static_assert(sizeof(kBinaryLogMagic) > kFrameHeaderLength, "the magic must be longer than a frame header");
+
+// Guards against allocating for the length of a corrupted frame.
+static constexpr size_t kMaxFrameLength = 16 * 1024 * 1024;
+
+namespace {
+
+struct DecoderState
+{
+    std::map<uint32_t, std::string> mFormats;
+    bool                            mHasClock       = false;
+    int64_t                         mWallClock      = 0;
+    uint64_t                        mMonotonicClock = 0;
+};
+
+} // namespace
+
+static size_t EncodeInteger(char *aBuf, uint64_t aValue, size_t aLength)
+{
+    for (size_t i = aLength; i > 0; --i)
+    {
+        aBuf[i - 1] = static_cast<char>(aValue & 0xFF);
+        aValue >>= 8;
+    }
+    return aLength;
+}
+
+static size_t EncodeFrameHeader(char *aBuf, BinaryLogFrameType aType, size_t aPayloadLength)
+{
+    size_t length = 0;
+
+    length += EncodeInteger(aBuf + length, static_cast<uint8_t>(aType), sizeof(uint8_t));
+    length += EncodeInteger(aBuf + length, aPayloadLength, sizeof(uint32_t));
+    return length;
+}
+
+size_t EncodeClockFrame(char *aBuf, int64_t aWallClock, uint64_t aMonotonicClock)
+{
+    size_t length = EncodeFrameHeader(aBuf, BinaryLogFrameType::kClock, sizeof(int64_t) + sizeof(uint64_t));
+
+    length += EncodeInteger(aBuf + length, static_cast<uint64_t>(aWallClock), sizeof(int64_t));
+    length += EncodeInteger(aBuf + length, aMonotonicClock, sizeof(uint64_t));
+    return length;
+}
+
+size_t EncodeFormatFrameHeader(char *aBuf, uint32_t aFormatId, size_t aFormatLength)
+{
+    size_t length = EncodeFrameHeader(aBuf, BinaryLogFrameType::kFormat, sizeof(uint32_t) + aFormatLength);
+
+    length += EncodeInteger(aBuf + length, aFormatId, sizeof(uint32_t));
+    return length;
+}
+
+size_t EncodeRecordFrameHeader(char *      aBuf,
+                               LogLevel    aLevel,
+                               const char *aRegion,
+                               size_t      aRegionLength,
+                               size_t      aRecordLength)
+{
+    size_t regionLength = std::min(aRegionLength, kMaxBinaryLogRegionLength);
+    size_t length       = EncodeFrameHeader(aBuf, BinaryLogFrameType::kRecord,
+                                      sizeof(uint8_t) + sizeof(uint8_t) + regionLength + aRecordLength);
+
+    length += EncodeInteger(aBuf + length, static_cast<uint8_t>(aLevel), sizeof(uint8_t));
+    length += EncodeInteger(aBuf + length, regionLength, sizeof(uint8_t));
+    memcpy(aBuf + length, aRegion, regionLength);
+    return length + regionLength;
+}
+
+size_t EncodeTextFrameHeader(char *      aBuf,
+                             LogLevel    aLevel,
+                             time_t      aTime,
+                             const char *aRegion,
+                             size_t      aRegionLength,
+                             size_t      aMessageLength)
+{
+    size_t regionLength = std::min(aRegionLength, kMaxBinaryLogRegionLength);
+    size_t length       = EncodeFrameHeader(aBuf, BinaryLogFrameType::kText,
+                                      sizeof(uint8_t) + sizeof(int64_t) + sizeof(uint8_t) + regionLength +
+                                          aMessageLength);
+
+    length += EncodeInteger(aBuf + length, static_cast<uint8_t>(aLevel), sizeof(uint8_t));
+    length += EncodeInteger(aBuf + length, static_cast<uint64_t>(aTime), sizeof(int64_t));
+    length += EncodeInteger(aBuf + length, regionLength, sizeof(uint8_t));
+    memcpy(aBuf + length, aRegion, regionLength);
+    return length + regionLength;
+}
+
+static void WriteLine(std::ostream &     aOutput,
+                      const TimePoint &  aTime,
+                      uint8_t            aLevel,
+                      const std::string &aRegion,
+                      const std::string &aMessage)
+{
+    aOutput << "[ " << TimePointToString(aTime) << " ] [ " << GetLogLevelName(static_cast<LogLevel>(aLevel)) << " ] [ "
+            << aRegion << " ] " << aMessage << std::endl;
+}
+
+// Parses the level and region at the beginning of kRecord and kText frames.
+static Error DecodeLevelAndRegion(uint8_t &        aLevel,
+                                  std::string &    aRegion,
+                                  size_t &         aOffset,
+                                  const ByteArray &aPayload,
+                                  size_t           aRegionLengthOffset)
+{
+    Error  error;
+    size_t regionLength;
+
+    VerifyOrExit(aPayload.size() > aRegionLengthOffset, error = ERROR_BAD_FORMAT("log frame is too short"));
+    aLevel       = aPayload[0];
+    regionLength = aPayload[aRegionLengthOffset];
+    aOffset      = aRegionLengthOffset + 1;
+
+    VerifyOrExit(aPayload.size() - aOffset >= regionLength, error = ERROR_BAD_FORMAT("log frame is too short"));
+    aRegion.assign(reinterpret_cast<const char *>(&aPayload[aOffset]), regionLength);
+    aOffset += regionLength;
+
+exit:
+    return error;
+}
+
+static Error DecodeFrame(std::ostream &aOutput, DecoderState &aState, uint8_t aType, const ByteArray &aPayload)
+{
+    Error       error;
+    uint8_t     level;
+    std::string region;
+    std::string message;
+    size_t      offset;
+
+    switch (static_cast<BinaryLogFrameType>(aType))
+    {
+    case BinaryLogFrameType::kClock:
+        VerifyOrExit(aPayload.size() == sizeof(int64_t) + sizeof(uint64_t),
+                     error = ERROR_BAD_FORMAT("invalid clock frame length: {}", aPayload.size()));
+        aState.mWallClock      = static_cast<int64_t>(utils::Decode<uint64_t>(aPayload));
+        aState.mMonotonicClock = utils::Decode<uint64_t>(&aPayload[sizeof(int64_t)], sizeof(uint64_t));
+        aState.mHasClock       = true;
+        break;
+
+    case BinaryLogFrameType::kFormat:
+        VerifyOrExit(aPayload.size() >= sizeof(uint32_t), error = ERROR_BAD_FORMAT("format frame is too short"));
+        aState.mFormats[utils::Decode<uint32_t>(aPayload)].assign(
+            reinterpret_cast<const char *>(&aPayload[sizeof(uint32_t)]), aPayload.size() - sizeof(uint32_t));
+        break;
+
+    case BinaryLogFrameType::kRecord:
+    {
+        uint32_t formatId;
+        uint64_t timestamp;
+        int64_t  wallClock;
+
+        SuccessOrExit(error = DecodeLevelAndRegion(level, region, offset, aPayload, sizeof(uint8_t)));
+        SuccessOrExit(error =
+                          ParseLogRecordHeader(formatId, timestamp, &aPayload[0] + offset, aPayload.size() - offset));
+        VerifyOrExit(aState.mHasClock, error = ERROR_BAD_FORMAT("log record before any clock frame"));
+
+        if (aState.mFormats.count(formatId) == 0)
+        {
+            message = fmt::format("<unknown log format {}>", formatId);
+        }
+        else
+        {
+            SuccessOrExit(error = FormatLogRecord(message, aState.mFormats[formatId], &aPayload[0] + offset,
+                                                  aPayload.size() - offset));
+        }
+
+        // The monotonic timestamp may be earlier than the clock frame.
+        wallClock = aState.mWallClock + static_cast<int64_t>(timestamp - aState.mMonotonicClock);
+        WriteLine(aOutput,
+                  TimePoint(std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(wallClock))), level,
+                  region, message);
+        break;
+    }
+
+    case BinaryLogFrameType::kText:
+    {
+        int64_t time;
+
+        SuccessOrExit(error = DecodeLevelAndRegion(level, region, offset, aPayload, sizeof(uint8_t) + sizeof(int64_t)));
+        time = static_cast<int64_t>(utils::Decode<uint64_t>(&aPayload[sizeof(uint8_t)], sizeof(int64_t)));
+        message.assign(reinterpret_cast<const char *>(&aPayload[0] + offset), aPayload.size() - offset);
+
+        WriteLine(aOutput, Clock::from_time_t(static_cast<time_t>(time)), level, region, message);
+        break;
+    }
+
+    default:
+        ExitNow(error = ERROR_BAD_FORMAT("unknown log frame type: {}", aType));
+    }
+
+exit:
+    return error;
+}
+
+Error DecodeBinaryLog(std::ostream &aOutput, std::istream &aInput)
+{
+    Error        error;
+    char         magic[sizeof(kBinaryLogMagic)];
+    uint8_t      header[kFrameHeaderLength];
+    ByteArray    payload;
+    DecoderState state;
+
+    VerifyOrExit(aInput.read(magic, sizeof(magic)) && memcmp(magic, kBinaryLogMagic, sizeof(magic)) == 0,
+                 error = ERROR_BAD_FORMAT("not a binary log"));
+
+    while (aInput.read(reinterpret_cast<char *>(header), sizeof(header)))
+    {
+        size_t length;
+
+        // FileLogger appends to an existing log, a new log may start in the middle.
+        if (memcmp(header, kBinaryLogMagic, sizeof(header)) == 0)
+        {
+            VerifyOrExit(aInput.read(magic, sizeof(magic) - sizeof(header)) &&
+                             memcmp(magic, kBinaryLogMagic + sizeof(header), sizeof(magic) - sizeof(header)) == 0,
+                         error = ERROR_BAD_FORMAT("truncated log magic"));
+            state = DecoderState();
+            continue;
+        }
+
+        length = utils::Decode<uint32_t>(header + 1, sizeof(uint32_t));
+
+        VerifyOrExit(length <= kMaxFrameLength, error = ERROR_BAD_FORMAT("log frame is too long: {}", length));
+        payload.resize(length);
+        VerifyOrExit(length == 0 || aInput.read(reinterpret_cast<char *>(&payload[0]), length),
+                     error = ERROR_BAD_FORMAT("truncated log frame"));
+
+        SuccessOrExit(error = DecodeFrame(aOutput, state, header[0], payload));
+    }
+
+    VerifyOrExit(aInput.gcount() == 0, error = ERROR_BAD_FORMAT("truncated log frame"));
+
+exit:
+    return error;
+}
+
+} // namespace commissioner
+
+} // namespace ot
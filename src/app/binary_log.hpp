@@ -0,0 +1,144 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *  This file defines the binary log file format written by FileLogger.
+ *
+ */
+
+#ifndef OT_COMM_APP_BINARY_LOG_HPP_
+#define OT_COMM_APP_BINARY_LOG_HPP_
+
+#include <istream>
+#include <ostream>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#include <commissioner/commissioner.hpp>
+
+namespace ot {
+
+namespace commissioner {
+
+/*
+ * A binary log file starts with kBinaryLogMagic which is followed by frames:
+ *
+ *   | frame type (1) | payload length (4) | payload ... |
+ *
+ * Integers are in big endian. Frames of the kRecord type hold the binary
+ * records of the commissioner library (see library/logging.hpp), whose
+ * format strings are defined by earlier kFormat frames and whose monotonic
+ * timestamps are converted to the wall clock by the latest kClock frame.
+ * The magic may appear again in place of a frame, which starts a new log.
+ */
+
+static constexpr char   kBinaryLogMagic[]              = {'O', 'T', 'C', 'L', 'O', 'G', '0', '1'};
+static constexpr size_t kMaxBinaryLogRegionLength      = 64;
+static constexpr size_t kMaxBinaryLogFrameHeaderLength = 96;
+
+enum class BinaryLogFrameType : uint8_t
+{
+    kClock  = 1, ///< | wall clock in nanoseconds (8) | monotonic clock in nanoseconds (8) |
+    kFormat = 2, ///< | format ID (4) | format string ... |
+    kRecord = 3, ///< | log level (1) | region length (1) | region ... | binary record ... |
+    kText   = 4, ///< | log level (1) | wall clock in seconds (8) | region length (1) | region ... | message ... |
+};
+
+/**
+ * This function encodes a complete kClock frame.
+ *
+ * @param[out] aBuf  A buffer of at least kMaxBinaryLogFrameHeaderLength bytes.
+ *
+ * @return The frame length.
+ *
+ */
+size_t EncodeClockFrame(char *aBuf, int64_t aWallClock, uint64_t aMonotonicClock);
+
+/**
+ * This function encodes the header of a kFormat frame, which is followed by the format string.
+ *
+ * @param[out] aBuf  A buffer of at least kMaxBinaryLogFrameHeaderLength bytes.
+ *
+ * @return The header length.
+ *
+ */
+size_t EncodeFormatFrameHeader(char *aBuf, uint32_t aFormatId, size_t aFormatLength);
+
+/**
+ * This function encodes the header of a kRecord frame, which is followed by the binary record.
+ *
+ * @param[out] aBuf  A buffer of at least kMaxBinaryLogFrameHeaderLength bytes.
+ *
+ * @return The header length.
+ *
+ */
+size_t EncodeRecordFrameHeader(char *      aBuf,
+                               LogLevel    aLevel,
+                               const char *aRegion,
+                               size_t      aRegionLength,
+                               size_t      aRecordLength);
+
+/**
+ * This function encodes the header of a kText frame, which is followed by the message.
+ *
+ * @param[out] aBuf  A buffer of at least kMaxBinaryLogFrameHeaderLength bytes.
+ *
+ * @return The header length.
+ *
+ */
+size_t EncodeTextFrameHeader(char *      aBuf,
+                             LogLevel    aLevel,
+                             time_t      aTime,
+                             const char *aRegion,
+                             size_t      aRegionLength,
+                             size_t      aMessageLength);
+
+/**
+ * This function decodes a binary log into text log lines in the format of FileLogger.
+ *
+ * Frames before a truncated or malformed frame are always decoded. The input
+ * may be several binary logs concatenated, for example a log file which
+ * FileLogger has appended to after restarting.
+ *
+ * @param[out] aOutput  The output stream of text log lines.
+ * @param[in]  aInput   The input stream of the binary log.
+ *
+ * @retval ErrorCode::kNone       Successfully decoded the whole binary log.
+ * @retval ErrorCode::kBadFormat  The binary log is malformed or truncated.
+ *
+ */
+Error DecodeBinaryLog(std::ostream &aOutput, std::istream &aInput);
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_APP_BINARY_LOG_HPP_
@@ -0,0 +1,216 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases for the binary log format.
+ */
+
+#include "app/binary_log.hpp"
+
+#include <fstream>
+#include <sstream>
+
+#include <stdio.h>
+
+#include <catch2/catch.hpp>
+
+#include "app/file_logger.hpp"
+#include "common/benchmark.hpp"
+#include "common/utils.hpp"
+#include "library/logging.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+static std::vector<std::string> SplitLines(const std::string &aText)
+{
+    std::istringstream       input(aText);
+    std::vector<std::string> lines;
+    std::string              line;
+
+    while (std::getline(input, line))
+    {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+// Strips the time stamp which depends on the time zone.
+static std::string StripTime(const std::string &aLine)
+{
+    return aLine.substr(aLine.find(" ] ") + 3);
+}
+
+TEST_CASE("binary-log-decode", "[binary-log]")
+{
+    const std::string           kFilename = "binary_log_test.log";
+    std::shared_ptr<FileLogger> logger;
+    std::ostringstream          text;
+    std::vector<std::string>    lines;
+    FileLogger::Options         options;
+
+    remove(kFilename.c_str());
+
+    options.mOverflowPolicy = FileLogger::OverflowPolicy::kBlock;
+    options.mFormat         = FileLogger::Format::kBinary;
+    REQUIRE(FileLogger::Create(logger, kFilename, LogLevel::kInfo, options) == ErrorCode::kNone);
+    REQUIRE(logger->IsBinary());
+
+    InitLogger(logger);
+    LOG_INFO(LOG_REGION_JOINER_SESSION, "joiner {} sent {} bytes", std::string{"1122334455667788"}, 64);
+    LOG_DEBUG(LOG_REGION_JOINER_SESSION, "filtered {}", 1);
+    LOG_INFO(LOG_REGION_JOINER_SESSION, "joiner {} sent {} bytes", std::string{"8877665544332211"}, 128);
+    logger->Log(LogLevel::kWarn, "app", "a text message");
+    InitLogger(nullptr);
+    logger->Flush();
+
+    {
+        std::ifstream file(kFilename, std::ios::binary);
+
+        REQUIRE(DecodeBinaryLog(text, file) == ErrorCode::kNone);
+    }
+
+    lines = SplitLines(text.str());
+    REQUIRE(lines.size() == 3);
+    REQUIRE(lines[0].compare(0, 2, "[ ") == 0);
+    REQUIRE(StripTime(lines[0]) == "[ info ] [ joiner-session ] joiner 1122334455667788 sent 64 bytes");
+    REQUIRE(StripTime(lines[1]) == "[ info ] [ joiner-session ] joiner 8877665544332211 sent 128 bytes");
+    REQUIRE(StripTime(lines[2]) == "[ warn ] [ app ] a text message");
+
+    SECTION("truncated binary log")
+    {
+        std::ifstream      file(kFilename, std::ios::binary);
+        std::string        log((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        std::istringstream truncated(log.substr(0, log.size() - 1));
+
+        text.str("");
+        REQUIRE(DecodeBinaryLog(text, truncated) == ErrorCode::kBadFormat);
+
+        // Frames before the truncated one are decoded.
+        REQUIRE(SplitLines(text.str()).size() == 2);
+    }
+
+    SECTION("binary log appended to after restarting")
+    {
+        logger.reset();
+        REQUIRE(FileLogger::Create(logger, kFilename, LogLevel::kInfo, options) == ErrorCode::kNone);
+
+        InitLogger(logger);
+        LOG_INFO(LOG_REGION_JOINER_SESSION, "joiner {} sent {} bytes", std::string{"1122334455667788"}, 256);
+        InitLogger(nullptr);
+        logger->Flush();
+
+        std::ifstream file(kFilename, std::ios::binary);
+
+        text.str("");
+        REQUIRE(DecodeBinaryLog(text, file) == ErrorCode::kNone);
+
+        // The format is defined again in the new log.
+        lines = SplitLines(text.str());
+        REQUIRE(lines.size() == 4);
+        REQUIRE(StripTime(lines[3]) == "[ info ] [ joiner-session ] joiner 1122334455667788 sent 256 bytes");
+    }
+
+    SECTION("not a binary log")
+    {
+        std::istringstream input("[ 2020-01-01 00:00:00 ] [ info ] [ coap ] text log");
+
+        REQUIRE(DecodeBinaryLog(text, input) == ErrorCode::kBadFormat);
+    }
+
+    logger.reset();
+    REQUIRE(remove(kFilename.c_str()) == 0);
+}
+
+TEST_CASE("binary-log-frames", "[binary-log]")
+{
+    char               frame[kMaxBinaryLogFrameHeaderLength];
+    std::string        log(kBinaryLogMagic, sizeof(kBinaryLogMagic));
+    std::ostringstream text;
+    std::istringstream input;
+
+    log.append(frame, EncodeClockFrame(frame, 0, 1000));
+    log.append(frame, EncodeTextFrameHeader(frame, LogLevel::kError, 0, "region", 6, 5));
+    log.append("hello");
+
+    input.str(log);
+    REQUIRE(DecodeBinaryLog(text, input) == ErrorCode::kNone);
+    REQUIRE(StripTime(text.str()) == "[ error ] [ region ] hello\n");
+
+    SECTION("record before any clock frame")
+    {
+        const ByteArray record{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+        log = std::string(kBinaryLogMagic, sizeof(kBinaryLogMagic));
+        log.append(frame, EncodeRecordFrameHeader(frame, LogLevel::kInfo, "region", 6, record.size()));
+        log.append(record.begin(), record.end());
+
+        input.str(log);
+        REQUIRE(DecodeBinaryLog(text, input) == ErrorCode::kBadFormat);
+    }
+}
+
+TEST_CASE("binary-log-latency", "[.benchmark]")
+{
+    const std::string kFilename   = "binary_log_benchmark.log";
+    constexpr int     kMessageNum = 200000;
+    const ByteArray   joinerId{0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88};
+
+    auto latency = [&](FileLogger::Format aFormat) {
+        std::shared_ptr<FileLogger> logger;
+        FileLogger::Options         options;
+        size_t                      length = 0;
+
+        options.mOverflowPolicy = FileLogger::OverflowPolicy::kBlock;
+        options.mFormat         = aFormat;
+        REQUIRE(FileLogger::Create(logger, kFilename, LogLevel::kDebug, options) == ErrorCode::kNone);
+        InitLogger(logger);
+
+        auto elapsed = benchmark::MeasureMean(kMessageNum, [&]() {
+            LOG_DEBUG(LOG_REGION_DTLS, "session={} read {} bytes from joiner {}", static_cast<void *>(logger.get()),
+                      length++, utils::Hex(joinerId));
+        });
+
+        InitLogger(nullptr);
+        logger.reset();
+        REQUIRE(remove(kFilename.c_str()) == 0);
+
+        return elapsed.count();
+    };
+
+    auto text   = latency(FileLogger::Format::kText);
+    auto binary = latency(FileLogger::Format::kBinary);
+
+    WARN("LOG_DEBUG() takes " << text << " ns in text format and " << binary << " ns in binary format");
+}
+
+} // namespace commissioner
+
+} // namespace ot
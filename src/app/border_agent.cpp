@@ -28,8 +28,15 @@
 
 #include "border_agent.hpp"
 
+#include <algorithm>
 #include <chrono>
-#include <thread>
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <ifaddrs.h>
+#include <net/if.h>
+#include <string.h>
+#include <unistd.h>
 
 #include <fmt/format.h>
 #include <mdns/mdns.h>
@@ -42,10 +49,40 @@ namespace ot {
 
 namespace commissioner {
 
+static constexpr size_t             kMdnsBufferSize       = 1024 * 16;
+static constexpr mdns_record_type_t kMdnsQueryType        = MDNS_RECORDTYPE_PTR;
+static constexpr const char *       kServiceName          = "_meshcop._udp.local";
+static constexpr size_t             kMaxResponsesPerEvent = 16;
+static constexpr const char *       kMdnsAddr             = "224.0.0.251";
+static constexpr const char *       kMdnsAddr6            = "ff02::fb";
+static constexpr uint16_t           kMdnsPort             = 5353;
+static constexpr uint16_t           kDnsClassIn           = 1;
+
+// The offset of the question name in a query, which is referred to by known answers.
+static constexpr uint16_t kQuestionNameOffset = 12;
+
+// The length of the fixed fields of a resource record with a compressed name.
+static constexpr size_t kRecordHeaderLength = 12;
+
+// Known answers are not added beyond this size, so that a query fits in a single packet.
+static constexpr size_t kMaxQueryLength = 1400;
+
+// Continuous queries start at one second and double up to one hour (RFC 6762, 5.2).
+static constexpr std::chrono::seconds kMinQueryInterval{1};
+static constexpr std::chrono::seconds kMaxQueryInterval{3600};
+
 struct BorderAgentOrErrorMsg
 {
     BorderAgent mBorderAgent;
     Error       mError;
+    std::string mResponder;
+
+    // The smallest TTL of the records.
+    uint32_t mTtl = UINT32_MAX;
+
+    // The service instance in the PTR record, if any.
+    std::string mServiceInstance;
+    uint32_t    mServiceInstanceTtl = 0;
 };
 
 static int HandleRecord(const struct sockaddr *from,
@@ -59,47 +96,577 @@ static int HandleRecord(const struct sockaddr *from,
                         size_t                 length,
                         void *                 user_data);
 
-Error DiscoverBorderAgent(BorderAgentHandler aBorderAgentHandler, size_t aTimeout)
+// Encodes a DNS name without compression.
+static void EncodeName(ByteArray &aBuf, const std::string &aName)
+{
+    static constexpr size_t kMaxLabelLength = 63;
+
+    size_t begin = 0;
+
+    while (begin < aName.size())
+    {
+        size_t end    = std::min(aName.find('.', begin), aName.size());
+        size_t length = std::min(end - begin, kMaxLabelLength);
+
+        if (length > 0)
+        {
+            utils::Encode<uint8_t>(aBuf, static_cast<uint8_t>(length));
+            aBuf.insert(aBuf.end(), aName.begin() + begin, aName.begin() + begin + length);
+        }
+        begin = end + 1;
+    }
+    utils::Encode<uint8_t>(aBuf, 0);
+}
+
+static Error SendQuery(int aSocket, int aFamily, unsigned aNetIfIndex, const ByteArray &aQuery)
+{
+    Error                   error;
+    struct sockaddr_storage addrStorage;
+    socklen_t               addrLength;
+
+    memset(&addrStorage, 0, sizeof(addrStorage));
+    if (aFamily == AF_INET)
+    {
+        auto &addr = *reinterpret_cast<struct sockaddr_in *>(&addrStorage);
+
+        addr.sin_family = AF_INET;
+        addr.sin_port   = htons(kMdnsPort);
+        VerifyOrDie(inet_pton(AF_INET, kMdnsAddr, &addr.sin_addr) == 1);
+        addrLength = sizeof(addr);
+    }
+    else
+    {
+        auto &addr = *reinterpret_cast<struct sockaddr_in6 *>(&addrStorage);
+
+        addr.sin6_family   = AF_INET6;
+        addr.sin6_port     = htons(kMdnsPort);
+        addr.sin6_scope_id = aNetIfIndex;
+        VerifyOrDie(inet_pton(AF_INET6, kMdnsAddr6, &addr.sin6_addr) == 1);
+        addrLength = sizeof(addr);
+    }
+
+    if (sendto(aSocket, aQuery.data(), aQuery.size(), 0, reinterpret_cast<struct sockaddr *>(&addrStorage),
+               addrLength) != static_cast<ssize_t>(aQuery.size()))
+    {
+        ExitNow(error = ERROR_IO_ERROR("failed to send mDNS query: {}", strerror(errno)));
+    }
+
+exit:
+    return error;
+}
+
+/**
+ * This function opens a UDP socket sending mDNS queries over the given network interface.
+ *
+ * The socket is bound to an ephemeral port, so that responses are unicast
+ * to it and not shared with other sockets (RFC 6762, 6.7).
+ *
+ */
+static Error OpenMdnsSocket(int aFamily, unsigned aNetIfIndex, const struct sockaddr &aNetIfAddr, int &aSocket)
+{
+    Error error;
+    int   fd   = socket(aFamily, SOCK_DGRAM, IPPROTO_UDP);
+    int   hops = 255;
+
+    VerifyOrExit(fd >= 0, error = ERROR_IO_ERROR("failed to open mDNS socket: {}", strerror(errno)));
+
+    if (aFamily == AF_INET)
+    {
+        struct sockaddr_in addr;
+        unsigned char      ttl = static_cast<unsigned char>(hops);
+
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family      = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+
+        VerifyOrExit(setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF,
+                                &reinterpret_cast<const struct sockaddr_in &>(aNetIfAddr).sin_addr,
+                                sizeof(struct in_addr)) == 0 &&
+                         setsockopt(fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) == 0 &&
+                         bind(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) == 0,
+                     error = ERROR_IO_ERROR("failed to set up mDNS IPv4 socket: {}", strerror(errno)));
+    }
+    else
+    {
+        struct sockaddr_in6 addr;
+        int                 v6Only = 1;
+
+        memset(&addr, 0, sizeof(addr));
+        addr.sin6_family = AF_INET6;
+        addr.sin6_addr   = in6addr_any;
+
+        VerifyOrExit(setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &v6Only, sizeof(v6Only)) == 0 &&
+                         setsockopt(fd, IPPROTO_IPV6, IPV6_MULTICAST_IF, &aNetIfIndex, sizeof(aNetIfIndex)) == 0 &&
+                         setsockopt(fd, IPPROTO_IPV6, IPV6_MULTICAST_HOPS, &hops, sizeof(hops)) == 0 &&
+                         bind(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) == 0,
+                     error = ERROR_IO_ERROR("failed to set up mDNS IPv6 socket: {}", strerror(errno)));
+    }
+
+    // Responses are read until the socket would block.
+    VerifyOrExit(evutil_make_socket_nonblocking(fd) == 0,
+                 error = ERROR_IO_ERROR("failed to make mDNS socket non-blocking"));
+
+    aSocket = fd;
+    fd      = -1;
+
+exit:
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+
+    return error;
+}
+
+template <typename T> static bool IsEqual(const T &aLhs, const T &aRhs)
+{
+    return aLhs == aRhs;
+}
+
+static bool IsEqual(const BorderAgent::State &aLhs, const BorderAgent::State &aRhs)
+{
+    return aLhs.mConnectionMode == aRhs.mConnectionMode && aLhs.mThreadIfStatus == aRhs.mThreadIfStatus &&
+           aLhs.mAvailability == aRhs.mAvailability && aLhs.mBbrIsActive == aRhs.mBbrIsActive &&
+           aLhs.mBbrIsPrimary == aRhs.mBbrIsPrimary;
+}
+
+static bool IsEqual(const Timestamp &aLhs, const Timestamp &aRhs)
+{
+    return aLhs.Encode() == aRhs.Encode();
+}
+
+/**
+ * This function merges the present fields of a Border Agent into another.
+ *
+ * A single mDNS response may carry only part of the records of a Border Agent.
+ *
+ * @retval true   Any field of @p aTarget is added or changed.
+ * @retval false  @p aTarget is not changed.
+ *
+ */
+static bool MergeBorderAgent(BorderAgent &aTarget, const BorderAgent &aSource)
+{
+    bool changed = false;
+
+#define MERGE_IF_PRESENT(name)                                                                                \
+    if ((aSource.mPresentFlags & BorderAgent::k##name##Bit) &&                                                \
+        (!(aTarget.mPresentFlags & BorderAgent::k##name##Bit) || !IsEqual(aTarget.m##name, aSource.m##name))) \
+    {                                                                                                         \
+        aTarget.m##name = aSource.m##name;                                                                    \
+        aTarget.mPresentFlags |= BorderAgent::k##name##Bit;                                                   \
+        changed = true;                                                                                       \
+    }
+
+    MERGE_IF_PRESENT(Addr);
+    MERGE_IF_PRESENT(Port);
+    MERGE_IF_PRESENT(ThreadVersion);
+    MERGE_IF_PRESENT(State);
+    MERGE_IF_PRESENT(NetworkName);
+    MERGE_IF_PRESENT(ExtendedPanId);
+    MERGE_IF_PRESENT(VendorName);
+    MERGE_IF_PRESENT(ModelName);
+    MERGE_IF_PRESENT(ActiveTimestamp);
+    MERGE_IF_PRESENT(PartitionId);
+    MERGE_IF_PRESENT(VendorData);
+    MERGE_IF_PRESENT(VendorOui);
+    MERGE_IF_PRESENT(DomainName);
+    MERGE_IF_PRESENT(BbrSeqNumber);
+    MERGE_IF_PRESENT(BbrPort);
+
+#undef MERGE_IF_PRESENT
+
+    return changed;
+}
+
+BorderAgentBrowser::BorderAgentBrowser(struct event_base *aEventBase, BorderAgentHandler aBorderAgentHandler)
+    : mEventBase(aEventBase)
+    , mBorderAgentHandler(aBorderAgentHandler)
+    , mQueryTimer(aEventBase, [this](Timer &aTimer) { HandleQueryTimer(aTimer); })
+    , mQueryInterval(kMinQueryInterval)
+    , mBuffer(kMdnsBufferSize)
+{
+}
+
+BorderAgentBrowser::~BorderAgentBrowser()
+{
+    Stop();
+}
+
+Error BorderAgentBrowser::Start(const std::vector<std::string> &aNetIfs)
+{
+    Error           error;
+    struct ifaddrs *netIfAddrs = nullptr;
+
+    VerifyOrExit(!IsRunning(), error = ERROR_INVALID_STATE("the border agent browser is already running"));
+    VerifyOrExit(getifaddrs(&netIfAddrs) == 0,
+                 error = ERROR_IO_ERROR("failed to get network interfaces: {}", strerror(errno)));
+
+    mResponders.clear();
+    mBorderAgents.clear();
+
+    for (struct ifaddrs *netIfAddr = netIfAddrs; netIfAddr != nullptr; netIfAddr = netIfAddr->ifa_next)
+    {
+        std::string netIf  = netIfAddr->ifa_name;
+        int         family = netIfAddr->ifa_addr != nullptr ? netIfAddr->ifa_addr->sa_family : AF_UNSPEC;
+        bool        isOpen = false;
+        Error       openError;
+
+        if ((family != AF_INET && family != AF_INET6) || !(netIfAddr->ifa_flags & IFF_UP) ||
+            !(netIfAddr->ifa_flags & IFF_MULTICAST) || (netIfAddr->ifa_flags & IFF_LOOPBACK))
+        {
+            continue;
+        }
+        if (!aNetIfs.empty() && std::find(aNetIfs.begin(), aNetIfs.end(), netIf) == aNetIfs.end())
+        {
+            continue;
+        }
+
+        // A network interface has usually several IPv6 addresses, but one socket per family is enough.
+        for (const auto &socket : mSockets)
+        {
+            isOpen = isOpen || (socket.mNetIf == netIf && socket.mFamily == family);
+        }
+
+        // Sockets which fail to open are skipped, as long as any of them succeeds.
+        if (!isOpen && (openError = OpenSocket(netIf, family, *netIfAddr->ifa_addr)) != ErrorCode::kNone)
+        {
+            error = openError;
+        }
+    }
+
+    if (IsRunning())
+    {
+        error = ERROR_NONE;
+    }
+    else if (error == ErrorCode::kNone)
+    {
+        error = ERROR_NOT_FOUND("no network interface to browse border agents on");
+    }
+    SuccessOrExit(error);
+
+    // Failing to send the first queries is not fatal, they are repeated by the query timer.
+    Query().IgnoreError();
+
+    mQueryInterval = kMinQueryInterval;
+    mQueryTimer.Start(mQueryInterval);
+
+exit:
+    if (netIfAddrs != nullptr)
+    {
+        freeifaddrs(netIfAddrs);
+    }
+
+    return error;
+}
+
+Error BorderAgentBrowser::OpenSocket(const std::string &aNetIf, int aFamily, const struct sockaddr &aNetIfAddr)
+{
+    Error    error;
+    unsigned netIfIndex = if_nametoindex(aNetIf.c_str());
+    int      fd         = -1;
+
+    VerifyOrExit(netIfIndex != 0, error = ERROR_IO_ERROR("failed to get index of {}: {}", aNetIf, strerror(errno)));
+    SuccessOrExit(error = OpenMdnsSocket(aFamily, netIfIndex, aNetIfAddr, fd));
+
+    mSockets.emplace_back();
+    mSockets.back().mBrowser    = this;
+    mSockets.back().mNetIf      = aNetIf;
+    mSockets.back().mNetIfIndex = netIfIndex;
+    mSockets.back().mFamily     = aFamily;
+    mSockets.back().mFd         = fd;
+
+    VerifyOrDie(event_assign(&mSockets.back().mEvent, mEventBase, fd, EV_READ | EV_PERSIST, HandleSocketEvent,
+                             &mSockets.back()) == 0);
+    VerifyOrDie(event_add(&mSockets.back().mEvent, nullptr) == 0);
+
+exit:
+    return error;
+}
+
+void BorderAgentBrowser::Stop()
 {
-    static constexpr size_t             kDefaultBufferSize = 1024 * 16;
-    static constexpr mdns_record_type_t kMdnsQueryType     = MDNS_RECORDTYPE_PTR;
-    static const char *                 kServiceName       = "_meshcop._udp.local";
+    VerifyOrExit(IsRunning());
 
-    Error   error;
-    uint8_t buf[kDefaultBufferSize];
+    mQueryTimer.Stop();
+    for (auto &socket : mSockets)
+    {
+        event_del(&socket.mEvent);
+        close(socket.mFd);
+    }
+    mSockets.clear();
 
-    auto begin = std::chrono::system_clock::now();
+exit:
+    return;
+}
+
+void BorderAgentBrowser::HandleSocketEvent(evutil_socket_t, short, void *aContext)
+{
+    auto &socket = *reinterpret_cast<Socket *>(aContext);
+
+    socket.mBrowser->Receive(socket);
+}
+
+Error BorderAgentBrowser::Query()
+{
+    Error error;
 
-    int socket = mdns_socket_open_ipv4();
-    VerifyOrExit(socket >= 0, error = ERROR_IO_ERROR("failed to open mDNS IPv4 socket"));
+    VerifyOrExit(IsRunning(), error = ERROR_INVALID_STATE("the border agent browser is not running"));
 
-    if (mdns_query_send(socket, kMdnsQueryType, kServiceName, strlen(kServiceName), buf, sizeof(buf)) != 0)
+    // Queries are sent on all sockets at once, the first error is reported.
+    for (auto &socket : mSockets)
     {
-        ExitNow(error = ERROR_IO_ERROR("failed to send mDNS query"));
+        Error sendError = SendQuery(socket.mFd, socket.mFamily, socket.mNetIfIndex, MakeQuery(socket));
+
+        if (error == ErrorCode::kNone && sendError != ErrorCode::kNone)
+        {
+            error = ERROR_IO_ERROR("{} on {}", sendError.GetMessage(), socket.mNetIf);
+        }
     }
 
-    while (begin + std::chrono::milliseconds(aTimeout) >= std::chrono::system_clock::now())
+exit:
+    return error;
+}
+
+void BorderAgentBrowser::HandleQueryTimer(Timer &aTimer)
+{
+    Error error = Query();
+
+    if (error != ErrorCode::kNone)
     {
-        BorderAgentOrErrorMsg curBorderAgentOrErrorMsg;
+        mBorderAgentHandler(nullptr, error);
+    }
+
+    // The handler may have stopped the browser.
+    VerifyOrExit(IsRunning());
+
+    mQueryInterval = std::min<Duration>(mQueryInterval * 2, kMaxQueryInterval);
+    aTimer.Start(mQueryInterval);
+
+exit:
+    return;
+}
+
+ByteArray BorderAgentBrowser::MakeQuery(Socket &aSocket)
+{
+    ByteArray query;
+    TimePoint now       = Clock::now();
+    uint16_t  answerNum = 0;
+
+    utils::Encode<uint16_t>(query, 0); // ID
+    utils::Encode<uint16_t>(query, 0); // Flags
+    utils::Encode<uint16_t>(query, 1); // QDCOUNT
+    utils::Encode<uint16_t>(query, 0); // ANCOUNT, updated below
+    utils::Encode<uint16_t>(query, 0); // NSCOUNT
+    utils::Encode<uint16_t>(query, 0); // ARCOUNT
+
+    EncodeName(query, kServiceName);
+    utils::Encode<uint16_t>(query, kMdnsQueryType);
+    utils::Encode<uint16_t>(query, kDnsClassIn);
+
+    for (auto knownAnswer = aSocket.mKnownAnswers.begin(); knownAnswer != aSocket.mKnownAnswers.end();)
+    {
+        auto      elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - knownAnswer->second.mReceivedTime);
+        uint32_t  ttl     = knownAnswer->second.mTtl;
+        ByteArray name;
+
+        if (elapsed.count() < 0 || elapsed.count() >= ttl)
+        {
+            knownAnswer = aSocket.mKnownAnswers.erase(knownAnswer);
+            continue;
+        }
+
+        // Only answers with more than half of their TTL remaining suppress
+        // responses, the others are refreshed (RFC 6762, 7.1).
+        EncodeName(name, knownAnswer->first);
+        if (elapsed.count() * 2 < ttl && query.size() + kRecordHeaderLength + name.size() <= kMaxQueryLength)
+        {
+            utils::Encode<uint16_t>(query, 0xC000 | kQuestionNameOffset);
+            utils::Encode<uint16_t>(query, kMdnsQueryType);
+            utils::Encode<uint16_t>(query, kDnsClassIn);
+            utils::Encode<uint32_t>(query, ttl - static_cast<uint32_t>(elapsed.count()));
+            utils::Encode<uint16_t>(query, static_cast<uint16_t>(name.size()));
+            query.insert(query.end(), name.begin(), name.end());
+            ++answerNum;
+        }
+
+        ++knownAnswer;
+    }
+
+    query[6] = static_cast<uint8_t>(answerNum >> 8);
+    query[7] = static_cast<uint8_t>(answerNum & 0xFF);
+
+    return query;
+}
+
+void BorderAgentBrowser::Receive(Socket &aSocket)
+{
+    // The handlers may stop or restart the browser, which closes the socket.
+    auto isOpen = [this, &aSocket]() {
+        return std::any_of(mSockets.begin(), mSockets.end(),
+                           [&aSocket](const Socket &aOpenSocket) { return &aOpenSocket == &aSocket; });
+    };
+
+    // Bounds the responses handled at once, so that a flood of
+    // them does not starve other events of the event loop.
+    for (size_t i = 0; i < kMaxResponsesPerEvent && isOpen(); ++i)
+    {
+        BorderAgentOrErrorMsg response;
+        std::string           responderKey;
+
+        if (mdns_query_recv(aSocket.mFd, &mBuffer[0], mBuffer.size(), HandleRecord, &response, 1) == 0)
+        {
+            break;
+        }
+
+        if (!response.mServiceInstance.empty())
+        {
+            if (response.mServiceInstanceTtl == 0)
+            {
+                aSocket.mKnownAnswers.erase(response.mServiceInstance);
+            }
+            else
+            {
+                aSocket.mKnownAnswers[response.mServiceInstance] = {Clock::now(), response.mServiceInstanceTtl};
+            }
+        }
+
+        // Link-local addresses are ambiguous across network interfaces.
+        responderKey = fmt::format("{}%{}", response.mResponder, aSocket.mNetIf);
 
-        mdns_query_recv(socket, buf, sizeof(buf), HandleRecord, &curBorderAgentOrErrorMsg, 1);
+        if (response.mError != ErrorCode::kNone)
+        {
+            mBorderAgentHandler(nullptr, response.mError);
+        }
+        else if (response.mBorderAgent.mPresentFlags != 0 || mResponders.count(responderKey) != 0)
+        {
+            Responder & responder = mResponders[responderKey];
+            BorderAgent update;
+            bool        changed;
+
+            MergeBorderAgent(responder.mBorderAgent, response.mBorderAgent);
+            if (!response.mServiceInstance.empty())
+            {
+                responder.mServiceInstance = response.mServiceInstance;
+            }
+
+            if (responder.mKey.empty())
+            {
+                responder.mKey = (responder.mBorderAgent.mPresentFlags & BorderAgent::kExtendedPanIdBit)
+                                     ? fmt::format("{:016x}/{}", responder.mBorderAgent.mExtendedPanId,
+                                                   responder.mServiceInstance)
+                                     : responderKey;
+            }
+
+            DiscoveredBorderAgent &discovered = mBorderAgents[responder.mKey];
+
+            // The address of the first responder is kept, so that a
+            // Border Agent answering on several addresses does not flap.
+            update = responder.mBorderAgent;
+            if (discovered.mAddrResponder.empty() || discovered.mAddrResponder == responderKey)
+            {
+                discovered.mAddrResponder = (update.mPresentFlags & BorderAgent::kAddrBit) ? responderKey : "";
+            }
+            else
+            {
+                update.mPresentFlags &= ~BorderAgent::kAddrBit;
+            }
+            changed = MergeBorderAgent(discovered.mBorderAgent, update);
+
+            // Report a copy, the handlers may restart the browser.
+            BorderAgent borderAgent = discovered.mBorderAgent;
 
-        if (curBorderAgentOrErrorMsg.mError != ErrorCode::kNone)
+            // A Border Agent leaving the network sends records with zero TTL.
+            if (response.mTtl == 0)
+            {
+                HandleGoodbye(responderKey);
+            }
+            else
+            {
+                if (mRecordHandler != nullptr)
+                {
+                    mRecordHandler(borderAgent, response.mTtl);
+                }
+
+                if (changed && isOpen())
+                {
+                    mBorderAgentHandler(&borderAgent, ERROR_NONE);
+                }
+            }
+        }
+    }
+}
+
+void BorderAgentBrowser::HandleGoodbye(const std::string &aResponder)
+{
+    std::string            key         = mResponders[aResponder].mKey;
+    DiscoveredBorderAgent &discovered  = mBorderAgents[key];
+    BorderAgent            borderAgent = discovered.mBorderAgent;
+    bool                   isGone      = true;
+
+    mResponders.erase(aResponder);
+
+    // The Border Agent may still be reachable through other responders.
+    for (const auto &responder : mResponders)
+    {
+        if (responder.second.mKey != key)
         {
-            aBorderAgentHandler(nullptr, curBorderAgentOrErrorMsg.mError);
+            continue;
         }
-        else if (curBorderAgentOrErrorMsg.mBorderAgent.mPresentFlags != 0)
+
+        isGone = false;
+        if (discovered.mAddrResponder == aResponder &&
+            (responder.second.mBorderAgent.mPresentFlags & BorderAgent::kAddrBit))
         {
-            aBorderAgentHandler(&curBorderAgentOrErrorMsg.mBorderAgent, ERROR_NONE);
+            discovered.mAddrResponder     = responder.first;
+            discovered.mBorderAgent.mAddr = responder.second.mBorderAgent.mAddr;
         }
+    }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    if (isGone)
+    {
+        mBorderAgents.erase(key);
+    }
+    else
+    {
+        // Only the address which is not reported anymore is gone, the
+        // new one is reported by the next response of its responder.
+        VerifyOrExit(discovered.mBorderAgent.mAddr != borderAgent.mAddr);
+    }
+
+    if (mRecordHandler != nullptr)
+    {
+        mRecordHandler(borderAgent, 0);
     }
 
 exit:
-    if (socket >= 0)
+    return;
+}
+
+Error DiscoverBorderAgent(BorderAgentHandler              aBorderAgentHandler,
+                          size_t                          aTimeout,
+                          const std::vector<std::string> &aNetIfs)
+{
+    Error              error;
+    struct event_base *eventBase = event_base_new();
+    struct timeval     timeout;
+
+    VerifyOrExit(eventBase != nullptr, error = ERROR_OUT_OF_MEMORY("failed to create event base"));
+
+    timeout.tv_sec  = static_cast<time_t>(aTimeout / 1000);
+    timeout.tv_usec = static_cast<suseconds_t>(aTimeout % 1000 * 1000);
+
+    {
+        BorderAgentBrowser browser(eventBase, aBorderAgentHandler);
+
+        SuccessOrExit(error = browser.Start(aNetIfs));
+        VerifyOrDie(event_base_loopexit(eventBase, &timeout) == 0);
+        VerifyOrExit(event_base_dispatch(eventBase) == 0, error = ERROR_IO_ERROR("failed to run mDNS event loop"));
+    }
+
+exit:
+    if (eventBase != nullptr)
     {
-        mdns_socket_close(socket);
+        event_base_free(eventBase);
     }
 
     return error;
@@ -143,9 +710,12 @@ static int HandleRecord(const struct sockaddr *from,
     Error &                error                 = borderAgentOrErrorMsg.mError;
 
     (void)rclass;
-    (void)ttl;
 
-    *reinterpret_cast<struct sockaddr *>(&fromAddrStorage) = *from;
+    borderAgentOrErrorMsg.mTtl = std::min(borderAgentOrErrorMsg.mTtl, ttl);
+
+    memset(&fromAddrStorage, 0, sizeof(fromAddrStorage));
+    memcpy(&fromAddrStorage, from,
+           from->sa_family == AF_INET6 ? sizeof(struct sockaddr_in6) : sizeof(struct sockaddr_in));
     if (fromAddr.Set(fromAddrStorage) != ErrorCode::kNone)
     {
         ExitNow(error = ERROR_BAD_FORMAT("invalid source address of mDNS response"));
@@ -153,13 +723,16 @@ static int HandleRecord(const struct sockaddr *from,
 
     fromAddrStr = fromAddr.ToString();
 
+    borderAgentOrErrorMsg.mResponder = fromAddrStr;
+
     entryType = (entry == MDNS_ENTRYTYPE_ANSWER) ? "answer"
                                                  : ((entry == MDNS_ENTRYTYPE_AUTHORITY) ? "authority" : "additional");
     if (type == MDNS_RECORDTYPE_PTR)
     {
         mdns_string_t nameStr = mdns_record_parse_ptr(data, size, offset, length, nameBuffer, sizeof(nameBuffer));
-        (void)nameStr;
-        // TODO(wgtdkp): add debug logging.
+
+        borderAgentOrErrorMsg.mServiceInstance    = ToString(nameStr);
+        borderAgentOrErrorMsg.mServiceInstanceTtl = ttl;
     }
     else if (type == MDNS_RECORDTYPE_SRV)
     {
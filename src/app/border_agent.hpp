@@ -37,11 +37,16 @@
 
 #include <functional>
 #include <list>
+#include <map>
 #include <string>
+#include <vector>
 
 #include <commissioner/defines.hpp>
 #include <commissioner/network_data.hpp>
 
+#include "library/event.hpp"
+#include "library/timer.hpp"
+
 namespace ot {
 
 namespace commissioner {
@@ -167,15 +172,163 @@ struct BorderAgent
  */
 using BorderAgentHandler = std::function<void(const BorderAgent *aBorderAgent, const Error &aError)>;
 
+/**
+ * This function is the callback of each valid mDNS response of a Border Agent.
+ *
+ * @param[in] aBorderAgent  The Border Agent with all fields received so far.
+ * @param[in] aTtl          The smallest TTL of the records in the response, in seconds.
+ *                          Zero means the Border Agent is leaving the network.
+ *
+ */
+using BorderAgentRecordHandler = std::function<void(const BorderAgent &aBorderAgent, uint32_t aTtl)>;
+
+/**
+ * This class browses Border Agents in local network with mDNS.
+ *
+ * The browser is driven by the libevent loop it is created with: mDNS
+ * responses are handled as soon as the socket is readable, and queries
+ * are repeated with doubling intervals for as long as the browser runs.
+ * Queries are sent in parallel over IPv4 and IPv6 on each network interface,
+ * and a Border Agent answering on several of them is reported only once.
+ * Queries carry the Border Agents which are already known, so that they
+ * are not answered again before half of their TTL (RFC 6762, 7.1).
+ * It must be used in the thread of the event loop, and must not be
+ * destroyed by the handlers.
+ *
+ */
+class BorderAgentBrowser
+{
+    friend class BorderAgentBrowserTest;
+
+public:
+    /**
+     * @param[in] aEventBase           The event base the browser runs on.
+     * @param[in] aBorderAgentHandler  The handler of found Border Agents, it is
+     *                                 called once for each newly discovered or
+     *                                 updated Border Agent, and for each invalid
+     *                                 mDNS response.
+     */
+    BorderAgentBrowser(struct event_base *aEventBase, BorderAgentHandler aBorderAgentHandler);
+    ~BorderAgentBrowser();
+
+    BorderAgentBrowser(const BorderAgentBrowser &) = delete;
+    BorderAgentBrowser &operator=(const BorderAgentBrowser &) = delete;
+
+    /**
+     * This method opens the mDNS sockets and starts browsing.
+     *
+     * An IPv4 and an IPv6 socket is opened on each multicast capable network
+     * interface which is up and has an address of that family. Border Agents
+     * discovered by a previous run are reported again.
+     *
+     * @param[in] aNetIfs  The names of the network interfaces to browse on.
+     *                     All network interfaces are used if it is empty.
+     *
+     */
+    Error Start(const std::vector<std::string> &aNetIfs = {});
+
+    /**
+     * This method stops browsing and closes the mDNS sockets.
+     */
+    void Stop();
+
+    bool IsRunning() const { return !mSockets.empty(); }
+
+    /**
+     * This method sets the handler of each valid mDNS response, which is
+     * called even if the response does not change the Border Agent.
+     *
+     */
+    void SetRecordHandler(BorderAgentRecordHandler aRecordHandler) { mRecordHandler = aRecordHandler; }
+
+    /**
+     * This method sends a query immediately, for example to refresh Border Agents before they expire.
+     *
+     * The schedule of the periodic queries is not changed.
+     *
+     */
+    Error Query();
+
+private:
+    struct KnownAnswer
+    {
+        TimePoint mReceivedTime;
+        uint32_t  mTtl;
+    };
+
+    // The mDNS socket of a single network interface and address family.
+    struct Socket
+    {
+        BorderAgentBrowser *mBrowser;
+        std::string         mNetIf;
+        unsigned            mNetIfIndex;
+        int                 mFamily;
+        int                 mFd;
+        struct event        mEvent;
+
+        // The PTR records received, keyed by the service instance name.
+        std::map<std::string, KnownAnswer> mKnownAnswers;
+    };
+
+    // The records received from a single responder address.
+    struct Responder
+    {
+        BorderAgent mBorderAgent;
+        std::string mServiceInstance;
+
+        // The key of the reported Border Agent, empty until it is reported.
+        std::string mKey;
+    };
+
+    struct DiscoveredBorderAgent
+    {
+        BorderAgent mBorderAgent;
+
+        // The responder whose address is reported.
+        std::string mAddrResponder;
+    };
+
+    static void HandleSocketEvent(evutil_socket_t aSocket, short aFlags, void *aContext);
+    void        HandleQueryTimer(Timer &aTimer);
+    Error       OpenSocket(const std::string &aNetIf, int aFamily, const struct sockaddr &aNetIfAddr);
+    ByteArray   MakeQuery(Socket &aSocket);
+    void        Receive(Socket &aSocket);
+    void        HandleGoodbye(const std::string &aResponder);
+
+    struct event_base *      mEventBase;
+    BorderAgentHandler       mBorderAgentHandler;
+    BorderAgentRecordHandler mRecordHandler;
+    std::list<Socket>        mSockets;
+    Timer                    mQueryTimer;
+    Duration                 mQueryInterval;
+    ByteArray                mBuffer;
+
+    // The responders, keyed by their address and network interface.
+    std::map<std::string, Responder> mResponders;
+
+    // The last reported Border Agents, keyed by the Extended PAN ID
+    // and service instance name, or by the responder if there is no
+    // Extended PAN ID. Responses from several responders of the same
+    // Border Agent, e.g. its IPv4 and IPv6 addresses, are merged.
+    std::map<std::string, DiscoveredBorderAgent> mBorderAgents;
+};
+
 /**
  * Discovery Border Agent in local network with mDNS.
  *
+ * It runs a BorderAgentBrowser on a private event loop until the timeout.
+ * All network interfaces are browsed at the same time.
+ *
  * @param[in] aBorderAgentHandler  The handler of found Border Agent.
  *                                 called once for each Border Agent.
- * @param[in] aTimeout             The time waiting for mDNS responses.
+ * @param[in] aTimeout             The time waiting for mDNS responses, in milliseconds.
+ * @param[in] aNetIfs              The names of the network interfaces to browse on.
+ *                                 All network interfaces are used if it is empty.
  *
  */
-Error DiscoverBorderAgent(BorderAgentHandler aBorderAgentHandler, size_t aTimeout);
+Error DiscoverBorderAgent(BorderAgentHandler              aBorderAgentHandler,
+                          size_t                          aTimeout,
+                          const std::vector<std::string> &aNetIfs = {});
 
 } // namespace commissioner
 
@@ -0,0 +1,272 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   The file implements the cache of Border Agents discovered by mDNS.
+ */
+
+#include "app/border_agent_cache.hpp"
+
+#include <algorithm>
+
+#include "common/error_macros.hpp"
+#include "common/utils.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+// The percentages of the TTL at which a Border Agent is refreshed (RFC 6762, 5.2).
+static constexpr uint32_t kRefreshPercents[] = {80, 85, 90, 95};
+static constexpr size_t   kRefreshNum         = sizeof(kRefreshPercents) / sizeof(kRefreshPercents[0]);
+
+// The interval of checking for Border Agents to be refreshed or expired.
+static constexpr std::chrono::seconds kRefreshCheckInterval{1};
+
+static std::string GetKey(const BorderAgent &aBorderAgent)
+{
+    return "[" + aBorderAgent.mAddr + "]:" + std::to_string(aBorderAgent.mPort);
+}
+
+TimePoint BorderAgentCache::Entry::GetRefreshTime() const
+{
+    auto percent = mRefreshNum < kRefreshNum ? kRefreshPercents[mRefreshNum] : 100;
+
+    return mUpdateTime + std::chrono::milliseconds(static_cast<uint64_t>(mTtl) * percent * 10);
+}
+
+TimePoint BorderAgentCache::Entry::GetExpiryTime() const
+{
+    return mUpdateTime + std::chrono::seconds(mTtl);
+}
+
+BorderAgentCache::~BorderAgentCache()
+{
+    Stop();
+}
+
+Error BorderAgentCache::Start()
+{
+    Error error;
+
+    VerifyOrExit(!IsRunning(), error = ERROR_INVALID_STATE("the border agent cache has been started"));
+
+    error = ERROR_UNKNOWN("failed to initialize event base");
+    VerifyOrExit(evthread_use_pthreads() == 0);
+    VerifyOrExit((mEventBase = event_base_new()) != nullptr);
+    VerifyOrExit(evthread_make_base_notifiable(mEventBase) == 0);
+    VerifyOrExit(event_assign(&mStopEvent, mEventBase, -1, 0, HandleStopEvent, this) == 0);
+    error = ERROR_NONE;
+
+    mBrowser.reset(new BorderAgentBrowser(mEventBase, [](const BorderAgent *, const Error &) {}));
+    mBrowser->SetRecordHandler([this](const BorderAgent &aBorderAgent, uint32_t aTtl) { Update(aBorderAgent, aTtl); });
+    SuccessOrExit(error = mBrowser->Start());
+
+    mRefreshTimer.reset(new Timer(
+        mEventBase, [this](Timer &aTimer) { HandleRefreshTimer(aTimer); }, /* aIsSingle */ false));
+    mRefreshTimer->Start(kRefreshCheckInterval);
+
+    mThread = std::thread([this]() { event_base_loop(mEventBase, 0); });
+
+exit:
+    if (error != ErrorCode::kNone && !IsRunning())
+    {
+        mRefreshTimer.reset();
+        mBrowser.reset();
+        if (mEventBase != nullptr)
+        {
+            event_base_free(mEventBase);
+            mEventBase = nullptr;
+        }
+    }
+    return error;
+}
+
+void BorderAgentCache::Stop()
+{
+    VerifyOrExit(IsRunning());
+
+    // Break the event loop from inside, the stop event
+    // stays active until the event loop has been started.
+    event_active(&mStopEvent, 0, 0);
+    mThread.join();
+
+    mRefreshTimer.reset();
+    mBrowser.reset();
+    event_base_free(mEventBase);
+    mEventBase = nullptr;
+
+exit:
+    return;
+}
+
+void BorderAgentCache::Update(const BorderAgent &aBorderAgent, uint32_t aTtl)
+{
+    constexpr uint16_t kRequiredFlags = BorderAgent::kAddrBit | BorderAgent::kPortBit;
+
+    VerifyOrExit((aBorderAgent.mPresentFlags & kRequiredFlags) == kRequiredFlags);
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        if (aTtl == 0)
+        {
+            mEntries.erase(GetKey(aBorderAgent));
+        }
+        else
+        {
+            mEntries[GetKey(aBorderAgent)] = {aBorderAgent, Clock::now(), aTtl, 0};
+        }
+    }
+    mCond.notify_all();
+
+exit:
+    return;
+}
+
+std::vector<BorderAgent> BorderAgentCache::GetBorderAgents() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::vector<BorderAgent>    borderAgents;
+
+    Find(borderAgents, [](const BorderAgent &) { return true; });
+    return borderAgents;
+}
+
+Error BorderAgentCache::FindByNetworkName(std::vector<BorderAgent> &aBorderAgents,
+                                          const std::string &       aNetworkName,
+                                          Duration                  aTimeout)
+{
+    Error error;
+    auto  predicate = [&aNetworkName](const BorderAgent &aBorderAgent) {
+        return (aBorderAgent.mPresentFlags & BorderAgent::kNetworkNameBit) && aBorderAgent.mNetworkName == aNetworkName;
+    };
+
+    if (Find(aBorderAgents, predicate, aTimeout) != ErrorCode::kNone)
+    {
+        ExitNow(error = ERROR_NOT_FOUND("no border agent of network {} is found", aNetworkName));
+    }
+
+exit:
+    return error;
+}
+
+Error BorderAgentCache::FindByExtendedPanId(std::vector<BorderAgent> &aBorderAgents,
+                                            uint64_t                  aExtendedPanId,
+                                            Duration                  aTimeout)
+{
+    Error error;
+    auto  predicate = [aExtendedPanId](const BorderAgent &aBorderAgent) {
+        return (aBorderAgent.mPresentFlags & BorderAgent::kExtendedPanIdBit) &&
+               aBorderAgent.mExtendedPanId == aExtendedPanId;
+    };
+
+    if (Find(aBorderAgents, predicate, aTimeout) != ErrorCode::kNone)
+    {
+        ExitNow(error = ERROR_NOT_FOUND("no border agent of extended PAN ID {:016X} is found", aExtendedPanId));
+    }
+
+exit:
+    return error;
+}
+
+size_t BorderAgentCache::Find(std::vector<BorderAgent> &aBorderAgents, const Predicate &aPredicate) const
+{
+    TimePoint now = Clock::now();
+
+    aBorderAgents.clear();
+    for (const auto &entry : mEntries)
+    {
+        if (now < entry.second.GetExpiryTime() && aPredicate(entry.second.mBorderAgent))
+        {
+            aBorderAgents.push_back(entry.second.mBorderAgent);
+        }
+    }
+
+    return aBorderAgents.size();
+}
+
+Error BorderAgentCache::Find(std::vector<BorderAgent> &aBorderAgents, const Predicate &aPredicate, Duration aTimeout)
+{
+    Error                        error;
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    // Any update wakes up the waiter to check again.
+    if (!mCond.wait_until(lock, Clock::now() + aTimeout, [&]() { return Find(aBorderAgents, aPredicate) > 0; }))
+    {
+        error = ERROR_NOT_FOUND("no border agent is found");
+    }
+
+    return error;
+}
+
+void BorderAgentCache::HandleStopEvent(evutil_socket_t, short, void *aContext)
+{
+    auto cache = reinterpret_cast<BorderAgentCache *>(aContext);
+
+    event_base_loopbreak(cache->mEventBase);
+}
+
+void BorderAgentCache::HandleRefreshTimer(Timer &)
+{
+    TimePoint now     = Clock::now();
+    bool      refresh = false;
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        for (auto entry = mEntries.begin(); entry != mEntries.end();)
+        {
+            if (now >= entry->second.GetExpiryTime())
+            {
+                entry = mEntries.erase(entry);
+                continue;
+            }
+
+            // A single query refreshes all Border Agents, even if
+            // several refresh times have passed since the last check.
+            while (entry->second.mRefreshNum < kRefreshNum && now >= entry->second.GetRefreshTime())
+            {
+                ++entry->second.mRefreshNum;
+                refresh = true;
+            }
+
+            ++entry;
+        }
+    }
+
+    if (refresh)
+    {
+        IgnoreError(mBrowser->Query());
+    }
+}
+
+} // namespace commissioner
+
+} // namespace ot
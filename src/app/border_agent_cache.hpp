@@ -0,0 +1,171 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   The file defines the cache of Border Agents discovered by mDNS.
+ */
+
+#ifndef OT_COMM_APP_BORDER_AGENT_CACHE_HPP_
+#define OT_COMM_APP_BORDER_AGENT_CACHE_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "app/border_agent.hpp"
+#include "common/time.hpp"
+#include "library/event.hpp"
+#include "library/timer.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+/**
+ * This class caches Border Agents with the TTL of their mDNS records.
+ *
+ * Once started, the cache browses Border Agents on its own event loop
+ * thread. A cached Border Agent is refreshed by queries at 80%, 85%, 90%
+ * and 95% of its TTL (RFC 6762, 5.2), and removed when it expires or
+ * leaves the network. Lookups are served from fresh records immediately,
+ * and are safe to be called by any thread.
+ *
+ */
+class BorderAgentCache
+{
+public:
+    BorderAgentCache() = default;
+    ~BorderAgentCache();
+
+    BorderAgentCache(const BorderAgentCache &) = delete;
+    BorderAgentCache &operator=(const BorderAgentCache &) = delete;
+
+    /**
+     * This method starts browsing Border Agents in background.
+     */
+    Error Start();
+
+    /**
+     * This method stops browsing, cached Border Agents are kept until they expire.
+     */
+    void Stop();
+
+    bool IsRunning() const { return mThread.joinable(); }
+
+    /**
+     * This method adds, refreshes or removes a Border Agent.
+     *
+     * Border Agents without an address or a port are ignored.
+     *
+     * @param[in] aBorderAgent  The Border Agent.
+     * @param[in] aTtl          The TTL of the Border Agent in seconds, zero to remove it.
+     *
+     */
+    void Update(const BorderAgent &aBorderAgent, uint32_t aTtl);
+
+    /**
+     * This method returns all fresh Border Agents.
+     */
+    std::vector<BorderAgent> GetBorderAgents() const;
+
+    /**
+     * This method finds fresh Border Agents of a Thread network by its network name.
+     *
+     * @param[out] aBorderAgents  The Border Agents found.
+     * @param[in]  aNetworkName   The network name.
+     * @param[in]  aTimeout       The time waiting for the Border Agents to be
+     *                            discovered if there is none in the cache.
+     *
+     * @retval ErrorCode::kNone      Found at least one Border Agent.
+     * @retval ErrorCode::kNotFound  No Border Agent is found before the timeout.
+     *
+     */
+    Error FindByNetworkName(std::vector<BorderAgent> &aBorderAgents,
+                            const std::string &       aNetworkName,
+                            Duration                  aTimeout = Duration::zero());
+
+    /**
+     * This method finds fresh Border Agents of a Thread network by its extended PAN ID.
+     *
+     * @param[out] aBorderAgents   The Border Agents found.
+     * @param[in]  aExtendedPanId  The extended PAN ID.
+     * @param[in]  aTimeout        The time waiting for the Border Agents to be
+     *                             discovered if there is none in the cache.
+     *
+     * @retval ErrorCode::kNone      Found at least one Border Agent.
+     * @retval ErrorCode::kNotFound  No Border Agent is found before the timeout.
+     *
+     */
+    Error FindByExtendedPanId(std::vector<BorderAgent> &aBorderAgents,
+                              uint64_t                  aExtendedPanId,
+                              Duration                  aTimeout = Duration::zero());
+
+private:
+    using Predicate = std::function<bool(const BorderAgent &aBorderAgent)>;
+
+    struct Entry
+    {
+        BorderAgent mBorderAgent;
+        TimePoint   mUpdateTime;
+        uint32_t    mTtl;
+
+        // The number of refresh queries sent since the last update.
+        size_t mRefreshNum;
+
+        TimePoint GetRefreshTime() const;
+        TimePoint GetExpiryTime() const;
+    };
+
+    static void HandleStopEvent(evutil_socket_t aFd, short aFlags, void *aContext);
+    void        HandleRefreshTimer(Timer &aTimer);
+    size_t      Find(std::vector<BorderAgent> &aBorderAgents, const Predicate &aPredicate) const; // mMutex is held.
+    Error       Find(std::vector<BorderAgent> &aBorderAgents, const Predicate &aPredicate, Duration aTimeout);
+
+    mutable std::mutex           mMutex;
+    std::condition_variable      mCond;
+    std::map<std::string, Entry> mEntries;
+
+    struct event_base *                 mEventBase = nullptr;
+    struct event                        mStopEvent;
+    std::unique_ptr<BorderAgentBrowser> mBrowser;
+    std::unique_ptr<Timer>              mRefreshTimer;
+    std::thread                         mThread;
+};
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_APP_BORDER_AGENT_CACHE_HPP_
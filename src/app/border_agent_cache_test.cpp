@@ -0,0 +1,140 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases for the Border Agent cache.
+ */
+
+#include "app/border_agent_cache.hpp"
+
+#include <chrono>
+#include <thread>
+
+#include <catch2/catch.hpp>
+
+namespace ot {
+
+namespace commissioner {
+
+static BorderAgent MakeBorderAgent(const std::string &aAddr, const std::string &aNetworkName, uint64_t aExtendedPanId)
+{
+    BorderAgent borderAgent;
+
+    borderAgent.mAddr          = aAddr;
+    borderAgent.mPort          = 49191;
+    borderAgent.mNetworkName   = aNetworkName;
+    borderAgent.mExtendedPanId = aExtendedPanId;
+    borderAgent.mPresentFlags  = BorderAgent::kAddrBit | BorderAgent::kPortBit | BorderAgent::kNetworkNameBit |
+                                BorderAgent::kExtendedPanIdBit;
+    return borderAgent;
+}
+
+TEST_CASE("border-agent-cache-lookup", "[border-agent-cache]")
+{
+    BorderAgentCache         cache;
+    std::vector<BorderAgent> borderAgents;
+
+    cache.Update(MakeBorderAgent("fe80::1", "net-1", 0x1111), 120);
+    cache.Update(MakeBorderAgent("fe80::2", "net-1", 0x1111), 120);
+    cache.Update(MakeBorderAgent("fe80::3", "net-2", 0x2222), 120);
+
+    SECTION("lookup by network name")
+    {
+        REQUIRE(cache.FindByNetworkName(borderAgents, "net-1") == ErrorCode::kNone);
+        REQUIRE(borderAgents.size() == 2);
+        REQUIRE(borderAgents[0].mAddr == "fe80::1");
+        REQUIRE(borderAgents[1].mAddr == "fe80::2");
+
+        REQUIRE(cache.FindByNetworkName(borderAgents, "net-3") == ErrorCode::kNotFound);
+        REQUIRE(borderAgents.empty());
+    }
+
+    SECTION("lookup by extended PAN ID")
+    {
+        REQUIRE(cache.FindByExtendedPanId(borderAgents, 0x2222) == ErrorCode::kNone);
+        REQUIRE(borderAgents.size() == 1);
+        REQUIRE(borderAgents[0].mNetworkName == "net-2");
+
+        REQUIRE(cache.FindByExtendedPanId(borderAgents, 0x3333) == ErrorCode::kNotFound);
+    }
+
+    SECTION("update and remove Border Agents")
+    {
+        BorderAgent noAddr = MakeBorderAgent("fe80::4", "net-1", 0x1111);
+
+        noAddr.mPresentFlags &= ~BorderAgent::kAddrBit;
+        cache.Update(noAddr, 120);
+        REQUIRE(cache.GetBorderAgents().size() == 3);
+
+        cache.Update(MakeBorderAgent("fe80::1", "net-3", 0x3333), 120);
+        REQUIRE(cache.FindByNetworkName(borderAgents, "net-1") == ErrorCode::kNone);
+        REQUIRE(borderAgents.size() == 1);
+
+        // A zero TTL means the Border Agent is leaving.
+        cache.Update(MakeBorderAgent("fe80::3", "net-2", 0x2222), 0);
+        REQUIRE(cache.FindByNetworkName(borderAgents, "net-2") == ErrorCode::kNotFound);
+        REQUIRE(cache.GetBorderAgents().size() == 2);
+    }
+}
+
+TEST_CASE("border-agent-cache-ttl", "[border-agent-cache]")
+{
+    BorderAgentCache         cache;
+    std::vector<BorderAgent> borderAgents;
+
+    SECTION("expired Border Agents are not served")
+    {
+        cache.Update(MakeBorderAgent("fe80::1", "net-1", 0x1111), 1);
+        REQUIRE(cache.FindByNetworkName(borderAgents, "net-1") == ErrorCode::kNone);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+        REQUIRE(cache.FindByNetworkName(borderAgents, "net-1") == ErrorCode::kNotFound);
+        REQUIRE(cache.GetBorderAgents().empty());
+    }
+
+    SECTION("a lookup returns as soon as the Border Agent is discovered")
+    {
+        auto        begin = std::chrono::steady_clock::now();
+        std::thread discovery([&cache]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            cache.Update(MakeBorderAgent("fe80::2", "net-2", 0x2222), 120);
+            cache.Update(MakeBorderAgent("fe80::1", "net-1", 0x1111), 120);
+        });
+
+        REQUIRE(cache.FindByExtendedPanId(borderAgents, 0x1111, std::chrono::seconds(10)) == ErrorCode::kNone);
+        REQUIRE(borderAgents.size() == 1);
+        REQUIRE(std::chrono::steady_clock::now() - begin < std::chrono::seconds(5));
+
+        discovery.join();
+    }
+}
+
+} // namespace commissioner
+
+} // namespace ot
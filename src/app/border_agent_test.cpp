@@ -0,0 +1,420 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases of the Border Agent browser.
+ */
+
+#include "app/border_agent.hpp"
+
+#include <memory>
+
+#include <arpa/inet.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <catch2/catch.hpp>
+
+#include "common/utils.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+// Feeds mDNS responses to a browser through loopback sockets, instead of
+// the multicast sockets opened by BorderAgentBrowser::Start().
+class BorderAgentBrowserTest
+{
+public:
+    static uint16_t OpenSocket(BorderAgentBrowser &aBrowser, int aFamily)
+    {
+        struct sockaddr_storage addrStorage;
+        socklen_t               addrLength = sizeof(addrStorage);
+        int                     fd         = Bind(aFamily, aFamily == AF_INET ? "127.0.0.1" : "::1");
+
+        REQUIRE(evutil_make_socket_nonblocking(fd) == 0);
+        REQUIRE(getsockname(fd, reinterpret_cast<struct sockaddr *>(&addrStorage), &addrLength) == 0);
+
+        aBrowser.mSockets.emplace_back();
+        aBrowser.mSockets.back().mBrowser    = &aBrowser;
+        aBrowser.mSockets.back().mNetIf      = "lo";
+        aBrowser.mSockets.back().mNetIfIndex = 0;
+        aBrowser.mSockets.back().mFamily     = aFamily;
+        aBrowser.mSockets.back().mFd         = fd;
+        REQUIRE(event_assign(&aBrowser.mSockets.back().mEvent, aBrowser.mEventBase, fd, EV_READ,
+                             BorderAgentBrowser::HandleSocketEvent, &aBrowser.mSockets.back()) == 0);
+
+        return aFamily == AF_INET ? ntohs(reinterpret_cast<struct sockaddr_in &>(addrStorage).sin_port)
+                                  : ntohs(reinterpret_cast<struct sockaddr_in6 &>(addrStorage).sin6_port);
+    }
+
+    // Sends the response from the responder address to the browser socket on the port.
+    static void Send(const std::string &aResponder, uint16_t aPort, const ByteArray &aResponse)
+    {
+        int                     family = aResponder.find(':') == std::string::npos ? AF_INET : AF_INET6;
+        int                     fd     = Bind(family, aResponder);
+        struct sockaddr_storage addrStorage;
+        socklen_t               addrLength = MakeSockAddr(addrStorage, family, family == AF_INET ? "127.0.0.1" : "::1");
+
+        SetPort(addrStorage, aPort);
+        REQUIRE(sendto(fd, aResponse.data(), aResponse.size(), 0, reinterpret_cast<struct sockaddr *>(&addrStorage),
+                       addrLength) == static_cast<ssize_t>(aResponse.size()));
+        close(fd);
+    }
+
+    static void Receive(BorderAgentBrowser &aBrowser)
+    {
+        for (auto &socket : aBrowser.mSockets)
+        {
+            aBrowser.Receive(socket);
+        }
+    }
+
+private:
+    static socklen_t MakeSockAddr(struct sockaddr_storage &aAddrStorage, int aFamily, const std::string &aAddr)
+    {
+        memset(&aAddrStorage, 0, sizeof(aAddrStorage));
+        aAddrStorage.ss_family = aFamily;
+        if (aFamily == AF_INET)
+        {
+            REQUIRE(inet_pton(AF_INET, aAddr.c_str(), &reinterpret_cast<struct sockaddr_in &>(aAddrStorage).sin_addr) ==
+                    1);
+            return sizeof(struct sockaddr_in);
+        }
+        REQUIRE(inet_pton(AF_INET6, aAddr.c_str(), &reinterpret_cast<struct sockaddr_in6 &>(aAddrStorage).sin6_addr) ==
+                1);
+        return sizeof(struct sockaddr_in6);
+    }
+
+    static void SetPort(struct sockaddr_storage &aAddrStorage, uint16_t aPort)
+    {
+        if (aAddrStorage.ss_family == AF_INET)
+        {
+            reinterpret_cast<struct sockaddr_in &>(aAddrStorage).sin_port = htons(aPort);
+        }
+        else
+        {
+            reinterpret_cast<struct sockaddr_in6 &>(aAddrStorage).sin6_port = htons(aPort);
+        }
+    }
+
+    static int Bind(int aFamily, const std::string &aAddr)
+    {
+        struct sockaddr_storage addrStorage;
+        socklen_t               addrLength = MakeSockAddr(addrStorage, aFamily, aAddr);
+        int                     fd         = socket(aFamily, SOCK_DGRAM, IPPROTO_UDP);
+
+        REQUIRE(fd >= 0);
+        REQUIRE(bind(fd, reinterpret_cast<struct sockaddr *>(&addrStorage), addrLength) == 0);
+        return fd;
+    }
+};
+
+namespace {
+
+constexpr uint16_t kTypeA    = 1;
+constexpr uint16_t kTypePtr  = 12;
+constexpr uint16_t kTypeTxt  = 16;
+constexpr uint16_t kTypeAaaa = 28;
+constexpr uint16_t kTypeSrv  = 33;
+
+constexpr uint32_t kTtl         = 120;
+constexpr uint64_t kXpanId      = 0xDEAD00BEEF00CAFE;
+const std::string  kServiceName = "_meshcop._udp.local";
+
+ByteArray EncodeName(const std::string &aName)
+{
+    ByteArray name;
+    size_t    begin = 0;
+
+    while (begin < aName.size())
+    {
+        size_t end = std::min(aName.find('.', begin), aName.size());
+
+        utils::Encode<uint8_t>(name, static_cast<uint8_t>(end - begin));
+        name.insert(name.end(), aName.begin() + begin, aName.begin() + end);
+        begin = end + 1;
+    }
+    utils::Encode<uint8_t>(name, 0);
+
+    return name;
+}
+
+struct Record
+{
+    std::string mName;
+    uint16_t    mType;
+    uint32_t    mTtl;
+    ByteArray   mData;
+};
+
+ByteArray MakeResponse(const std::vector<Record> &aRecords)
+{
+    ByteArray response;
+
+    utils::Encode<uint16_t>(response, 0);      // ID
+    utils::Encode<uint16_t>(response, 0x8400); // Flags: response, authoritative
+    utils::Encode<uint16_t>(response, 0);      // QDCOUNT
+    utils::Encode<uint16_t>(response, static_cast<uint16_t>(aRecords.size()));
+    utils::Encode<uint16_t>(response, 0); // NSCOUNT
+    utils::Encode<uint16_t>(response, 0); // ARCOUNT
+
+    for (const auto &record : aRecords)
+    {
+        ByteArray name = EncodeName(record.mName);
+
+        response.insert(response.end(), name.begin(), name.end());
+        utils::Encode<uint16_t>(response, record.mType);
+        utils::Encode<uint16_t>(response, 1); // Class IN
+        utils::Encode<uint32_t>(response, record.mTtl);
+        utils::Encode<uint16_t>(response, static_cast<uint16_t>(record.mData.size()));
+        response.insert(response.end(), record.mData.begin(), record.mData.end());
+    }
+
+    return response;
+}
+
+std::string InstanceName(const std::string &aInstance)
+{
+    return aInstance + "." + kServiceName;
+}
+
+Record Ptr(const std::string &aInstance, uint32_t aTtl = kTtl)
+{
+    return {kServiceName, kTypePtr, aTtl, EncodeName(InstanceName(aInstance))};
+}
+
+Record Srv(const std::string &aInstance, uint16_t aPort, uint32_t aTtl = kTtl)
+{
+    ByteArray data;
+    ByteArray target = EncodeName(aInstance + ".local");
+
+    utils::Encode<uint16_t>(data, 0); // Priority
+    utils::Encode<uint16_t>(data, 0); // Weight
+    utils::Encode<uint16_t>(data, aPort);
+    data.insert(data.end(), target.begin(), target.end());
+
+    return {InstanceName(aInstance), kTypeSrv, aTtl, data};
+}
+
+Record Txt(const std::string &aInstance, const std::string &aNetworkName, uint64_t aXpanId, uint32_t aTtl = kTtl)
+{
+    ByteArray   data;
+    std::string networkName = "nn=" + aNetworkName;
+    ByteArray   xpanId      = {'x', 'p', '='};
+
+    utils::Encode(xpanId, aXpanId);
+    for (const ByteArray &entry : {ByteArray{networkName.begin(), networkName.end()}, xpanId})
+    {
+        utils::Encode<uint8_t>(data, static_cast<uint8_t>(entry.size()));
+        data.insert(data.end(), entry.begin(), entry.end());
+    }
+
+    return {InstanceName(aInstance), kTypeTxt, aTtl, data};
+}
+
+Record Addr(const std::string &aInstance, const std::string &aAddr, uint32_t aTtl = kTtl)
+{
+    bool      isIpv4 = aAddr.find(':') == std::string::npos;
+    ByteArray data(isIpv4 ? 4 : 16);
+
+    REQUIRE(inet_pton(isIpv4 ? AF_INET : AF_INET6, aAddr.c_str(), &data[0]) == 1);
+
+    return {aInstance + ".local", isIpv4 ? kTypeA : kTypeAaaa, aTtl, data};
+}
+
+// All records of a Border Agent in a single response.
+std::vector<Record> AllRecords(const std::string &aInstance, const std::string &aAddr, uint32_t aTtl = kTtl)
+{
+    return {Ptr(aInstance, aTtl), Srv(aInstance, 49191, aTtl), Txt(aInstance, "OpenThread", kXpanId, aTtl),
+            Addr(aInstance, aAddr, aTtl)};
+}
+
+struct Browser
+{
+    Browser()
+        : mEventBase(event_base_new(), event_base_free)
+        , mBrowser(mEventBase.get(),
+                   [this](const BorderAgent *aBorderAgent, const Error &aError) {
+                       REQUIRE(aError == ErrorCode::kNone);
+                       mBorderAgents.push_back(*aBorderAgent);
+                   })
+        , mPort(BorderAgentBrowserTest::OpenSocket(mBrowser, AF_INET))
+        , mPort6(BorderAgentBrowserTest::OpenSocket(mBrowser, AF_INET6))
+    {
+        mBrowser.SetRecordHandler([this](const BorderAgent &aBorderAgent, uint32_t aTtl) {
+            mRecords.emplace_back(aBorderAgent, aTtl);
+        });
+    }
+
+    void Receive(const std::string &aResponder, const std::vector<Record> &aRecords)
+    {
+        bool isIpv4 = aResponder.find(':') == std::string::npos;
+
+        BorderAgentBrowserTest::Send(aResponder, isIpv4 ? mPort : mPort6, MakeResponse(aRecords));
+        BorderAgentBrowserTest::Receive(mBrowser);
+    }
+
+    // The browser is destroyed before its event base.
+    std::unique_ptr<struct event_base, void (*)(struct event_base *)> mEventBase;
+    BorderAgentBrowser                                                mBrowser;
+    uint16_t                                                          mPort;
+    uint16_t                                                          mPort6;
+    std::vector<BorderAgent>                                          mBorderAgents;
+    std::vector<std::pair<BorderAgent, uint32_t>>                     mRecords;
+};
+
+} // namespace
+
+TEST_CASE("border-agent-browser-merges-responses", "[border-agent]")
+{
+    Browser browser;
+
+    // The records of a Border Agent may come in several responses.
+    browser.Receive("127.0.0.1", {Ptr("ba1"), Srv("ba1", 49191)});
+    REQUIRE(browser.mBorderAgents.size() == 1);
+    REQUIRE(browser.mBorderAgents[0].mPresentFlags == uint16_t{BorderAgent::kPortBit});
+    REQUIRE(browser.mBorderAgents[0].mPort == 49191);
+
+    browser.Receive("127.0.0.1", {Txt("ba1", "OpenThread", kXpanId), Addr("ba1", "10.0.0.1")});
+    REQUIRE(browser.mBorderAgents.size() == 2);
+    REQUIRE(browser.mBorderAgents[1].mPresentFlags ==
+            (BorderAgent::kPortBit | BorderAgent::kNetworkNameBit | BorderAgent::kExtendedPanIdBit |
+             BorderAgent::kAddrBit));
+    REQUIRE(browser.mBorderAgents[1].mPort == 49191);
+    REQUIRE(browser.mBorderAgents[1].mNetworkName == "OpenThread");
+    REQUIRE(browser.mBorderAgents[1].mExtendedPanId == kXpanId);
+    REQUIRE(browser.mBorderAgents[1].mAddr == "10.0.0.1");
+
+    // Unchanged Border Agents are not reported again, but their records are.
+    browser.Receive("127.0.0.1", AllRecords("ba1", "10.0.0.1"));
+    REQUIRE(browser.mBorderAgents.size() == 2);
+    REQUIRE(browser.mRecords.size() == 3);
+    REQUIRE(browser.mRecords.back().second == kTtl);
+
+    // A changed field is reported.
+    browser.Receive("127.0.0.1", {Txt("ba1", "OpenThread-1", kXpanId)});
+    REQUIRE(browser.mBorderAgents.size() == 3);
+    REQUIRE(browser.mBorderAgents[2].mNetworkName == "OpenThread-1");
+    REQUIRE(browser.mBorderAgents[2].mAddr == "10.0.0.1");
+}
+
+TEST_CASE("border-agent-browser-keys-border-agents", "[border-agent]")
+{
+    Browser browser;
+
+    SECTION("responders of the same service instance are merged")
+    {
+        // The IPv4 and IPv6 addresses of the same Border Agent.
+        browser.Receive("127.0.0.1", AllRecords("ba1", "10.0.0.1"));
+        browser.Receive("::1", AllRecords("ba1", "10.0.0.1"));
+        REQUIRE(browser.mBorderAgents.size() == 1);
+        REQUIRE(browser.mRecords.size() == 2);
+    }
+
+    SECTION("service instances of the same network are not merged")
+    {
+        browser.Receive("127.0.0.1", AllRecords("ba1", "10.0.0.1"));
+        browser.Receive("127.0.0.2", AllRecords("ba2", "10.0.0.2"));
+        REQUIRE(browser.mBorderAgents.size() == 2);
+        REQUIRE(browser.mBorderAgents[0].mAddr == "10.0.0.1");
+        REQUIRE(browser.mBorderAgents[1].mAddr == "10.0.0.2");
+    }
+
+    SECTION("Border Agents without Extended PAN ID are keyed by responder")
+    {
+        browser.Receive("127.0.0.1", {Ptr("ba1"), Srv("ba1", 49191), Addr("ba1", "10.0.0.1")});
+        browser.Receive("127.0.0.2", {Ptr("ba1"), Srv("ba1", 49191), Addr("ba1", "10.0.0.2")});
+        REQUIRE(browser.mBorderAgents.size() == 2);
+        REQUIRE(browser.mBorderAgents[0].mAddr == "10.0.0.1");
+        REQUIRE(browser.mBorderAgents[1].mAddr == "10.0.0.2");
+    }
+}
+
+TEST_CASE("border-agent-browser-pins-address", "[border-agent]")
+{
+    Browser browser;
+
+    browser.Receive("127.0.0.1", AllRecords("ba1", "10.0.0.1"));
+    REQUIRE(browser.mBorderAgents.size() == 1);
+
+    // The address of the first responder is kept.
+    browser.Receive("127.0.0.2", AllRecords("ba1", "10.0.0.2"));
+    REQUIRE(browser.mBorderAgents.size() == 1);
+    REQUIRE(browser.mRecords.back().first.mAddr == "10.0.0.1");
+
+    // The first responder changes its address.
+    browser.Receive("127.0.0.1", {Addr("ba1", "10.0.0.3")});
+    REQUIRE(browser.mBorderAgents.size() == 2);
+    REQUIRE(browser.mBorderAgents[1].mAddr == "10.0.0.3");
+}
+
+TEST_CASE("border-agent-browser-handles-goodbye", "[border-agent]")
+{
+    Browser browser;
+
+    browser.Receive("127.0.0.1", AllRecords("ba1", "10.0.0.1"));
+    browser.Receive("127.0.0.2", AllRecords("ba1", "10.0.0.2"));
+    REQUIRE(browser.mRecords.size() == 2);
+
+    SECTION("the Border Agent is gone with its last responder")
+    {
+        // The address of the other responder is still reported.
+        browser.Receive("127.0.0.2", AllRecords("ba1", "10.0.0.2", 0));
+        REQUIRE(browser.mRecords.size() == 2);
+
+        browser.Receive("127.0.0.1", AllRecords("ba1", "10.0.0.1", 0));
+        REQUIRE(browser.mRecords.size() == 3);
+        REQUIRE(browser.mRecords.back().first.mAddr == "10.0.0.1");
+        REQUIRE(browser.mRecords.back().second == 0);
+    }
+
+    SECTION("the address of another responder is taken over")
+    {
+        browser.Receive("127.0.0.1", AllRecords("ba1", "10.0.0.1", 0));
+        REQUIRE(browser.mRecords.size() == 3);
+        REQUIRE(browser.mRecords.back().first.mAddr == "10.0.0.1");
+        REQUIRE(browser.mRecords.back().second == 0);
+
+        browser.Receive("127.0.0.2", AllRecords("ba1", "10.0.0.2", 0));
+        REQUIRE(browser.mRecords.size() == 4);
+        REQUIRE(browser.mRecords.back().first.mAddr == "10.0.0.2");
+        REQUIRE(browser.mRecords.back().second == 0);
+    }
+
+    // A Border Agent coming back is reported again.
+    REQUIRE(browser.mBorderAgents.size() == 1);
+    browser.Receive("127.0.0.1", AllRecords("ba1", "10.0.0.1"));
+    REQUIRE(browser.mBorderAgents.size() == 2);
+    REQUIRE(browser.mBorderAgents[1].mAddr == "10.0.0.1");
+}
+
+} // namespace commissioner
+
+} // namespace ot
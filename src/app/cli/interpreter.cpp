@@ -33,10 +33,22 @@
 
 #include "app/cli/interpreter.hpp"
 
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <set>
+#include <thread>
+
 #include <string.h>
 
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
 #include "app/file_util.hpp"
 #include "app/json.hpp"
+#include "app/network_data_snapshot.hpp"
 #include "common/error_macros.hpp"
 #include "common/utils.hpp"
 
@@ -44,6 +56,9 @@ namespace ot {
 
 namespace commissioner {
 
+constexpr Duration Interpreter::kDiscoveryTimeout;
+constexpr size_t   Interpreter::kMaxPipelinedCommands;
+
 const std::map<std::string, Interpreter::Evaluator> &Interpreter::mEvaluatorMap = *new std::map<std::string, Evaluator>{
     {"start", &Interpreter::ProcessStart},
     {"stop", &Interpreter::ProcessStop},
@@ -68,16 +83,20 @@ const std::map<std::string, Interpreter::Evaluator> &Interpreter::mEvaluatorMap
 };
 
 const std::map<std::string, std::string> &Interpreter::mUsageMap = *new std::map<std::string, std::string>{
-    {"start", "start <border-agent-addr> <border-agent-port>"},
+    {"start", "start <border-agent-addr> <border-agent-port> [<border-agent-addr> <border-agent-port>]...\n"
+              "start <network-name>"},
     {"stop", "stop"},
     {"active", "active"},
     {"token", "token request <registrar-addr> <registrar-port>\n"
               "token print\n"
               "token set <signed-token-hex-string-file> <signer-cert-pem-file>"},
-    {"network", "network save <network-data-file>\n"
+    {"network", "network save <network-data-file> [json|snapshot]\n"
+                "network export <snapshot-file> <json-file>\n"
                 "network sync"},
     {"sessionid", "sessionid"},
     {"borderagent", "borderagent discover [<timeout-in-milliseconds>]\n"
+                    "borderagent find networkname <network-name> [<timeout-in-milliseconds>]\n"
+                    "borderagent find xpanid <extended-pan-id> [<timeout-in-milliseconds>]\n"
                     "borderagent get locator\n"
                     "borderagent get meshlocaladdr"},
     {"joiner", "joiner enable (meshcop|ae|nmkp) <joiner-eui64> [<joiner-password>] [<provisioning-url>]\n"
@@ -197,6 +216,90 @@ exit:
     return;
 }
 
+Error Interpreter::RunBatch(const std::string &aCommandFile)
+{
+    Error                                error;
+    std::ifstream                        file;
+    std::istream *                       input = &std::cin;
+    std::string                          line;
+    size_t                               lineNum        = 0;
+    size_t                               commandNum     = 0;
+    size_t                               failedNum      = 0;
+    auto                                 batchStartTime = BatchClock::now();
+    std::deque<std::future<BatchResult>> pipeline;
+
+    auto popPipeline = [&]() {
+        BatchResult result = pipeline.front().get();
+
+        pipeline.pop_front();
+        failedNum += result.mValue.HasNoError() ? 0 : 1;
+        PrintBatchResult(result);
+    };
+
+    VerifyOrExit(mCommissioner != nullptr, error = ERROR_INVALID_STATE("the commissioner is not initialized"));
+
+    if (aCommandFile != "-")
+    {
+        file.open(aCommandFile);
+        VerifyOrExit(file.is_open(), error = ERROR_IO_ERROR("cannot open file '{}'", aCommandFile));
+        input = &file;
+    }
+
+    while (!mShouldExit && std::getline(*input, line))
+    {
+        Expression expr = ParseExpression(line);
+
+        ++lineNum;
+
+        // Blank lines and comments are skipped.
+        if (expr.empty() || (!expr.front().empty() && expr.front()[0] == '#'))
+        {
+            continue;
+        }
+        ++commandNum;
+
+        if (IsPipelined(expr))
+        {
+            if (pipeline.size() >= kMaxPipelinedCommands)
+            {
+                popPipeline();
+            }
+            pipeline.push_back(std::async(std::launch::async, &Interpreter::EvalBatchCommand, this, lineNum, line,
+                                          expr, batchStartTime));
+        }
+        else
+        {
+            BatchResult result;
+
+            // A command which depends on or changes the commissioner state
+            // waits for all preceding commands to complete.
+            while (!pipeline.empty())
+            {
+                popPipeline();
+            }
+
+            result = EvalBatchCommand(lineNum, line, expr, batchStartTime);
+            failedNum += result.mValue.HasNoError() ? 0 : 1;
+            PrintBatchResult(result);
+        }
+    }
+
+    while (!pipeline.empty())
+    {
+        popPipeline();
+    }
+
+    if (!mShouldExit)
+    {
+        mCommissioner->Stop();
+    }
+
+    VerifyOrExit(failedNum == 0, error = ERROR_ABORTED("{} of {} commands failed", failedNum, commandNum));
+
+exit:
+    return error;
+}
+
 void Interpreter::CancelCommand()
 {
     if (mCommissioner->IsActive())
@@ -248,6 +351,37 @@ void Interpreter::Print(const Value &aValue)
     mConsole.Write(output, color);
 }
 
+Interpreter::BatchResult Interpreter::EvalBatchCommand(size_t                 aLine,
+                                                       const std::string &    aCommand,
+                                                       const Expression &     aExpr,
+                                                       BatchClock::time_point aBatchStartTime)
+{
+    BatchResult result;
+    auto        startTime = BatchClock::now();
+
+    result.mLine      = aLine;
+    result.mCommand   = aCommand;
+    result.mValue     = Eval(aExpr);
+    result.mStartTime = std::chrono::duration_cast<Duration>(startTime - aBatchStartTime);
+    result.mDuration  = std::chrono::duration_cast<Duration>(BatchClock::now() - startTime);
+
+    return result;
+}
+
+void Interpreter::PrintBatchResult(const BatchResult &aResult)
+{
+    nlohmann::json json;
+
+    json["Line"]      = aResult.mLine;
+    json["Command"]   = aResult.mCommand;
+    json["Status"]    = aResult.mValue.HasNoError() ? "done" : "failed";
+    json["StartTime"] = aResult.mStartTime.count();
+    json["Duration"]  = aResult.mDuration.count();
+    json[aResult.mValue.HasNoError() ? "Result" : "Error"] = aResult.mValue.ToString();
+
+    std::cout << json.dump() << std::endl;
+}
+
 std::string Interpreter::Value::ToString() const
 {
     return HasNoError() ? mData : mError.ToString();
@@ -308,13 +442,62 @@ Interpreter::Expression Interpreter::ParseExpression(const std::string &aLiteral
 
 Interpreter::Value Interpreter::ProcessStart(const Expression &aExpr)
 {
-    Error       error;
-    uint16_t    port;
-    std::string existingCommissionerId;
+    Error                        error;
+    Value                        value;
+    std::string                  existingCommissionerId;
+    std::vector<BorderAgentAddr> borderAgentAddrs;
+    ConnectResult                connectResult;
+
+    VerifyOrExit(aExpr.size() >= 2, error = ERROR_INVALID_ARGS("too few arguments"));
+
+    if (aExpr.size() == 2)
+    {
+        std::vector<BorderAgent> borderAgents;
+
+        // A cached Border Agent of the network is used without waiting for discovery.
+        if (!mBorderAgentCache.IsRunning())
+        {
+            SuccessOrExit(error = mBorderAgentCache.Start());
+        }
+        SuccessOrExit(error = mBorderAgentCache.FindByNetworkName(borderAgents, aExpr[1], kDiscoveryTimeout));
+
+        for (const auto &borderAgent : borderAgents)
+        {
+            BorderAgentAddr borderAgentAddr;
+
+            borderAgentAddr.mAddr = borderAgent.mAddr;
+            borderAgentAddr.mPort = borderAgent.mPort;
+            borderAgentAddrs.push_back(borderAgentAddr);
+        }
+    }
+    else
+    {
+        VerifyOrExit(aExpr.size() % 2 == 1,
+                     error = ERROR_INVALID_ARGS("expect pairs of border agent address and port"));
+
+        for (size_t i = 1; i < aExpr.size(); i += 2)
+        {
+            BorderAgentAddr borderAgentAddr;
+
+            borderAgentAddr.mAddr = aExpr[i];
+            SuccessOrExit(error = ParseInteger(borderAgentAddr.mPort, aExpr[i + 1]));
+            borderAgentAddrs.push_back(borderAgentAddr);
+        }
+    }
 
-    VerifyOrExit(aExpr.size() >= 3, error = ERROR_INVALID_ARGS("too few arguments"));
-    SuccessOrExit(error = ParseInteger(port, aExpr[2]));
-    SuccessOrExit(error = mCommissioner->Start(existingCommissionerId, aExpr[1], port));
+    if (borderAgentAddrs.size() == 1)
+    {
+        SuccessOrExit(error = mCommissioner->Start(existingCommissionerId, borderAgentAddrs.front().mAddr,
+                                                   borderAgentAddrs.front().mPort));
+    }
+    else
+    {
+        // Several Border Agents race with staggered DTLS handshakes.
+        SuccessOrExit(error = mCommissioner->Start(existingCommissionerId, borderAgentAddrs, connectResult));
+        value = fmt::format("connected to [{}]:{} in {}ms, DTLS handshake took {}ms",
+                            connectResult.mBorderAgent.mAddr, connectResult.mBorderAgent.mPort,
+                            connectResult.mConnectTime, connectResult.mHandshakeTime);
+    }
 
 exit:
     if (!existingCommissionerId.empty())
@@ -322,7 +505,11 @@ exit:
         ASSERT(error != ErrorCode::kNone);
         error = Error{error.GetCode(), "there is an existing active commissioner: " + existingCommissionerId};
     }
-    return error;
+    if (error != ErrorCode::kNone)
+    {
+        value = error;
+    }
+    return value;
 }
 
 Interpreter::Value Interpreter::ProcessStop(const Expression &)
@@ -382,7 +569,26 @@ Interpreter::Value Interpreter::ProcessNetwork(const Expression &aExpr)
     if (CaseInsensitiveEqual(aExpr[1], "save"))
     {
         VerifyOrExit(aExpr.size() >= 3, value = ERROR_INVALID_ARGS("too few arguments"));
-        SuccessOrExit(value = mCommissioner->SaveNetworkData(aExpr[2]));
+        if (aExpr.size() == 3 || CaseInsensitiveEqual(aExpr[3], "json"))
+        {
+            SuccessOrExit(value = mCommissioner->SaveNetworkData(aExpr[2]));
+        }
+        else if (CaseInsensitiveEqual(aExpr[3], "snapshot"))
+        {
+            SuccessOrExit(value = mCommissioner->SaveNetworkSnapshot(aExpr[2]));
+        }
+        else
+        {
+            ExitNow(value = ERROR_INVALID_ARGS("{} is not a valid network data format", aExpr[3]));
+        }
+    }
+    else if (CaseInsensitiveEqual(aExpr[1], "export"))
+    {
+        std::string json;
+
+        VerifyOrExit(aExpr.size() >= 4, value = ERROR_INVALID_ARGS("too few arguments"));
+        SuccessOrExit(value = SnapshotToJson(json, aExpr[2]));
+        SuccessOrExit(value = WriteFile(json, aExpr[3]));
     }
     else if (CaseInsensitiveEqual(aExpr[1], "sync"))
     {
@@ -417,14 +623,67 @@ Interpreter::Value Interpreter::ProcessBorderAgent(const Expression &aExpr)
 
     if (CaseInsensitiveEqual(aExpr[1], "discover"))
     {
-        uint64_t timeout = 4000;
+        uint64_t                 timeout = kDiscoveryTimeout.count();
+        std::vector<BorderAgent> borderAgents;
 
         if (aExpr.size() >= 3)
         {
             SuccessOrExit(value = ParseInteger(timeout, aExpr[2]));
         }
 
-        SuccessOrExit(value = DiscoverBorderAgent(BorderAgentHandler, static_cast<size_t>(timeout)));
+        if (!mBorderAgentCache.IsRunning())
+        {
+            SuccessOrExit(value = mBorderAgentCache.Start());
+        }
+
+        // Waits for mDNS responses only if no fresh Border Agent is cached.
+        borderAgents = mBorderAgentCache.GetBorderAgents();
+        if (borderAgents.empty())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+            borderAgents = mBorderAgentCache.GetBorderAgents();
+        }
+
+        value = ToString(borderAgents);
+    }
+    else if (CaseInsensitiveEqual(aExpr[1], "find"))
+    {
+        uint64_t                 timeout = kDiscoveryTimeout.count();
+        std::vector<BorderAgent> borderAgents;
+
+        VerifyOrExit(aExpr.size() >= 4, value = ERROR_INVALID_ARGS("too few arguments"));
+
+        if (aExpr.size() >= 5)
+        {
+            SuccessOrExit(value = ParseInteger(timeout, aExpr[4]));
+        }
+
+        if (!mBorderAgentCache.IsRunning())
+        {
+            SuccessOrExit(value = mBorderAgentCache.Start());
+        }
+
+        if (CaseInsensitiveEqual(aExpr[2], "networkname"))
+        {
+            SuccessOrExit(value = mBorderAgentCache.FindByNetworkName(borderAgents, aExpr[3],
+                                                                      std::chrono::milliseconds(timeout)));
+        }
+        else if (CaseInsensitiveEqual(aExpr[2], "xpanid"))
+        {
+            ByteArray xpanid;
+
+            SuccessOrExit(value = utils::Hex(xpanid, aExpr[3]));
+            VerifyOrExit(xpanid.size() == sizeof(uint64_t),
+                         value = ERROR_INVALID_ARGS("{} is not a valid extended PAN ID", aExpr[3]));
+            SuccessOrExit(value = mBorderAgentCache.FindByExtendedPanId(borderAgents, utils::Decode<uint64_t>(xpanid),
+                                                                        std::chrono::milliseconds(timeout)));
+        }
+        else
+        {
+            ExitNow(value = ERROR_INVALID_ARGS("{} is not a valid border agent field", aExpr[2]));
+        }
+
+        value = ToString(borderAgents);
     }
     else if (CaseInsensitiveEqual(aExpr[1], "get"))
     {
@@ -1031,17 +1290,22 @@ exit:
     return value;
 }
 
-void Interpreter::BorderAgentHandler(const BorderAgent *aBorderAgent, const Error &aError)
+bool Interpreter::IsPipelined(const Expression &aExpr)
 {
-    if (aError != ErrorCode::kNone)
-    {
-        Console::Write(aError.ToString(), Console::Color::kRed);
-    }
-    else
+    // These commands send a single request to the Thread network and touch
+    // no state of the CLI or the commissioner app, so they are independent
+    // of each other and of the commands around them.
+    static const std::set<std::string> kPipelinedCommands = {"reenroll", "domainreset", "migrate", "announce"};
+
+    std::string command = ToLower(aExpr.front());
+
+    if (kPipelinedCommands.count(command) != 0)
     {
-        ASSERT(aBorderAgent != nullptr);
-        Console::Write(ToString(*aBorderAgent), Console::Color::kGreen);
+        return true;
     }
+
+    return aExpr.size() >= 2 && ((command == "panid" && CaseInsensitiveEqual(aExpr[1], "query")) ||
+                                 (command == "energy" && CaseInsensitiveEqual(aExpr[1], "scan")));
 }
 
 const std::string Interpreter::Usage(Expression aExpr)
@@ -1171,6 +1435,24 @@ std::string Interpreter::ToString(const BorderAgent &aBorderAgent)
     return ret;
 }
 
+std::string Interpreter::ToString(const std::vector<BorderAgent> &aBorderAgents)
+{
+    std::string ret;
+
+    for (const auto &borderAgent : aBorderAgents)
+    {
+        ret += (ret.empty() ? "" : "\n") + ToString(borderAgent);
+    }
+
+    // Print() appends its own line break.
+    if (!ret.empty())
+    {
+        ret.pop_back();
+    }
+
+    return ret;
+}
+
 std::string Interpreter::ToString(const BorderAgent::State &aState)
 {
     std::string ret;
@@ -34,9 +34,11 @@
 #ifndef OT_COMM_APP_CLI_INTERPRETER_HPP_
 #define OT_COMM_APP_CLI_INTERPRETER_HPP_
 
+#include <chrono>
 #include <map>
 
 #include "app/border_agent.hpp"
+#include "app/border_agent_cache.hpp"
 #include "app/cli/console.hpp"
 #include "app/commissioner_app.hpp"
 
@@ -54,6 +56,11 @@ public:
 
     void Run();
 
+    // Runs commands read from the file, or stdin if it is "-", and prints
+    // one JSON object per command. Consecutive independent commands are
+    // pipelined and their results are printed in input order.
+    Error RunBatch(const std::string &aCommandFile);
+
     void CancelCommand();
 
 private:
@@ -92,6 +99,16 @@ private:
 
     using Expression = std::vector<std::string>;
     using Evaluator  = std::function<Value(Interpreter *, const Expression &)>;
+    using BatchClock = std::chrono::steady_clock;
+
+    struct BatchResult
+    {
+        size_t      mLine;
+        std::string mCommand;
+        Value       mValue;
+        Duration    mStartTime; ///< Relative to the start of the batch.
+        Duration    mDuration;
+    };
 
     Expression Read();
 
@@ -99,6 +116,12 @@ private:
 
     void Print(const Value &aValue);
 
+    BatchResult EvalBatchCommand(size_t                 aLine,
+                                 const std::string &    aCommand,
+                                 const Expression &     aExpr,
+                                 BatchClock::time_point aBatchStartTime);
+    void        PrintBatchResult(const BatchResult &aResult);
+
     Expression ParseExpression(const std::string &aLiteral);
 
     Value ProcessStart(const Expression &aExpr);
@@ -122,8 +145,7 @@ private:
     Value ProcessExit(const Expression &aExpr);
     Value ProcessHelp(const Expression &aExpr);
 
-    static void BorderAgentHandler(const BorderAgent *aBorderAgent, const Error &aError);
-
+    static bool              IsPipelined(const Expression &aExpr);
     static const std::string Usage(Expression aExpr);
     static Error             GetJoinerType(JoinerType &aType, const std::string &aStr);
     static Error             ParseChannelMask(ChannelMask &aChannelMask, const Expression &aExpr, size_t aIndex);
@@ -133,15 +155,23 @@ private:
     static std::string       ToString(const SecurityPolicy &aSecurityPolicy);
     static std::string       ToString(const EnergyReport &aReport);
     static std::string       ToString(const BorderAgent &aBorderAgent);
+    static std::string       ToString(const std::vector<BorderAgent> &aBorderAgents);
     static std::string       ToString(const BorderAgent::State &aState);
     static std::string       BaConnModeToString(uint32_t aConnMode);
     static std::string       BaThreadIfStatusToString(uint32_t aIfStatus);
     static std::string       BaAvailabilityToString(uint32_t aAvailability);
 
 private:
+    // The default time waiting for Border Agents to be discovered.
+    static constexpr Duration kDiscoveryTimeout{4000};
+
+    // The max number of pipelined commands waiting for responses in batch mode.
+    static constexpr size_t kMaxPipelinedCommands = 8;
+
     Config                           mConfig;
     std::shared_ptr<CommissionerApp> mCommissioner = nullptr;
     Console                          mConsole;
+    BorderAgentCache                 mBorderAgentCache;
 
     bool mShouldExit = false;
 
@@ -0,0 +1,159 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases of the CLI interpreter.
+ */
+
+#include "app/cli/interpreter.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <stdio.h>
+
+#include <catch2/catch.hpp>
+#include <nlohmann/json.hpp>
+
+#include "app/file_util.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+namespace {
+
+const std::string kConfig      = R"({"EnableCcm" : false, "PSKc" : "3aa55f91ca47d1e4e71a08cb35e91591"})";
+const std::string kConfigFile  = "interpreter_test.json";
+const std::string kCommandFile = "interpreter_test.commands";
+
+// Runs the command file in batch mode, and returns the JSON lines written to stdout.
+Error RunBatch(std::vector<nlohmann::json> &aResults, const std::string &aCommands)
+{
+    Error              error;
+    Interpreter        interpreter;
+    std::ostringstream output;
+    std::istringstream lines;
+    std::string        line;
+    std::streambuf *   stdoutBuf;
+
+    SuccessOrExit(error = WriteFile(kConfig, kConfigFile));
+    SuccessOrExit(error = WriteFile(aCommands, kCommandFile));
+    SuccessOrExit(error = interpreter.Init(kConfigFile));
+
+    stdoutBuf = std::cout.rdbuf(output.rdbuf());
+    error     = interpreter.RunBatch(kCommandFile);
+    std::cout.rdbuf(stdoutBuf);
+
+    lines.str(output.str());
+    while (std::getline(lines, line))
+    {
+        aResults.push_back(nlohmann::json::parse(line));
+    }
+
+exit:
+    remove(kConfigFile.c_str());
+    remove(kCommandFile.c_str());
+    return error;
+}
+
+} // namespace
+
+TEST_CASE("cli-batch-prints-results-in-input-order", "[cli]")
+{
+    std::vector<nlohmann::json> results;
+    std::string                 commands = "# Comments and blank lines are skipped.\n\nhelp stop\n";
+
+    // More pipelined commands than run at once. They fail because the
+    // commissioner is not active.
+    for (int i = 0; i < 10; ++i)
+    {
+        commands += "reenroll fd00::" + std::to_string(i + 1) + "\n";
+    }
+    commands += "help migrate\n"
+                "invalid-command\n";
+
+    Error error = RunBatch(results, commands);
+    REQUIRE(error.GetCode() == ErrorCode::kAborted);
+    REQUIRE(error.GetMessage() == "11 of 13 commands failed");
+
+    REQUIRE(results.size() == 13);
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        REQUIRE(results[i]["Line"] == i + 3);
+        REQUIRE(results[i].contains("StartTime"));
+        REQUIRE(results[i].contains("Duration"));
+    }
+
+    REQUIRE(results[0]["Command"] == "help stop");
+    REQUIRE(results[0]["Status"] == "done");
+    REQUIRE(results[0]["Result"] == "usage:\nstop");
+
+    for (size_t i = 1; i <= 10; ++i)
+    {
+        REQUIRE(results[i]["Command"] == "reenroll fd00::" + std::to_string(i));
+        REQUIRE(results[i]["Status"] == "failed");
+        REQUIRE(results[i].contains("Error"));
+    }
+
+    REQUIRE(results[11]["Command"] == "help migrate");
+    REQUIRE(results[11]["Status"] == "done");
+
+    REQUIRE(results[12]["Command"] == "invalid-command");
+    REQUIRE(results[12]["Status"] == "failed");
+}
+
+TEST_CASE("cli-batch-succeeds-if-all-commands-succeed", "[cli]")
+{
+    std::vector<nlohmann::json> results;
+
+    REQUIRE(RunBatch(results, "help\nhelp reenroll\n") == ErrorCode::kNone);
+    REQUIRE(results.size() == 2);
+    REQUIRE(results[0]["Status"] == "done");
+    REQUIRE(results[1]["Status"] == "done");
+    REQUIRE(results[1]["Result"] == "usage:\nreenroll <device-addr>");
+}
+
+TEST_CASE("cli-batch-without-command-file", "[cli]")
+{
+    Interpreter interpreter;
+
+    REQUIRE(interpreter.RunBatch(kCommandFile) == ErrorCode::kInvalidState);
+
+    REQUIRE(WriteFile(kConfig, kConfigFile) == ErrorCode::kNone);
+    REQUIRE(interpreter.Init(kConfigFile) == ErrorCode::kNone);
+    REQUIRE(remove(kConfigFile.c_str()) == 0);
+
+    REQUIRE(interpreter.RunBatch("no-such-directory/commands") == ErrorCode::kIOError);
+}
+
+} // namespace commissioner
+
+} // namespace ot
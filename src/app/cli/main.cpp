@@ -31,11 +31,14 @@
  *   The file is the entrance of the commissioner CLI.
  */
 
+#include <iostream>
 #include <thread>
 
 #include <signal.h>
 
 #include "app/cli/interpreter.hpp"
+#include "app/file_logger.hpp"
+#include "common/error_macros.hpp"
 #include "common/utils.hpp"
 
 #ifndef OT_COMM_VERSION
@@ -67,7 +70,8 @@ static void PrintUsage(const std::string &aProgram)
 {
     static const std::string usage = "usage: \n"
                                      "    " +
-                                     aProgram + " <config-file>";
+                                     aProgram + " <config-file>\n" + "    " + aProgram +
+                                     " <config-file> --batch [<command-file>|-]";
 
     Console::Write(usage, Console::Color::kWhite);
 }
@@ -93,8 +97,10 @@ static void HandleSignalInterrupt()
 
 int main(int argc, const char *argv[])
 {
-    Error  error;
-    Config config;
+    Error       error;
+    Config      config;
+    bool        isBatch = false;
+    std::string commandFile;
 
     if (argc < 2 || ToLower(argv[1]) == "-h" || ToLower(argv[1]) == "--help")
     {
@@ -106,6 +112,18 @@ int main(int argc, const char *argv[])
         PrintVersion();
         ExitNow();
     }
+    else if (argc >= 3)
+    {
+        if (ToLower(argv[2]) != "--batch" || argc > 4)
+        {
+            PrintUsage(argv[0]);
+            ExitNow(error = ERROR_INVALID_ARGS("invalid arguments"));
+        }
+
+        // Commands are read from stdin if no command file is given.
+        isBatch     = true;
+        commandFile = argc == 4 ? argv[3] : "-";
+    }
 
     // Block signals in this thread and subsequently spawned threads.
     sigemptyset(&gSignalSet);
@@ -114,6 +132,17 @@ int main(int argc, const char *argv[])
 
     std::thread(HandleSignalInterrupt).detach();
 
+    // Write buffered log messages if the CLI crashes.
+    FileLogger::InstallCrashHandler();
+
+    if (isBatch)
+    {
+        // The stdout carries only JSON results in batch mode.
+        SuccessOrExit(error = gInterpreter.Init(argv[1]));
+        SuccessOrExit(error = gInterpreter.RunBatch(commandFile));
+        ExitNow();
+    }
+
     Console::Write(kLogo, Console::Color::kBlue);
 
     SuccessOrExit(error = gInterpreter.Init(argv[1]));
@@ -121,7 +150,11 @@ int main(int argc, const char *argv[])
     gInterpreter.Run();
 
 exit:
-    if (error != ErrorCode::kNone)
+    if (error != ErrorCode::kNone && isBatch)
+    {
+        std::cerr << "OT-commissioner CLI batch failed: " << error.ToString() << std::endl;
+    }
+    else if (error != ErrorCode::kNone)
     {
         Console::Write("start OT-commissioner CLI failed: " + error.ToString(), Console::Color::kRed);
     }
@@ -34,9 +34,13 @@
 #include "app/commissioner_app.hpp"
 
 #include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 
 #include "app/file_util.hpp"
 #include "app/json.hpp"
+#include "app/network_data_snapshot.hpp"
 #include "common/address.hpp"
 #include "common/error_macros.hpp"
 #include "common/utils.hpp"
@@ -98,6 +102,27 @@ exit:
     return error;
 }
 
+Error CommissionerApp::Start(std::string &                       aExistingCommissionerId,
+                             const std::vector<BorderAgentAddr> &aBorderAgents,
+                             ConnectResult &                     aConnectResult)
+{
+    Error error;
+
+    SuccessOrExit(error = mCommissioner->Connect(aConnectResult, aBorderAgents));
+
+    // The connected border agent is petitioned without connecting again.
+    SuccessOrExit(error = mCommissioner->Petition(aExistingCommissionerId, aConnectResult.mBorderAgent.mAddr,
+                                                  aConnectResult.mBorderAgent.mPort));
+    SuccessOrExit(error = SyncNetworkData());
+
+exit:
+    if (error != ErrorCode::kNone && !IsActive())
+    {
+        Stop();
+    }
+    return error;
+}
+
 void CommissionerApp::Stop()
 {
     IgnoreError(mCommissioner->Resign());
@@ -109,6 +134,8 @@ void CommissionerApp::Stop()
     mPendingDataset = PendingOperationalDataset();
     mCommDataset    = MakeDefaultCommissionerDataset();
     mBbrDataset     = BbrDataset();
+
+    InvalidateDatasetCache();
 }
 
 void CommissionerApp::CancelRequests()
@@ -135,7 +162,9 @@ Error CommissionerApp::SaveNetworkData(const std::string &aFilename)
     networkData.mPendingDataset = mPendingDataset;
     networkData.mCommDataset    = mCommDataset;
     networkData.mBbrDataset     = mBbrDataset;
-    auto jsonString             = NetworkDataToJson(networkData);
+
+    // In the same format as an exported snapshot.
+    auto jsonString = NetworkDataListToJson({networkData});
 
     SuccessOrExit(error = WriteFile(jsonString, aFilename));
 
@@ -143,28 +172,121 @@ exit:
     return error;
 }
 
+Error CommissionerApp::SaveNetworkSnapshot(const std::string &aFilename)
+{
+    NetworkData networkData;
+
+    networkData.mActiveDataset  = mActiveDataset;
+    networkData.mPendingDataset = mPendingDataset;
+    networkData.mCommDataset    = mCommDataset;
+    networkData.mBbrDataset     = mBbrDataset;
+
+    return WriteSnapshot({networkData}, aFilename);
+}
+
+namespace {
+
+// Joins concurrent asynchronous requests. The response data of a request
+// is stored only if it succeeds, and Wait() returns the first error.
+class RequestJoiner
+{
+public:
+    Commissioner::ErrorHandler Add()
+    {
+        auto state = mState;
+
+        state->Begin();
+        return [state](Error aError) { state->Finish(aError); };
+    }
+
+    template <typename T> Commissioner::Handler<T> Add(T &aResponseData)
+    {
+        auto state = mState;
+
+        state->Begin();
+        return [state, &aResponseData](const T *aData, Error aError) {
+            if (aData != nullptr)
+            {
+                aResponseData = *aData;
+            }
+            state->Finish(aError);
+        };
+    }
+
+    Error Wait()
+    {
+        std::unique_lock<std::mutex> lock(mState->mMutex);
+
+        mState->mCondVar.wait(lock, [this]() { return mState->mPending == 0; });
+        return mState->mError;
+    }
+
+private:
+    struct State
+    {
+        std::mutex              mMutex;
+        std::condition_variable mCondVar;
+        size_t                  mPending = 0;
+        Error                   mError;
+
+        void Begin()
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            ++mPending;
+        }
+
+        void Finish(Error aError)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+
+            if (mError == ErrorCode::kNone)
+            {
+                mError = aError;
+            }
+            if (--mPending == 0)
+            {
+                mCondVar.notify_all();
+            }
+        }
+    };
+
+    std::shared_ptr<State> mState = std::make_shared<State>();
+};
+
+} // namespace
+
 Error CommissionerApp::SyncNetworkData(void)
 {
     Error                     error;
+    uint32_t                  generation = mDatasetGeneration;
     ActiveOperationalDataset  activeDataset;
     PendingOperationalDataset pendingDataset;
     BbrDataset                bbrDataset;
+    RequestJoiner             joiner;
 
-    SuccessOrExit(error = mCommissioner->SetCommissionerDataset(mCommDataset));
+    // The requests are independent of each other, they are sent
+    // concurrently and the sync takes about the slowest one.
+    mCommissioner->SetCommissionerDataset(joiner.Add(), mCommDataset);
     if (IsCcmMode())
     {
-        SuccessOrExit(error = mCommissioner->GetBbrDataset(bbrDataset, 0xFFFF));
+        mCommissioner->GetBbrDataset(joiner.Add(bbrDataset), 0xFFFF);
     }
+    mCommissioner->GetActiveDataset(joiner.Add(activeDataset), 0xFFFF);
+    mCommissioner->GetPendingDataset(joiner.Add(pendingDataset), 0xFFFF);
 
-    SuccessOrExit(error = mCommissioner->GetActiveDataset(activeDataset, 0xFFFF));
-    SuccessOrExit(error = mCommissioner->GetPendingDataset(pendingDataset, 0xFFFF));
+    SuccessOrExit(error = joiner.Wait());
 
     if (IsCcmMode())
     {
         mBbrDataset = bbrDataset;
     }
-    mActiveDataset  = activeDataset;
-    mPendingDataset = pendingDataset;
+
+    mActiveDataset            = activeDataset;
+    mActiveDatasetCached      = true;
+    mActiveDatasetGeneration  = generation;
+    mPendingDataset           = pendingDataset;
+    mPendingDatasetCached     = true;
+    mPendingDatasetGeneration = generation;
 
 exit:
     return error;
@@ -406,11 +528,12 @@ exit:
     return error;
 }
 
-Error CommissionerApp::GetActiveTimestamp(Timestamp &aTimestamp) const
+Error CommissionerApp::GetActiveTimestamp(Timestamp &aTimestamp)
 {
     Error error;
 
     VerifyOrExit(IsActive(), error = ERROR_INVALID_STATE("the commissioner is not active"));
+    SuccessOrExit(error = RefreshActiveDataset(false));
 
     VerifyOrDie(mActiveDataset.mPresentFlags & ActiveOperationalDataset::kActiveTimestampBit);
     aTimestamp = mActiveDataset.mActiveTimestamp;
@@ -426,10 +549,8 @@ Error CommissionerApp::GetChannel(Channel &aChannel)
     VerifyOrExit(IsActive(), error = ERROR_INVALID_STATE("the commissioner is not active"));
 
     // Since channel will be updated by pending operational after a delay time,
-    // we need to pull the active operational dataset.
-
-    // TODO(wgtdkp): should we send MGMT_ACTIVE_GET.req for all GetXXX APIs ?
-    SuccessOrExit(error = mCommissioner->GetActiveDataset(mActiveDataset, 0xFFFF));
+    // we need to revalidate the active operational dataset.
+    SuccessOrExit(error = RefreshActiveDataset(true));
 
     VerifyOrDie(mActiveDataset.mPresentFlags & ActiveOperationalDataset::kChannelBit);
 
@@ -455,16 +576,18 @@ Error CommissionerApp::SetChannel(const Channel &aChannel, MilliSeconds aDelay)
     SuccessOrExit(error = mCommissioner->SetPendingDataset(pendingDataset));
 
     MergeDataset(mPendingDataset, pendingDataset);
+    mPendingDatasetCached = false;
 
 exit:
     return error;
 }
 
-Error CommissionerApp::GetChannelMask(ChannelMask &aChannelMask) const
+Error CommissionerApp::GetChannelMask(ChannelMask &aChannelMask)
 {
     Error error;
 
     VerifyOrExit(IsActive(), error = ERROR_INVALID_STATE("the commissioner is not active"));
+    SuccessOrExit(error = RefreshActiveDataset(false));
 
     VerifyOrExit(mActiveDataset.mPresentFlags & ActiveOperationalDataset::kChannelMaskBit,
                  error = ERROR_NOT_FOUND("cannot find valid Channel Masks in Active Operational Dataset"));
@@ -487,16 +610,18 @@ Error CommissionerApp::SetChannelMask(const ChannelMask &aChannelMask)
     SuccessOrExit(error = mCommissioner->SetActiveDataset(activeDataset));
 
     MergeDataset(mActiveDataset, activeDataset);
+    mActiveDatasetCached = false;
 
 exit:
     return error;
 }
 
-Error CommissionerApp::GetExtendedPanId(ByteArray &aExtendedPanId) const
+Error CommissionerApp::GetExtendedPanId(ByteArray &aExtendedPanId)
 {
     Error error;
 
     VerifyOrExit(IsActive(), error = ERROR_INVALID_STATE("the commissioner is not active"));
+    SuccessOrExit(error = RefreshActiveDataset(false));
 
     VerifyOrExit(mActiveDataset.mPresentFlags & ActiveOperationalDataset::kExtendedPanIdBit,
                  error = ERROR_NOT_FOUND("cannot find valid Extended PAN ID in Active Operational Dataset"));
@@ -519,6 +644,7 @@ Error CommissionerApp::SetExtendedPanId(const ByteArray &aExtendedPanId)
     SuccessOrExit(error = mCommissioner->SetActiveDataset(activeDataset));
 
     MergeDataset(mActiveDataset, activeDataset);
+    mActiveDatasetCached = false;
 
 exit:
     return error;
@@ -530,7 +656,7 @@ Error CommissionerApp::GetMeshLocalPrefix(std::string &aPrefix)
 
     VerifyOrExit(IsActive(), error = ERROR_INVALID_STATE("the commissioner is not active"));
 
-    SuccessOrExit(error = mCommissioner->GetActiveDataset(mActiveDataset, 0xFFFF));
+    SuccessOrExit(error = RefreshActiveDataset(true));
 
     VerifyOrExit(mActiveDataset.mPresentFlags & ActiveOperationalDataset::kMeshLocalPrefixBit,
                  error = ERROR_NOT_FOUND("cannot find valid Mesh-local Prefix in Active Operational Dataset"));
@@ -556,6 +682,7 @@ Error CommissionerApp::SetMeshLocalPrefix(const std::string &aPrefix, MilliSecon
     SuccessOrExit(error = mCommissioner->SetPendingDataset(pendingDataset));
 
     MergeDataset(mPendingDataset, pendingDataset);
+    mPendingDatasetCached = false;
 
 exit:
     return error;
@@ -568,7 +695,7 @@ Error CommissionerApp::GetNetworkMasterKey(ByteArray &aMasterKey)
     VerifyOrExit(IsActive(), error = ERROR_INVALID_STATE("the commissioner is not active"));
     ;
 
-    SuccessOrExit(error = mCommissioner->GetActiveDataset(mActiveDataset, 0xFFFF));
+    SuccessOrExit(error = RefreshActiveDataset(true));
 
     VerifyOrExit(mActiveDataset.mPresentFlags & ActiveOperationalDataset::kNetworkMasterKeyBit,
                  error = ERROR_NOT_FOUND("cannot find valid Network Master Key in Active Operational Dataset"));
@@ -594,16 +721,18 @@ Error CommissionerApp::SetNetworkMasterKey(const ByteArray &aMasterKey, MilliSec
     SuccessOrExit(error = mCommissioner->SetPendingDataset(pendingDataset));
 
     MergeDataset(mPendingDataset, pendingDataset);
+    mPendingDatasetCached = false;
 
 exit:
     return error;
 }
 
-Error CommissionerApp::GetNetworkName(std::string &aNetworkName) const
+Error CommissionerApp::GetNetworkName(std::string &aNetworkName)
 {
     Error error;
 
     VerifyOrExit(IsActive(), error = ERROR_INVALID_STATE("the commissioner is not active"));
+    SuccessOrExit(error = RefreshActiveDataset(false));
 
     VerifyOrExit(mActiveDataset.mPresentFlags & ActiveOperationalDataset::kNetworkNameBit,
                  error = ERROR_NOT_FOUND("cannot find valid Network Name in Active Operational Dataset"));
@@ -626,6 +755,7 @@ Error CommissionerApp::SetNetworkName(const std::string &aNetworkName)
     SuccessOrExit(error = mCommissioner->SetActiveDataset(activeDataset));
 
     MergeDataset(mActiveDataset, activeDataset);
+    mActiveDatasetCached = false;
 
 exit:
     return error;
@@ -637,7 +767,7 @@ Error CommissionerApp::GetPanId(uint16_t &aPanId)
 
     VerifyOrExit(IsActive(), error = ERROR_INVALID_STATE("the commissioner is not active"));
 
-    SuccessOrExit(error = mCommissioner->GetActiveDataset(mActiveDataset, 0xFFFF));
+    SuccessOrExit(error = RefreshActiveDataset(true));
 
     VerifyOrExit(mActiveDataset.mPresentFlags & ActiveOperationalDataset::kPanIdBit,
                  error = ERROR_NOT_FOUND("cannot find valid PAN ID in Active Operational Dataset"));
@@ -663,16 +793,18 @@ Error CommissionerApp::SetPanId(uint16_t aPanId, MilliSeconds aDelay)
     SuccessOrExit(error = mCommissioner->SetPendingDataset(pendingDataset));
 
     MergeDataset(mPendingDataset, pendingDataset);
+    mPendingDatasetCached = false;
 
 exit:
     return error;
 }
 
-Error CommissionerApp::GetPSKc(ByteArray &aPSKc) const
+Error CommissionerApp::GetPSKc(ByteArray &aPSKc)
 {
     Error error;
 
     VerifyOrExit(IsActive(), error = ERROR_INVALID_STATE("the commissioner is not active"));
+    SuccessOrExit(error = RefreshActiveDataset(false));
 
     VerifyOrExit(mActiveDataset.mPresentFlags & ActiveOperationalDataset::kPSKcBit,
                  error = ERROR_NOT_FOUND("cannot find valid PSKc in Active Operational Dataset"));
@@ -695,16 +827,18 @@ Error CommissionerApp::SetPSKc(const ByteArray &aPSKc)
     SuccessOrExit(error = mCommissioner->SetActiveDataset(activeDataset));
 
     MergeDataset(mActiveDataset, activeDataset);
+    mActiveDatasetCached = false;
 
 exit:
     return error;
 }
 
-Error CommissionerApp::GetSecurityPolicy(SecurityPolicy &aSecurityPolicy) const
+Error CommissionerApp::GetSecurityPolicy(SecurityPolicy &aSecurityPolicy)
 {
     Error error;
 
     VerifyOrExit(IsActive(), error = ERROR_INVALID_STATE("the commissioner is not active"));
+    SuccessOrExit(error = RefreshActiveDataset(false));
 
     VerifyOrExit(mActiveDataset.mPresentFlags & ActiveOperationalDataset::kSecurityPolicyBit,
                  error = ERROR_NOT_FOUND("cannot find valid Security Policy in Active Operational Dataset"));
@@ -727,6 +861,52 @@ Error CommissionerApp::SetSecurityPolicy(const SecurityPolicy &aSecurityPolicy)
     SuccessOrExit(error = mCommissioner->SetActiveDataset(activeDataset));
 
     MergeDataset(mActiveDataset, activeDataset);
+    mActiveDatasetCached = false;
+
+exit:
+    return error;
+}
+
+Error CommissionerApp::CommitDatasetTransaction(const DatasetTransaction &aTransaction)
+{
+    Error                    error;
+    ActiveOperationalDataset changes;
+
+    VerifyOrExit(IsActive(), error = ERROR_INVALID_STATE("the commissioner is not active"));
+    VerifyOrExit(!aTransaction.IsEmpty());
+
+    // The cache is invalidated by DATASET_CHANGED.ntf and by our own sets,
+    // so a valid cache is diffed without revalidation.
+    SuccessOrExit(error = RefreshActiveDataset(false));
+
+    changes = aTransaction.Diff(mActiveDataset);
+    VerifyOrExit(changes.mPresentFlags != 0);
+
+    if (DatasetTransaction::RequiresPendingDataset(changes.mPresentFlags))
+    {
+        PendingOperationalDataset pendingDataset;
+
+        MergeDataset(pendingDataset, changes);
+
+        pendingDataset.mDelayTimer = aTransaction.GetDelay().count();
+        pendingDataset.mPresentFlags |= PendingOperationalDataset::kDelayTimerBit;
+
+        SuccessOrExit(error = mCommissioner->SetPendingDataset(pendingDataset));
+
+        MergeDataset(mPendingDataset, pendingDataset);
+        mPendingDatasetCached = false;
+    }
+    else
+    {
+        ActiveOperationalDataset activeDataset;
+
+        MergeDataset(activeDataset, changes);
+
+        SuccessOrExit(error = mCommissioner->SetActiveDataset(activeDataset));
+
+        MergeDataset(mActiveDataset, activeDataset);
+        mActiveDatasetCached = false;
+    }
 
 exit:
     return error;
@@ -736,8 +916,14 @@ Error CommissionerApp::GetActiveDataset(ActiveOperationalDataset &aDataset, uint
 {
     Error error;
 
-    SuccessOrExit(error = mCommissioner->GetActiveDataset(aDataset, aDatasetFlags));
-    MergeDataset(mActiveDataset, aDataset);
+    SuccessOrExit(error = RefreshActiveDataset(true));
+
+    // An empty flags selects all fields, the same as MGMT_ACTIVE_GET.req without Get TLV.
+    aDataset = mActiveDataset;
+    if (aDatasetFlags != 0)
+    {
+        aDataset.mPresentFlags &= aDatasetFlags;
+    }
 
 exit:
     return error;
@@ -749,6 +935,7 @@ Error CommissionerApp::SetActiveDataset(const ActiveOperationalDataset &aDataset
 
     SuccessOrExit(error = mCommissioner->SetActiveDataset(aDataset));
     MergeDataset(mActiveDataset, aDataset);
+    mActiveDatasetCached = false;
 
 exit:
     return error;
@@ -758,8 +945,14 @@ Error CommissionerApp::GetPendingDataset(PendingOperationalDataset &aDataset, ui
 {
     Error error;
 
-    SuccessOrExit(error = mCommissioner->GetPendingDataset(aDataset, aDatasetFlags));
-    MergeDataset(mPendingDataset, aDataset);
+    SuccessOrExit(error = RefreshPendingDataset(true));
+
+    // An empty flags selects all fields, the same as MGMT_PENDING_GET.req without Get TLV.
+    aDataset = mPendingDataset;
+    if (aDatasetFlags != 0)
+    {
+        aDataset.mPresentFlags &= aDatasetFlags;
+    }
 
 exit:
     return error;
@@ -771,6 +964,7 @@ Error CommissionerApp::SetPendingDataset(const PendingOperationalDataset &aDatas
 
     SuccessOrExit(error = mCommissioner->SetPendingDataset(aDataset));
     MergeDataset(mPendingDataset, aDataset);
+    mPendingDatasetCached = false;
 
 exit:
     return error;
@@ -1267,33 +1461,8 @@ void CommissionerApp::OnEnergyReport(const std::string &aPeerAddr,
 
 void CommissionerApp::OnDatasetChanged()
 {
-    mCommissioner->GetActiveDataset(
-        [this](const ActiveOperationalDataset *aDataset, Error aError) {
-            if (aError == ErrorCode::kNone)
-            {
-                // FIXME(wgtdkp): synchronization
-                mActiveDataset = *aDataset;
-            }
-            else
-            {
-                // TODO(wgtdkp): logging
-            }
-        },
-        0xFFFF);
-
-    mCommissioner->GetPendingDataset(
-        [this](const PendingOperationalDataset *aDataset, Error aError) {
-            if (aError == ErrorCode::kNone)
-            {
-                // FIXME(wgtdkp): synchronization
-                mPendingDataset = *aDataset;
-            }
-            else
-            {
-                // TODO(wgtdkp): logging
-            }
-        },
-        0xFFFF);
+    // The datasets are fetched again on next access.
+    ++mDatasetGeneration;
 }
 
 Error CommissionerApp::ValidatePSKd(const std::string &aPSKd)
@@ -1316,6 +1485,74 @@ exit:
     return error;
 }
 
+// Returns true if both datasets have no Pending Timestamp or have the same one.
+static bool HasSamePendingTimestamp(const PendingOperationalDataset &aLhs, const PendingOperationalDataset &aRhs)
+{
+    bool lhsPresent = aLhs.mPresentFlags & PendingOperationalDataset::kPendingTimestampBit;
+    bool rhsPresent = aRhs.mPresentFlags & PendingOperationalDataset::kPendingTimestampBit;
+
+    return lhsPresent == rhsPresent &&
+           (!lhsPresent || aLhs.mPendingTimestamp.Encode() == aRhs.mPendingTimestamp.Encode());
+}
+
+Error CommissionerApp::RefreshActiveDataset(bool aRevalidate)
+{
+    Error                    error;
+    uint32_t                 generation = mDatasetGeneration;
+    ActiveOperationalDataset activeDataset;
+
+    if (mActiveDatasetCached && mActiveDatasetGeneration == generation)
+    {
+        VerifyOrExit(aRevalidate);
+
+        SuccessOrExit(error = mCommissioner->GetActiveDataset(activeDataset,
+                                                              ActiveOperationalDataset::kActiveTimestampBit));
+        VerifyOrExit(activeDataset.mActiveTimestamp.Encode() != mActiveDataset.mActiveTimestamp.Encode());
+    }
+
+    SuccessOrExit(error = mCommissioner->GetActiveDataset(activeDataset, 0xFFFF));
+
+    mActiveDataset           = activeDataset;
+    mActiveDatasetCached     = true;
+    mActiveDatasetGeneration = generation;
+
+exit:
+    return error;
+}
+
+Error CommissionerApp::RefreshPendingDataset(bool aRevalidate)
+{
+    Error                     error;
+    uint32_t                  generation = mDatasetGeneration;
+    PendingOperationalDataset pendingDataset;
+
+    if (mPendingDatasetCached && mPendingDatasetGeneration == generation)
+    {
+        VerifyOrExit(aRevalidate);
+
+        // The Delay Timer of a cached Pending Operational Dataset is not
+        // updated until the Pending Timestamp moves.
+        SuccessOrExit(error = mCommissioner->GetPendingDataset(pendingDataset,
+                                                               PendingOperationalDataset::kPendingTimestampBit));
+        VerifyOrExit(!HasSamePendingTimestamp(pendingDataset, mPendingDataset));
+    }
+
+    SuccessOrExit(error = mCommissioner->GetPendingDataset(pendingDataset, 0xFFFF));
+
+    mPendingDataset           = pendingDataset;
+    mPendingDatasetCached     = true;
+    mPendingDatasetGeneration = generation;
+
+exit:
+    return error;
+}
+
+void CommissionerApp::InvalidateDatasetCache()
+{
+    mActiveDatasetCached  = false;
+    mPendingDatasetCached = false;
+}
+
 const JoinerInfo *CommissionerApp::GetJoinerInfo(JoinerType aType, const ByteArray &aJoinerId)
 {
     auto joinerInfo = mJoiners.find({aType, aJoinerId});
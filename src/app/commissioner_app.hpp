@@ -38,6 +38,7 @@
 #ifndef OT_COMM_APP_COMMISSIONER_APP_HPP_
 #define OT_COMM_APP_COMMISSIONER_APP_HPP_
 
+#include <atomic>
 #include <chrono>
 #include <fstream>
 #include <list>
@@ -48,6 +49,7 @@
 #include <commissioner/commissioner.hpp>
 #include <commissioner/network_data.hpp>
 
+#include "app/dataset_transaction.hpp"
 #include "common/address.hpp"
 
 namespace ot {
@@ -93,6 +95,8 @@ struct JoinerInfo
 
 class CommissionerApp : public CommissionerHandler
 {
+    friend class CommissionerAppTest;
+
 public:
     using MilliSeconds = std::chrono::milliseconds;
     using Seconds      = std::chrono::seconds;
@@ -124,6 +128,12 @@ public:
     void OnDatasetChanged() override;
 
     Error Start(std::string &aExistingCommissionerId, const std::string &aBorderAgentAddr, uint16_t aBorderAgentPort);
+
+    // Connects to the border agent which completes the DTLS handshake first, and petitions through it.
+    Error Start(std::string &                       aExistingCommissionerId,
+                const std::vector<BorderAgentAddr> &aBorderAgents,
+                ConnectResult &                     aConnectResult);
+
     void  Stop();
 
     void CancelRequests();
@@ -134,10 +144,15 @@ public:
 
     bool IsCcmMode() const;
 
-    // Save network data of current Thread network to file in JSON format.
+    // Save network data of current Thread network to file in JSON format,
+    // as a list of one network data which is what a snapshot exports to.
     Error SaveNetworkData(const std::string &aFilename);
 
+    // Save network data of current Thread network to file in the binary snapshot format.
+    Error SaveNetworkSnapshot(const std::string &aFilename);
+
     // Sync network data between the Thread Network and Commissioner.
+    // The MGMT requests are sent concurrently.
     Error SyncNetworkData(void);
 
     /*
@@ -170,38 +185,50 @@ public:
     /*
      * Operational Dataset APIs
      */
+    // The Active/Pending Operational Datasets are cached locally. A cached
+    // dataset is dropped when the leader reports DATASET_CHANGED.ntf, and
+    // is otherwise revalidated by fetching only its timestamp where the
+    // latest value is required. The full dataset is fetched only if the
+    // timestamp has moved.
     // TODO(wgtdkp): secure pending operational dataset update
-    Error GetActiveTimestamp(Timestamp &aTimestamp) const;
+    Error GetActiveTimestamp(Timestamp &aTimestamp);
     Error GetChannel(Channel &aChannel);
     Error SetChannel(const Channel &aChannel, MilliSeconds aDelay);
-    Error GetChannelMask(ChannelMask &aChannelMask) const;
+    Error GetChannelMask(ChannelMask &aChannelMask);
     Error SetChannelMask(const ChannelMask &aChannelMask);
-    Error GetExtendedPanId(ByteArray &aExtendedPanId) const;
+    Error GetExtendedPanId(ByteArray &aExtendedPanId);
     Error SetExtendedPanId(const ByteArray &aExtendedPanId);
     Error GetMeshLocalPrefix(std::string &aPrefix);
     Error SetMeshLocalPrefix(const std::string &aPrefix, MilliSeconds aDelay);
     Error GetNetworkMasterKey(ByteArray &aMasterKey);
     Error SetNetworkMasterKey(const ByteArray &aMasterKey, MilliSeconds aDelay);
-    Error GetNetworkName(std::string &aNetworkName) const;
+    Error GetNetworkName(std::string &aNetworkName);
     Error SetNetworkName(const std::string &aNetworkName);
     Error GetPanId(uint16_t &aPanId);
     Error SetPanId(uint16_t aPanId, MilliSeconds aDelay);
-    Error GetPSKc(ByteArray &aPSKc) const;
+    Error GetPSKc(ByteArray &aPSKc);
     Error SetPSKc(const ByteArray &aPSKc);
 
-    Error GetSecurityPolicy(SecurityPolicy &aSecurityPolicy) const;
+    Error GetSecurityPolicy(SecurityPolicy &aSecurityPolicy);
     Error SetSecurityPolicy(const SecurityPolicy &aSecurityPolicy);
 
+    // Applies all changes of @p aTransaction in one round trip. Only fields
+    // differ from the Active Operational Dataset are sent, with MGMT_PENDING_SET.req
+    // if any of them affects connectivity and MGMT_ACTIVE_SET.req otherwise.
+    // The Active Operational Dataset is fetched before only if it is not cached.
+    // Nothing is sent if there is no difference.
+    Error CommitDatasetTransaction(const DatasetTransaction &aTransaction);
+
     // Advanced Active/Pending Operational Dataset APIs exposed for setting with customized user data.
     // Not recommended unless you have good understanding of the encoding of each fields.
 
-    // Always send MGMT_ACTIVE_GET.req.
+    // Served from the cache revalidated by MGMT_ACTIVE_GET.req of the Active Timestamp.
     Error GetActiveDataset(ActiveOperationalDataset &aDataset, uint16_t aDatasetFlags);
 
     // Always send MGMT_ACTIVE_SET.req.
     Error SetActiveDataset(const ActiveOperationalDataset &aDataset);
 
-    // Always send MGMT_PENDING_GET.req.
+    // Served from the cache revalidated by MGMT_PENDING_GET.req of the Pending Timestamp.
     Error GetPendingDataset(PendingOperationalDataset &aDataset, uint16_t aDatasetFlags);
 
     // Always send MGMT_PENDING_SET.req.
@@ -277,6 +304,12 @@ private:
 
     static Error ValidatePSKd(const std::string &aPSKd);
 
+    // Makes sure the cached dataset is valid. A valid cache is revalidated
+    // against the leader's timestamp if @p aRevalidate is true.
+    Error RefreshActiveDataset(bool aRevalidate);
+    Error RefreshPendingDataset(bool aRevalidate);
+    void  InvalidateDatasetCache();
+
     const JoinerInfo *GetJoinerInfo(JoinerType aType, const ByteArray &aJoinerId);
 
     std::shared_ptr<Commissioner> mCommissioner;
@@ -294,6 +327,17 @@ private:
     PendingOperationalDataset       mPendingDataset;
     CommissionerDataset             mCommDataset;
     BbrDataset                      mBbrDataset;
+
+    // A cached Active/Pending Operational Dataset is valid only if it has
+    // been fetched after the last DATASET_CHANGED.ntf. The generation is
+    // bumped by OnDatasetChanged() in the commissioner event thread. The
+    // leader doesn't send DATASET_CHANGED.ntf to the commissioner which
+    // made the change, so a successful set invalidates the cached dataset.
+    std::atomic<uint32_t> mDatasetGeneration{0};
+    bool                  mActiveDatasetCached      = false;
+    uint32_t              mActiveDatasetGeneration  = 0;
+    bool                  mPendingDatasetCached     = false;
+    uint32_t              mPendingDatasetGeneration = 0;
 };
 
 } // namespace commissioner
@@ -35,12 +35,191 @@
 #include <catch2/catch.hpp>
 
 #include "app/commissioner_app.hpp"
+#include "common/error_macros.hpp"
 #include "common/utils.hpp"
 
 namespace ot {
 
 namespace commissioner {
 
+class CommissionerAppTest
+{
+public:
+    static void SetCommissioner(CommissionerApp &aCommApp, std::shared_ptr<Commissioner> aCommissioner)
+    {
+        aCommApp.mCommissioner = aCommissioner;
+    }
+
+    template <typename Dataset> static void MergeDataset(Dataset &aDst, const Dataset &aSrc)
+    {
+        CommissionerApp::MergeDataset(aDst, aSrc);
+    }
+};
+
+// A commissioner which talks to a fake leader. Only the synchronous
+// Active/Pending Operational Dataset requests are implemented.
+class FakeLeaderCommissioner : public Commissioner
+{
+public:
+    FakeLeaderCommissioner()
+    {
+        mActiveDataset.mActiveTimestamp = {1, 0, 0};
+        mActiveDataset.mPresentFlags |= ActiveOperationalDataset::kActiveTimestampBit;
+
+        mActiveDataset.mNetworkName = "OpenThread";
+        mActiveDataset.mPresentFlags |= ActiveOperationalDataset::kNetworkNameBit;
+
+        mActiveDataset.mPanId = 0xFACE;
+        mActiveDataset.mPresentFlags |= ActiveOperationalDataset::kPanIdBit;
+
+        mPendingDataset.mPendingTimestamp = {1, 0, 0};
+        mPendingDataset.mPresentFlags |= PendingOperationalDataset::kPendingTimestampBit;
+    }
+
+    Error GetActiveDataset(ActiveOperationalDataset &aDataset, uint16_t aDatasetFlags) override
+    {
+        ++mActiveGetCount;
+        aDataset = mActiveDataset;
+        aDataset.mPresentFlags &= aDatasetFlags;
+        return ERROR_NONE;
+    }
+
+    Error SetActiveDataset(const ActiveOperationalDataset &aActiveDataset) override
+    {
+        ++mActiveSetCount;
+        CommissionerAppTest::MergeDataset(mActiveDataset, aActiveDataset);
+        mActiveDataset.mActiveTimestamp.mSeconds++;
+        return ERROR_NONE;
+    }
+
+    Error GetPendingDataset(PendingOperationalDataset &aDataset, uint16_t aDatasetFlags) override
+    {
+        ++mPendingGetCount;
+        aDataset = mPendingDataset;
+        aDataset.mPresentFlags &= aDatasetFlags;
+        return ERROR_NONE;
+    }
+
+    Error SetPendingDataset(const PendingOperationalDataset &aPendingDataset) override
+    {
+        ++mPendingSetCount;
+        CommissionerAppTest::MergeDataset(mPendingDataset, aPendingDataset);
+        mPendingDataset.mPendingTimestamp.mSeconds++;
+        return ERROR_NONE;
+    }
+
+    bool IsActive() const override { return true; }
+
+    bool IsCcmMode() const override { return false; }
+
+    Error Init(const Config &) override { return ERROR_NONE; }
+
+    const Config &GetConfig() const override { return mConfig; }
+
+    void  Connect(ErrorHandler, const std::string &, uint16_t) override {}
+    Error Connect(const std::string &, uint16_t) override { return ERROR_UNIMPLEMENTED(""); }
+    void  Connect(Handler<ConnectResult>, const std::vector<BorderAgentAddr> &) override {}
+    Error Connect(ConnectResult &, const std::vector<BorderAgentAddr> &) override { return ERROR_UNIMPLEMENTED(""); }
+
+    void Disconnect() override {}
+
+    uint16_t GetSessionId() const override { return 0; }
+
+    State GetState() const override { return State::kActive; }
+
+    const std::string &GetDomainName() const override { return mDomainName; }
+
+    void CancelRequests() override {}
+
+    void  Petition(PetitionHandler, const std::string &, uint16_t) override {}
+    Error Petition(std::string &, const std::string &, uint16_t) override { return ERROR_UNIMPLEMENTED(""); }
+
+    void  Resign(ErrorHandler) override {}
+    Error Resign() override { return ERROR_UNIMPLEMENTED(""); }
+
+    void  GetCommissionerDataset(Handler<CommissionerDataset>, uint16_t) override {}
+    Error GetCommissionerDataset(CommissionerDataset &, uint16_t) override { return ERROR_UNIMPLEMENTED(""); }
+
+    void  SetCommissionerDataset(ErrorHandler, const CommissionerDataset &) override {}
+    Error SetCommissionerDataset(const CommissionerDataset &) override { return ERROR_UNIMPLEMENTED(""); }
+
+    void  SetBbrDataset(ErrorHandler, const BbrDataset &) override {}
+    Error SetBbrDataset(const BbrDataset &) override { return ERROR_UNIMPLEMENTED(""); }
+
+    void  GetBbrDataset(Handler<BbrDataset>, uint16_t) override {}
+    Error GetBbrDataset(BbrDataset &, uint16_t) override { return ERROR_UNIMPLEMENTED(""); }
+
+    void GetActiveDataset(Handler<ActiveOperationalDataset>, uint16_t) override {}
+
+    void  GetRawActiveDataset(Handler<ByteArray>, uint16_t) override {}
+    Error GetRawActiveDataset(ByteArray &, uint16_t) override { return ERROR_UNIMPLEMENTED(""); }
+
+    void SetActiveDataset(ErrorHandler, const ActiveOperationalDataset &) override {}
+
+    void GetPendingDataset(Handler<PendingOperationalDataset>, uint16_t) override {}
+
+    void SetPendingDataset(ErrorHandler, const PendingOperationalDataset &) override {}
+
+    void  SetSecurePendingDataset(ErrorHandler,
+                                  const std::string &,
+                                  uint32_t,
+                                  const PendingOperationalDataset &) override
+    {
+    }
+    Error SetSecurePendingDataset(const std::string &, uint32_t, const PendingOperationalDataset &) override
+    {
+        return ERROR_UNIMPLEMENTED("");
+    }
+
+    void  CommandReenroll(ErrorHandler, const std::string &) override {}
+    Error CommandReenroll(const std::string &) override { return ERROR_UNIMPLEMENTED(""); }
+
+    void  CommandDomainReset(ErrorHandler, const std::string &) override {}
+    Error CommandDomainReset(const std::string &) override { return ERROR_UNIMPLEMENTED(""); }
+
+    void  CommandMigrate(ErrorHandler, const std::string &, const std::string &) override {}
+    Error CommandMigrate(const std::string &, const std::string &) override { return ERROR_UNIMPLEMENTED(""); }
+
+    void  AnnounceBegin(ErrorHandler, uint32_t, uint8_t, uint16_t, const std::string &) override {}
+    Error AnnounceBegin(uint32_t, uint8_t, uint16_t, const std::string &) override { return ERROR_UNIMPLEMENTED(""); }
+
+    void  PanIdQuery(ErrorHandler, uint32_t, uint16_t, const std::string &) override {}
+    Error PanIdQuery(uint32_t, uint16_t, const std::string &) override { return ERROR_UNIMPLEMENTED(""); }
+
+    void  EnergyScan(ErrorHandler, uint32_t, uint8_t, uint16_t, uint16_t, const std::string &) override {}
+    Error EnergyScan(uint32_t, uint8_t, uint16_t, uint16_t, const std::string &) override
+    {
+        return ERROR_UNIMPLEMENTED("");
+    }
+
+    void  RegisterMulticastListener(Handler<uint8_t>,
+                                    const std::string &,
+                                    const std::vector<std::string> &,
+                                    uint32_t) override
+    {
+    }
+    Error RegisterMulticastListener(uint8_t &, const std::string &, const std::vector<std::string> &, uint32_t) override
+    {
+        return ERROR_UNIMPLEMENTED("");
+    }
+
+    void  RequestToken(Handler<ByteArray>, const std::string &, uint16_t) override {}
+    Error RequestToken(ByteArray &, const std::string &, uint16_t) override { return ERROR_UNIMPLEMENTED(""); }
+
+    Error SetToken(const ByteArray &, const ByteArray &) override { return ERROR_UNIMPLEMENTED(""); }
+
+    ActiveOperationalDataset  mActiveDataset;
+    PendingOperationalDataset mPendingDataset;
+    size_t                    mActiveGetCount  = 0;
+    size_t                    mActiveSetCount  = 0;
+    size_t                    mPendingGetCount = 0;
+    size_t                    mPendingSetCount = 0;
+
+private:
+    Config      mConfig;
+    std::string mDomainName;
+};
+
 TEST_CASE("pskd-validation", "[pskd]")
 {
     Config config;
@@ -90,6 +269,133 @@ TEST_CASE("pskd-validation", "[pskd]")
     }
 }
 
+TEST_CASE("commissioner-app-dataset-cache", "[dataset-cache]")
+{
+    Config config;
+    config.mEnableCcm = false;
+    config.mPSKc = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+
+    std::shared_ptr<CommissionerApp> commApp;
+    REQUIRE(CommissionerApp::Create(commApp, config) == ErrorCode::kNone);
+
+    auto leader = std::make_shared<FakeLeaderCommissioner>();
+    CommissionerAppTest::SetCommissioner(*commApp, leader);
+
+    std::string networkName;
+    Timestamp   activeTimestamp;
+
+    REQUIRE(commApp->GetNetworkName(networkName) == ErrorCode::kNone);
+    REQUIRE(networkName == "OpenThread");
+    REQUIRE(leader->mActiveGetCount == 1);
+
+    SECTION("a cached dataset is read without requests")
+    {
+        REQUIRE(commApp->GetNetworkName(networkName) == ErrorCode::kNone);
+        REQUIRE(leader->mActiveGetCount == 1);
+    }
+
+    SECTION("a set dataset is read back from the leader")
+    {
+        REQUIRE(commApp->SetNetworkName("OpenThread-1") == ErrorCode::kNone);
+        REQUIRE(leader->mActiveSetCount == 1);
+
+        // The leader has moved the Active Timestamp, which is not in the set request.
+        REQUIRE(commApp->GetActiveTimestamp(activeTimestamp) == ErrorCode::kNone);
+        REQUIRE(activeTimestamp.Encode() == leader->mActiveDataset.mActiveTimestamp.Encode());
+        REQUIRE(leader->mActiveGetCount == 2);
+
+        REQUIRE(commApp->GetNetworkName(networkName) == ErrorCode::kNone);
+        REQUIRE(networkName == "OpenThread-1");
+        REQUIRE(leader->mActiveGetCount == 2);
+    }
+
+    SECTION("a set pending dataset is read back from the leader")
+    {
+        PendingOperationalDataset pendingDataset;
+
+        REQUIRE(commApp->GetPendingDataset(pendingDataset, 0) == ErrorCode::kNone);
+        REQUIRE(commApp->SetPanId(0xBEEF, CommissionerApp::MilliSeconds(30000)) == ErrorCode::kNone);
+        REQUIRE(leader->mPendingSetCount == 1);
+
+        REQUIRE(commApp->GetPendingDataset(pendingDataset, 0) == ErrorCode::kNone);
+        REQUIRE(pendingDataset.mPanId == 0xBEEF);
+        REQUIRE(pendingDataset.mPendingTimestamp.Encode() == leader->mPendingDataset.mPendingTimestamp.Encode());
+    }
+
+    SECTION("a dataset changed by a peer is read from the leader")
+    {
+        leader->mActiveDataset.mNetworkName = "OpenThread-2";
+        leader->mActiveDataset.mActiveTimestamp.mSeconds++;
+        commApp->OnDatasetChanged();
+
+        REQUIRE(commApp->GetNetworkName(networkName) == ErrorCode::kNone);
+        REQUIRE(networkName == "OpenThread-2");
+        REQUIRE(leader->mActiveGetCount == 2);
+    }
+}
+
+TEST_CASE("commissioner-app-commit-dataset-transaction", "[dataset-cache]")
+{
+    Config config;
+    config.mEnableCcm = false;
+    config.mPSKc = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+
+    std::shared_ptr<CommissionerApp> commApp;
+    REQUIRE(CommissionerApp::Create(commApp, config) == ErrorCode::kNone);
+
+    auto leader = std::make_shared<FakeLeaderCommissioner>();
+    CommissionerAppTest::SetCommissioner(*commApp, leader);
+
+    std::string        networkName;
+    DatasetTransaction transaction;
+
+    // Warms up the cache.
+    REQUIRE(commApp->GetNetworkName(networkName) == ErrorCode::kNone);
+    REQUIRE(leader->mActiveGetCount == 1);
+
+    SECTION("a commit sends a single MGMT_ACTIVE_SET.req")
+    {
+        transaction.SetNetworkName("OpenThread-1");
+
+        REQUIRE(commApp->CommitDatasetTransaction(transaction) == ErrorCode::kNone);
+        REQUIRE(leader->mActiveGetCount == 1);
+        REQUIRE(leader->mActiveSetCount == 1);
+        REQUIRE(leader->mPendingSetCount == 0);
+        REQUIRE(leader->mActiveDataset.mNetworkName == "OpenThread-1");
+    }
+
+    SECTION("a commit sends a single MGMT_PENDING_SET.req")
+    {
+        transaction.SetPanId(0xBEEF);
+
+        REQUIRE(commApp->CommitDatasetTransaction(transaction) == ErrorCode::kNone);
+        REQUIRE(leader->mActiveGetCount == 1);
+        REQUIRE(leader->mActiveSetCount == 0);
+        REQUIRE(leader->mPendingSetCount == 1);
+        REQUIRE(leader->mPendingDataset.mPanId == 0xBEEF);
+    }
+
+    SECTION("a commit with no difference sends nothing")
+    {
+        transaction.SetNetworkName("OpenThread");
+
+        REQUIRE(commApp->CommitDatasetTransaction(transaction) == ErrorCode::kNone);
+        REQUIRE(leader->mActiveGetCount == 1);
+        REQUIRE(leader->mActiveSetCount == 0);
+        REQUIRE(leader->mPendingSetCount == 0);
+    }
+
+    SECTION("a commit after a set diffs against the dataset read back")
+    {
+        REQUIRE(commApp->SetNetworkName("OpenThread-1") == ErrorCode::kNone);
+        transaction.SetNetworkName("OpenThread-1");
+
+        REQUIRE(commApp->CommitDatasetTransaction(transaction) == ErrorCode::kNone);
+        REQUIRE(leader->mActiveGetCount == 2);
+        REQUIRE(leader->mActiveSetCount == 1);
+    }
+}
+
 } // namespace commissioner
 
 } // namespace ot
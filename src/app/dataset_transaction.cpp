@@ -0,0 +1,173 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements Operational Dataset transactions.
+ */
+
+#include "app/dataset_transaction.hpp"
+
+#include <algorithm>
+
+#include "common/error_macros.hpp"
+#include "common/utils.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+template <typename T> static bool IsEqual(const T &aLhs, const T &aRhs)
+{
+    return aLhs == aRhs;
+}
+
+static bool IsEqual(const Channel &aLhs, const Channel &aRhs)
+{
+    return aLhs.mPage == aRhs.mPage && aLhs.mNumber == aRhs.mNumber;
+}
+
+static bool IsEqual(const ChannelMask &aLhs, const ChannelMask &aRhs)
+{
+    auto isEqualEntry = [](const ChannelMaskEntry &aEntry, const ChannelMaskEntry &aOther) {
+        return aEntry.mPage == aOther.mPage && aEntry.mMasks == aOther.mMasks;
+    };
+
+    return aLhs.size() == aRhs.size() && std::equal(aLhs.begin(), aLhs.end(), aRhs.begin(), isEqualEntry);
+}
+
+static bool IsEqual(const SecurityPolicy &aLhs, const SecurityPolicy &aRhs)
+{
+    return aLhs.mRotationTime == aRhs.mRotationTime && aLhs.mFlags == aRhs.mFlags;
+}
+
+void DatasetTransaction::SetChannel(const Channel &aChannel)
+{
+    mChanges.mChannel = aChannel;
+    mChanges.mPresentFlags |= ActiveOperationalDataset::kChannelBit;
+}
+
+void DatasetTransaction::SetChannelMask(const ChannelMask &aChannelMask)
+{
+    mChanges.mChannelMask = aChannelMask;
+    mChanges.mPresentFlags |= ActiveOperationalDataset::kChannelMaskBit;
+}
+
+void DatasetTransaction::SetExtendedPanId(const ByteArray &aExtendedPanId)
+{
+    mChanges.mExtendedPanId = aExtendedPanId;
+    mChanges.mPresentFlags |= ActiveOperationalDataset::kExtendedPanIdBit;
+}
+
+Error DatasetTransaction::SetMeshLocalPrefix(const std::string &aPrefix)
+{
+    Error error;
+
+    SuccessOrExit(error = Ipv6PrefixFromString(mChanges.mMeshLocalPrefix, aPrefix));
+    mChanges.mPresentFlags |= ActiveOperationalDataset::kMeshLocalPrefixBit;
+
+exit:
+    return error;
+}
+
+void DatasetTransaction::SetNetworkMasterKey(const ByteArray &aMasterKey)
+{
+    mChanges.mNetworkMasterKey = aMasterKey;
+    mChanges.mPresentFlags |= ActiveOperationalDataset::kNetworkMasterKeyBit;
+}
+
+void DatasetTransaction::SetNetworkName(const std::string &aNetworkName)
+{
+    mChanges.mNetworkName = aNetworkName;
+    mChanges.mPresentFlags |= ActiveOperationalDataset::kNetworkNameBit;
+}
+
+void DatasetTransaction::SetPanId(uint16_t aPanId)
+{
+    mChanges.mPanId = aPanId;
+    mChanges.mPresentFlags |= ActiveOperationalDataset::kPanIdBit;
+}
+
+void DatasetTransaction::SetPSKc(const ByteArray &aPSKc)
+{
+    mChanges.mPSKc = aPSKc;
+    mChanges.mPresentFlags |= ActiveOperationalDataset::kPSKcBit;
+}
+
+void DatasetTransaction::SetSecurityPolicy(const SecurityPolicy &aSecurityPolicy)
+{
+    mChanges.mSecurityPolicy = aSecurityPolicy;
+    mChanges.mPresentFlags |= ActiveOperationalDataset::kSecurityPolicyBit;
+}
+
+ActiveOperationalDataset DatasetTransaction::Diff(const ActiveOperationalDataset &aActiveDataset) const
+{
+    ActiveOperationalDataset diff = mChanges;
+
+#define CLEAR_IF_EQUAL(name)                                                       \
+    if ((diff.mPresentFlags & ActiveOperationalDataset::k##name##Bit) &&           \
+        (aActiveDataset.mPresentFlags & ActiveOperationalDataset::k##name##Bit) && \
+        IsEqual(diff.m##name, aActiveDataset.m##name))                             \
+    {                                                                              \
+        diff.mPresentFlags &= ~ActiveOperationalDataset::k##name##Bit;             \
+    }
+
+    CLEAR_IF_EQUAL(Channel);
+    CLEAR_IF_EQUAL(ChannelMask);
+    CLEAR_IF_EQUAL(ExtendedPanId);
+    CLEAR_IF_EQUAL(MeshLocalPrefix);
+    CLEAR_IF_EQUAL(NetworkMasterKey);
+    CLEAR_IF_EQUAL(NetworkName);
+    CLEAR_IF_EQUAL(PanId);
+    CLEAR_IF_EQUAL(PSKc);
+    CLEAR_IF_EQUAL(SecurityPolicy);
+
+#undef CLEAR_IF_EQUAL
+
+    return diff;
+}
+
+bool DatasetTransaction::RequiresPendingDataset(uint16_t aDatasetFlags)
+{
+    // Those are rejected by MGMT_ACTIVE_SET.req, see CommissionerImpl::SetActiveDataset().
+    return aDatasetFlags & (ActiveOperationalDataset::kChannelBit | ActiveOperationalDataset::kPanIdBit |
+                            ActiveOperationalDataset::kMeshLocalPrefixBit |
+                            ActiveOperationalDataset::kNetworkMasterKeyBit);
+}
+
+ActiveOperationalDataset DatasetTransaction::MakeEmptyDataset()
+{
+    ActiveOperationalDataset dataset;
+
+    dataset.mPresentFlags = 0;
+    return dataset;
+}
+
+} // namespace commissioner
+
+} // namespace ot
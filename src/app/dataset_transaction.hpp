@@ -0,0 +1,89 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions of Operational Dataset transactions.
+ */
+
+#ifndef OT_COMM_APP_DATASET_TRANSACTION_HPP_
+#define OT_COMM_APP_DATASET_TRANSACTION_HPP_
+
+#include <chrono>
+
+#include <commissioner/error.hpp>
+#include <commissioner/network_data.hpp>
+
+namespace ot {
+
+namespace commissioner {
+
+// Collects changes of Active Operational Dataset fields which are applied
+// with a single MGMT_ACTIVE_SET.req or MGMT_PENDING_SET.req, including
+// only the fields that differ from the current Active Operational Dataset.
+class DatasetTransaction
+{
+public:
+    using MilliSeconds = std::chrono::milliseconds;
+
+    void  SetChannel(const Channel &aChannel);
+    void  SetChannelMask(const ChannelMask &aChannelMask);
+    void  SetExtendedPanId(const ByteArray &aExtendedPanId);
+    Error SetMeshLocalPrefix(const std::string &aPrefix);
+    void  SetNetworkMasterKey(const ByteArray &aMasterKey);
+    void  SetNetworkName(const std::string &aNetworkName);
+    void  SetPanId(uint16_t aPanId);
+    void  SetPSKc(const ByteArray &aPSKc);
+    void  SetSecurityPolicy(const SecurityPolicy &aSecurityPolicy);
+
+    // The delay before changes sent with the Pending Operational Dataset take effect.
+    void         SetDelay(MilliSeconds aDelay) { mDelay = aDelay; }
+    MilliSeconds GetDelay() const { return mDelay; }
+
+    bool IsEmpty() const { return mChanges.mPresentFlags == 0; }
+
+    // Returns a dataset including only the changed fields which differ
+    // from @p aActiveDataset. The Active Timestamp is never included.
+    ActiveOperationalDataset Diff(const ActiveOperationalDataset &aActiveDataset) const;
+
+    // Returns true if any of @p aDatasetFlags affects connectivity and
+    // must be changed with the Pending Operational Dataset.
+    static bool RequiresPendingDataset(uint16_t aDatasetFlags);
+
+private:
+    ActiveOperationalDataset mChanges = MakeEmptyDataset();
+    MilliSeconds             mDelay{0};
+
+    static ActiveOperationalDataset MakeEmptyDataset();
+};
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_APP_DATASET_TRANSACTION_HPP_
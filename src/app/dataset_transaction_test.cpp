@@ -0,0 +1,105 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases for Operational Dataset transactions.
+ */
+
+#include "app/dataset_transaction.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace ot {
+
+namespace commissioner {
+
+TEST_CASE("dataset-transaction-diff", "[dataset-transaction]")
+{
+    ActiveOperationalDataset activeDataset;
+    DatasetTransaction       transaction;
+
+    activeDataset.mChannel        = {0, 11};
+    activeDataset.mNetworkName    = "OpenThread";
+    activeDataset.mPanId          = 0xFACE;
+    activeDataset.mSecurityPolicy = {672, {0xF7, 0xF8}};
+    activeDataset.mChannelMask    = {{0, {0x07, 0xFF, 0xF8, 0x00}}};
+    activeDataset.mPresentFlags |= ActiveOperationalDataset::kChannelBit | ActiveOperationalDataset::kNetworkNameBit |
+                                   ActiveOperationalDataset::kPanIdBit | ActiveOperationalDataset::kSecurityPolicyBit |
+                                   ActiveOperationalDataset::kChannelMaskBit;
+
+    REQUIRE(transaction.IsEmpty());
+
+    SECTION("unchanged fields are dropped")
+    {
+        transaction.SetChannel({0, 11});
+        transaction.SetNetworkName("OpenThread");
+        transaction.SetSecurityPolicy({672, {0xF7, 0xF8}});
+        transaction.SetChannelMask({{0, {0x07, 0xFF, 0xF8, 0x00}}});
+
+        REQUIRE_FALSE(transaction.IsEmpty());
+        REQUIRE(transaction.Diff(activeDataset).mPresentFlags == 0);
+    }
+
+    SECTION("active dataset changes")
+    {
+        transaction.SetNetworkName("OpenThread-1");
+        transaction.SetSecurityPolicy({672, {0xF7, 0xF0}});
+        transaction.SetPanId(0xFACE);
+
+        auto diff = transaction.Diff(activeDataset);
+        REQUIRE(diff.mPresentFlags ==
+                (ActiveOperationalDataset::kNetworkNameBit | ActiveOperationalDataset::kSecurityPolicyBit));
+        REQUIRE(diff.mNetworkName == "OpenThread-1");
+        REQUIRE_FALSE(DatasetTransaction::RequiresPendingDataset(diff.mPresentFlags));
+    }
+
+    SECTION("pending dataset changes")
+    {
+        transaction.SetChannel({0, 15});
+        transaction.SetNetworkName("OpenThread-1");
+        REQUIRE(transaction.SetMeshLocalPrefix("fd00:db8::/64") == ErrorCode::kNone);
+
+        auto diff = transaction.Diff(activeDataset);
+        REQUIRE(diff.mPresentFlags == (ActiveOperationalDataset::kChannelBit |
+                                       ActiveOperationalDataset::kNetworkNameBit |
+                                       ActiveOperationalDataset::kMeshLocalPrefixBit));
+        REQUIRE(diff.mChannel.mNumber == 15);
+        REQUIRE(DatasetTransaction::RequiresPendingDataset(diff.mPresentFlags));
+    }
+
+    SECTION("invalid mesh-local prefix")
+    {
+        REQUIRE(transaction.SetMeshLocalPrefix("fd00:db8::") != ErrorCode::kNone);
+        REQUIRE(transaction.IsEmpty());
+    }
+}
+
+} // namespace commissioner
+
+} // namespace ot
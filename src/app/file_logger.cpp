@@ -34,21 +34,221 @@
 
 #include "app/file_logger.hpp"
 
-#include <sstream>
+#include <algorithm>
 
+#include <errno.h>
+#include <signal.h>
 #include <string.h>
+#include <unistd.h>
 
+#include "app/binary_log.hpp"
 #include "common/error_macros.hpp"
 #include "common/time.hpp"
 #include "common/utils.hpp"
+#include "library/logging.hpp"
 
 namespace ot {
 
 namespace commissioner {
 
-static std::string ToString(LogLevel aLevel)
+// The writer thread drains the rings at least once per interval.
+static constexpr std::chrono::milliseconds kWriterIdleInterval{100};
+
+// The interval a blocked producer re-checks its ring.
+static constexpr std::chrono::milliseconds kBlockInterval{10};
+
+// The interval of clock frames which anchor monotonic timestamps of binary log records.
+static constexpr std::chrono::seconds kClockFrameInterval{60};
+
+static constexpr size_t kMinBufferSize   = 1024;
+static constexpr size_t kMaxRegionLength = 64;
+static constexpr size_t kMaxPrefixLength = 128;
+
+static_assert(kMaxPrefixLength >= kMaxBinaryLogFrameHeaderLength, "buffer is too small for binary log frame headers");
+static_assert(kMaxRegionLength <= kMaxBinaryLogRegionLength, "region is too long for binary log frames");
+
+static const char kDroppedRegion[] = "file-logger";
+
+static std::atomic<uint64_t>     sNextLoggerId{0};
+static std::atomic<FileLogger *> sCrashLogger{nullptr};
+
+struct FileLogger::Record
 {
-    std::string ret;
+    LogLevel    mLevel;
+    time_t      mTime;
+    const char *mRegion;
+    size_t      mRegionLength;
+    const char *mMessage;
+    size_t      mMessageLength;
+    bool        mIsBinary;
+};
+
+/**
+ * A single-producer single-consumer ring buffer of log records.
+ *
+ * A record is a fixed-size header followed by the region and the message,
+ * aligned to the header size. A record never wraps around the end of the
+ * buffer, the producer fills the tail with a padding record instead.
+ *
+ */
+class FileLogger::Ring
+{
+public:
+    explicit Ring(size_t aCapacity)
+        : mCapacity(RoundUpToPowerOfTwo(std::max(aCapacity, kMinBufferSize)))
+        , mBuffer(new uint8_t[mCapacity])
+    {
+    }
+
+    /**
+     * This method pushes a record, it must be called by only the producer thread.
+     *
+     * The message is truncated to GetMaxMessageLength().
+     *
+     * @retval true   The record is pushed.
+     * @retval false  There is no room for the record.
+     */
+    bool Push(LogLevel           aLevel,
+              time_t             aTime,
+              const std::string &aRegion,
+              const void *       aMessage,
+              size_t             aMessageLength,
+              bool               aIsBinary)
+    {
+        size_t regionLength  = std::min(aRegion.size(), kMaxRegionLength);
+        size_t messageLength = std::min(aMessageLength, GetMaxMessageLength());
+        size_t size          = Align(sizeof(Header) + regionLength + messageLength);
+        size_t tail          = mTail.load(std::memory_order_relaxed);
+        size_t head          = mHead.load(std::memory_order_acquire);
+        size_t offset        = tail & (mCapacity - 1);
+        size_t contiguous    = mCapacity - offset;
+        Header header;
+
+        if (mCapacity - (tail - head) < (contiguous < size ? contiguous + size : size))
+        {
+            return false;
+        }
+
+        if (contiguous < size)
+        {
+            memset(&header, 0, sizeof(header));
+            header.mType = kPaddingRecord;
+            memcpy(&mBuffer[offset], &header, sizeof(header));
+            tail += contiguous;
+            offset = 0;
+        }
+
+        header.mMessageLength = static_cast<uint32_t>(messageLength);
+        header.mRegionLength  = static_cast<uint16_t>(regionLength);
+        header.mLevel         = static_cast<uint8_t>(aLevel);
+        header.mType          = aIsBinary ? kBinaryRecord : kTextRecord;
+        header.mTime          = static_cast<int64_t>(aTime);
+        memcpy(&mBuffer[offset], &header, sizeof(header));
+        memcpy(&mBuffer[offset + sizeof(header)], aRegion.data(), regionLength);
+        memcpy(&mBuffer[offset + sizeof(header) + regionLength], aMessage, messageLength);
+
+        mTail.store(tail + size, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * This method returns the oldest record without removing it,
+     * it must be called by only the consumer.
+     *
+     * @retval true   The oldest record is returned in @p aRecord.
+     * @retval false  The ring is empty.
+     */
+    bool Peek(FileLogger::Record &aRecord)
+    {
+        size_t head = mHead.load(std::memory_order_relaxed);
+        size_t tail = mTail.load(std::memory_order_acquire);
+        Header header;
+
+        while (head != tail)
+        {
+            size_t offset = head & (mCapacity - 1);
+
+            memcpy(&header, &mBuffer[offset], sizeof(header));
+            if (header.mType != kPaddingRecord)
+            {
+                aRecord.mLevel         = static_cast<LogLevel>(header.mLevel);
+                aRecord.mTime          = static_cast<time_t>(header.mTime);
+                aRecord.mRegion        = reinterpret_cast<const char *>(&mBuffer[offset + sizeof(header)]);
+                aRecord.mRegionLength  = header.mRegionLength;
+                aRecord.mMessage       = aRecord.mRegion + header.mRegionLength;
+                aRecord.mMessageLength = header.mMessageLength;
+                aRecord.mIsBinary      = header.mType == kBinaryRecord;
+
+                mPeekedSize = Align(sizeof(header) + header.mRegionLength + header.mMessageLength);
+                return true;
+            }
+
+            head += mCapacity - offset;
+            mHead.store(head, std::memory_order_release);
+        }
+
+        return false;
+    }
+
+    /**
+     * This method removes the record returned by last Peek(), it must be called by only the consumer.
+     */
+    void Pop() { mHead.store(mHead.load(std::memory_order_relaxed) + mPeekedSize, std::memory_order_release); }
+
+    size_t GetMaxMessageLength() const { return mCapacity / 2 - sizeof(Header) - kMaxRegionLength; }
+
+    void Close() { mClosed.store(true, std::memory_order_relaxed); }
+    bool IsClosed() const { return mClosed.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t kCacheLineSize = 64;
+
+    enum : uint8_t
+    {
+        kPaddingRecord = 0,
+        kTextRecord,
+        kBinaryRecord,
+    };
+
+    struct Header
+    {
+        uint32_t mMessageLength;
+        uint16_t mRegionLength;
+        uint8_t  mLevel;
+        uint8_t  mType;
+        int64_t  mTime;
+    };
+
+    static size_t Align(size_t aSize) { return (aSize + sizeof(Header) - 1) / sizeof(Header) * sizeof(Header); }
+
+    static size_t RoundUpToPowerOfTwo(size_t aValue)
+    {
+        size_t ret = 1;
+
+        while (ret < aValue)
+        {
+            ret <<= 1;
+        }
+        return ret;
+    }
+
+    const size_t               mCapacity;
+    std::unique_ptr<uint8_t[]> mBuffer;
+    std::atomic<bool>          mClosed{false};
+
+    // Accessed by only the consumer.
+    size_t mPeekedSize = 0;
+
+    // Pads the positions to separate cache lines, so that the
+    // producer does not bounce the line read by the consumer.
+    std::atomic<size_t> mHead{0};
+    char                mPadding[kCacheLineSize - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> mTail{0};
+};
+
+static const char *ToString(LogLevel aLevel)
+{
+    const char *ret = "";
 
     switch (aLevel)
     {
@@ -78,12 +278,105 @@ static std::string ToString(LogLevel aLevel)
     return ret;
 }
 
+// Formats the time in the same way as TimePointToString() without allocating memory.
+static void FormatTime(char *aBuf, size_t aSize, time_t aTime)
+{
+    struct tm localTime;
+
+    localtime_r(&aTime, &localTime);
+    if (strftime(aBuf, aSize, "%Y-%m-%d %H:%M:%S", &localTime) == 0)
+    {
+        aBuf[0] = '\0';
+    }
+}
+
+static size_t FormatPrefix(char *      aBuf,
+                           size_t      aSize,
+                           const char *aTime,
+                           LogLevel    aLevel,
+                           const char *aRegion,
+                           size_t      aRegionLength)
+{
+    int length = snprintf(aBuf, aSize, "[ %s ] [ %s ] [ %.*s ] ", aTime, ToString(aLevel),
+                          static_cast<int>(aRegionLength), aRegion);
+
+    return length < 0 ? 0 : std::min(static_cast<size_t>(length), aSize - 1);
+}
+
+static int64_t GetMonotonicClock()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+static int64_t GetWallClock()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+static void WriteAll(int aFd, const char *aBuf, size_t aLength)
+{
+    while (aLength > 0)
+    {
+        ssize_t rval = write(aFd, aBuf, aLength);
+
+        if (rval < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (rval <= 0)
+        {
+            break;
+        }
+        aBuf += rval;
+        aLength -= static_cast<size_t>(rval);
+    }
+}
+
+// Appends the output of the writer thread to a batch.
+class BatchOutput
+{
+public:
+    explicit BatchOutput(std::string &aBatch)
+        : mBatch(aBatch)
+    {
+    }
+
+    void Write(const char *aData, size_t aLength) { mBatch.append(aData, aLength); }
+
+private:
+    std::string &mBatch;
+};
+
+// Writes a file descriptor directly without allocating memory, used by the crash handler.
+class FdOutput
+{
+public:
+    explicit FdOutput(int aFd)
+        : mFd(aFd)
+    {
+    }
+
+    void Write(const char *aData, size_t aLength) { WriteAll(mFd, aData, aLength); }
+
+private:
+    int mFd;
+};
+
 Error FileLogger::Create(std::shared_ptr<FileLogger> &aFileLogger, const std::string &aFilename, LogLevel aLogLevel)
+{
+    return Create(aFileLogger, aFilename, aLogLevel, Options());
+}
+
+Error FileLogger::Create(std::shared_ptr<FileLogger> &aFileLogger,
+                         const std::string &          aFilename,
+                         LogLevel                     aLogLevel,
+                         const Options &              aOptions)
 {
     Error error;
     auto  logger = std::shared_ptr<FileLogger>(new FileLogger);
 
-    SuccessOrExit(error = logger->Init(aFilename, aLogLevel));
+    SuccessOrExit(error = logger->Init(aFilename, aLogLevel, aOptions));
     aFileLogger = logger;
 
 exit:
@@ -92,48 +385,477 @@ exit:
 
 FileLogger::~FileLogger()
 {
+    FileLogger *self = this;
+
+    sCrashLogger.compare_exchange_strong(self, nullptr);
+
+    if (mWriter.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mWriterMutex);
+            mStopped.store(true);
+        }
+        mWriterCond.notify_one();
+        mWriter.join();
+    }
+
+    for (auto &ring : mRings)
+    {
+        ring->Close();
+    }
+
     if (mLogFile)
     {
         fclose(mLogFile);
     }
 }
 
-Error FileLogger::Init(const std::string &aFilename, LogLevel aLogLevel)
+Error FileLogger::Init(const std::string &aFilename, LogLevel aLogLevel, const Options &aOptions)
+{
+    Error error;
+
+    mFilename = aFilename;
+    mLogLevel = aLogLevel;
+    mOptions  = aOptions;
+
+    if (mOptions.mFormat == Format::kBinary)
+    {
+        mWrittenFormats.assign(kMaxLogFormatNum, false);
+    }
+
+    SuccessOrExit(error = OpenFile());
+
+    if (mOptions.mMaxSegmentSize > 0 || mOptions.mSegmentInterval.count() > 0)
+    {
+        mArchiver.reset(new LogArchiver(mFilename, mOptions.mRetainedSegmentNum, mOptions.mCompress));
+    }
+
+    mId     = ++sNextLoggerId;
+    mWriter = std::thread(&FileLogger::Run, this);
+
+    sCrashLogger.store(this);
+
+exit:
+    return error;
+}
+
+Error FileLogger::OpenFile()
 {
     Error error;
-    FILE *logFile;
+    long  fileSize;
 
-    logFile = fopen(aFilename.c_str(), "w");
-    if (logFile == nullptr)
+    // Appends to the file, so that restarting does not lose the previous log.
+    mLogFile = fopen(mFilename.c_str(), "a");
+    if (mLogFile == nullptr)
     {
         if (errno == ENOENT)
         {
-            ExitNow(error = ERROR_NOT_FOUND("failed to init file logger '{}', {}", aFilename, strerror(errno)));
+            ExitNow(error = ERROR_NOT_FOUND("failed to init file logger '{}', {}", mFilename, strerror(errno)));
         }
         else
         {
-            ExitNow(error = ERROR_IO_ERROR("failed to init file logger '{}', {}", aFilename, strerror(errno)));
+            ExitNow(error = ERROR_IO_ERROR("failed to init file logger '{}', {}", mFilename, strerror(errno)));
         }
     }
 
-    mLogFile  = logFile;
-    mLogLevel = aLogLevel;
+    fseek(mLogFile, 0, SEEK_END);
+    fileSize      = ftell(mLogFile);
+    mFileSize     = fileSize < 0 ? 0 : static_cast<size_t>(fileSize);
+    mSegmentStart = std::chrono::steady_clock::now();
+
+    // Every segment of a binary log can be decoded on its own.
+    if (mOptions.mFormat == Format::kBinary)
+    {
+        char   clockFrame[kMaxBinaryLogFrameHeaderLength];
+        size_t clockFrameLength = EncodeClockFrame(clockFrame, GetWallClock(), GetMonotonicClock());
+
+        std::fill(mWrittenFormats.begin(), mWrittenFormats.end(), false);
+        mLastClockFrame = std::chrono::steady_clock::now();
+        fwrite(kBinaryLogMagic, 1, sizeof(kBinaryLogMagic), mLogFile);
+        fwrite(clockFrame, 1, clockFrameLength, mLogFile);
+        fflush(mLogFile);
+        mFileSize += sizeof(kBinaryLogMagic) + clockFrameLength;
+    }
+
+    mOpenedFileSize = mFileSize;
 
 exit:
     return error;
 }
 
+bool FileLogger::ShouldRotate() const
+{
+    bool rotate = false;
+
+    // A segment without new messages is never rotated.
+    VerifyOrExit(mArchiver != nullptr && mFileSize > mOpenedFileSize);
+
+    rotate = (mOptions.mMaxSegmentSize > 0 && mFileSize >= mOptions.mMaxSegmentSize) ||
+             (mOptions.mSegmentInterval.count() > 0 &&
+              std::chrono::steady_clock::now() - mSegmentStart >= mOptions.mSegmentInterval);
+
+exit:
+    return rotate;
+}
+
+void FileLogger::Rotate()
+{
+    std::string segment;
+
+    fclose(mLogFile);
+    mLogFile = nullptr;
+
+    segment = mArchiver->MakeSegmentName(Clock::to_time_t(Clock::now()));
+    if (rename(mFilename.c_str(), segment.c_str()) == 0)
+    {
+        mArchiver->Archive(segment);
+    }
+
+    // Drain() retries opening the file if it fails here.
+    IgnoreError(OpenFile());
+}
+
 void FileLogger::Log(LogLevel aLevel, const std::string &aRegion, const std::string &aMsg)
 {
-    std::lock_guard<std::mutex> _(mLogMutex);
-    std::stringstream           logStream;
+    VerifyOrExit(aLevel <= mLogLevel);
+
+    Enqueue(aLevel, Clock::to_time_t(Clock::now()), aRegion, aMsg.data(), aMsg.size(), /* aIsBinary */ false);
+
+exit:
+    return;
+}
 
+void FileLogger::LogRecord(LogLevel aLevel, const std::string &aRegion, const ByteArray &aRecord)
+{
     VerifyOrExit(aLevel <= mLogLevel);
-    VerifyOrExit(mLogFile != nullptr);
+    VerifyOrExit(mOptions.mFormat == Format::kBinary);
+
+    // The monotonic timestamp is in the record.
+    Enqueue(aLevel, 0, aRegion, aRecord.data(), aRecord.size(), /* aIsBinary */ true);
+
+exit:
+    return;
+}
+
+void FileLogger::Enqueue(LogLevel           aLevel,
+                         time_t             aTime,
+                         const std::string &aRegion,
+                         const void *       aMessage,
+                         size_t             aLength,
+                         bool               aIsBinary)
+{
+    Ring &ring = GetThreadRing();
+
+    // A binary record cannot be truncated.
+    if (aIsBinary && aLength > ring.GetMaxMessageLength())
+    {
+        mDroppedCount.fetch_add(1, std::memory_order_relaxed);
+        ExitNow();
+    }
+
+    while (!ring.Push(aLevel, aTime, aRegion, aMessage, aLength, aIsBinary))
+    {
+        if (mOptions.mOverflowPolicy == OverflowPolicy::kDrop)
+        {
+            mDroppedCount.fetch_add(1, std::memory_order_relaxed);
+            ExitNow();
+        }
+
+        WaitForSpace();
+    }
+
+    WakeWriter();
+
+exit:
+    return;
+}
+
+void FileLogger::Flush()
+{
+    std::unique_lock<std::mutex> lock(mWriterMutex);
+    uint64_t                     request = ++mFlushRequests;
+
+    mPending.store(true);
+    mWriterCond.notify_one();
+    mSpaceCond.wait(lock, [this, request]() { return mFlushedRequests >= request || mStopped.load(); });
+}
+
+FileLogger::Ring &FileLogger::GetThreadRing()
+{
+    // The rings of the calling thread, one for each file logger it has logged to.
+    static thread_local std::vector<std::pair<uint64_t, std::shared_ptr<Ring>>> sThreadRings;
+
+    std::shared_ptr<Ring> ring;
+
+    for (auto &threadRing : sThreadRings)
+    {
+        if (threadRing.first == mId)
+        {
+            return *threadRing.second;
+        }
+    }
+
+    // Forget the rings of destroyed file loggers.
+    sThreadRings.erase(std::remove_if(sThreadRings.begin(), sThreadRings.end(),
+                                      [](const std::pair<uint64_t, std::shared_ptr<Ring>> &aThreadRing) {
+                                          return aThreadRing.second->IsClosed();
+                                      }),
+                       sThreadRings.end());
+
+    ring = std::make_shared<Ring>(mOptions.mBufferSize);
+    {
+        std::lock_guard<std::mutex> lock(mRingsMutex);
+        mRings.push_back(ring);
+    }
+    sThreadRings.emplace_back(mId, ring);
+
+    return *ring;
+}
+
+void FileLogger::WakeWriter()
+{
+    // Only the first message since the writer started draining notifies it.
+    if (!mPending.exchange(true))
+    {
+        std::lock_guard<std::mutex> lock(mWriterMutex);
+        mWriterCond.notify_one();
+    }
+}
+
+void FileLogger::WaitForSpace()
+{
+    std::unique_lock<std::mutex> lock(mWriterMutex);
+
+    mPending.store(true);
+    mWriterCond.notify_one();
+    mSpaceCond.wait_for(lock, kBlockInterval);
+}
+
+void FileLogger::Run()
+{
+    std::string batch;
+
+    while (true)
+    {
+        uint64_t flushRequests;
+        bool     stopped;
+        bool     drained;
+
+        // Clear the pending flag first, so that messages logged
+        // from now on will wake up the writer for another round.
+        mPending.store(false);
+        flushRequests = mFlushRequests.load();
+        stopped       = mStopped.load();
+
+        drained = Drain(batch);
+
+        {
+            std::lock_guard<std::mutex> lock(mWriterMutex);
+            mFlushedRequests = flushRequests;
+        }
+        mSpaceCond.notify_all();
+
+        if (stopped)
+        {
+            break;
+        }
+
+        if (!drained)
+        {
+            std::unique_lock<std::mutex> lock(mWriterMutex);
+
+            mWriterCond.wait_for(lock, kWriterIdleInterval, [this]() { return mPending.load() || mStopped.load(); });
+        }
+    }
+}
+
+bool FileLogger::Drain(std::string &aBatch)
+{
+    uint64_t    droppedCount = mDroppedCount.load(std::memory_order_relaxed);
+    BatchOutput output(aBatch);
+    Record      record;
+
+    while (mDraining.test_and_set(std::memory_order_acquire))
+    {
+        std::this_thread::yield();
+    }
+
+    aBatch.clear();
+
+    if (mOptions.mFormat == Format::kBinary &&
+        std::chrono::steady_clock::now() - mLastClockFrame >= kClockFrameInterval)
+    {
+        char clockFrame[kMaxBinaryLogFrameHeaderLength];
+
+        output.Write(clockFrame, EncodeClockFrame(clockFrame, GetWallClock(), GetMonotonicClock()));
+        mLastClockFrame = std::chrono::steady_clock::now();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mRingsMutex);
+
+        for (auto ring = mRings.begin(); ring != mRings.end();)
+        {
+            // Nothing else holds the ring after its thread exits,
+            // it is released once drained.
+            bool isOrphan = ring->use_count() == 1;
+
+            while ((*ring)->Peek(record))
+            {
+                EmitRecord(output, record);
+                (*ring)->Pop();
+            }
+
+            ring = isOrphan ? mRings.erase(ring) : ring + 1;
+        }
+    }
+
+    if (droppedCount != mReportedDroppedCount)
+    {
+        std::string message = std::to_string(droppedCount - mReportedDroppedCount) + " log messages are dropped";
+
+        record.mLevel         = LogLevel::kWarn;
+        record.mTime          = Clock::to_time_t(Clock::now());
+        record.mRegion        = kDroppedRegion;
+        record.mRegionLength  = sizeof(kDroppedRegion) - 1;
+        record.mMessage       = message.data();
+        record.mMessageLength = message.size();
+        record.mIsBinary      = false;
+        EmitRecord(output, record);
+
+        mReportedDroppedCount = droppedCount;
+    }
+
+    if (mLogFile == nullptr)
+    {
+        IgnoreError(OpenFile());
+    }
+
+    // The batch is lost if the file cannot be opened.
+    if (!aBatch.empty() && mLogFile != nullptr)
+    {
+        fwrite(aBatch.data(), 1, aBatch.size(), mLogFile);
+        fflush(mLogFile);
+        mFileSize += aBatch.size();
+    }
+
+    if (mLogFile != nullptr && ShouldRotate())
+    {
+        Rotate();
+    }
+
+    mDraining.clear(std::memory_order_release);
+
+    return !aBatch.empty();
+}
+
+template <typename Output> void FileLogger::EmitRecord(Output &aOutput, const Record &aRecord)
+{
+    char header[kMaxPrefixLength];
+
+    if (mOptions.mFormat == Format::kText)
+    {
+        if (aRecord.mTime != mCachedTime)
+        {
+            FormatTime(mCachedTimeString, sizeof(mCachedTimeString), aRecord.mTime);
+            mCachedTime = aRecord.mTime;
+        }
+
+        aOutput.Write(header, FormatPrefix(header, sizeof(header), mCachedTimeString, aRecord.mLevel,
+                                           aRecord.mRegion, aRecord.mRegionLength));
+        aOutput.Write(aRecord.mMessage, aRecord.mMessageLength);
+        aOutput.Write("\n", 1);
+    }
+    else if (!aRecord.mIsBinary)
+    {
+        aOutput.Write(header, EncodeTextFrameHeader(header, aRecord.mLevel, aRecord.mTime, aRecord.mRegion,
+                                                    aRecord.mRegionLength, aRecord.mMessageLength));
+        aOutput.Write(aRecord.mMessage, aRecord.mMessageLength);
+    }
+    else
+    {
+        uint32_t formatId = utils::Decode<uint32_t>(reinterpret_cast<const uint8_t *>(aRecord.mMessage),
+                                                    aRecord.mMessageLength);
+
+        // Define the format before the first record using it.
+        if (formatId < mWrittenFormats.size() && !mWrittenFormats[formatId])
+        {
+            const char *format = GetLogFormat(formatId);
+
+            if (format != nullptr)
+            {
+                size_t formatLength = strlen(format);
+
+                aOutput.Write(header, EncodeFormatFrameHeader(header, formatId, formatLength));
+                aOutput.Write(format, formatLength);
+                mWrittenFormats[formatId] = true;
+            }
+        }
+
+        aOutput.Write(header, EncodeRecordFrameHeader(header, aRecord.mLevel, aRecord.mRegion, aRecord.mRegionLength,
+                                                      aRecord.mMessageLength));
+        aOutput.Write(aRecord.mMessage, aRecord.mMessageLength);
+    }
+}
+
+void FileLogger::InstallCrashHandler()
+{
+    static const int kSignals[] = {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT};
+    struct sigaction action;
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = HandleCrash;
+    action.sa_flags   = SA_RESETHAND;
+    sigemptyset(&action.sa_mask);
+
+    for (int signal : kSignals)
+    {
+        sigaction(signal, &action, nullptr);
+    }
+}
+
+void FileLogger::HandleCrash(int aSignal)
+{
+    FileLogger *logger = sCrashLogger.load();
+
+    if (logger != nullptr)
+    {
+        logger->FlushOnCrash();
+    }
+
+    // The default action has been restored by SA_RESETHAND.
+    raise(aSignal);
+}
+
+void FileLogger::FlushOnCrash()
+{
+    Record record;
+
+    // Never wait here, the crashed thread may be the one holding the lock.
+    VerifyOrExit(!mDraining.test_and_set(std::memory_order_acquire));
+    if (mLogFile == nullptr || !mRingsMutex.try_lock())
+    {
+        mDraining.clear(std::memory_order_release);
+        ExitNow();
+    }
+
+    {
+        // The stdio buffer is always flushed by the writer thread before
+        // releasing mDraining, it is safe to write the file descriptor directly.
+        FdOutput output(fileno(mLogFile));
+
+        for (auto &ring : mRings)
+        {
+            while (ring->Peek(record))
+            {
+                EmitRecord(output, record);
+                ring->Pop();
+            }
+        }
+    }
 
-    logStream << "[ " << TimePointToString(Clock::now()) << " ] [ " << ToString(aLevel) << " ] [ " << aRegion << " ] "
-              << aMsg << std::endl;
-    fputs(logStream.str().c_str(), mLogFile);
+    mRingsMutex.unlock();
+    mDraining.clear(std::memory_order_release);
 
 exit:
     return;
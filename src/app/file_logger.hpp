@@ -35,13 +35,22 @@
 #ifndef OT_COMM_APP_FILE_LOGGER_HPP_
 #define OT_COMM_APP_FILE_LOGGER_HPP_
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <stdio.h>
+#include <time.h>
 
 #include <commissioner/commissioner.hpp>
 
+#include "app/log_archiver.hpp"
+
 namespace ot {
 
 namespace commissioner {
@@ -49,18 +58,59 @@ namespace commissioner {
 /**
  * @brief An implementation of the Logger interface that write log to a text file.
  *
+ * Log() only copies the message into a lock-free ring buffer owned by the
+ * calling thread. A background writer thread drains the buffers of all
+ * threads, formats the messages and writes them to the file in batches.
+ * The writer thread also rotates the file, so that logging threads never
+ * wait for a rollover.
+ *
  */
 class FileLogger : public Logger
 {
 public:
+    /**
+     * The policy of logging a message when the buffer of the calling thread is full.
+     */
+    enum class OverflowPolicy : uint8_t
+    {
+        kDrop = 0, ///< Drop the message and count it in GetDroppedCount().
+        kBlock,    ///< Block the calling thread until the writer thread makes room.
+    };
+
+    /**
+     * The format of the log file.
+     */
+    enum class Format : uint8_t
+    {
+        kText = 0, ///< Text log lines.
+        kBinary,   ///< Binary log records, see app/binary_log.hpp.
+    };
+
+    static constexpr size_t kDefaultBufferSize = 64 * 1024; ///< The buffer size per producer thread.
+
     ~FileLogger() override;
 
+    /**
+     * The options of a file logger.
+     */
+    struct Options
+    {
+        OverflowPolicy mOverflowPolicy = OverflowPolicy::kDrop; ///< The policy when the buffer of a thread is full.
+        size_t         mBufferSize     = kDefaultBufferSize;    ///< The size of the buffer of each producer thread.
+        Format         mFormat         = Format::kText;         ///< The format of the log file.
+
+        size_t               mMaxSegmentSize = 0;     ///< Rotates the log file at this size in bytes, 0 to disable.
+        std::chrono::seconds mSegmentInterval{0};     ///< Rotates the log file at this interval, 0 to disable.
+        size_t               mRetainedSegmentNum = 0; ///< The number of closed segments to keep, 0 to keep all.
+        bool                 mCompress = false;       ///< Compresses closed segments with gzip.
+    };
+
     /**
      * This function returns a file logger with given filename and minimum log level.
      *
-     * @param[in] aFilename  The log file name.
-     * @param[in] aLogLevel  The minimum log level. Log messages with a lower
-     *                       log level than this will be dropped silently.
+     * @param[in] aFilename        The log file name.
+     * @param[in] aLogLevel        The minimum log level. Log messages with a lower
+     *                             log level than this will be dropped silently.
      *
      * @retval Error::kNone  Successfully created the file logger.
      * @retval ...           Failed to create the file logger.
@@ -68,15 +118,121 @@ public:
      */
     static Error Create(std::shared_ptr<FileLogger> &aFileLogger, const std::string &aFilename, LogLevel aLogLevel);
 
+    /**
+     * This function returns a file logger with given filename, minimum log level and options.
+     *
+     * Messages are appended to the file. When rotation is enabled, the file
+     * is renamed to "<aFilename>.<UTC time>" once it reaches the maximum size
+     * or the rotation interval elapses, and a new file is started. Closed
+     * segments are compressed and pruned in background, see LogArchiver.
+     *
+     * @param[in] aFilename        The log file name.
+     * @param[in] aLogLevel        The minimum log level. Log messages with a lower
+     *                             log level than this will be dropped silently.
+     * @param[in] aOptions         The options.
+     *
+     * @retval Error::kNone  Successfully created the file logger.
+     * @retval ...           Failed to create the file logger.
+     *
+     */
+    static Error Create(std::shared_ptr<FileLogger> &aFileLogger,
+                        const std::string &          aFilename,
+                        LogLevel                     aLogLevel,
+                        const Options &              aOptions);
+
     void Log(LogLevel aLevel, const std::string &aRegion, const std::string &aMsg) override;
 
+    LogLevel GetLogLevel() const override { return mLogLevel; }
+
+    bool IsBinary() const override { return mOptions.mFormat == Format::kBinary; }
+
+    void LogRecord(LogLevel aLevel, const std::string &aRegion, const ByteArray &aRecord) override;
+
+    /**
+     * This method blocks until all messages logged before by the
+     * calling thread are written to the file.
+     *
+     */
+    void Flush();
+
+    /**
+     * This method returns the number of messages dropped because of a full buffer.
+     *
+     */
+    uint64_t GetDroppedCount() const { return mDroppedCount.load(std::memory_order_relaxed); }
+
+    /**
+     * This function installs handlers of fatal signals (SIGSEGV, SIGABRT and so on)
+     * which write buffered messages of the most recently created file logger
+     * before the process terminates.
+     *
+     * The handlers are best-effort: messages being drained by the writer
+     * thread at the time of the crash may be lost.
+     *
+     */
+    static void InstallCrashHandler();
+
 private:
+    class Ring;
+    struct Record;
+
     FileLogger() = default;
-    Error Init(const std::string &aFilename, LogLevel aLogLevel);
+    Error Init(const std::string &aFilename, LogLevel aLogLevel, const Options &aOptions);
+    Error OpenFile();
+    bool  ShouldRotate() const;
+    void  Rotate();
+
+    Ring &GetThreadRing();
+    void  Enqueue(LogLevel aLevel, time_t aTime, const std::string &aRegion, const void *aMessage, size_t aLength,
+                  bool aIsBinary);
+    void  WakeWriter();
+    void  WaitForSpace();
+    void  Run();
+    bool  Drain(std::string &aBatch);
+    void  FlushOnCrash();
+
+    template <typename Output> void EmitRecord(Output &aOutput, const Record &aRecord);
+
+    static void HandleCrash(int aSignal);
+
+    uint64_t    mId = 0;
+    std::string mFilename;
+    LogLevel    mLogLevel = LogLevel::kOff;
+    Options     mOptions;
+
+    std::mutex                         mRingsMutex;
+    std::vector<std::shared_ptr<Ring>> mRings;
+
+    // Held by whoever drains the rings and writes the file:
+    // the writer thread or the crash handler.
+    std::atomic_flag mDraining = ATOMIC_FLAG_INIT;
+
+    std::mutex              mWriterMutex;
+    std::condition_variable mWriterCond;
+    std::condition_variable mSpaceCond;
+    std::atomic<bool>       mPending{false};
+    std::atomic<bool>       mStopped{false};
+    std::atomic<uint64_t>   mFlushRequests{0};
+    uint64_t                mFlushedRequests = 0; // Guarded by mWriterMutex.
+    std::atomic<uint64_t>   mDroppedCount{0};
+    std::thread             mWriter;
+
+    // Accessed by only the writer thread.
+    uint64_t mReportedDroppedCount = 0;
+    time_t   mCachedTime           = -1;
+    char     mCachedTimeString[32];
+
+    // The binary log formats which have been written to the file.
+    std::vector<bool>                     mWrittenFormats;
+    std::chrono::steady_clock::time_point mLastClockFrame;
 
-    FILE *     mLogFile;
-    LogLevel   mLogLevel;
-    std::mutex mLogMutex;
+    // The active segment, written by only the holder of mDraining. It is
+    // null if the file could not be reopened after a rotation.
+    FILE *                                mLogFile        = nullptr;
+    size_t                                mFileSize       = 0;
+    size_t                                mOpenedFileSize = 0;
+    std::chrono::steady_clock::time_point mSegmentStart;
+    std::unique_ptr<LogArchiver>          mArchiver;
 };
 
 } // namespace commissioner
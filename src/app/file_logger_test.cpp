@@ -0,0 +1,310 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases for the asynchronous file logger.
+ */
+
+#include "app/file_logger.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include <stdio.h>
+
+#include <catch2/catch.hpp>
+
+#include "common/benchmark.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+static std::vector<std::string> ReadLines(const std::string &aFilename, const std::string &aPattern)
+{
+    std::ifstream            file(aFilename);
+    std::vector<std::string> lines;
+    std::string              line;
+
+    while (std::getline(file, line))
+    {
+        if (line.find(aPattern) != std::string::npos)
+        {
+            lines.push_back(line);
+        }
+    }
+    return lines;
+}
+
+TEST_CASE("file-logger-write", "[file-logger]")
+{
+    const std::string           kFilename    = "file_logger_test.log";
+    constexpr int               kThreadNum   = 4;
+    constexpr int               kMessageNum  = 1000;
+    std::shared_ptr<FileLogger> logger;
+    std::vector<std::thread>    threads;
+    FileLogger::Options         options;
+
+    // The file logger appends to an existing file.
+    remove(kFilename.c_str());
+
+    options.mOverflowPolicy = FileLogger::OverflowPolicy::kBlock;
+    REQUIRE(FileLogger::Create(logger, kFilename, LogLevel::kInfo, options) == ErrorCode::kNone);
+    REQUIRE(logger->GetLogLevel() == LogLevel::kInfo);
+
+    logger->Log(LogLevel::kInfo, "test", "hello");
+    logger->Log(LogLevel::kDebug, "test", "filtered");
+    logger->Flush();
+
+    auto lines = ReadLines(kFilename, "[ test ]");
+    REQUIRE(lines.size() == 1);
+    REQUIRE(lines[0].front() == '[');
+    REQUIRE(lines[0].find("] [ info ] [ test ] hello") != std::string::npos);
+
+    for (int i = 0; i < kThreadNum; ++i)
+    {
+        threads.emplace_back([&logger, i]() {
+            for (int j = 0; j < kMessageNum; ++j)
+            {
+                logger->Log(LogLevel::kWarn, "thread-" + std::to_string(i), std::to_string(j));
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    logger->Flush();
+
+    // Messages of the same thread keep their order.
+    for (int i = 0; i < kThreadNum; ++i)
+    {
+        lines = ReadLines(kFilename, "[ thread-" + std::to_string(i) + " ]");
+        REQUIRE(lines.size() == kMessageNum);
+        for (int j = 0; j < kMessageNum; ++j)
+        {
+            REQUIRE(lines[j].substr(lines[j].rfind(' ') + 1) == std::to_string(j));
+        }
+    }
+    REQUIRE(logger->GetDroppedCount() == 0);
+
+    logger.reset();
+    REQUIRE(remove(kFilename.c_str()) == 0);
+}
+
+TEST_CASE("file-logger-overflow", "[file-logger]")
+{
+    const std::string           kFilename   = "file_logger_test.log";
+    constexpr int               kMessageNum = 10000;
+    const std::string           kMessage(200, 'x');
+    std::shared_ptr<FileLogger> logger;
+    FileLogger::Options         options;
+
+    remove(kFilename.c_str());
+    options.mBufferSize = 1024;
+
+    SECTION("drop messages when the buffer is full")
+    {
+        options.mOverflowPolicy = FileLogger::OverflowPolicy::kDrop;
+        REQUIRE(FileLogger::Create(logger, kFilename, LogLevel::kDebug, options) == ErrorCode::kNone);
+
+        for (int i = 0; i < kMessageNum; ++i)
+        {
+            logger->Log(LogLevel::kDebug, "test", kMessage);
+        }
+        logger->Flush();
+
+        REQUIRE(ReadLines(kFilename, "[ test ]").size() + logger->GetDroppedCount() == kMessageNum);
+        REQUIRE(ReadLines(kFilename, "log messages are dropped").empty() == (logger->GetDroppedCount() == 0));
+    }
+
+    SECTION("block when the buffer is full")
+    {
+        options.mOverflowPolicy = FileLogger::OverflowPolicy::kBlock;
+        REQUIRE(FileLogger::Create(logger, kFilename, LogLevel::kDebug, options) == ErrorCode::kNone);
+
+        for (int i = 0; i < kMessageNum; ++i)
+        {
+            logger->Log(LogLevel::kDebug, "test", kMessage);
+        }
+        logger->Flush();
+
+        REQUIRE(ReadLines(kFilename, "[ test ]").size() == kMessageNum);
+        REQUIRE(logger->GetDroppedCount() == 0);
+    }
+
+    SECTION("truncate messages larger than the buffer")
+    {
+        options.mOverflowPolicy = FileLogger::OverflowPolicy::kBlock;
+        REQUIRE(FileLogger::Create(logger, kFilename, LogLevel::kDebug, options) == ErrorCode::kNone);
+
+        logger->Log(LogLevel::kDebug, "test", std::string(4096, 'y'));
+        logger->Flush();
+
+        auto lines = ReadLines(kFilename, "[ test ]");
+        REQUIRE(lines.size() == 1);
+        REQUIRE(lines[0].size() < 1024);
+    }
+
+    logger.reset();
+    REQUIRE(remove(kFilename.c_str()) == 0);
+}
+
+TEST_CASE("file-logger-rotate", "[file-logger]")
+{
+    const std::string           kFilename   = "file_logger_rotate_test.log";
+    constexpr int               kMessageNum = 2000;
+    const std::string           kMessage(100, 'x');
+    std::shared_ptr<FileLogger> logger;
+    FileLogger::Options         options;
+    std::vector<std::string>    lines;
+
+    // Removes the log file and segments of previous runs.
+    remove(kFilename.c_str());
+    for (const auto &segment : LogArchiver(kFilename, 0, false).GetSegments())
+    {
+        REQUIRE(remove(segment.c_str()) == 0);
+    }
+
+    options.mOverflowPolicy = FileLogger::OverflowPolicy::kBlock;
+
+    SECTION("append to the existing file")
+    {
+        REQUIRE(FileLogger::Create(logger, kFilename, LogLevel::kDebug, options) == ErrorCode::kNone);
+        logger->Log(LogLevel::kInfo, "test", "first");
+        logger.reset();
+
+        REQUIRE(FileLogger::Create(logger, kFilename, LogLevel::kDebug, options) == ErrorCode::kNone);
+        logger->Log(LogLevel::kInfo, "test", "second");
+        logger->Flush();
+
+        lines = ReadLines(kFilename, "[ test ]");
+        REQUIRE(lines.size() == 2);
+        REQUIRE(lines[1].find("second") != std::string::npos);
+    }
+
+    SECTION("rotate by size and keep the latest segments")
+    {
+        options.mMaxSegmentSize     = 16 * 1024;
+        options.mRetainedSegmentNum = 2;
+        REQUIRE(FileLogger::Create(logger, kFilename, LogLevel::kDebug, options) == ErrorCode::kNone);
+
+        for (int i = 0; i < kMessageNum; ++i)
+        {
+            logger->Log(LogLevel::kDebug, "test", std::to_string(i) + " " + kMessage);
+            if (i % 100 == 0)
+            {
+                logger->Flush();
+            }
+        }
+        logger.reset();
+
+        auto segments = LogArchiver(kFilename, 0, false).GetSegments();
+        REQUIRE(segments.size() == 2);
+
+        // The retained segments and the active file hold the latest messages in order.
+        for (const auto &segment : segments)
+        {
+            auto segmentLines = ReadLines(segment, "[ test ]");
+
+            lines.insert(lines.end(), segmentLines.begin(), segmentLines.end());
+            REQUIRE(remove(segment.c_str()) == 0);
+        }
+        for (const auto &line : ReadLines(kFilename, "[ test ]"))
+        {
+            lines.push_back(line);
+        }
+        REQUIRE(!lines.empty());
+        REQUIRE(lines.size() < kMessageNum);
+        for (size_t i = 0; i < lines.size(); ++i)
+        {
+            std::string expected = std::to_string(kMessageNum - lines.size() + i) + " " + kMessage;
+
+            REQUIRE(lines[i].substr(lines[i].size() - expected.size()) == expected);
+        }
+    }
+
+    SECTION("rotate by time")
+    {
+        options.mSegmentInterval = std::chrono::seconds(1);
+        REQUIRE(FileLogger::Create(logger, kFilename, LogLevel::kDebug, options) == ErrorCode::kNone);
+
+        logger->Log(LogLevel::kInfo, "test", "first");
+        logger->Flush();
+
+        // The writer thread rotates the file even if nothing is logged.
+        std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+
+        auto segments = LogArchiver(kFilename, 0, false).GetSegments();
+        REQUIRE(segments.size() == 1);
+        REQUIRE(ReadLines(segments[0], "[ test ]").size() == 1);
+        REQUIRE(remove(segments[0].c_str()) == 0);
+
+        logger->Log(LogLevel::kInfo, "test", "second");
+        logger->Flush();
+        lines = ReadLines(kFilename, "[ test ]");
+        REQUIRE(lines.size() == 1);
+        REQUIRE(lines[0].find("second") != std::string::npos);
+    }
+
+    logger.reset();
+    REQUIRE(remove(kFilename.c_str()) == 0);
+}
+
+TEST_CASE("file-logger-latency", "[.benchmark]")
+{
+    const std::string           kFilename   = "file_logger_benchmark.log";
+    constexpr int               kMessageNum = 200000;
+    const std::string           kMessage    = "received 64 bytes from joiner 0x1122334455667788";
+    std::shared_ptr<FileLogger> logger;
+    FileLogger::Options         options;
+
+    remove(kFilename.c_str());
+
+    options.mOverflowPolicy = FileLogger::OverflowPolicy::kBlock;
+    REQUIRE(FileLogger::Create(logger, kFilename, LogLevel::kDebug, options) == ErrorCode::kNone);
+
+    auto logged  = benchmark::Measure(kMessageNum, [&]() { logger->Log(LogLevel::kDebug, "dtls", kMessage); });
+    auto flushed = benchmark::Measure([&]() { logger->Flush(); });
+
+    auto perMessage = logged.count() / kMessageNum;
+    auto total      = std::chrono::duration_cast<std::chrono::milliseconds>(logged + flushed).count();
+
+    WARN("Log() takes " << perMessage << " ns per message, " << kMessageNum << " messages are written in " << total
+                        << " ms");
+
+    logger.reset();
+    REQUIRE(remove(kFilename.c_str()) == 0);
+}
+
+} // namespace commissioner
+
+} // namespace ot
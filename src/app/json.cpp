@@ -188,6 +188,18 @@ NLOHMANN_JSON_SERIALIZE_ENUM(LogLevel,
                                  {LogLevel::kDebug, "debug"},
                              });
 
+NLOHMANN_JSON_SERIALIZE_ENUM(FileLogger::OverflowPolicy,
+                             {
+                                 {FileLogger::OverflowPolicy::kDrop, "drop"},
+                                 {FileLogger::OverflowPolicy::kBlock, "block"},
+                             });
+
+NLOHMANN_JSON_SERIALIZE_ENUM(FileLogger::Format,
+                             {
+                                 {FileLogger::Format::kText, "text"},
+                                 {FileLogger::Format::kBinary, "binary"},
+                             });
+
 static void from_json(const Json &aJson, Config &aConfig)
 {
 #define SET_IF_PRESENT(name)            \
@@ -203,6 +215,8 @@ static void from_json(const Json &aJson, Config &aConfig)
     SET_IF_PRESENT(KeepAliveInterval);
     SET_IF_PRESENT(MaxConnectionNum);
 
+    SET_IF_PRESENT(SequenceNumberJournal);
+
 #undef SET_IF_PRESENT
 
     // The default log level is LogLevel::kInfo.
@@ -216,8 +230,44 @@ static void from_json(const Json &aJson, Config &aConfig)
     if (aJson.contains("LogFile"))
     {
         std::shared_ptr<FileLogger> logger;
+        FileLogger::Options         options;
+
+        if (aJson.contains("LogOverflowPolicy"))
+        {
+            options.mOverflowPolicy = aJson["LogOverflowPolicy"];
+        }
+
+        if (aJson.contains("LogBufferSize"))
+        {
+            options.mBufferSize = aJson["LogBufferSize"];
+        }
+
+        if (aJson.contains("LogFormat"))
+        {
+            options.mFormat = aJson["LogFormat"];
+        }
+
+        if (aJson.contains("LogMaxSize"))
+        {
+            options.mMaxSegmentSize = aJson["LogMaxSize"];
+        }
+
+        if (aJson.contains("LogRotateInterval"))
+        {
+            options.mSegmentInterval = std::chrono::seconds(aJson["LogRotateInterval"].get<uint32_t>());
+        }
+
+        if (aJson.contains("LogRetainedSegments"))
+        {
+            options.mRetainedSegmentNum = aJson["LogRetainedSegments"];
+        }
+
+        if (aJson.contains("LogCompressSegments"))
+        {
+            options.mCompress = aJson["LogCompressSegments"];
+        }
 
-        SuccessOrThrow(FileLogger::Create(logger, aJson["LogFile"], logLevel));
+        SuccessOrThrow(FileLogger::Create(logger, aJson["LogFile"], logLevel, options));
         aConfig.mLogger = logger;
     }
 
@@ -549,6 +599,30 @@ std::string NetworkDataToJson(const NetworkData &aNetworkData)
     return json.dump(/* indent */ 4);
 }
 
+Error NetworkDataListFromJson(std::vector<NetworkData> &aNetworkDataList, const std::string &aJson)
+{
+    Error error;
+
+    try
+    {
+        aNetworkDataList = Json::parse(StripComments(aJson)).get<std::vector<NetworkData>>();
+    } catch (JsonException &e)
+    {
+        error = e.GetError();
+    } catch (std::exception &e)
+    {
+        error = {ErrorCode::kInvalidArgs, e.what()};
+    }
+
+    return error;
+}
+
+std::string NetworkDataListToJson(const std::vector<NetworkData> &aNetworkDataList)
+{
+    Json json = aNetworkDataList;
+    return json.dump(/* indent */ 4);
+}
+
 Error CommissionerDatasetFromJson(CommissionerDataset &aDataset, const std::string &aJson)
 {
     Error error;
@@ -36,6 +36,7 @@
 #define OT_COMM_APP_JSON_HPP_
 
 #include <string>
+#include <vector>
 
 #include <commissioner/commissioner.hpp>
 #include <commissioner/error.hpp>
@@ -57,6 +58,8 @@ struct NetworkData
 
 Error       NetworkDataFromJson(NetworkData &aNetworkData, const std::string &aJson);
 std::string NetworkDataToJson(const NetworkData &aNetworkData);
+Error       NetworkDataListFromJson(std::vector<NetworkData> &aNetworkDataList, const std::string &aJson);
+std::string NetworkDataListToJson(const std::vector<NetworkData> &aNetworkDataList);
 
 Error       CommissionerDatasetFromJson(CommissionerDataset &aDataset, const std::string &aJson);
 std::string CommissionerDatasetToJson(const CommissionerDataset &aDataset);
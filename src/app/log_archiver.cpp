@@ -0,0 +1,250 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *  This file implements the archiver of closed log file segments.
+ *
+ */
+
+#include "app/log_archiver.hpp"
+
+#include <algorithm>
+
+#include <ctype.h>
+#include <dirent.h>
+#include <errno.h>
+#include <spawn.h>
+#include <stdio.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+
+namespace ot {
+
+namespace commissioner {
+
+static const char kCompressedSuffix[] = ".gz";
+
+static bool EndsWith(const std::string &aString, const std::string &aSuffix)
+{
+    return aString.size() >= aSuffix.size() &&
+           aString.compare(aString.size() - aSuffix.size(), aSuffix.size(), aSuffix) == 0;
+}
+
+static std::string StripCompressedSuffix(const std::string &aSegment)
+{
+    return EndsWith(aSegment, kCompressedSuffix) ? aSegment.substr(0, aSegment.size() - sizeof(kCompressedSuffix) + 1)
+                                                 : aSegment;
+}
+
+static bool Exists(const std::string &aPath)
+{
+    return access(aPath.c_str(), F_OK) == 0;
+}
+
+LogArchiver::LogArchiver(const std::string &aFilename, size_t aRetainedSegmentNum, bool aCompress)
+    : mFilename(aFilename)
+    , mRetainedSegmentNum(aRetainedSegmentNum)
+    , mCompress(aCompress)
+    , mThread(&LogArchiver::Run, this)
+{
+}
+
+LogArchiver::~LogArchiver()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopped = true;
+    }
+    mCond.notify_all();
+    mThread.join();
+}
+
+std::string LogArchiver::MakeSegmentName(time_t aTime)
+{
+    char        timeString[32];
+    struct tm   utcTime;
+    std::string base;
+    std::string name;
+    int         sequence;
+
+    gmtime_r(&aTime, &utcTime);
+    if (strftime(timeString, sizeof(timeString), "%Y%m%dT%H%M%SZ", &utcTime) == 0)
+    {
+        timeString[0] = '\0';
+    }
+
+    // Sequence numbers are never reused within a second, even
+    // if the segments holding them have been pruned.
+    base     = mFilename + "." + timeString;
+    sequence = aTime == mLastSegmentTime ? mLastSequence + 1 : 0;
+    name     = sequence == 0 ? base : base + "-" + std::to_string(sequence);
+    while (Exists(name) || Exists(name + kCompressedSuffix))
+    {
+        name = base + "-" + std::to_string(++sequence);
+    }
+
+    mLastSegmentTime = aTime;
+    mLastSequence    = sequence;
+
+    return name;
+}
+
+void LogArchiver::Archive(const std::string &aSegment)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mSegments.push_back(aSegment);
+    }
+    mCond.notify_all();
+}
+
+std::vector<std::string> LogArchiver::GetSegments() const
+{
+    size_t                   separator = mFilename.rfind('/');
+    std::string              directory = separator == std::string::npos ? "." : mFilename.substr(0, separator + 1);
+    std::string              prefix    = mFilename.substr(separator == std::string::npos ? 0 : separator + 1) + ".";
+    size_t                   offset    = (separator == std::string::npos ? 0 : directory.size()) + prefix.size();
+    std::vector<std::string> segments;
+    DIR *                    dir;
+    struct dirent *          entry;
+
+    dir = opendir(directory.c_str());
+    if (dir == nullptr)
+    {
+        return segments;
+    }
+
+    while ((entry = readdir(dir)) != nullptr)
+    {
+        std::string name = entry->d_name;
+
+        // A segment name is the log file name followed by a timestamp.
+        if (name.size() > prefix.size() && name.compare(0, prefix.size(), prefix) == 0 &&
+            isdigit(static_cast<unsigned char>(name[prefix.size()])))
+        {
+            segments.push_back(separator == std::string::npos ? name : directory + name);
+        }
+    }
+    closedir(dir);
+
+    // Segments are ordered by the timestamp, then by the sequence number
+    // appended to the segments closed in the same second.
+    std::sort(segments.begin(), segments.end(), [offset](const std::string &aLhs, const std::string &aRhs) {
+        std::string lhs     = StripCompressedSuffix(aLhs);
+        std::string rhs     = StripCompressedSuffix(aRhs);
+        std::string lhsTime = lhs.substr(0, lhs.find('-', offset));
+        std::string rhsTime = rhs.substr(0, rhs.find('-', offset));
+
+        if (lhsTime != rhsTime)
+        {
+            return lhsTime < rhsTime;
+        }
+        return lhs.size() != rhs.size() ? lhs.size() < rhs.size() : lhs < rhs;
+    });
+
+    return segments;
+}
+
+void LogArchiver::Wait()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    mCond.wait(lock, [this]() { return mSegments.empty() && !mBusy; });
+}
+
+void LogArchiver::Run()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    while (true)
+    {
+        std::string segment;
+
+        mCond.wait(lock, [this]() { return !mSegments.empty() || mStopped; });
+        if (mSegments.empty())
+        {
+            break;
+        }
+
+        segment = mSegments.front();
+        mSegments.pop_front();
+        mBusy = true;
+        lock.unlock();
+
+        if (mCompress)
+        {
+            Compress(segment);
+        }
+        if (mRetainedSegmentNum > 0)
+        {
+            Prune();
+        }
+
+        lock.lock();
+        mBusy = false;
+        mCond.notify_all();
+    }
+}
+
+void LogArchiver::Compress(const std::string &aSegment)
+{
+    // Compressing with the gzip utility keeps zlib out of the dependencies,
+    // the segment is replaced by "<segment>.gz" on success.
+    char  program[] = "gzip";
+    char  force[]   = "-f";
+    char  quiet[]   = "-q";
+    char *argv[]    = {program, force, quiet, const_cast<char *>(aSegment.c_str()), nullptr};
+    pid_t pid;
+    int   status;
+
+    if (posix_spawnp(&pid, program, nullptr, nullptr, argv, environ) != 0)
+    {
+        return;
+    }
+
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR)
+    {
+    }
+}
+
+void LogArchiver::Prune()
+{
+    std::vector<std::string> segments = GetSegments();
+
+    for (size_t i = 0; i + mRetainedSegmentNum < segments.size(); ++i)
+    {
+        remove(segments[i].c_str());
+    }
+}
+
+} // namespace commissioner
+
+} // namespace ot
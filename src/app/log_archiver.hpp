@@ -0,0 +1,132 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *  This file defines the archiver of closed log file segments.
+ *
+ */
+
+#ifndef OT_COMM_APP_LOG_ARCHIVER_HPP_
+#define OT_COMM_APP_LOG_ARCHIVER_HPP_
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <time.h>
+
+namespace ot {
+
+namespace commissioner {
+
+/**
+ * The archiver of closed segments of a rotated log file.
+ *
+ * A closed segment is named after the log file and the UTC time it is
+ * closed, for example "commissioner.log.20200101T080000Z". Archiving a
+ * segment, which compresses it and removes the oldest segments beyond the
+ * retained number, is done by a background thread so that rotating the
+ * log file never waits for it.
+ *
+ */
+class LogArchiver
+{
+public:
+    /**
+     * @param[in] aFilename            The log file name.
+     * @param[in] aRetainedSegmentNum  The number of closed segments to keep, 0 to keep all.
+     * @param[in] aCompress            Compress closed segments with gzip.
+     */
+    LogArchiver(const std::string &aFilename, size_t aRetainedSegmentNum, bool aCompress);
+
+    /**
+     * The destructor waits for the segments being archived.
+     */
+    ~LogArchiver();
+
+    LogArchiver(const LogArchiver &) = delete;
+    LogArchiver &operator=(const LogArchiver &) = delete;
+
+    /**
+     * This method returns a new segment name which sorts after the segments made before.
+     *
+     * @param[in] aTime  The time the segment is closed.
+     *
+     */
+    std::string MakeSegmentName(time_t aTime);
+
+    /**
+     * This method archives a closed segment in background.
+     *
+     * @param[in] aSegment  The segment name.
+     *
+     */
+    void Archive(const std::string &aSegment);
+
+    /**
+     * This method returns the closed segments, oldest first.
+     *
+     */
+    std::vector<std::string> GetSegments() const;
+
+    /**
+     * This method blocks until all segments passed to Archive() are archived.
+     *
+     */
+    void Wait();
+
+private:
+    void Run();
+    void Compress(const std::string &aSegment);
+    void Prune();
+
+    const std::string mFilename;
+    const size_t      mRetainedSegmentNum;
+    const bool        mCompress;
+
+    // The last segment name made, accessed by only the caller of MakeSegmentName().
+    time_t mLastSegmentTime = -1;
+    int    mLastSequence    = 0;
+
+    std::mutex              mMutex;
+    std::condition_variable mCond;
+    std::deque<std::string> mSegments;
+    bool                    mBusy    = false;
+    bool                    mStopped = false;
+    std::thread             mThread;
+};
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_APP_LOG_ARCHIVER_HPP_
@@ -0,0 +1,134 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases for the log archiver.
+ */
+
+#include "app/log_archiver.hpp"
+
+#include <fstream>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <catch2/catch.hpp>
+
+namespace ot {
+
+namespace commissioner {
+
+static const char kFilename[] = "log_archiver_test.log";
+
+static void RemoveSegments()
+{
+    for (const auto &segment : LogArchiver(kFilename, 0, false).GetSegments())
+    {
+        REQUIRE(remove(segment.c_str()) == 0);
+    }
+}
+
+static std::string CreateSegment(LogArchiver &aArchiver, time_t aTime)
+{
+    std::string   segment = aArchiver.MakeSegmentName(aTime);
+    std::ofstream file(segment);
+
+    file << "segment " << aTime << std::endl;
+    return segment;
+}
+
+TEST_CASE("log-archiver-prune", "[log-archiver]")
+{
+    std::vector<std::string> segments;
+
+    RemoveSegments();
+
+    {
+        LogArchiver archiver(kFilename, 3, false);
+
+        REQUIRE(archiver.MakeSegmentName(0) == std::string(kFilename) + ".19700101T000000Z");
+
+        for (time_t time = 100; time < 105; ++time)
+        {
+            segments.push_back(CreateSegment(archiver, time));
+        }
+
+        // Segments closed in the same second are numbered.
+        for (int i = 0; i < 11; ++i)
+        {
+            segments.push_back(CreateSegment(archiver, 200));
+        }
+        REQUIRE(segments[5] == std::string(kFilename) + ".19700101T000320Z");
+        REQUIRE(segments[6] == segments[5] + "-1");
+        REQUIRE(segments[15] == segments[5] + "-10");
+        REQUIRE(archiver.GetSegments() == segments);
+
+        archiver.Archive(segments.back());
+        archiver.Wait();
+
+        REQUIRE(archiver.GetSegments() == std::vector<std::string>(segments.end() - 3, segments.end()));
+    }
+
+    RemoveSegments();
+}
+
+TEST_CASE("log-archiver-compress", "[log-archiver]")
+{
+    std::vector<std::string> segments;
+
+    if (system("command -v gzip > /dev/null 2>&1") != 0)
+    {
+        WARN("gzip is not available, skip the test");
+        return;
+    }
+
+    RemoveSegments();
+
+    {
+        LogArchiver archiver(kFilename, 2, true);
+
+        for (time_t time = 100; time < 103; ++time)
+        {
+            segments.push_back(CreateSegment(archiver, time));
+            archiver.Archive(segments.back());
+        }
+        archiver.Wait();
+
+        // Compressed segments keep their order and are never reused.
+        REQUIRE(archiver.GetSegments() == std::vector<std::string>{segments[1] + ".gz", segments[2] + ".gz"});
+        REQUIRE(archiver.MakeSegmentName(102) == segments[2] + "-1");
+    }
+
+    RemoveSegments();
+}
+
+} // namespace commissioner
+
+} // namespace ot
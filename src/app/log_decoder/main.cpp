@@ -0,0 +1,66 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   The file is the entrance of the decoder of binary commissioner logs.
+ */
+
+#include <fstream>
+#include <iostream>
+
+#include "app/binary_log.hpp"
+
+using namespace ot::commissioner;
+
+int main(int argc, const char *argv[])
+{
+    Error         error;
+    std::ifstream logFile;
+
+    if (argc != 2)
+    {
+        std::cerr << "usage: " << argv[0] << " <binary-log-file>" << std::endl;
+        return -1;
+    }
+
+    logFile.open(argv[1], std::ios::binary);
+    if (!logFile)
+    {
+        std::cerr << "failed to open " << argv[1] << std::endl;
+        return -1;
+    }
+
+    error = DecodeBinaryLog(std::cout, logFile);
+    if (error != ErrorCode::kNone)
+    {
+        std::cerr << "failed to decode " << argv[1] << ": " << error.ToString() << std::endl;
+    }
+
+    return error == ErrorCode::kNone ? 0 : -1;
+}
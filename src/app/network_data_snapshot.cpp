@@ -0,0 +1,518 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the binary network data snapshot.
+ */
+
+#include "app/network_data_snapshot.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "common/error_macros.hpp"
+#include "common/utils.hpp"
+#include "library/dataset_codec.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+namespace {
+
+constexpr uint8_t  kMagic[]        = {'O', 'T', 'N', 'S'};
+constexpr uint16_t kVersion        = 1;
+constexpr size_t   kHeaderLength   = sizeof(kMagic) + sizeof(uint16_t) + sizeof(uint16_t);
+constexpr size_t   kTrailerLength  = sizeof(uint32_t) + sizeof(uint32_t);
+constexpr size_t   kSectionHeadLen = sizeof(uint8_t) + sizeof(uint16_t);
+
+enum class SectionType : uint8_t
+{
+    kActiveDataset       = 1,
+    kPendingDataset      = 2,
+    kCommissionerDataset = 3,
+    kBbrDataset          = 4,
+};
+
+// CRC-32 (IEEE 802.3), @p aCrc is the CRC of the preceding bytes.
+uint32_t Crc32(uint32_t aCrc, const uint8_t *aBuf, size_t aLength)
+{
+    static const std::array<uint32_t, 256> kTable = []() {
+        std::array<uint32_t, 256> table;
+
+        for (uint32_t i = 0; i < table.size(); ++i)
+        {
+            uint32_t crc = i;
+
+            for (int bit = 0; bit < 8; ++bit)
+            {
+                crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : (crc >> 1);
+            }
+            table[i] = crc;
+        }
+        return table;
+    }();
+
+    aCrc = ~aCrc;
+    for (size_t i = 0; i < aLength; ++i)
+    {
+        aCrc = kTable[(aCrc ^ aBuf[i]) & 0xFF] ^ (aCrc >> 8);
+    }
+    return ~aCrc;
+}
+
+template <typename Dataset> Error EncodeSection(ByteArray &aBuf, SectionType aType, const Dataset &aDataset)
+{
+    Error  error;
+    size_t length = dataset::GetEncodedLength(aDataset);
+
+    VerifyOrExit(length <= std::numeric_limits<uint16_t>::max(),
+                 error = ERROR_INVALID_ARGS("dataset of {} bytes is too large", length));
+
+    aBuf.push_back(utils::to_underlying(aType));
+    utils::Encode<uint16_t>(aBuf, static_cast<uint16_t>(length));
+    SuccessOrExit(error = dataset::Encode(aBuf, aDataset));
+
+exit:
+    return error;
+}
+
+template <typename Dataset> Error DecodeSection(Dataset &aDataset, const uint8_t *aBuf, size_t aLength)
+{
+    Error         error;
+    tlv::TlvTable tlvTable;
+
+    SuccessOrExit(error = tlvTable.Parse(aBuf, aLength));
+    SuccessOrExit(error = dataset::Decode(aDataset, tlvTable));
+
+exit:
+    return error;
+}
+
+// Encodes a record into @p aBuf, datasets with no fields are omitted.
+Error EncodeRecord(ByteArray &aBuf, const NetworkData &aNetworkData)
+{
+    Error error;
+
+    aBuf.assign(sizeof(uint32_t), 0);
+
+    if (aNetworkData.mActiveDataset.mPresentFlags != 0)
+    {
+        SuccessOrExit(error = EncodeSection(aBuf, SectionType::kActiveDataset, aNetworkData.mActiveDataset));
+    }
+    if (aNetworkData.mPendingDataset.mPresentFlags != 0)
+    {
+        SuccessOrExit(error = EncodeSection(aBuf, SectionType::kPendingDataset, aNetworkData.mPendingDataset));
+    }
+    if (aNetworkData.mCommDataset.mPresentFlags != 0)
+    {
+        SuccessOrExit(error = EncodeSection(aBuf, SectionType::kCommissionerDataset, aNetworkData.mCommDataset));
+    }
+#if OT_COMM_CONFIG_CCM_ENABLE
+    if (aNetworkData.mBbrDataset.mPresentFlags != 0)
+    {
+        SuccessOrExit(error = EncodeSection(aBuf, SectionType::kBbrDataset, aNetworkData.mBbrDataset));
+    }
+#endif
+
+    VerifyOrExit(aBuf.size() - sizeof(uint32_t) <= std::numeric_limits<uint32_t>::max(),
+                 error = ERROR_INVALID_ARGS("network data of {} bytes is too large", aBuf.size()));
+    {
+        auto length = utils::Encode<uint32_t>(static_cast<uint32_t>(aBuf.size() - sizeof(uint32_t)));
+        std::copy(length.begin(), length.end(), aBuf.begin());
+    }
+
+exit:
+    return error;
+}
+
+Error DecodeRecord(NetworkData &aNetworkData, const uint8_t *aBuf, size_t aLength)
+{
+    Error       error;
+    NetworkData networkData;
+    size_t      offset = 0;
+
+    // A dataset with no fields has no section, it must not be restored with
+    // the fields (e.g. the timestamp) that a default dataset comes with.
+    networkData.mActiveDataset.mPresentFlags  = 0;
+    networkData.mPendingDataset.mPresentFlags = 0;
+    networkData.mCommDataset.mPresentFlags    = 0;
+#if OT_COMM_CONFIG_CCM_ENABLE
+    networkData.mBbrDataset.mPresentFlags = 0;
+#endif
+
+    while (offset < aLength)
+    {
+        SectionType    type;
+        uint16_t       length;
+        const uint8_t *tlvs;
+
+        VerifyOrExit(aLength - offset >= kSectionHeadLen, error = ERROR_BAD_FORMAT("premature end of section"));
+        type   = utils::from_underlying<SectionType>(aBuf[offset]);
+        length = utils::Decode<uint16_t>(aBuf + offset + sizeof(uint8_t), sizeof(uint16_t));
+        tlvs   = aBuf + offset + kSectionHeadLen;
+        offset += kSectionHeadLen;
+
+        VerifyOrExit(aLength - offset >= length, error = ERROR_BAD_FORMAT("premature end of section"));
+        offset += length;
+
+        switch (type)
+        {
+        case SectionType::kActiveDataset:
+            SuccessOrExit(error = DecodeSection(networkData.mActiveDataset, tlvs, length));
+            break;
+        case SectionType::kPendingDataset:
+            SuccessOrExit(error = DecodeSection(networkData.mPendingDataset, tlvs, length));
+            break;
+        case SectionType::kCommissionerDataset:
+            SuccessOrExit(error = DecodeSection(networkData.mCommDataset, tlvs, length));
+            break;
+#if OT_COMM_CONFIG_CCM_ENABLE
+        case SectionType::kBbrDataset:
+            SuccessOrExit(error = DecodeSection(networkData.mBbrDataset, tlvs, length));
+            break;
+#endif
+        default:
+            // Skip sections which are not known by this version.
+            break;
+        }
+    }
+
+    aNetworkData = networkData;
+
+exit:
+    return error;
+}
+
+} // namespace
+
+SnapshotWriter::~SnapshotWriter()
+{
+    Abort();
+}
+
+Error SnapshotWriter::Open(const std::string &aFilename)
+{
+    Error     error;
+    ByteArray header{std::begin(kMagic), std::end(kMagic)};
+
+    // Discard the snapshot being written, if any.
+    Abort();
+
+    mFilename     = aFilename;
+    mTempFilename = aFilename + ".tmp";
+    mCrc          = 0;
+    mCount        = 0;
+
+    mFile = fopen(mTempFilename.c_str(), "wb");
+    VerifyOrExit(mFile != nullptr,
+                 error = ERROR_IO_ERROR("cannot open file '{}', {}", mTempFilename, strerror(errno)));
+
+    utils::Encode<uint16_t>(header, kVersion);
+    utils::Encode<uint16_t>(header, 0);
+    SuccessOrExit(error = WriteBytes(header));
+
+exit:
+    if (error != ErrorCode::kNone)
+    {
+        Abort();
+    }
+    return error;
+}
+
+Error SnapshotWriter::Write(const NetworkData &aNetworkData)
+{
+    Error error;
+
+    VerifyOrExit(mFile != nullptr, error = ERROR_INVALID_STATE("the snapshot writer is not open"));
+    VerifyOrExit(mCount < std::numeric_limits<uint32_t>::max(),
+                 error = ERROR_INVALID_STATE("too many network data in the snapshot"));
+
+    // A record in bad format is not written and the snapshot is still good.
+    SuccessOrExit(error = EncodeRecord(mBuf, aNetworkData));
+    SuccessOrExit(error = WriteBytes(mBuf));
+    ++mCount;
+
+exit:
+    return error;
+}
+
+Error SnapshotWriter::Close()
+{
+    Error     error;
+    ByteArray trailer;
+
+    VerifyOrExit(mFile != nullptr, error = ERROR_INVALID_STATE("the snapshot writer is not open"));
+
+    utils::Encode<uint32_t>(trailer, mCount);
+    SuccessOrExit(error = WriteBytes(trailer));
+    SuccessOrExit(error = WriteBytes(utils::Encode<uint32_t>(mCrc)));
+
+    VerifyOrExit(fclose(mFile) == 0,
+                 error = ERROR_IO_ERROR("cannot write file '{}', {}", mTempFilename, strerror(errno)));
+    mFile = nullptr;
+
+    VerifyOrExit(rename(mTempFilename.c_str(), mFilename.c_str()) == 0,
+                 error = ERROR_IO_ERROR("cannot rename file '{}', {}", mTempFilename, strerror(errno)));
+    mTempFilename.clear();
+    mFilename.clear();
+
+exit:
+    if (error != ErrorCode::kNone)
+    {
+        Abort();
+    }
+    return error;
+}
+
+Error SnapshotWriter::WriteBytes(const ByteArray &aBuf)
+{
+    Error error;
+
+    VerifyOrExit(fwrite(aBuf.data(), 1, aBuf.size(), mFile) == aBuf.size(),
+                 error = ERROR_IO_ERROR("cannot write file '{}', {}", mTempFilename, strerror(errno)));
+    mCrc = Crc32(mCrc, aBuf.data(), aBuf.size());
+
+exit:
+    if (error != ErrorCode::kNone)
+    {
+        Abort();
+    }
+    return error;
+}
+
+void SnapshotWriter::Abort()
+{
+    if (mFile != nullptr)
+    {
+        fclose(mFile);
+        mFile = nullptr;
+    }
+    if (!mTempFilename.empty())
+    {
+        remove(mTempFilename.c_str());
+        mTempFilename.clear();
+    }
+    mFilename.clear();
+}
+
+SnapshotReader::~SnapshotReader()
+{
+    Close();
+}
+
+Error SnapshotReader::Open(const std::string &aFilename)
+{
+    Error       error;
+    int         fd;
+    struct stat fileStat;
+
+    Close();
+
+    fd = open(aFilename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        if (errno == ENOENT)
+        {
+            ExitNow(error = ERROR_NOT_FOUND("cannot open file '{}', {}", aFilename, strerror(errno)));
+        }
+        else
+        {
+            ExitNow(error = ERROR_IO_ERROR("cannot open file '{}', {}", aFilename, strerror(errno)));
+        }
+    }
+
+    VerifyOrExit(fstat(fd, &fileStat) == 0,
+                 error = ERROR_IO_ERROR("cannot stat file '{}', {}", aFilename, strerror(errno)));
+    VerifyOrExit(static_cast<size_t>(fileStat.st_size) >= kHeaderLength + kTrailerLength,
+                 error = ERROR_BAD_FORMAT("snapshot '{}' is truncated", aFilename));
+
+    mLength = fileStat.st_size;
+    mMap    = mmap(nullptr, mLength, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mMap == MAP_FAILED)
+    {
+        mMap = nullptr;
+        ExitNow(error = ERROR_IO_ERROR("cannot map file '{}', {}", aFilename, strerror(errno)));
+    }
+
+    // Records are decoded in order, this is only a hint.
+    madvise(mMap, mLength, MADV_SEQUENTIAL);
+
+    SuccessOrExit(error = Verify());
+
+exit:
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    if (error != ErrorCode::kNone)
+    {
+        Close();
+    }
+    return error;
+}
+
+void SnapshotReader::Close()
+{
+    if (mMap != nullptr)
+    {
+        munmap(mMap, mLength);
+        mMap = nullptr;
+    }
+    mLength = 0;
+    mCursor = nullptr;
+    mEnd    = nullptr;
+    mCount  = 0;
+}
+
+Error SnapshotReader::Verify()
+{
+    Error          error;
+    const uint8_t *begin   = static_cast<const uint8_t *>(mMap);
+    const uint8_t *trailer = begin + mLength - kTrailerLength;
+    const uint8_t *record  = begin + kHeaderLength;
+    uint16_t       version;
+    uint32_t       count = 0;
+
+    VerifyOrExit(std::equal(std::begin(kMagic), std::end(kMagic), begin),
+                 error = ERROR_BAD_FORMAT("not a network data snapshot"));
+
+    version = utils::Decode<uint16_t>(begin + sizeof(kMagic), sizeof(uint16_t));
+    VerifyOrExit(version == kVersion, error = ERROR_BAD_FORMAT("snapshot version {} is not supported", version));
+
+    VerifyOrExit(Crc32(0, begin, mLength - sizeof(uint32_t)) ==
+                     utils::Decode<uint32_t>(trailer + sizeof(uint32_t), sizeof(uint32_t)),
+                 error = ERROR_BAD_FORMAT("snapshot checksum mismatch"));
+
+    // Walk through the records so that Read() never goes out of bounds.
+    while (record < trailer)
+    {
+        uint32_t length;
+
+        VerifyOrExit(static_cast<size_t>(trailer - record) >= sizeof(uint32_t),
+                     error = ERROR_BAD_FORMAT("premature end of record"));
+        length = utils::Decode<uint32_t>(record, sizeof(uint32_t));
+        record += sizeof(uint32_t);
+
+        VerifyOrExit(static_cast<size_t>(trailer - record) >= length,
+                     error = ERROR_BAD_FORMAT("premature end of record"));
+        record += length;
+        ++count;
+    }
+
+    VerifyOrExit(count == utils::Decode<uint32_t>(trailer, sizeof(uint32_t)),
+                 error = ERROR_BAD_FORMAT("snapshot record count mismatch"));
+
+    mCursor = begin + kHeaderLength;
+    mEnd    = trailer;
+    mCount  = count;
+
+exit:
+    return error;
+}
+
+Error SnapshotReader::Read(NetworkData &aNetworkData)
+{
+    Error    error;
+    uint32_t length = 0;
+
+    VerifyOrExit(mMap != nullptr, error = ERROR_INVALID_STATE("the snapshot reader is not open"));
+    VerifyOrExit(mCursor < mEnd, error = ERROR_NOT_FOUND("no more network data in the snapshot"));
+
+    length = utils::Decode<uint32_t>(mCursor, sizeof(uint32_t));
+    SuccessOrExit(error = DecodeRecord(aNetworkData, mCursor + sizeof(uint32_t), length));
+
+exit:
+    // Skip the record even if it is in bad format.
+    if (mCursor < mEnd)
+    {
+        mCursor += sizeof(uint32_t) + length;
+    }
+    return error;
+}
+
+Error WriteSnapshot(const std::vector<NetworkData> &aNetworkDataList, const std::string &aFilename)
+{
+    Error          error;
+    SnapshotWriter writer;
+
+    SuccessOrExit(error = writer.Open(aFilename));
+    for (const auto &networkData : aNetworkDataList)
+    {
+        SuccessOrExit(error = writer.Write(networkData));
+    }
+    SuccessOrExit(error = writer.Close());
+
+exit:
+    return error;
+}
+
+Error ReadSnapshot(std::vector<NetworkData> &aNetworkDataList, const std::string &aFilename)
+{
+    Error                    error;
+    SnapshotReader           reader;
+    std::vector<NetworkData> networkDataList;
+
+    SuccessOrExit(error = reader.Open(aFilename));
+
+    networkDataList.resize(reader.GetCount());
+    for (auto &networkData : networkDataList)
+    {
+        SuccessOrExit(error = reader.Read(networkData));
+    }
+
+    aNetworkDataList = std::move(networkDataList);
+
+exit:
+    return error;
+}
+
+Error SnapshotToJson(std::string &aJson, const std::string &aFilename)
+{
+    Error                    error;
+    std::vector<NetworkData> networkDataList;
+
+    SuccessOrExit(error = ReadSnapshot(networkDataList, aFilename));
+    aJson = NetworkDataListToJson(networkDataList);
+
+exit:
+    return error;
+}
+
+} // namespace commissioner
+
+} // namespace ot
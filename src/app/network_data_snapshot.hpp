@@ -0,0 +1,133 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions of the binary network data snapshot.
+ */
+
+#ifndef OT_COMM_APP_NETWORK_DATA_SNAPSHOT_HPP_
+#define OT_COMM_APP_NETWORK_DATA_SNAPSHOT_HPP_
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include <commissioner/error.hpp>
+
+#include "app/json.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+// A snapshot is a compact and versioned binary file of a list of network
+// data, it is much faster to write and load than JSON. Each dataset is
+// stored in its MeshCoP TLV encoding, which is what the Thread network
+// gives to and takes from the commissioner.
+//
+// All integers are in network byte order:
+//
+//   Header:  'O' 'T' 'N' 'S' | version (2) | reserved (2)
+//   Record:  record length (4) | section...
+//   Section: dataset type (1) | TLVs length (2) | TLVs
+//   Trailer: record count (4) | CRC-32 of all preceding bytes (4)
+//
+// Sections of unknown dataset types are skipped by the reader.
+
+// Streams network data into a snapshot file. The snapshot is written to
+// a temporary file which replaces the target file only when the writer
+// is successfully closed, so a partially written snapshot is never seen.
+class SnapshotWriter
+{
+public:
+    SnapshotWriter() = default;
+    ~SnapshotWriter();
+
+    SnapshotWriter(const SnapshotWriter &) = delete;
+    SnapshotWriter &operator=(const SnapshotWriter &) = delete;
+
+    Error Open(const std::string &aFilename);
+    Error Write(const NetworkData &aNetworkData);
+    Error Close();
+
+private:
+    Error WriteBytes(const ByteArray &aBuf);
+    void  Abort();
+
+    FILE *      mFile = nullptr;
+    std::string mFilename;
+    std::string mTempFilename;
+    uint32_t    mCrc   = 0;
+    uint32_t    mCount = 0;
+    ByteArray   mBuf;
+};
+
+// Reads network data from a snapshot file which is memory-mapped. The
+// header and checksum are verified when the snapshot is opened, records
+// are decoded one by one straight from the mapped memory.
+class SnapshotReader
+{
+public:
+    SnapshotReader() = default;
+    ~SnapshotReader();
+
+    SnapshotReader(const SnapshotReader &) = delete;
+    SnapshotReader &operator=(const SnapshotReader &) = delete;
+
+    Error Open(const std::string &aFilename);
+    void  Close();
+
+    uint32_t GetCount() const { return mCount; }
+
+    // Reads the next record, returns ERROR_NOT_FOUND if no more records.
+    Error Read(NetworkData &aNetworkData);
+
+private:
+    Error Verify();
+
+    void *         mMap    = nullptr;
+    size_t         mLength = 0;
+    const uint8_t *mCursor = nullptr;
+    const uint8_t *mEnd    = nullptr;
+    uint32_t       mCount  = 0;
+};
+
+Error WriteSnapshot(const std::vector<NetworkData> &aNetworkDataList, const std::string &aFilename);
+Error ReadSnapshot(std::vector<NetworkData> &aNetworkDataList, const std::string &aFilename);
+
+// Exports a snapshot file to a JSON list of network data, the format
+// of `NetworkDataListToJson` which `NetworkDataListFromJson` reads.
+Error SnapshotToJson(std::string &aJson, const std::string &aFilename);
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_APP_NETWORK_DATA_SNAPSHOT_HPP_
@@ -0,0 +1,214 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases for the binary network data snapshot.
+ */
+
+#include "app/network_data_snapshot.hpp"
+
+#include <stdio.h>
+
+#include <catch2/catch.hpp>
+
+namespace ot {
+
+namespace commissioner {
+
+static NetworkData MakeNetworkData(uint16_t aPanId, const std::string &aNetworkName)
+{
+    NetworkData networkData;
+
+    networkData.mActiveDataset.mActiveTimestamp = {1, 0, 0};
+    networkData.mActiveDataset.mChannel         = {0, 11};
+    networkData.mActiveDataset.mChannelMask     = {{0, {0x07, 0xFF, 0xF8, 0x00}}};
+    networkData.mActiveDataset.mExtendedPanId   = {0xDE, 0xAD, 0x00, 0xBE, 0xEF, 0x00, 0xCA, 0xFE};
+    networkData.mActiveDataset.mNetworkName     = aNetworkName;
+    networkData.mActiveDataset.mPanId           = aPanId;
+    networkData.mActiveDataset.mPresentFlags =
+        ActiveOperationalDataset::kActiveTimestampBit | ActiveOperationalDataset::kChannelBit |
+        ActiveOperationalDataset::kChannelMaskBit | ActiveOperationalDataset::kExtendedPanIdBit |
+        ActiveOperationalDataset::kNetworkNameBit | ActiveOperationalDataset::kPanIdBit;
+
+    networkData.mPendingDataset.mPendingTimestamp = {2, 0, 0};
+    networkData.mPendingDataset.mDelayTimer       = 30000;
+    networkData.mPendingDataset.mPresentFlags =
+        PendingOperationalDataset::kPendingTimestampBit | PendingOperationalDataset::kDelayTimerBit;
+
+    networkData.mCommDataset.mSessionId = 0x1234;
+    networkData.mCommDataset.mPresentFlags |= CommissionerDataset::kSessionIdBit;
+
+    return networkData;
+}
+
+TEST_CASE("network-data-snapshot-write-read", "[snapshot]")
+{
+    const std::string        kFilename = "network_data_snapshot_test.bin";
+    std::vector<NetworkData> networkDataList;
+
+    for (uint16_t i = 0; i < 100; ++i)
+    {
+        networkDataList.emplace_back(MakeNetworkData(i, "OpenThread-" + std::to_string(i)));
+    }
+    networkDataList.emplace_back();
+
+    REQUIRE(WriteSnapshot(networkDataList, kFilename) == ErrorCode::kNone);
+
+    SECTION("all network data are restored")
+    {
+        std::vector<NetworkData> restored;
+
+        REQUIRE(ReadSnapshot(restored, kFilename) == ErrorCode::kNone);
+        REQUIRE(restored.size() == networkDataList.size());
+
+        // The last network data has only default fields.
+        REQUIRE(restored.back().mActiveDataset.mPresentFlags == NetworkData{}.mActiveDataset.mPresentFlags);
+        REQUIRE(restored.back().mPendingDataset.mPresentFlags == NetworkData{}.mPendingDataset.mPresentFlags);
+        REQUIRE(restored.back().mCommDataset.mPresentFlags == 0);
+
+        for (size_t i = 0; i + 1 < networkDataList.size(); ++i)
+        {
+            const auto &active = restored[i].mActiveDataset;
+
+            REQUIRE(active.mPresentFlags == networkDataList[i].mActiveDataset.mPresentFlags);
+            REQUIRE(active.mNetworkName == networkDataList[i].mActiveDataset.mNetworkName);
+            REQUIRE(active.mPanId == networkDataList[i].mActiveDataset.mPanId);
+            REQUIRE(active.mExtendedPanId == networkDataList[i].mActiveDataset.mExtendedPanId);
+            REQUIRE(restored[i].mPendingDataset.mPresentFlags == networkDataList[i].mPendingDataset.mPresentFlags);
+            REQUIRE(restored[i].mPendingDataset.mDelayTimer == networkDataList[i].mPendingDataset.mDelayTimer);
+            REQUIRE(restored[i].mCommDataset.mPresentFlags == networkDataList[i].mCommDataset.mPresentFlags);
+            REQUIRE(restored[i].mCommDataset.mSessionId == networkDataList[i].mCommDataset.mSessionId);
+        }
+    }
+
+    SECTION("reader stops at the end of the snapshot")
+    {
+        SnapshotReader reader;
+        NetworkData    networkData;
+
+        REQUIRE(reader.Open(kFilename) == ErrorCode::kNone);
+        REQUIRE(reader.GetCount() == networkDataList.size());
+
+        for (size_t i = 0; i < networkDataList.size(); ++i)
+        {
+            REQUIRE(reader.Read(networkData) == ErrorCode::kNone);
+        }
+        REQUIRE(reader.Read(networkData) == ErrorCode::kNotFound);
+    }
+
+    SECTION("corrupted snapshot is rejected")
+    {
+        SnapshotReader reader;
+        FILE *         file = fopen(kFilename.c_str(), "r+b");
+
+        REQUIRE(file != nullptr);
+        REQUIRE(fseek(file, 100, SEEK_SET) == 0);
+        REQUIRE(fputc(0xFF, file) != EOF);
+        REQUIRE(fclose(file) == 0);
+
+        REQUIRE(reader.Open(kFilename) == ErrorCode::kBadFormat);
+    }
+
+    SECTION("truncated snapshot is rejected")
+    {
+        SnapshotReader reader;
+        FILE *         file = fopen(kFilename.c_str(), "wb");
+
+        REQUIRE(file != nullptr);
+        REQUIRE(fputs("OTNS", file) != EOF);
+        REQUIRE(fclose(file) == 0);
+
+        REQUIRE(reader.Open(kFilename) == ErrorCode::kBadFormat);
+    }
+
+    REQUIRE(remove(kFilename.c_str()) == 0);
+}
+
+TEST_CASE("network-data-snapshot-empty-datasets", "[snapshot]")
+{
+    const std::string        kFilename = "network_data_snapshot_test_empty.bin";
+    NetworkData              networkData;
+    std::vector<NetworkData> restored;
+
+    // Default datasets come with a timestamp, which is not in the network.
+    networkData.mActiveDataset.mPresentFlags  = 0;
+    networkData.mPendingDataset.mPresentFlags = 0;
+
+    REQUIRE(WriteSnapshot({networkData}, kFilename) == ErrorCode::kNone);
+    REQUIRE(ReadSnapshot(restored, kFilename) == ErrorCode::kNone);
+    REQUIRE(restored.size() == 1);
+
+    REQUIRE(restored[0].mActiveDataset.mPresentFlags == 0);
+    REQUIRE(restored[0].mPendingDataset.mPresentFlags == 0);
+    REQUIRE(restored[0].mCommDataset.mPresentFlags == 0);
+
+    REQUIRE(remove(kFilename.c_str()) == 0);
+}
+
+TEST_CASE("network-data-snapshot-export-json", "[snapshot]")
+{
+    const std::string        kFilename   = "network_data_snapshot_test_export.bin";
+    NetworkData              networkData = MakeNetworkData(0xFACE, "OpenThread");
+    std::string              json;
+    std::vector<NetworkData> restored;
+
+    REQUIRE(WriteSnapshot({networkData}, kFilename) == ErrorCode::kNone);
+    REQUIRE(SnapshotToJson(json, kFilename) == ErrorCode::kNone);
+
+    // The exported JSON is the same as what `network save` writes.
+    REQUIRE(json == NetworkDataListToJson({networkData}));
+
+    REQUIRE(NetworkDataListFromJson(restored, json) == ErrorCode::kNone);
+    REQUIRE(restored.size() == 1);
+    REQUIRE(restored[0].mActiveDataset.mPresentFlags == networkData.mActiveDataset.mPresentFlags);
+    REQUIRE(restored[0].mActiveDataset.mNetworkName == "OpenThread");
+    REQUIRE(restored[0].mActiveDataset.mPanId == 0xFACE);
+    REQUIRE(restored[0].mPendingDataset.mDelayTimer == networkData.mPendingDataset.mDelayTimer);
+
+    REQUIRE(remove(kFilename.c_str()) == 0);
+}
+
+TEST_CASE("network-data-snapshot-writer-not-closed", "[snapshot]")
+{
+    const std::string kFilename = "network_data_snapshot_test_aborted.bin";
+    SnapshotReader    reader;
+
+    {
+        SnapshotWriter writer;
+
+        REQUIRE(writer.Open(kFilename) == ErrorCode::kNone);
+        REQUIRE(writer.Write(MakeNetworkData(0xFACE, "OpenThread")) == ErrorCode::kNone);
+    }
+
+    REQUIRE(reader.Open(kFilename) == ErrorCode::kNotFound);
+}
+
+} // namespace commissioner
+
+} // namespace ot
@@ -0,0 +1,113 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes helpers of benchmark test cases.
+ *
+ *   Benchmarks are tagged with "[.benchmark]", which hides them by
+ *   default. Run them with `commissioner-test "[.benchmark]"`.
+ */
+
+#ifndef OT_COMM_COMMON_BENCHMARK_HPP_
+#define OT_COMM_COMMON_BENCHMARK_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace ot {
+
+namespace commissioner {
+
+namespace benchmark {
+
+using Clock = std::chrono::steady_clock;
+
+// Returns the time taken by a call of @p aFunc.
+template <typename Func> std::chrono::nanoseconds Measure(Func &&aFunc)
+{
+    auto begin = Clock::now();
+
+    aFunc();
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin);
+}
+
+// Returns the time taken by @p aCount calls of @p aFunc.
+template <typename Func> std::chrono::nanoseconds Measure(size_t aCount, Func &&aFunc)
+{
+    return Measure([aCount, &aFunc]() {
+        for (size_t i = 0; i < aCount; ++i)
+        {
+            aFunc();
+        }
+    });
+}
+
+// Returns the number of @p aCount operations done per second in @p aElapsed.
+inline double PerSecond(size_t aCount, std::chrono::nanoseconds aElapsed)
+{
+    return aCount * 1e9 / std::max<int64_t>(aElapsed.count(), 1);
+}
+
+// Returns the mean time taken by a call of @p aFunc, measured by @p aCount calls.
+template <typename Func> std::chrono::nanoseconds MeasureMean(size_t aCount, Func &&aFunc)
+{
+    return Measure(aCount, aFunc) / std::max<size_t>(aCount, 1);
+}
+
+// Returns the number of calls of @p aFunc per second, measured by @p aCount calls.
+template <typename Func> double MeasureRate(size_t aCount, Func &&aFunc)
+{
+    return PerSecond(aCount, Measure(aCount, aFunc));
+}
+
+// Returns the number of allocations with operator new by the test program
+// so far. Allocations with malloc(), such as the nodes of cn-cbor, are not
+// counted.
+size_t GetAllocationCount();
+
+// Returns the number of allocations with operator new by a call of @p aFunc.
+template <typename Func> size_t CountAllocations(Func &&aFunc)
+{
+    size_t begin = GetAllocationCount();
+
+    aFunc();
+
+    return GetAllocationCount() - begin;
+}
+
+} // namespace benchmark
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_COMMON_BENCHMARK_HPP_
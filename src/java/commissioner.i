@@ -98,6 +98,7 @@
 
 %template(ChannelMask) std::vector<ot::commissioner::ChannelMaskEntry>;
 %template(StringVector) std::vector<std::string>;
+%template(BorderAgentAddrVector) std::vector<ot::commissioner::BorderAgentAddr>;
 
 %typemap(jstype) std::string& OUTPUT "String[]"
 %typemap(jtype)  std::string& OUTPUT "String[]"
@@ -128,6 +129,7 @@ namespace ot {
 namespace commissioner {
     // Remove async commissioner APIs.
     %ignore Commissioner::Connect(ErrorHandler aHandler, const std::string &aAddr, uint16_t aPort);
+    %ignore Commissioner::Connect(Handler<ConnectResult> aHandler, const std::vector<BorderAgentAddr> &aBorderAgents);
     %ignore Commissioner::Petition(PetitionHandler aHandler, const std::string &aAddr, uint16_t aPort);
     %ignore Commissioner::Resign(ErrorHandler aHandler);
     %ignore Commissioner::GetCommissionerDataset(Handler<CommissionerDataset> aHandler, uint16_t aDatasetFlags);
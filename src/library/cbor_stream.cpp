@@ -0,0 +1,374 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the streaming CBOR writer and reader.
+ */
+
+#include "library/cbor_stream.hpp"
+
+#include <string.h>
+
+#include "common/error_macros.hpp"
+#include "common/utils.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+// The major types of CBOR data items (RFC 7049, 2.1).
+static constexpr uint8_t kMajorTypeUnsigned = 0;
+static constexpr uint8_t kMajorTypeNegative = 1;
+static constexpr uint8_t kMajorTypeBytes    = 2;
+static constexpr uint8_t kMajorTypeText     = 3;
+static constexpr uint8_t kMajorTypeArray    = 4;
+static constexpr uint8_t kMajorTypeMap      = 5;
+static constexpr uint8_t kMajorTypeTag      = 6;
+static constexpr uint8_t kMajorTypeSimple   = 7;
+
+// The additional information of a head with the argument in following bytes.
+static constexpr uint8_t kAdditionalInfoOneByte    = 24;
+static constexpr uint8_t kAdditionalInfoEightBytes = 27;
+
+constexpr size_t CborReader::kMaxNestingDepth;
+
+CborWriter::CborWriter(uint8_t *aBuf, size_t aMaxLength)
+    : mBuf(aBuf)
+    , mMaxLength(aMaxLength)
+    , mLength(0)
+{
+}
+
+Error CborWriter::WriteInt(int64_t aValue)
+{
+    if (aValue < 0)
+    {
+        return WriteHead(kMajorTypeNegative, static_cast<uint64_t>(-1 - aValue));
+    }
+
+    return WriteHead(kMajorTypeUnsigned, static_cast<uint64_t>(aValue));
+}
+
+Error CborWriter::WriteBytes(const uint8_t *aBytes, size_t aLength)
+{
+    Error  error;
+    size_t length = mLength;
+
+    SuccessOrExit(error = WriteHead(kMajorTypeBytes, aLength));
+    SuccessOrExit(error = Write(aBytes, aLength));
+
+exit:
+    if (error != ErrorCode::kNone)
+    {
+        // Never leave a partial item.
+        mLength = length;
+    }
+    return error;
+}
+
+Error CborWriter::WriteText(const char *aStr, size_t aLength)
+{
+    Error  error;
+    size_t length = mLength;
+
+    SuccessOrExit(error = WriteHead(kMajorTypeText, aLength));
+    SuccessOrExit(error = Write(aStr, aLength));
+
+exit:
+    if (error != ErrorCode::kNone)
+    {
+        // Never leave a partial item.
+        mLength = length;
+    }
+    return error;
+}
+
+Error CborWriter::WriteArray(size_t aCount)
+{
+    return WriteHead(kMajorTypeArray, aCount);
+}
+
+Error CborWriter::WriteMap(size_t aCount)
+{
+    return WriteHead(kMajorTypeMap, aCount);
+}
+
+Error CborWriter::WriteTag(uint64_t aTag)
+{
+    return WriteHead(kMajorTypeTag, aTag);
+}
+
+Error CborWriter::WriteHead(uint8_t aMajorType, uint64_t aArgument)
+{
+    uint8_t head[1 + sizeof(uint64_t)];
+    size_t  length;
+
+    // The argument is encoded in the shortest form.
+    if (aArgument < kAdditionalInfoOneByte)
+    {
+        head[0] = static_cast<uint8_t>(aArgument);
+        length  = 0;
+    }
+    else if (aArgument <= UINT8_MAX)
+    {
+        head[0] = kAdditionalInfoOneByte;
+        length  = 1;
+    }
+    else if (aArgument <= UINT16_MAX)
+    {
+        head[0] = kAdditionalInfoOneByte + 1;
+        length  = 2;
+    }
+    else if (aArgument <= UINT32_MAX)
+    {
+        head[0] = kAdditionalInfoOneByte + 2;
+        length  = 4;
+    }
+    else
+    {
+        head[0] = kAdditionalInfoEightBytes;
+        length  = 8;
+    }
+
+    head[0] |= static_cast<uint8_t>(aMajorType << 5);
+    for (size_t i = 0; i < length; ++i)
+    {
+        head[1 + i] = static_cast<uint8_t>(aArgument >> ((length - 1 - i) * 8));
+    }
+
+    return Write(head, 1 + length);
+}
+
+Error CborWriter::Write(const void *aData, size_t aLength)
+{
+    if (aLength > mMaxLength - mLength)
+    {
+        return ERROR_OUT_OF_MEMORY("CBOR buffer of {} bytes is too small", mMaxLength);
+    }
+
+    if (aLength > 0)
+    {
+        memcpy(mBuf + mLength, aData, aLength);
+        mLength += aLength;
+    }
+
+    return ERROR_NONE;
+}
+
+CborReader::CborReader(const uint8_t *aBuf, size_t aLength)
+    : mBuf(aBuf)
+    , mLength(aLength)
+    , mOffset(0)
+{
+}
+
+Error CborReader::ReadInt(int64_t &aValue)
+{
+    Error    error;
+    uint8_t  majorType;
+    uint64_t argument;
+
+    SuccessOrExit(error = ReadHead(majorType, argument));
+    VerifyOrExit(majorType == kMajorTypeUnsigned || majorType == kMajorTypeNegative,
+                 error = ERROR_BAD_FORMAT("expect a CBOR integer, but got major type {}", majorType));
+    VerifyOrExit(argument <= static_cast<uint64_t>(INT64_MAX),
+                 error = ERROR_BAD_FORMAT("CBOR integer is out of range"));
+
+    aValue = majorType == kMajorTypeUnsigned ? static_cast<int64_t>(argument) : -1 - static_cast<int64_t>(argument);
+
+exit:
+    return error;
+}
+
+Error CborReader::ReadBytes(const uint8_t *&aBytes, size_t &aLength)
+{
+    return ReadString(kMajorTypeBytes, aBytes, aLength);
+}
+
+Error CborReader::ReadText(const char *&aStr, size_t &aLength)
+{
+    Error          error;
+    const uint8_t *str;
+
+    SuccessOrExit(error = ReadString(kMajorTypeText, str, aLength));
+    aStr = reinterpret_cast<const char *>(str);
+
+exit:
+    return error;
+}
+
+Error CborReader::ReadArray(size_t &aCount)
+{
+    Error    error;
+    uint64_t count;
+
+    SuccessOrExit(error = ReadHeadOfType(kMajorTypeArray, count));
+
+    // Each element takes at least one byte.
+    VerifyOrExit(count <= mLength - mOffset, error = ERROR_BAD_FORMAT("truncated CBOR array"));
+    aCount = static_cast<size_t>(count);
+
+exit:
+    return error;
+}
+
+Error CborReader::ReadMap(size_t &aCount)
+{
+    Error    error;
+    uint64_t count;
+
+    SuccessOrExit(error = ReadHeadOfType(kMajorTypeMap, count));
+
+    // Each key and value takes at least one byte.
+    VerifyOrExit(count <= (mLength - mOffset) / 2, error = ERROR_BAD_FORMAT("truncated CBOR map"));
+    aCount = static_cast<size_t>(count);
+
+exit:
+    return error;
+}
+
+Error CborReader::ReadTag(uint64_t &aTag)
+{
+    return ReadHeadOfType(kMajorTypeTag, aTag);
+}
+
+Error CborReader::Skip()
+{
+    return Skip(0);
+}
+
+Error CborReader::ReadHead(uint8_t &aMajorType, uint64_t &aArgument)
+{
+    Error   error;
+    uint8_t additionalInfo;
+    size_t  length;
+
+    VerifyOrExit(mOffset < mLength, error = ERROR_BAD_FORMAT("truncated CBOR data item"));
+
+    aMajorType     = mBuf[mOffset] >> 5;
+    additionalInfo = mBuf[mOffset] & 0x1f;
+    ++mOffset;
+
+    if (additionalInfo < kAdditionalInfoOneByte)
+    {
+        aArgument = additionalInfo;
+        ExitNow();
+    }
+
+    VerifyOrExit(additionalInfo <= kAdditionalInfoEightBytes,
+                 error = ERROR_BAD_FORMAT("indefinite-length or reserved CBOR data item"));
+
+    length = size_t{1} << (additionalInfo - kAdditionalInfoOneByte);
+    VerifyOrExit(length <= mLength - mOffset, error = ERROR_BAD_FORMAT("truncated CBOR data item"));
+
+    aArgument = 0;
+    while (length-- > 0)
+    {
+        aArgument = (aArgument << 8) | mBuf[mOffset++];
+    }
+
+exit:
+    return error;
+}
+
+Error CborReader::ReadHeadOfType(uint8_t aMajorType, uint64_t &aArgument)
+{
+    Error   error;
+    uint8_t majorType;
+
+    SuccessOrExit(error = ReadHead(majorType, aArgument));
+    VerifyOrExit(majorType == aMajorType,
+                 error = ERROR_BAD_FORMAT("expect CBOR major type {}, but got {}", aMajorType, majorType));
+
+exit:
+    return error;
+}
+
+Error CborReader::ReadString(uint8_t aMajorType, const uint8_t *&aData, size_t &aLength)
+{
+    Error    error;
+    uint64_t length;
+
+    SuccessOrExit(error = ReadHeadOfType(aMajorType, length));
+    VerifyOrExit(length <= mLength - mOffset, error = ERROR_BAD_FORMAT("truncated CBOR string"));
+
+    aData   = mBuf + mOffset;
+    aLength = static_cast<size_t>(length);
+    mOffset += aLength;
+
+exit:
+    return error;
+}
+
+Error CborReader::Skip(size_t aDepth)
+{
+    Error    error;
+    uint8_t  majorType;
+    uint64_t argument;
+    uint64_t count = 0;
+
+    VerifyOrExit(aDepth < kMaxNestingDepth, error = ERROR_BAD_FORMAT("CBOR data item is nested too deep"));
+    SuccessOrExit(error = ReadHead(majorType, argument));
+
+    switch (majorType)
+    {
+    case kMajorTypeBytes:
+    case kMajorTypeText:
+        VerifyOrExit(argument <= mLength - mOffset, error = ERROR_BAD_FORMAT("truncated CBOR string"));
+        mOffset += static_cast<size_t>(argument);
+        break;
+    case kMajorTypeArray:
+        count = argument;
+        break;
+    case kMajorTypeMap:
+        VerifyOrExit(argument <= (mLength - mOffset) / 2, error = ERROR_BAD_FORMAT("truncated CBOR map"));
+        count = argument * 2;
+        break;
+    case kMajorTypeTag:
+        count = 1;
+        break;
+    case kMajorTypeUnsigned:
+    case kMajorTypeNegative:
+    case kMajorTypeSimple:
+    default:
+        break;
+    }
+
+    while (count-- > 0)
+    {
+        SuccessOrExit(error = Skip(aDepth + 1));
+    }
+
+exit:
+    return error;
+}
+
+} // namespace commissioner
+
+} // namespace ot
@@ -0,0 +1,118 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions of the streaming CBOR writer and reader.
+ *   Ref: https://tools.ietf.org/html/rfc7049
+ */
+
+#ifndef OT_COMM_LIBRARY_CBOR_STREAM_HPP_
+#define OT_COMM_LIBRARY_CBOR_STREAM_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+
+#include <commissioner/defines.hpp>
+#include <commissioner/error.hpp>
+
+namespace ot {
+
+namespace commissioner {
+
+// Writes CBOR data items to a caller-supplied buffer without any allocation.
+// Arrays and maps are of definite length: the head with the number of
+// elements is written first, followed by the elements (or key-value pairs
+// for a map) written by the caller.
+class CborWriter
+{
+public:
+    CborWriter(uint8_t *aBuf, size_t aMaxLength);
+
+    Error WriteInt(int64_t aValue);
+    Error WriteBytes(const uint8_t *aBytes, size_t aLength);
+    Error WriteBytes(const ByteArray &aBytes) { return WriteBytes(aBytes.data(), aBytes.size()); }
+    Error WriteText(const char *aStr, size_t aLength);
+    Error WriteText(const std::string &aStr) { return WriteText(aStr.data(), aStr.size()); }
+    Error WriteArray(size_t aCount);
+    Error WriteMap(size_t aCount);
+    Error WriteTag(uint64_t aTag);
+
+    // The number of bytes written.
+    size_t GetLength() const { return mLength; }
+
+private:
+    Error WriteHead(uint8_t aMajorType, uint64_t aArgument);
+    Error Write(const void *aData, size_t aLength);
+
+    uint8_t *    mBuf;
+    const size_t mMaxLength;
+    size_t       mLength;
+};
+
+// Reads CBOR data items in place from a caller-supplied buffer without
+// any allocation. Byte and text strings are returned as pointers into the
+// buffer. Indefinite-length items are rejected.
+class CborReader
+{
+public:
+    CborReader(const uint8_t *aBuf, size_t aLength);
+
+    Error ReadInt(int64_t &aValue);
+    Error ReadBytes(const uint8_t *&aBytes, size_t &aLength);
+    Error ReadText(const char *&aStr, size_t &aLength);
+    Error ReadArray(size_t &aCount);
+    Error ReadMap(size_t &aCount);
+    Error ReadTag(uint64_t &aTag);
+
+    // Skip the next data item, including all nested items.
+    Error Skip();
+
+    bool IsEnd() const { return mOffset == mLength; }
+
+private:
+    // The max nesting depth of arrays, maps and tags to be skipped.
+    static constexpr size_t kMaxNestingDepth = 16;
+
+    Error ReadHead(uint8_t &aMajorType, uint64_t &aArgument);
+    Error ReadHeadOfType(uint8_t aMajorType, uint64_t &aArgument);
+    Error ReadString(uint8_t aMajorType, const uint8_t *&aData, size_t &aLength);
+    Error Skip(size_t aDepth);
+
+    const uint8_t *mBuf;
+    size_t         mLength;
+    size_t         mOffset;
+};
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_LIBRARY_CBOR_STREAM_HPP_
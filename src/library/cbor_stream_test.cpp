@@ -0,0 +1,283 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases of the streaming CBOR writer and reader.
+ */
+
+#include "library/cbor_stream.hpp"
+
+#include <functional>
+
+#include <catch2/catch.hpp>
+
+#include "common/benchmark.hpp"
+#include "common/error_macros.hpp"
+#include "common/utils.hpp"
+#include "library/cbor.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+TEST_CASE("cbor-writer-rfc7049-examples", "[cbor]")
+{
+    uint8_t buf[64];
+
+    auto encode = [&buf](const std::function<Error(CborWriter &)> &aWrite) {
+        CborWriter writer{buf, sizeof(buf)};
+
+        REQUIRE(aWrite(writer) == ErrorCode::kNone);
+        return utils::Hex({buf, buf + writer.GetLength()});
+    };
+
+    // Examples in Appendix A of RFC 7049.
+    REQUIRE(encode([](CborWriter &aWriter) { return aWriter.WriteInt(0); }) == "00");
+    REQUIRE(encode([](CborWriter &aWriter) { return aWriter.WriteInt(23); }) == "17");
+    REQUIRE(encode([](CborWriter &aWriter) { return aWriter.WriteInt(24); }) == "1818");
+    REQUIRE(encode([](CborWriter &aWriter) { return aWriter.WriteInt(1000); }) == "1903e8");
+    REQUIRE(encode([](CborWriter &aWriter) { return aWriter.WriteInt(1000000); }) == "1a000f4240");
+    REQUIRE(encode([](CborWriter &aWriter) { return aWriter.WriteInt(1000000000000); }) == "1b000000e8d4a51000");
+    REQUIRE(encode([](CborWriter &aWriter) { return aWriter.WriteInt(-1); }) == "20");
+    REQUIRE(encode([](CborWriter &aWriter) { return aWriter.WriteInt(-1000); }) == "3903e7");
+    REQUIRE(encode([](CborWriter &aWriter) { return aWriter.WriteInt(INT64_MIN); }) == "3b7fffffffffffffff");
+    REQUIRE(encode([](CborWriter &aWriter) { return aWriter.WriteBytes({0x01, 0x02, 0x03, 0x04}); }) == "4401020304");
+    REQUIRE(encode([](CborWriter &aWriter) { return aWriter.WriteText("IETF"); }) == "6449455446");
+    REQUIRE(encode([](CborWriter &aWriter) { return aWriter.WriteTag(1); }) == "c1");
+
+    REQUIRE(encode([](CborWriter &aWriter) {
+                Error error;
+
+                // {1: 2, 3: [4, 5]}
+                SuccessOrExit(error = aWriter.WriteMap(2));
+                SuccessOrExit(error = aWriter.WriteInt(1));
+                SuccessOrExit(error = aWriter.WriteInt(2));
+                SuccessOrExit(error = aWriter.WriteInt(3));
+                SuccessOrExit(error = aWriter.WriteArray(2));
+                SuccessOrExit(error = aWriter.WriteInt(4));
+                SuccessOrExit(error = aWriter.WriteInt(5));
+
+            exit:
+                return error;
+            }) == "a2010203820405");
+}
+
+TEST_CASE("cbor-writer-buffer-too-small", "[cbor]")
+{
+    uint8_t    buf[4];
+    CborWriter writer{buf, sizeof(buf)};
+
+    REQUIRE(writer.WriteInt(1000) == ErrorCode::kNone);
+    REQUIRE(writer.WriteText("IETF").GetCode() == ErrorCode::kOutOfMemory);
+    REQUIRE(writer.WriteInt(1000).GetCode() == ErrorCode::kOutOfMemory);
+    REQUIRE(writer.WriteInt(1) == ErrorCode::kNone);
+    REQUIRE(writer.GetLength() == sizeof(buf));
+}
+
+TEST_CASE("cbor-reader-map", "[cbor]")
+{
+    ByteArray      buf;
+    int64_t        value;
+    const uint8_t *bytes;
+    const char *   str;
+    size_t         length;
+    size_t         count;
+
+    // {1: 2, -1: h'0102', 3: "IETF", 8: {1: [1, {2: 3}], 2: 1(1)}}
+    REQUIRE(utils::Hex(buf, "a401022042010203644945544608a2018201a1020302c101") == ErrorCode::kNone);
+
+    SECTION("read items in order")
+    {
+        CborReader reader{buf.data(), buf.size()};
+
+        REQUIRE(reader.ReadMap(count) == ErrorCode::kNone);
+        REQUIRE(count == 4);
+        REQUIRE(reader.ReadInt(value) == ErrorCode::kNone);
+        REQUIRE(value == 1);
+        REQUIRE(reader.ReadInt(value) == ErrorCode::kNone);
+        REQUIRE(value == 2);
+        REQUIRE(reader.ReadInt(value) == ErrorCode::kNone);
+        REQUIRE(value == -1);
+        REQUIRE(reader.ReadBytes(bytes, length) == ErrorCode::kNone);
+        REQUIRE(ByteArray{bytes, bytes + length} == ByteArray{0x01, 0x02});
+        REQUIRE(reader.ReadInt(value) == ErrorCode::kNone);
+        REQUIRE(value == 3);
+        REQUIRE(reader.ReadText(str, length) == ErrorCode::kNone);
+        REQUIRE(std::string{str, length} == "IETF");
+        REQUIRE(reader.ReadInt(value) == ErrorCode::kNone);
+        REQUIRE(value == 8);
+        REQUIRE(reader.Skip() == ErrorCode::kNone);
+        REQUIRE(reader.IsEnd());
+        REQUIRE(reader.Skip().GetCode() == ErrorCode::kBadFormat);
+    }
+
+    SECTION("skip nested items")
+    {
+        CborReader reader{buf.data(), buf.size()};
+        uint64_t   tag;
+
+        REQUIRE(reader.ReadMap(count) == ErrorCode::kNone);
+        for (size_t i = 0; i < 6; ++i)
+        {
+            REQUIRE(reader.Skip() == ErrorCode::kNone);
+        }
+
+        REQUIRE(reader.ReadInt(value) == ErrorCode::kNone);
+        REQUIRE(value == 8);
+        REQUIRE(reader.ReadMap(count) == ErrorCode::kNone);
+        REQUIRE(count == 2);
+        REQUIRE(reader.ReadInt(value) == ErrorCode::kNone);
+        REQUIRE(reader.Skip() == ErrorCode::kNone);
+        REQUIRE(reader.ReadInt(value) == ErrorCode::kNone);
+        REQUIRE(value == 2);
+        REQUIRE(reader.ReadTag(tag) == ErrorCode::kNone);
+        REQUIRE(tag == 1);
+        REQUIRE(reader.ReadInt(value) == ErrorCode::kNone);
+        REQUIRE(value == 1);
+        REQUIRE(reader.IsEnd());
+    }
+
+    SECTION("type mismatch")
+    {
+        CborReader reader{buf.data(), buf.size()};
+
+        REQUIRE(reader.ReadArray(count).GetCode() == ErrorCode::kBadFormat);
+    }
+}
+
+TEST_CASE("cbor-reader-malformed", "[cbor]")
+{
+    const std::vector<std::string> malformed = {
+        "",                     // Empty input.
+        "19e8",                 // Truncated argument.
+        "45010203",             // Truncated byte string.
+        "5f42010243030405ff",   // Indefinite-length byte string.
+        "1c",                   // Reserved additional information.
+        "a30102",               // Truncated map.
+        "9b000000010000000001", // Truncated array.
+    };
+
+    for (const auto &hex : malformed)
+    {
+        ByteArray buf;
+
+        INFO(hex);
+        REQUIRE(utils::Hex(buf, hex) == ErrorCode::kNone);
+
+        CborReader reader{buf.data(), buf.size()};
+        REQUIRE(reader.Skip().GetCode() == ErrorCode::kBadFormat);
+    }
+
+    SECTION("integer out of range")
+    {
+        const ByteArray buf = {0x1b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+        CborReader      reader{buf.data(), buf.size()};
+        int64_t         value;
+
+        REQUIRE(reader.ReadInt(value).GetCode() == ErrorCode::kBadFormat);
+    }
+
+    SECTION("nested too deep")
+    {
+        const ByteArray buf(64, 0x81);
+        CborReader      reader{buf.data(), buf.size()};
+
+        REQUIRE(reader.Skip().GetCode() == ErrorCode::kBadFormat);
+    }
+}
+
+// Encodings per second of a COSE-key-shaped map and operator new calls per
+// encoding, with the streaming writer and with cn-cbor. cn-cbor takes a
+// node for the map and for each key and value (11 here) from calloc(), which
+// the operator new counter doesn't see.
+TEST_CASE("cbor-writer-throughput", "[.benchmark]")
+{
+    constexpr int kEncodingCount = 200000;
+
+    const ByteArray kid(16, 0x11);
+    const ByteArray point(32, 0x22);
+    uint8_t         buf[256];
+    Error           error;
+
+    auto encode = [&]() {
+        CborWriter writer{buf, sizeof(buf)};
+
+        SuccessOrExit(error = writer.WriteMap(5));
+        SuccessOrExit(error = writer.WriteInt(2));
+        SuccessOrExit(error = writer.WriteBytes(kid));
+        SuccessOrExit(error = writer.WriteInt(1));
+        SuccessOrExit(error = writer.WriteInt(2));
+        SuccessOrExit(error = writer.WriteInt(-1));
+        SuccessOrExit(error = writer.WriteInt(1));
+        SuccessOrExit(error = writer.WriteInt(-2));
+        SuccessOrExit(error = writer.WriteBytes(point));
+        SuccessOrExit(error = writer.WriteInt(-3));
+        SuccessOrExit(error = writer.WriteBytes(point));
+
+    exit:
+        return;
+    };
+
+    size_t streamingAllocations = benchmark::CountAllocations([&]() {
+        for (int i = 0; i < kEncodingCount; ++i)
+        {
+            encode();
+        }
+    });
+
+    double streaming = benchmark::MeasureRate(kEncodingCount, encode);
+
+    REQUIRE(error == ErrorCode::kNone);
+    REQUIRE(streamingAllocations == 0);
+
+    WARN("COSE key encodings per second: streaming = " << streaming << " (" << streamingAllocations
+                                                       << " operator new calls in " << kEncodingCount << " encodings)");
+
+#if OT_COMM_CONFIG_CCM_ENABLE
+    double cnCbor = benchmark::MeasureRate(kEncodingCount, [&]() {
+        CborMap map;
+        size_t  length;
+
+        REQUIRE(map.Init() == ErrorCode::kNone);
+        REQUIRE(map.Put(2, kid.data(), kid.size()) == ErrorCode::kNone);
+        REQUIRE(map.Put(1, 2) == ErrorCode::kNone);
+        REQUIRE(map.Put(-1, 1) == ErrorCode::kNone);
+        REQUIRE(map.Put(-2, point.data(), point.size()) == ErrorCode::kNone);
+        REQUIRE(map.Put(-3, point.data(), point.size()) == ErrorCode::kNone);
+        REQUIRE(map.Serialize(buf, length, sizeof(buf)) == ErrorCode::kNone);
+        map.Free();
+    });
+
+    WARN("COSE key encodings per second: cn-cbor = " << cnCbor << " (11 calloc() calls per encoding)");
+#endif // OT_COMM_CONFIG_CCM_ENABLE
+}
+
+} // namespace commissioner
+
+} // namespace ot
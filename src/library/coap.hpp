@@ -499,6 +499,9 @@ public:
 
     const ByteArray &GetPayload() const { return mPayload; }
 
+    // Allows serializing data (e.g. TLVs) straight into the payload.
+    ByteArray &GetPayload() { return mPayload; }
+
     std::string GetPayloadAsString() const { return std::string{mPayload.begin(), mPayload.end()}; }
 
     Endpoint *GetEndpoint() const { return mEndpoint; }
@@ -0,0 +1,185 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements connecting CoAP with DTLS to one of several peers.
+ */
+
+#include "library/coap_secure.hpp"
+
+#include "library/logging.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+namespace coap {
+
+void CoapSecure::Connect(MultiConnectHandler aHandler, const std::vector<Peer> &aPeers, Duration aAttemptDelay)
+{
+    Error error;
+
+    VerifyOrExit(!aPeers.empty(), error = ERROR_INVALID_ARGS("no peer to connect to"));
+    VerifyOrExit(mMultiConnectHandler == nullptr, error = ERROR_INVALID_STATE("already connecting to peers"));
+
+    mPeers               = aPeers;
+    mNextPeer            = 0;
+    mPendingAttemptNum   = 0;
+    mAttemptDelay        = aAttemptDelay;
+    mMultiConnectHandler = aHandler;
+    mLastAttemptError    = ERROR_NONE;
+
+    StartNextAttempt();
+
+exit:
+    if (error != ErrorCode::kNone)
+    {
+        aHandler(0, Duration{0}, error);
+    }
+}
+
+void CoapSecure::StartNextAttempt()
+{
+    Error        error;
+    const Peer & peer    = mPeers[mNextPeer];
+    UdpSocketPtr socket  = std::make_shared<UdpSocket>(mEventBase);
+    auto         session = std::make_shared<DtlsSession>(mEventBase, mIsServer, socket);
+    Attempt &    attempt = *mAttempts.insert(mAttempts.end(), Attempt{mNextPeer, Clock::now(), socket, session});
+
+    LOG_DEBUG(LOG_REGION_COAP, "start DTLS handshake with peer {}: addr={}, port={}", mNextPeer, peer.first,
+              peer.second);
+
+    ++mNextPeer;
+    ++mPendingAttemptNum;
+
+    // The next peer is tried after the delay, or as soon as this one fails.
+    if (mNextPeer < mPeers.size())
+    {
+        mAttemptTimer.Start(mAttemptDelay);
+    }
+
+    SuccessOrExit(error = session->Init(mDtlsConfig));
+    if (int fail = socket->Connect(peer.first, peer.second))
+    {
+        ExitNow(error = ERROR_IO_ERROR("connect socket to peer addr={}, port={} failed: {}", peer.first, peer.second,
+                                       fail));
+    }
+    session->Connect(
+        [this, &attempt](DtlsSession &aSession, Error aError) { HandleAttemptConnected(attempt, aSession, aError); });
+
+exit:
+    if (error != ErrorCode::kNone)
+    {
+        HandleAttemptConnected(attempt, *session, error);
+    }
+}
+
+void CoapSecure::HandleAttemptConnected(Attempt &aAttempt, DtlsSession &aDtlsSession, Error aError)
+{
+    if (mMultiConnectHandler == nullptr)
+    {
+        // Another peer has been connected in the same event loop iteration.
+        if (aError == ErrorCode::kNone)
+        {
+            aDtlsSession.Disconnect(ERROR_CANCELLED("connected to another peer"));
+        }
+        ExitNow();
+    }
+
+    --mPendingAttemptNum;
+
+    if (aError == ErrorCode::kNone)
+    {
+        auto handshakeTime = std::chrono::duration_cast<Duration>(Clock::now() - aAttempt.mStartTime);
+
+        LOG_INFO(LOG_REGION_COAP, "connected to peer {} after a DTLS handshake of {} ms", aAttempt.mPeerIndex,
+                 handshakeTime.count());
+
+        // The replaced session is released with the attempts.
+        mAttempts.push_back(Attempt{0, TimePoint{}, mSocket, mDtlsSession});
+        SetDtlsSession(aAttempt.mSocket, aAttempt.mDtlsSession);
+
+        FinishAttempts(aAttempt.mPeerIndex, handshakeTime, ERROR_NONE);
+    }
+    else
+    {
+        LOG_INFO(LOG_REGION_COAP, "DTLS handshake with peer {} failed: {}", aAttempt.mPeerIndex, aError.ToString());
+
+        mLastAttemptError = aError;
+        if (mNextPeer < mPeers.size())
+        {
+            mAttemptTimer.Stop();
+            StartNextAttempt();
+        }
+        else if (mPendingAttemptNum == 0)
+        {
+            FinishAttempts(0, Duration{0}, mLastAttemptError);
+        }
+    }
+
+exit:
+    return;
+}
+
+void CoapSecure::HandleAttemptTimer(Timer &)
+{
+    mFinishedAttempts.clear();
+
+    if (mMultiConnectHandler != nullptr && mNextPeer < mPeers.size())
+    {
+        StartNextAttempt();
+    }
+}
+
+void CoapSecure::FinishAttempts(size_t aPeerIndex, Duration aHandshakeTime, Error aError)
+{
+    MultiConnectHandler handler = mMultiConnectHandler;
+
+    mMultiConnectHandler = nullptr;
+    mAttemptTimer.Stop();
+
+    for (auto &attempt : mAttempts)
+    {
+        if (attempt.mDtlsSession != mDtlsSession)
+        {
+            attempt.mDtlsSession->Disconnect(aError == ErrorCode::kNone ? ERROR_CANCELLED("connected to another peer")
+                                                                        : aError);
+        }
+    }
+    mFinishedAttempts.splice(mFinishedAttempts.end(), mAttempts);
+    mAttemptTimer.Start(Duration{0});
+
+    handler(aPeerIndex, aHandshakeTime, aError);
+}
+
+} // namespace coap
+
+} // namespace commissioner
+
+} // namespace ot
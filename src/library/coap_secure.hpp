@@ -34,9 +34,17 @@
 #ifndef OT_COMM_LIBRARY_COAP_SECURE_HPP_
 #define OT_COMM_LIBRARY_COAP_SECURE_HPP_
 
+#include <functional>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "common/error_macros.hpp"
+#include "common/time.hpp"
 #include "library/coap.hpp"
 #include "library/dtls.hpp"
+#include "library/timer.hpp"
 
 namespace ot {
 
@@ -47,16 +55,37 @@ namespace coap {
 class CoapSecure
 {
 public:
+    using Peer = std::pair<std::string, uint16_t>;
+
+    /**
+     * The handler of connecting to one of several peers.
+     *
+     * @param[in] aPeerIndex      The index of the connected peer. Valid only if @p aError is none.
+     * @param[in] aHandshakeTime  The time of the DTLS handshake with the connected peer.
+     * @param[in] aError          The error of the last peer which failed, if none succeeded.
+     *
+     */
+    using MultiConnectHandler = std::function<void(size_t aPeerIndex, Duration aHandshakeTime, Error aError)>;
+
     explicit CoapSecure(struct event_base *aEventBase, bool aIsServer = false)
-        : mSocket(std::make_shared<UdpSocket>(aEventBase))
-        , mDtlsSession(aEventBase, aIsServer, mSocket)
-        , mCoap(aEventBase, mDtlsSession)
+        : mEventBase(aEventBase)
+        , mIsServer(aIsServer)
+        , mEndpoint(*this)
+        , mCoap(aEventBase, mEndpoint)
+        , mAttemptTimer(aEventBase, [this](Timer &aTimer) { HandleAttemptTimer(aTimer); })
     {
+        auto socket = std::make_shared<UdpSocket>(aEventBase);
+
+        SetDtlsSession(socket, std::make_shared<DtlsSession>(aEventBase, aIsServer, socket));
     }
 
     ~CoapSecure() = default;
 
-    Error Init(const DtlsConfig &aConfig) { return mDtlsSession.Init(aConfig); }
+    Error Init(const DtlsConfig &aConfig)
+    {
+        mDtlsConfig = aConfig;
+        return mDtlsSession->Init(aConfig);
+    }
 
     Error Start(DtlsSession::ConnectHandler aOnConnected, const std::string &aLocalAddr, uint16_t aLocalPort)
     {
@@ -67,7 +96,7 @@ public:
             ExitNow(error = ERROR_IO_ERROR("bind socket to local addr={}, port={} failed: {}", aLocalAddr, aLocalPort,
                                            fail));
         }
-        mDtlsSession.Connect(aOnConnected);
+        mDtlsSession->Connect(aOnConnected);
 
     exit:
         return error;
@@ -79,17 +108,27 @@ public:
         {
             if (aOnConnected != nullptr)
             {
-                aOnConnected(mDtlsSession, ERROR_IO_ERROR("connect socket to peer addr={}, port={} failed: {}",
-                                                          aPeerAddr, aPeerPort, fail));
+                aOnConnected(*mDtlsSession, ERROR_IO_ERROR("connect socket to peer addr={}, port={} failed: {}",
+                                                           aPeerAddr, aPeerPort, fail));
                 ExitNow();
             }
         }
-        mDtlsSession.Connect(aOnConnected);
+        mDtlsSession->Connect(aOnConnected);
 
     exit:
         return;
     }
 
+    /**
+     * This method connects to the first of several peers which completes the DTLS handshake.
+     *
+     * A handshake with the next peer is started after @p aAttemptDelay, or as soon as
+     * the previous one fails, while the earlier handshakes go on. The session of the
+     * first peer which succeeds is kept and the other handshakes are cancelled.
+     *
+     */
+    void Connect(MultiConnectHandler aHandler, const std::vector<Peer> &aPeers, Duration aAttemptDelay);
+
     void Stop() { Disconnect(ERROR_CANCELLED("the CoAPs server has been stopped")); }
 
     Error GetLocalAddr(Address &aAddr) const
@@ -105,7 +144,11 @@ public:
 
     void Disconnect(Error aError)
     {
-        mDtlsSession.Disconnect(aError);
+        if (mMultiConnectHandler != nullptr)
+        {
+            FinishAttempts(0, Duration{0}, aError);
+        }
+        mDtlsSession->Disconnect(aError);
         mCoap.ClearRequestsAndResponses();
     }
 
@@ -117,16 +160,78 @@ public:
 
     Error SendResponse(const Request &aRequest, Response &aResponse) { return mCoap.SendResponse(aRequest, aResponse); }
 
-    bool IsConnected() const { return mDtlsSession.GetState() == DtlsSession::State::kConnected; }
+    bool IsConnected() const { return mDtlsSession->GetState() == DtlsSession::State::kConnected; }
 
-    const DtlsSession &GetDtlsSession() const { return mDtlsSession; }
+    const DtlsSession &GetDtlsSession() const { return *mDtlsSession; }
 
     void CancelRequests() { mCoap.CancelRequests(); }
 
 private:
-    UdpSocketPtr mSocket;
-    DtlsSession  mDtlsSession;
-    Coap         mCoap;
+    // The endpoint of the CoAP layer, which stays the same when
+    // the DTLS session is replaced by the one of another peer.
+    class SessionEndpoint : public Endpoint
+    {
+    public:
+        explicit SessionEndpoint(CoapSecure &aCoapSecure)
+            : mCoapSecure(aCoapSecure)
+        {
+        }
+        ~SessionEndpoint() override = default;
+
+        Error Send(const ByteArray &aBuf, MessageSubType aSubType) override
+        {
+            return mCoapSecure.mDtlsSession->Send(aBuf, aSubType);
+        }
+        Address  GetPeerAddr() const override { return mCoapSecure.mDtlsSession->GetPeerAddr(); }
+        uint16_t GetPeerPort() const override { return mCoapSecure.mDtlsSession->GetPeerPort(); }
+
+        void Receive(const ByteArray &aBuf) { mReceiver(*this, aBuf); }
+
+    private:
+        CoapSecure &mCoapSecure;
+    };
+
+    // A DTLS handshake with one of the peers.
+    struct Attempt
+    {
+        size_t         mPeerIndex;
+        TimePoint      mStartTime;
+        UdpSocketPtr   mSocket;
+        DtlsSessionPtr mDtlsSession;
+    };
+
+    void SetDtlsSession(UdpSocketPtr aSocket, DtlsSessionPtr aDtlsSession)
+    {
+        mSocket      = aSocket;
+        mDtlsSession = aDtlsSession;
+        mDtlsSession->SetReceiver([this](Endpoint &, const ByteArray &aBuf) { mEndpoint.Receive(aBuf); });
+    }
+
+    void StartNextAttempt();
+    void HandleAttemptConnected(Attempt &aAttempt, DtlsSession &aDtlsSession, Error aError);
+    void HandleAttemptTimer(Timer &aTimer);
+    void FinishAttempts(size_t aPeerIndex, Duration aHandshakeTime, Error aError);
+
+    struct event_base *mEventBase;
+    bool               mIsServer;
+    DtlsConfig         mDtlsConfig;
+    UdpSocketPtr       mSocket;
+    DtlsSessionPtr     mDtlsSession;
+    SessionEndpoint    mEndpoint;
+    Coap               mCoap;
+
+    std::vector<Peer>   mPeers;
+    size_t              mNextPeer = 0;
+    size_t              mPendingAttemptNum = 0;
+    Duration            mAttemptDelay;
+    MultiConnectHandler mMultiConnectHandler;
+    Error               mLastAttemptError;
+    std::list<Attempt>  mAttempts;
+    Timer               mAttemptTimer;
+
+    // Finished attempts may be on the call stack of their own
+    // handlers, so they are released later by the attempt timer.
+    std::list<Attempt> mFinishedAttempts;
 };
 
 } // namespace coap
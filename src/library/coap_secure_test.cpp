@@ -178,6 +178,111 @@ TEST_CASE("coap-secure-basic", "[coaps]")
     event_base_free(eventBase);
 }
 
+TEST_CASE("coap-secure-connect-first-peer", "[coaps]")
+{
+    DtlsConfig config;
+
+    config.mCaChain = ByteArray{kServerTrustAnchor.begin(), kServerTrustAnchor.end()};
+    config.mOwnCert = ByteArray{kServerCert.begin(), kServerCert.end()};
+    config.mOwnKey  = ByteArray{kServerKey.begin(), kServerKey.end()};
+
+    config.mCaChain.push_back(0);
+    config.mOwnCert.push_back(0);
+    config.mOwnKey.push_back(0);
+
+    auto eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    // Both peers are bound to free ports picked by the system.
+    CoapSecure coapsServer{eventBase, true};
+    Resource   resHello{"/hello", [&coapsServer](const Request &aRequest) {
+                          Response response{Type::kAcknowledgment, Code::kChanged};
+                          response.Append("world");
+                          REQUIRE(coapsServer.SendResponse(aRequest, response) == ErrorCode::kNone);
+                      }};
+    REQUIRE(coapsServer.AddResource(resHello) == ErrorCode::kNone);
+    REQUIRE(coapsServer.Init(config) == ErrorCode::kNone);
+    REQUIRE(coapsServer.Start(nullptr, kServerAddr, 0) == ErrorCode::kNone);
+
+    uint16_t peerPort = coapsServer.GetDtlsSession().GetLocalPort();
+
+    // A peer which never answers the handshake. Once the handshake with it
+    // is cancelled, its datagrams are refused by the closed client socket.
+    UdpSocket silentPeer{eventBase};
+    size_t    helloCount = 0;
+    bool      isRefused  = false;
+    REQUIRE(silentPeer.Bind(kServerAddr, 0) == 0);
+    silentPeer.SetEventHandler([&silentPeer, &helloCount, &isRefused, eventBase](short aFlags) {
+        uint8_t buf[1024];
+        int     rval;
+
+        VerifyOrExit(aFlags & EV_READ);
+        while ((rval = silentPeer.Receive(buf, sizeof(buf))) > 0)
+        {
+            ++helloCount;
+        }
+        if (rval == MBEDTLS_ERR_NET_RECV_FAILED)
+        {
+            isRefused = true;
+            event_base_loopbreak(eventBase);
+        }
+
+    exit:
+        return;
+    });
+
+    uint16_t silentPeerPort = silentPeer.GetLocalPort();
+
+    config.mCaChain = ByteArray{kClientTrustAnchor.begin(), kClientTrustAnchor.end()};
+    config.mOwnCert = ByteArray{kClientCert.begin(), kClientCert.end()};
+    config.mOwnKey  = ByteArray{kClientKey.begin(), kClientKey.end()};
+
+    config.mCaChain.push_back(0);
+    config.mOwnCert.push_back(0);
+    config.mOwnKey.push_back(0);
+
+    CoapSecure coapsClient{eventBase, false};
+    REQUIRE(coapsClient.Init(config) == ErrorCode::kNone);
+
+    auto startTime   = Clock::now();
+    auto onConnected = [&coapsClient, &silentPeer, &helloCount, eventBase, peerPort, startTime](
+                           size_t aPeerIndex, Duration aHandshakeTime, Error aError) {
+        REQUIRE(aError == ErrorCode::kNone);
+        REQUIRE(aPeerIndex == 1);
+        REQUIRE(aHandshakeTime <= Clock::now() - startTime);
+        REQUIRE(coapsClient.IsConnected());
+        REQUIRE(coapsClient.GetDtlsSession().GetPeerPort() == peerPort);
+
+        // The handshake with the silent peer has been started before.
+        REQUIRE(helloCount > 0);
+
+        // Requests go through the session of the connected peer.
+        Request request{Type::kConfirmable, Code::kPost};
+        REQUIRE(request.SetUriPath("/hello") == ErrorCode::kNone);
+        auto onResponse = [&silentPeer, eventBase](const Response *aResponse, Error aError) {
+            const uint8_t  kProbe[] = {0};
+            struct timeval timeout  = {1, 0};
+
+            REQUIRE(aError == ErrorCode::kNone);
+            REQUIRE(aResponse != nullptr);
+
+            auto payload = aResponse->GetPayload();
+            REQUIRE(std::string{payload.begin(), payload.end()} == "world");
+
+            // The socket of the cancelled handshake has been closed by now.
+            REQUIRE(silentPeer.Send(kProbe, sizeof(kProbe)) == sizeof(kProbe));
+            REQUIRE(event_base_loopexit(eventBase, &timeout) == 0);
+        };
+        coapsClient.SendRequest(request, onResponse);
+    };
+    coapsClient.Connect(onConnected, {{kServerAddr, silentPeerPort}, {kServerAddr, peerPort}},
+                        std::chrono::milliseconds(100));
+
+    REQUIRE(event_base_loop(eventBase, EVLOOP_NO_EXIT_ON_EMPTY) == 0);
+    REQUIRE(isRefused);
+    event_base_free(eventBase);
+}
+
 } // namespace coap
 
 } // namespace commissioner
@@ -0,0 +1,88 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   The file implements the host of commissioners running on a shared event-loop pool.
+ */
+
+#include "library/commissioner_host.hpp"
+
+#include <functional>
+
+#include "common/error_macros.hpp"
+#include "library/commissioner_safe.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+std::shared_ptr<CommissionerHost> CommissionerHost::Create()
+{
+    return std::make_shared<CommissionerHostImpl>();
+}
+
+Error CommissionerHostImpl::Init(size_t aEventLoopCount)
+{
+    Error                     error;
+    std::vector<EventLoopPtr> eventLoops;
+
+    VerifyOrExit(mEventLoops.empty(), error = ERROR_INVALID_STATE("the commissioner host has been initialized"));
+    VerifyOrExit(aEventLoopCount > 0, error = ERROR_INVALID_ARGS("the number of event loops must be greater than 0"));
+
+    for (size_t i = 0; i < aEventLoopCount; ++i)
+    {
+        auto eventLoop = std::make_shared<EventLoop>();
+
+        SuccessOrExit(error = eventLoop->Start());
+        eventLoops.emplace_back(eventLoop);
+    }
+
+    mEventLoops = std::move(eventLoops);
+
+exit:
+    return error;
+}
+
+std::shared_ptr<Commissioner> CommissionerHostImpl::CreateCommissioner(CommissionerHandler &aHandler,
+                                                                       const std::string &  aNetworkId)
+{
+    std::shared_ptr<Commissioner> commissioner;
+
+    VerifyOrExit(!mEventLoops.empty());
+
+    commissioner = std::make_shared<CommissionerSafe>(
+        aHandler, mEventLoops[std::hash<std::string>{}(aNetworkId) % mEventLoops.size()]);
+
+exit:
+    return commissioner;
+}
+
+} // namespace commissioner
+
+} // namespace ot
@@ -0,0 +1,71 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   The file defines the host of commissioners running on a shared event-loop pool.
+ */
+
+#ifndef OT_COMM_LIBRARY_COMMISSIONER_HOST_HPP_
+#define OT_COMM_LIBRARY_COMMISSIONER_HOST_HPP_
+
+#include <vector>
+
+#include <commissioner/commissioner.hpp>
+
+#include "library/event_loop.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+class CommissionerHostImpl : public CommissionerHost
+{
+public:
+    CommissionerHostImpl() = default;
+    ~CommissionerHostImpl() override = default;
+
+    CommissionerHostImpl(const CommissionerHostImpl &aHost) = delete;
+    const CommissionerHostImpl &operator=(const CommissionerHostImpl &aHost) = delete;
+
+    Error Init(size_t aEventLoopCount) override;
+
+    size_t GetEventLoopCount() const override { return mEventLoops.size(); }
+
+    std::shared_ptr<Commissioner> CreateCommissioner(CommissionerHandler &aHandler,
+                                                     const std::string &  aNetworkId) override;
+
+private:
+    std::vector<EventLoopPtr> mEventLoops;
+};
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_LIBRARY_COMMISSIONER_HOST_HPP_
@@ -0,0 +1,111 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases of CommissionerHost.
+ */
+
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "library/commissioner_host.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+TEST_CASE("commissioner-host-not-initialized", "[commissioner-host]")
+{
+    CommissionerHandler dummyHandler;
+
+    auto host = CommissionerHost::Create();
+    REQUIRE(host != nullptr);
+
+    REQUIRE(host->GetEventLoopCount() == 0);
+    REQUIRE(host->CreateCommissioner(dummyHandler, "dead00beef00cafe") == nullptr);
+    REQUIRE(host->Init(0) == ErrorCode::kInvalidArgs);
+}
+
+TEST_CASE("commissioner-host-shares-event-loops", "[commissioner-host]")
+{
+    constexpr size_t kEventLoopCount    = 2;
+    constexpr size_t kCommissionerCount = 10;
+
+    CommissionerHandler                        dummyHandler;
+    std::vector<std::shared_ptr<Commissioner>> commissioners;
+    Config                                     config;
+
+    config.mEnableCcm = false;
+    config.mPSKc = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+
+    auto host = CommissionerHost::Create();
+    REQUIRE(host != nullptr);
+    REQUIRE(host->Init(kEventLoopCount) == ErrorCode::kNone);
+    REQUIRE(host->GetEventLoopCount() == kEventLoopCount);
+    REQUIRE(host->Init(kEventLoopCount) == ErrorCode::kInvalidState);
+
+    for (size_t i = 0; i < kCommissionerCount; ++i)
+    {
+        auto commissioner = host->CreateCommissioner(dummyHandler, "network-" + std::to_string(i));
+
+        REQUIRE(commissioner != nullptr);
+        REQUIRE(commissioner->Init(config) == ErrorCode::kNone);
+        commissioners.emplace_back(commissioner);
+    }
+
+    // The request is rejected on the event loop thread of each commissioner.
+#if OT_COMM_CONFIG_CCM_ENABLE
+    constexpr ErrorCode kRejected = ErrorCode::kInvalidState;
+#else
+    constexpr ErrorCode kRejected = ErrorCode::kUnimplemented;
+#endif
+    for (auto &commissioner : commissioners)
+    {
+        BbrDataset dataset;
+
+        REQUIRE(commissioner->GetBbrDataset(dataset, 0xFFFF) == kRejected);
+    }
+
+    SECTION("commissioners are destroyed before the host")
+    {
+        commissioners.clear();
+        host.reset();
+    }
+
+    SECTION("commissioners are destroyed after the host")
+    {
+        host.reset();
+        commissioners.clear();
+    }
+}
+
+} // namespace commissioner
+
+} // namespace ot
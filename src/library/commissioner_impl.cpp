@@ -35,11 +35,12 @@
 
 #include "library/coap.hpp"
 #include "library/cose.hpp"
+#include "library/dataset_codec.hpp"
 #include "library/dtls.hpp"
 #include "library/logging.hpp"
 #include "library/openthread/bloom_filter.hpp"
-#include "library/openthread/pbkdf2_cmac.hpp"
 #include "library/openthread/sha256.hpp"
+#include "library/pskc_generator.hpp"
 #include "library/uri.hpp"
 
 #define CCM_NOT_IMPLEMENTED "CCM features not implemented"
@@ -53,36 +54,30 @@ static constexpr uint16_t kDefaultMmPort = 61631;
 static constexpr uint32_t kMinKeepAliveInterval = 30;
 static constexpr uint32_t kMaxKeepAliveInterval = 45;
 
+// The max number of PSKc remembered by the batch PSKc API.
+static constexpr size_t kPSKcCacheCapacity = 4096;
+
 Error Commissioner::GeneratePSKc(ByteArray &        aPSKc,
                                  const std::string &aPassphrase,
                                  const std::string &aNetworkName,
                                  const ByteArray &  aExtendedPanId)
 {
-    Error             error;
-    const std::string saltPrefix = "Thread";
-    ByteArray         salt;
-
-    VerifyOrExit((aPassphrase.size() >= kMinCommissionerCredentialLength) &&
-                     (aPassphrase.size() <= kMaxCommissionerCredentialLength),
-                 error = ERROR_INVALID_ARGS("passphrase length={} exceeds range [{}, {}]", aPassphrase.size(),
-                                            kMinCommissionerCredentialLength, kMaxCommissionerCredentialLength));
-    VerifyOrExit(aNetworkName.size() <= kMaxNetworkNameLength,
-                 error = ERROR_INVALID_ARGS("network name length={} > {}", aNetworkName.size(), kMaxNetworkNameLength));
-    VerifyOrExit(
-        aExtendedPanId.size() == kExtendedPanIdLength,
-        error = ERROR_INVALID_ARGS("extended PAN ID length={} != {}", aExtendedPanId.size(), kExtendedPanIdLength));
+    return PSKcGenerator::Derive(aPSKc, {aPassphrase, aNetworkName, aExtendedPanId});
+}
 
-    salt.insert(salt.end(), saltPrefix.begin(), saltPrefix.end());
-    salt.insert(salt.end(), aExtendedPanId.begin(), aExtendedPanId.end());
-    salt.insert(salt.end(), aNetworkName.begin(), aNetworkName.end());
+Error Commissioner::GeneratePSKc(std::vector<ByteArray> &       aPSKcList,
+                                 const std::vector<PSKcParams> &aParamsList,
+                                 size_t                         aThreadNum,
+                                 bool                           aUseCache)
+{
+    static PSKcGenerator sCachedGenerator(kPSKcCacheCapacity);
 
-    aPSKc.resize(kMaxPSKcLength);
-    otPbkdf2Cmac(reinterpret_cast<const uint8_t *>(aPassphrase.data()), static_cast<uint16_t>(aPassphrase.size()),
-                 salt.data(), static_cast<uint16_t>(salt.size()), 16384, static_cast<uint16_t>(aPSKc.size()),
-                 aPSKc.data());
+    if (aUseCache)
+    {
+        return sCachedGenerator.Generate(aPSKcList, aParamsList, aThreadNum);
+    }
 
-exit:
-    return error;
+    return PSKcGenerator(0).Generate(aPSKcList, aParamsList, aThreadNum);
 }
 
 ByteArray Commissioner::ComputeJoinerId(uint64_t aEui64)
@@ -140,11 +135,17 @@ exit:
     return error;
 }
 
-CommissionerImpl::CommissionerImpl(CommissionerHandler &aHandler, struct event_base *aEventBase)
+CommissionerImpl::CommissionerImpl(CommissionerHandler &aHandler,
+                                   struct event_base *  aEventBase,
+                                   DtlsResourcesPtr     aDtlsResources,
+                                   Executor             aEventLoopExecutor)
     : mState(State::kDisabled)
     , mSessionId(0)
     , mCommissionerHandler(aHandler)
     , mEventBase(aEventBase)
+    , mEventLoopExecutor(aEventLoopExecutor)
+    , mLifetime(std::make_shared<bool>(true))
+    , mDtlsResources(aDtlsResources)
     , mKeepAliveTimer(mEventBase, [this](Timer &aTimer) { SendKeepAlive(aTimer); })
     , mBrClient(mEventBase)
     , mJoinerSessionTimer(mEventBase, [this](Timer &aTimer) { HandleJoinerSessionTimer(aTimer); })
@@ -177,7 +178,9 @@ Error CommissionerImpl::Init(const Config &aConfig)
     InitLogger(aConfig.mLogger);
     LoggingConfig();
 
-    SuccessOrExit(error = mBrClient.Init(GetDtlsConfig(mConfig)));
+    mDtlsConfig            = commissioner::GetDtlsConfig(mConfig);
+    mDtlsConfig.mResources = mDtlsResources;
+    SuccessOrExit(error = mBrClient.Init(mDtlsConfig));
 
 #if OT_COMM_CONFIG_CCM_ENABLE
     if (IsCcmMode())
@@ -246,6 +249,7 @@ void CommissionerImpl::LoggingConfig()
     LOG_INFO(LOG_REGION_CONFIG, "keep alive interval = {}", mConfig.mKeepAliveInterval);
     LOG_INFO(LOG_REGION_CONFIG, "enable DTLS debug logging = {}", mConfig.mEnableDtlsDebugLogging);
     LOG_INFO(LOG_REGION_CONFIG, "maximum connection number = {}", mConfig.mMaxConnectionNum);
+    LOG_INFO(LOG_REGION_CONFIG, "connect attempt delay = {} ms", mConfig.mConnectAttemptDelay);
 
     // Do not logging credentials
 }
@@ -315,10 +319,43 @@ void CommissionerImpl::Connect(ErrorHandler aHandler, const std::string &aAddr,
     mBrClient.Connect(onConnected, aAddr, aPort);
 }
 
+void CommissionerImpl::Connect(Handler<ConnectResult> aHandler, const std::vector<BorderAgentAddr> &aBorderAgents)
+{
+    std::vector<coap::CoapSecure::Peer> peers;
+    TimePoint                           startTime = Clock::now();
+
+    auto onConnected = [aHandler, aBorderAgents, startTime](size_t aPeerIndex, Duration aHandshakeTime, Error aError) {
+        ConnectResult result;
+
+        SuccessOrExit(aError);
+
+        result.mBorderAgent   = aBorderAgents[aPeerIndex];
+        result.mHandshakeTime = static_cast<uint32_t>(aHandshakeTime.count());
+        result.mConnectTime =
+            static_cast<uint32_t>(std::chrono::duration_cast<Duration>(Clock::now() - startTime).count());
+
+        LOG_INFO(LOG_REGION_MESHCOP, "connected to border agent ({}, {}) in {} ms, the DTLS handshake took {} ms",
+                 result.mBorderAgent.mAddr, result.mBorderAgent.mPort, result.mConnectTime, result.mHandshakeTime);
+
+    exit:
+        aHandler(aError == ErrorCode::kNone ? &result : nullptr, aError);
+    };
+
+    for (const auto &borderAgent : aBorderAgents)
+    {
+        peers.emplace_back(borderAgent.mAddr, borderAgent.mPort);
+    }
+
+    mBrClient.Connect(onConnected, peers, std::chrono::milliseconds(mConfig.mConnectAttemptDelay));
+}
+
 void CommissionerImpl::Disconnect()
 {
     mBrClient.Disconnect(ERROR_CANCELLED("the CoAPs client was disconnected"));
     mState = State::kDisabled;
+
+    // Answers of the handler to these requests are dropped.
+    mPendingJoinerRequests.clear();
 }
 
 uint16_t CommissionerImpl::GetSessionId() const
@@ -363,7 +400,7 @@ void CommissionerImpl::GetCommissionerDataset(Handler<CommissionerDataset> aHand
 {
     Error         error;
     coap::Request request{coap::Type::kConfirmable, coap::Code::kPost};
-    ByteArray     tlvTypes = GetCommissionerDatasetTlvs(aDatasetFlags);
+    ByteArray     tlvTypes = dataset::GetCommissionerDatasetTlvTypes(aDatasetFlags);
 
     auto onResponse = [aHandler](const coap::Response *aResponse, Error aError) {
         Error               error;
@@ -471,7 +508,7 @@ void CommissionerImpl::GetRawActiveDataset(Handler<ByteArray> aHandler, uint16_t
 {
     Error         error;
     coap::Request request{coap::Type::kConfirmable, coap::Code::kPost};
-    ByteArray     datasetList = GetActiveOperationalDatasetTlvs(aDatasetFlags);
+    ByteArray     datasetList = dataset::GetActiveDatasetTlvTypes(aDatasetFlags);
 
     auto onResponse = [aHandler](const coap::Response *aResponse, Error aError) {
         Error error;
@@ -565,7 +602,7 @@ void CommissionerImpl::GetPendingDataset(Handler<PendingOperationalDataset> aHan
 {
     Error         error;
     coap::Request request{coap::Type::kConfirmable, coap::Code::kPost};
-    ByteArray     datasetList = GetPendingOperationalDatasetTlvs(aDatasetFlags);
+    ByteArray     datasetList = dataset::GetPendingDatasetTlvTypes(aDatasetFlags);
 
     auto onResponse = [aHandler](const coap::Response *aResponse, Error aError) {
         Error                     error;
@@ -696,7 +733,7 @@ void CommissionerImpl::GetBbrDataset(Handler<BbrDataset> aHandler, uint16_t aDat
     Error error;
 
     coap::Request request{coap::Type::kConfirmable, coap::Code::kPost};
-    ByteArray     datasetList = GetBbrDatasetTlvs(aDatasetFlags);
+    ByteArray     datasetList = dataset::GetBbrDatasetTlvTypes(aDatasetFlags);
 
     auto onResponse = [aHandler](const coap::Response *aResponse, Error aError) {
         Error      error;
@@ -1289,7 +1326,7 @@ void CommissionerImpl::SendKeepAlive(Timer &, bool aKeepAlive)
             LOG_WARN(LOG_REGION_MESHCOP, "keep alive message rejected: {}", error.ToString());
         }
 
-        mCommissionerHandler.OnKeepAliveResponse(error);
+        DispatchToHandler([error](CommissionerHandler &aHandler) { aHandler.OnKeepAliveResponse(error); });
     };
 
     VerifyOrExit(IsActive(),
@@ -1340,17 +1377,7 @@ exit:
 
 Error AppendTlv(coap::Message &aMessage, const tlv::Tlv &aTlv)
 {
-    Error     error;
-    ByteArray buf;
-
-    VerifyOrExit(aTlv.IsValid(),
-                 error = ERROR_INVALID_ARGS("the tlv(type={}) is in bad format", utils::to_underlying(aTlv.GetType())));
-
-    aTlv.Serialize(buf);
-    aMessage.Append(buf);
-
-exit:
-    return error;
+    return tlv::TlvWriter{aMessage.GetPayload(), aTlv.GetScope()}.Write(aTlv.GetType(), aTlv.GetValue());
 }
 
 Error GetTlvSet(tlv::TlvSet &aTlvSet, const coap::Message &aMessage, tlv::Scope aScope)
@@ -1382,217 +1409,32 @@ exit:
     return error;
 }
 
-static void inline EncodeTlvType(ByteArray &aBuf, tlv::Type aTlvType)
-{
-    aBuf.emplace_back(utils::to_underlying(aTlvType));
-}
-
-ByteArray CommissionerImpl::GetActiveOperationalDatasetTlvs(uint16_t aDatasetFlags)
-{
-    ByteArray tlvTypes;
-
-    if (aDatasetFlags & ActiveOperationalDataset::kActiveTimestampBit)
-    {
-        EncodeTlvType(tlvTypes, tlv::Type::kActiveTimestamp);
-    }
-    if (aDatasetFlags & ActiveOperationalDataset::kChannelBit)
-    {
-        EncodeTlvType(tlvTypes, tlv::Type::kChannel);
-    }
-    if (aDatasetFlags & ActiveOperationalDataset::kChannelMaskBit)
-    {
-        EncodeTlvType(tlvTypes, tlv::Type::kChannelMask);
-    }
-    if (aDatasetFlags & ActiveOperationalDataset::kExtendedPanIdBit)
-    {
-        EncodeTlvType(tlvTypes, tlv::Type::kExtendedPanId);
-    }
-    if (aDatasetFlags & ActiveOperationalDataset::kMeshLocalPrefixBit)
-    {
-        EncodeTlvType(tlvTypes, tlv::Type::kNetworkMeshLocalPrefix);
-    }
-    if (aDatasetFlags & ActiveOperationalDataset::kNetworkMasterKeyBit)
-    {
-        EncodeTlvType(tlvTypes, tlv::Type::kNetworkMasterKey);
-    }
-    if (aDatasetFlags & ActiveOperationalDataset::kNetworkNameBit)
-    {
-        EncodeTlvType(tlvTypes, tlv::Type::kNetworkName);
-    }
-    if (aDatasetFlags & ActiveOperationalDataset::kPanIdBit)
-    {
-        EncodeTlvType(tlvTypes, tlv::Type::kPanId);
-    }
-    if (aDatasetFlags & ActiveOperationalDataset::kPSKcBit)
-    {
-        EncodeTlvType(tlvTypes, tlv::Type::kPSKc);
-    }
-    if (aDatasetFlags & ActiveOperationalDataset::kSecurityPolicyBit)
-    {
-        EncodeTlvType(tlvTypes, tlv::Type::kSecurityPolicy);
-    }
-
-    return tlvTypes;
-}
-
-ByteArray CommissionerImpl::GetPendingOperationalDatasetTlvs(uint16_t aDatasetFlags)
-{
-    auto tlvTypes = GetActiveOperationalDatasetTlvs(aDatasetFlags);
-
-    if (aDatasetFlags & PendingOperationalDataset::kDelayTimerBit)
-    {
-        EncodeTlvType(tlvTypes, tlv::Type::kDelayTimer);
-    }
-    if (aDatasetFlags & PendingOperationalDataset::kPendingTimestampBit)
-    {
-        EncodeTlvType(tlvTypes, tlv::Type::kPendingTimestamp);
-    }
-
-    return tlvTypes;
-}
-
 Error CommissionerImpl::DecodeActiveOperationalDataset(ActiveOperationalDataset &aDataset, const ByteArray &aPayload)
 {
-    Error                    error;
-    tlv::TlvSet              tlvSet;
-    ActiveOperationalDataset dataset;
-
-    // Clear all data fields
-    dataset.mPresentFlags = 0;
-
-    SuccessOrExit(error = tlv::GetTlvSet(tlvSet, aPayload));
-
-    if (auto activeTimeStamp = tlvSet[tlv::Type::kActiveTimestamp])
-    {
-        uint64_t value;
-        value                    = utils::Decode<uint64_t>(activeTimeStamp->GetValue());
-        dataset.mActiveTimestamp = Timestamp::Decode(value);
-        dataset.mPresentFlags |= ActiveOperationalDataset::kActiveTimestampBit;
-    }
-
-    if (auto channel = tlvSet[tlv::Type::kChannel])
-    {
-        const ByteArray &value   = channel->GetValue();
-        dataset.mChannel.mPage   = value[0];
-        dataset.mChannel.mNumber = utils::Decode<uint16_t>(value.data() + 1, value.size() - 1);
-        dataset.mPresentFlags |= ActiveOperationalDataset::kChannelBit;
-    }
-
-    if (auto channelMask = tlvSet[tlv::Type::kChannelMask])
-    {
-        SuccessOrExit(DecodeChannelMask(dataset.mChannelMask, channelMask->GetValue()));
-        dataset.mPresentFlags |= ActiveOperationalDataset::kChannelMaskBit;
-    }
-
-    if (auto extendedPanId = tlvSet[tlv::Type::kExtendedPanId])
-    {
-        dataset.mExtendedPanId = extendedPanId->GetValue();
-        dataset.mPresentFlags |= ActiveOperationalDataset::kExtendedPanIdBit;
-    }
-
-    if (auto meshLocalPrefix = tlvSet[tlv::Type::kNetworkMeshLocalPrefix])
-    {
-        dataset.mMeshLocalPrefix = meshLocalPrefix->GetValue();
-        dataset.mPresentFlags |= ActiveOperationalDataset::kMeshLocalPrefixBit;
-    }
-
-    if (auto networkMasterKey = tlvSet[tlv::Type::kNetworkMasterKey])
-    {
-        dataset.mNetworkMasterKey = networkMasterKey->GetValue();
-        dataset.mPresentFlags |= ActiveOperationalDataset::kNetworkMasterKeyBit;
-    }
-
-    if (auto networkName = tlvSet[tlv::Type::kNetworkName])
-    {
-        dataset.mNetworkName = networkName->GetValueAsString();
-        dataset.mPresentFlags |= ActiveOperationalDataset::kNetworkNameBit;
-    }
-
-    if (auto panId = tlvSet[tlv::Type::kPanId])
-    {
-        dataset.mPanId = utils::Decode<uint16_t>(panId->GetValue());
-        dataset.mPresentFlags |= ActiveOperationalDataset::kPanIdBit;
-    }
-
-    if (auto pskc = tlvSet[tlv::Type::kPSKc])
-    {
-        dataset.mPSKc = pskc->GetValue();
-        dataset.mPresentFlags |= ActiveOperationalDataset::kPSKcBit;
-    }
-
-    if (auto securityPolicy = tlvSet[tlv::Type::kSecurityPolicy])
-    {
-        auto &value                           = securityPolicy->GetValue();
-        dataset.mSecurityPolicy.mRotationTime = utils::Decode<uint16_t>(value);
-        dataset.mSecurityPolicy.mFlags        = {value.begin() + sizeof(uint16_t), value.end()};
-        dataset.mPresentFlags |= ActiveOperationalDataset::kSecurityPolicyBit;
-    }
+    Error         error;
+    tlv::TlvTable tlvTable;
 
-    aDataset = dataset;
+    SuccessOrExit(error = tlvTable.Parse(aPayload));
+    SuccessOrExit(error = DecodeActiveOperationalDataset(aDataset, tlvTable));
 
 exit:
     return error;
 }
 
-Error CommissionerImpl::DecodePendingOperationalDataset(PendingOperationalDataset &aDataset,
-                                                        const coap::Response &     aResponse)
+Error CommissionerImpl::DecodeActiveOperationalDataset(ActiveOperationalDataset &aDataset,
+                                                       const tlv::TlvTable &     aTlvTable)
 {
-    Error                     error;
-    tlv::TlvSet               tlvSet;
-    PendingOperationalDataset dataset;
-
-    // Clear all data fields
-    dataset.mPresentFlags = 0;
-
-    SuccessOrExit(error = DecodeActiveOperationalDataset(dataset, aResponse.GetPayload()));
-    SuccessOrExit(error = GetTlvSet(tlvSet, aResponse));
-
-    if (auto delayTimer = tlvSet[tlv::Type::kDelayTimer])
-    {
-        dataset.mDelayTimer = utils::Decode<uint32_t>(delayTimer->GetValue());
-        dataset.mPresentFlags |= PendingOperationalDataset::kDelayTimerBit;
-    }
-
-    if (auto pendingTimestamp = tlvSet[tlv::Type::kPendingTimestamp])
-    {
-        uint64_t value;
-        value                     = utils::Decode<uint64_t>(pendingTimestamp->GetValue());
-        dataset.mPendingTimestamp = Timestamp::Decode(value);
-        dataset.mPresentFlags |= PendingOperationalDataset::kPendingTimestampBit;
-    }
-
-    aDataset = dataset;
-
-exit:
-    return error;
+    return dataset::Decode(aDataset, aTlvTable);
 }
 
-Error CommissionerImpl::DecodeChannelMask(ChannelMask &aChannelMask, const ByteArray &aBuf)
+Error CommissionerImpl::DecodePendingOperationalDataset(PendingOperationalDataset &aDataset,
+                                                        const coap::Response &     aResponse)
 {
-    Error       error;
-    ChannelMask channelMask;
-    size_t      offset = 0;
-    size_t      length = aBuf.size();
-
-    while (offset < length)
-    {
-        ChannelMaskEntry entry;
-        uint8_t          entryLength;
-        VerifyOrExit(offset + 2 <= length, error = ERROR_BAD_FORMAT("premature end of Channel Mask Entry"));
-
-        entry.mPage = aBuf[offset++];
-        entryLength = aBuf[offset++];
-
-        VerifyOrExit(offset + entryLength <= length, error = ERROR_BAD_FORMAT("premature end of Channel Mask Entry"));
-        entry.mMasks = {aBuf.begin() + offset, aBuf.begin() + offset + entryLength};
-        channelMask.emplace_back(entry);
-
-        offset += entryLength;
-    }
-
-    ASSERT(offset == length);
+    Error         error;
+    tlv::TlvTable tlvTable;
 
-    aChannelMask = channelMask;
+    SuccessOrExit(error = tlvTable.Parse(aResponse.GetPayload()));
+    SuccessOrExit(error = dataset::Decode(aDataset, tlvTable));
 
 exit:
     return error;
@@ -1601,141 +1443,23 @@ exit:
 Error CommissionerImpl::EncodeActiveOperationalDataset(coap::Request &                 aRequest,
                                                        const ActiveOperationalDataset &aDataset)
 {
-    Error error;
-
-    if (aDataset.mPresentFlags & ActiveOperationalDataset::kActiveTimestampBit)
-    {
-        SuccessOrExit(error = AppendTlv(aRequest, {tlv::Type::kActiveTimestamp, aDataset.mActiveTimestamp.Encode()}));
-    }
-
-    if (aDataset.mPresentFlags & ActiveOperationalDataset::kChannelBit)
-    {
-        ByteArray value;
-        utils::Encode(value, aDataset.mChannel.mPage);
-        utils::Encode(value, aDataset.mChannel.mNumber);
-        SuccessOrExit(error = AppendTlv(aRequest, {tlv::Type::kChannel, value}));
-    }
-
-    if (aDataset.mPresentFlags & ActiveOperationalDataset::kChannelMaskBit)
-    {
-        ByteArray value;
-        SuccessOrExit(error = EncodeChannelMask(value, aDataset.mChannelMask));
-        SuccessOrExit(error = AppendTlv(aRequest, {tlv::Type::kChannelMask, value}));
-    }
-
-    if (aDataset.mPresentFlags & ActiveOperationalDataset::kExtendedPanIdBit)
-    {
-        SuccessOrExit(error = AppendTlv(aRequest, {tlv::Type::kExtendedPanId, aDataset.mExtendedPanId}));
-    }
-
-    if (aDataset.mPresentFlags & ActiveOperationalDataset::kMeshLocalPrefixBit)
-    {
-        SuccessOrExit(error = AppendTlv(aRequest, {tlv::Type::kNetworkMeshLocalPrefix, aDataset.mMeshLocalPrefix}));
-    }
-
-    if (aDataset.mPresentFlags & ActiveOperationalDataset::kNetworkMasterKeyBit)
-    {
-        SuccessOrExit(error = AppendTlv(aRequest, {tlv::Type::kNetworkMasterKey, aDataset.mNetworkMasterKey}));
-    }
-
-    if (aDataset.mPresentFlags & ActiveOperationalDataset::kNetworkNameBit)
-    {
-        SuccessOrExit(error = AppendTlv(aRequest, {tlv::Type::kNetworkName, aDataset.mNetworkName}));
-    }
-
-    if (aDataset.mPresentFlags & ActiveOperationalDataset::kPanIdBit)
-    {
-        SuccessOrExit(error = AppendTlv(aRequest, {tlv::Type::kPanId, aDataset.mPanId}));
-    }
-
-    if (aDataset.mPresentFlags & ActiveOperationalDataset::kPSKcBit)
-    {
-        SuccessOrExit(error = AppendTlv(aRequest, {tlv::Type::kPSKc, aDataset.mPSKc}));
-    }
-
-    if (aDataset.mPresentFlags & ActiveOperationalDataset::kSecurityPolicyBit)
-    {
-        ByteArray value;
-        utils::Encode(value, aDataset.mSecurityPolicy.mRotationTime);
-        value.insert(value.end(), aDataset.mSecurityPolicy.mFlags.begin(), aDataset.mSecurityPolicy.mFlags.end());
-        SuccessOrExit(error = AppendTlv(aRequest, {tlv::Type::kSecurityPolicy, value}));
-    }
-
-exit:
-    return error;
+    return dataset::Encode(aRequest.GetPayload(), aDataset);
 }
 
 Error CommissionerImpl::EncodePendingOperationalDataset(coap::Request &                  aRequest,
                                                         const PendingOperationalDataset &aDataset)
 {
-    Error error;
-
-    SuccessOrExit(error = EncodeActiveOperationalDataset(aRequest, aDataset));
-
-    if (aDataset.mPresentFlags & PendingOperationalDataset::kDelayTimerBit)
-    {
-        SuccessOrExit(error = AppendTlv(aRequest, {tlv::Type::kDelayTimer, aDataset.mDelayTimer}));
-    }
-
-    if (aDataset.mPresentFlags & PendingOperationalDataset::kPendingTimestampBit)
-    {
-        SuccessOrExit(error = AppendTlv(aRequest, {tlv::Type::kPendingTimestamp, aDataset.mPendingTimestamp.Encode()}));
-    }
-
-exit:
-    return error;
-}
-
-Error CommissionerImpl::EncodeChannelMask(ByteArray &aBuf, const ChannelMask &aChannelMask)
-{
-    Error error;
-
-    for (const auto &entry : aChannelMask)
-    {
-        VerifyOrExit(entry.mMasks.size() < tlv::kEscapeLength,
-                     error = ERROR_INVALID_ARGS("Channel Mask list is tool long (>={})", tlv::kEscapeLength));
-
-        utils::Encode(aBuf, entry.mPage);
-        utils::Encode(aBuf, static_cast<uint8_t>(entry.mMasks.size()));
-        aBuf.insert(aBuf.end(), entry.mMasks.begin(), entry.mMasks.end());
-    }
-
-exit:
-    return error;
+    return dataset::Encode(aRequest.GetPayload(), aDataset);
 }
 
 #if OT_COMM_CONFIG_CCM_ENABLE
 Error CommissionerImpl::DecodeBbrDataset(BbrDataset &aDataset, const coap::Response &aResponse)
 {
-    Error       error;
-    tlv::TlvSet tlvSet;
-    BbrDataset  dataset;
-
-    SuccessOrExit(error = GetTlvSet(tlvSet, aResponse));
-
-    if (auto triHostname = tlvSet[tlv::Type::kTriHostname])
-    {
-        dataset.mTriHostname = triHostname->GetValueAsString();
-        dataset.mPresentFlags |= BbrDataset::kTriHostnameBit;
-    }
-
-    if (auto registrarHostname = tlvSet[tlv::Type::kRegistrarHostname])
-    {
-        dataset.mRegistrarHostname = registrarHostname->GetValueAsString();
-        dataset.mPresentFlags |= BbrDataset::kRegistrarHostnameBit;
-    }
-
-    if (auto registrarIpv6Addr = tlvSet[tlv::Type::kRegistrarIpv6Address])
-    {
-        Address addr;
-
-        SuccessOrExit(error = addr.Set(registrarIpv6Addr->GetValue()));
-
-        dataset.mRegistrarIpv6Addr = addr.ToString();
-        dataset.mPresentFlags |= BbrDataset::kRegistrarIpv6AddrBit;
-    }
+    Error         error;
+    tlv::TlvTable tlvTable;
 
-    aDataset = dataset;
+    SuccessOrExit(error = tlvTable.Parse(aResponse.GetPayload()));
+    SuccessOrExit(error = dataset::Decode(aDataset, tlvTable));
 
 exit:
     return error;
@@ -1743,109 +1467,17 @@ exit:
 
 Error CommissionerImpl::EncodeBbrDataset(coap::Request &aRequest, const BbrDataset &aDataset)
 {
-    Error error;
-
-    if (aDataset.mPresentFlags & BbrDataset::kTriHostnameBit)
-    {
-        SuccessOrExit(error = AppendTlv(aRequest, {tlv::Type::kTriHostname, aDataset.mTriHostname}));
-    }
-
-    if (aDataset.mPresentFlags & BbrDataset::kRegistrarHostnameBit)
-    {
-        SuccessOrExit(error = AppendTlv(aRequest, {tlv::Type::kRegistrarHostname, aDataset.mRegistrarHostname}));
-    }
-
-    if (aDataset.mPresentFlags & BbrDataset::kRegistrarIpv6AddrBit)
-    {
-        Address addr;
-
-        SuccessOrExit(error = addr.Set(aDataset.mRegistrarIpv6Addr));
-        SuccessOrExit(error = AppendTlv(aRequest, {tlv::Type::kRegistrarIpv6Address, addr.GetRaw()}));
-    }
-
-exit:
-    return error;
-}
-
-ByteArray CommissionerImpl::GetBbrDatasetTlvs(uint16_t aDatasetFlags)
-{
-    ByteArray tlvTypes;
-
-    if (aDatasetFlags & BbrDataset::kTriHostnameBit)
-    {
-        tlvTypes.emplace_back(utils::to_underlying(tlv::Type::kTriHostname));
-    }
-
-    if (aDatasetFlags & BbrDataset::kRegistrarHostnameBit)
-    {
-        tlvTypes.emplace_back(utils::to_underlying(tlv::Type::kRegistrarHostname));
-    }
-
-    if (aDatasetFlags & BbrDataset::kRegistrarIpv6AddrBit)
-    {
-        tlvTypes.emplace_back(utils::to_underlying(tlv::Type::kRegistrarIpv6Address));
-    }
-    return tlvTypes;
+    return dataset::Encode(aRequest.GetPayload(), aDataset);
 }
 #endif // OT_COMM_CONFIG_CCM_ENABLE
 
 Error CommissionerImpl::DecodeCommissionerDataset(CommissionerDataset &aDataset, const coap::Response &aResponse)
 {
-    Error               error;
-    tlv::TlvSet         tlvSet;
-    CommissionerDataset dataset;
-
-    SuccessOrExit(error = GetTlvSet(tlvSet, aResponse));
-
-    if (auto sessionId = tlvSet[tlv::Type::kCommissionerSessionId])
-    {
-        dataset.mSessionId = sessionId->GetValueAsUint16();
-        dataset.mPresentFlags |= CommissionerDataset::kSessionIdBit;
-    }
-
-    if (auto borderAgentLocator = tlvSet[tlv::Type::kBorderAgentLocator])
-    {
-        dataset.mBorderAgentLocator = borderAgentLocator->GetValueAsUint16();
-        dataset.mPresentFlags |= CommissionerDataset::kBorderAgentLocatorBit;
-    }
-
-    if (auto steeringData = tlvSet[tlv::Type::kSteeringData])
-    {
-        dataset.mSteeringData = steeringData->GetValue();
-        dataset.mPresentFlags |= CommissionerDataset::kSteeringDataBit;
-    }
-
-    if (auto aeSteeringData = tlvSet[tlv::Type::kAeSteeringData])
-    {
-        dataset.mAeSteeringData = aeSteeringData->GetValue();
-        dataset.mPresentFlags |= CommissionerDataset::kAeSteeringDataBit;
-    }
-
-    if (auto nmkpSteeringData = tlvSet[tlv::Type::kNmkpSteeringData])
-    {
-        dataset.mNmkpSteeringData = nmkpSteeringData->GetValue();
-        dataset.mPresentFlags |= CommissionerDataset::kNmkpSteeringDataBit;
-    }
-
-    if (auto joinerUdpPort = tlvSet[tlv::Type::kJoinerUdpPort])
-    {
-        dataset.mJoinerUdpPort = joinerUdpPort->GetValueAsUint16();
-        dataset.mPresentFlags |= CommissionerDataset::kJoinerUdpPortBit;
-    }
-
-    if (auto aeUdpPort = tlvSet[tlv::Type::kAeUdpPort])
-    {
-        dataset.mAeUdpPort = aeUdpPort->GetValueAsUint16();
-        dataset.mPresentFlags |= CommissionerDataset::kAeUdpPortBit;
-    }
-
-    if (auto nmkpUdpPort = tlvSet[tlv::Type::kNmkpUdpPort])
-    {
-        dataset.mNmkpUdpPort = nmkpUdpPort->GetValueAsUint16();
-        dataset.mPresentFlags |= CommissionerDataset::kNmkpUdpPortBit;
-    }
+    Error         error;
+    tlv::TlvTable tlvTable;
 
-    aDataset = dataset;
+    SuccessOrExit(error = tlvTable.Parse(aResponse.GetPayload()));
+    SuccessOrExit(error = dataset::Decode(aDataset, tlvTable));
 
 exit:
     return error;
@@ -1853,96 +1485,7 @@ exit:
 
 Error CommissionerImpl::EncodeCommissionerDataset(coap::Request &aRequest, const CommissionerDataset &aDataset)
 {
-    Error error;
-
-    if (aDataset.mPresentFlags & CommissionerDataset::kSessionIdBit)
-    {
-        SuccessOrExit(error = AppendTlv(aRequest, {tlv::Type::kCommissionerSessionId, aDataset.mSessionId}));
-    }
-
-    if (aDataset.mPresentFlags & CommissionerDataset::kBorderAgentLocatorBit)
-    {
-        SuccessOrExit(error = AppendTlv(aRequest, {tlv::Type::kBorderAgentLocator, aDataset.mBorderAgentLocator}));
-    }
-
-    if (aDataset.mPresentFlags & CommissionerDataset::kSteeringDataBit)
-    {
-        SuccessOrExit(error = AppendTlv(aRequest, {tlv::Type::kSteeringData, aDataset.mSteeringData}));
-    }
-
-    if (aDataset.mPresentFlags & CommissionerDataset::kAeSteeringDataBit)
-    {
-        SuccessOrExit(error = AppendTlv(aRequest, {tlv::Type::kAeSteeringData, aDataset.mAeSteeringData}));
-    }
-
-    if (aDataset.mPresentFlags & CommissionerDataset::kNmkpSteeringDataBit)
-    {
-        SuccessOrExit(error = AppendTlv(aRequest, {tlv::Type::kNmkpSteeringData, aDataset.mNmkpSteeringData}));
-    }
-
-    if (aDataset.mPresentFlags & CommissionerDataset::kJoinerUdpPortBit)
-    {
-        SuccessOrExit(error = AppendTlv(aRequest, {tlv::Type::kJoinerUdpPort, aDataset.mJoinerUdpPort}));
-    }
-
-    if (aDataset.mPresentFlags & CommissionerDataset::kAeUdpPortBit)
-    {
-        SuccessOrExit(error = AppendTlv(aRequest, {tlv::Type::kAeUdpPort, aDataset.mAeUdpPort}));
-    }
-
-    if (aDataset.mPresentFlags & CommissionerDataset::kNmkpUdpPortBit)
-    {
-        SuccessOrExit(error = AppendTlv(aRequest, {tlv::Type::kNmkpUdpPort, aDataset.mNmkpUdpPort}));
-    }
-
-exit:
-    return error;
-}
-
-ByteArray CommissionerImpl::GetCommissionerDatasetTlvs(uint16_t aDatasetFlags)
-{
-    ByteArray tlvTypes;
-
-    if (aDatasetFlags & CommissionerDataset::kSessionIdBit)
-    {
-        tlvTypes.emplace_back(utils::to_underlying(tlv::Type::kCommissionerSessionId));
-    }
-
-    if (aDatasetFlags & CommissionerDataset::kBorderAgentLocatorBit)
-    {
-        tlvTypes.emplace_back(utils::to_underlying(tlv::Type::kBorderAgentLocator));
-    }
-
-    if (aDatasetFlags & CommissionerDataset::kSteeringDataBit)
-    {
-        tlvTypes.emplace_back(utils::to_underlying(tlv::Type::kSteeringData));
-    }
-
-    if (aDatasetFlags & CommissionerDataset::kAeSteeringDataBit)
-    {
-        tlvTypes.emplace_back(utils::to_underlying(tlv::Type::kAeSteeringData));
-    }
-
-    if (aDatasetFlags & CommissionerDataset::kNmkpSteeringDataBit)
-    {
-        tlvTypes.emplace_back(utils::to_underlying(tlv::Type::kNmkpSteeringData));
-    }
-
-    if (aDatasetFlags & CommissionerDataset::kJoinerUdpPortBit)
-    {
-        tlvTypes.emplace_back(utils::to_underlying(tlv::Type::kJoinerUdpPort));
-    }
-
-    if (aDatasetFlags & CommissionerDataset::kAeUdpPortBit)
-    {
-        tlvTypes.emplace_back(utils::to_underlying(tlv::Type::kAeUdpPort));
-    }
-
-    if (aDatasetFlags & CommissionerDataset::kNmkpUdpPortBit)
-    {
-        tlvTypes.emplace_back(utils::to_underlying(tlv::Type::kNmkpUdpPort));
-    }
-    return tlvTypes;
+    return dataset::Encode(aRequest.GetPayload(), aDataset);
 }
 
 void CommissionerImpl::SendProxyMessage(ErrorHandler aHandler, const std::string &aDstAddr, const std::string &aUriPath)
@@ -1983,33 +1526,34 @@ void CommissionerImpl::HandleDatasetChanged(const coap::Request &aRequest)
 
     mProxyClient.SendEmptyChanged(aRequest);
 
-    mCommissionerHandler.OnDatasetChanged();
+    DispatchToHandler([](CommissionerHandler &aHandler) { aHandler.OnDatasetChanged(); });
 }
 
 void CommissionerImpl::HandlePanIdConflict(const coap::Request &aRequest)
 {
-    Error       error;
-    tlv::TlvSet tlvSet;
-    tlv::TlvPtr channelMaskTlv;
-    tlv::TlvPtr panIdTlv;
-    ChannelMask channelMask;
-    uint16_t    panId;
-    std::string peerAddr = aRequest.GetEndpoint()->GetPeerAddr().ToString();
+    Error         error;
+    tlv::TlvTable tlvTable;
+    ChannelMask   channelMask;
+    uint16_t      panId;
+    std::string   peerAddr = aRequest.GetEndpoint()->GetPeerAddr().ToString();
 
     LOG_INFO(LOG_REGION_MGMT, "received MGMT_PANID_CONFLICT.ans from {}", peerAddr);
 
     mProxyClient.SendEmptyChanged(aRequest);
 
-    SuccessOrExit(error = GetTlvSet(tlvSet, aRequest));
-    VerifyOrExit((channelMaskTlv = tlvSet[tlv::Type::kChannelMask]) != nullptr,
+    SuccessOrExit(error = tlvTable.Parse(aRequest.GetPayload()));
+    VerifyOrExit(tlvTable[tlv::Type::kChannelMask].IsPresent(),
                  error = ERROR_BAD_FORMAT("no valid Channel Mask TLV in MGMT_PANID_CONFLICT.ans"));
-    VerifyOrExit((panIdTlv = tlvSet[tlv::Type::kPanId]) != nullptr,
+    VerifyOrExit(tlvTable[tlv::Type::kPanId].IsPresent(),
                  error = ERROR_BAD_FORMAT("no valid PAN ID TLV in MGMT_PANID_CONFLICT.ans"));
 
-    SuccessOrExit(error = DecodeChannelMask(channelMask, channelMaskTlv->GetValue()));
-    panId = panIdTlv->GetValueAsUint16();
+    SuccessOrExit(error = dataset::DecodeChannelMask(channelMask, tlvTable[tlv::Type::kChannelMask].GetValue(),
+                                                     tlvTable[tlv::Type::kChannelMask].GetLength()));
+    panId = tlvTable[tlv::Type::kPanId].GetValueAsUint16();
 
-    mCommissionerHandler.OnPanIdConflict(peerAddr, channelMask, panId);
+    DispatchToHandler([peerAddr, channelMask, panId](CommissionerHandler &aHandler) {
+        aHandler.OnPanIdConflict(peerAddr, channelMask, panId);
+    });
 
 exit:
     if (error != ErrorCode::kNone)
@@ -2020,27 +1564,30 @@ exit:
 
 void CommissionerImpl::HandleEnergyReport(const coap::Request &aRequest)
 {
-    Error       error;
-    tlv::TlvSet tlvSet;
-    ChannelMask channelMask;
-    ByteArray   energyList;
-    std::string peerAddr = aRequest.GetEndpoint()->GetPeerAddr().ToString();
+    Error         error;
+    tlv::TlvTable tlvTable;
+    ChannelMask   channelMask;
+    ByteArray     energyList;
+    std::string   peerAddr = aRequest.GetEndpoint()->GetPeerAddr().ToString();
 
     LOG_INFO(LOG_REGION_MGMT, "received MGMT_ED_REPORT.ans from {}", peerAddr);
 
     mProxyClient.SendEmptyChanged(aRequest);
 
-    SuccessOrExit(error = GetTlvSet(tlvSet, aRequest));
-    if (auto channelMaskTlv = tlvSet[tlv::Type::kChannelMask])
+    SuccessOrExit(error = tlvTable.Parse(aRequest.GetPayload()));
+    if (auto &channelMaskTlv = tlvTable[tlv::Type::kChannelMask])
     {
-        SuccessOrExit(error = DecodeChannelMask(channelMask, channelMaskTlv->GetValue()));
+        SuccessOrExit(error = dataset::DecodeChannelMask(channelMask, channelMaskTlv.GetValue(),
+                                                         channelMaskTlv.GetLength()));
     }
-    if (auto eneryListTlv = tlvSet[tlv::Type::kEnergyList])
+    if (auto &eneryListTlv = tlvTable[tlv::Type::kEnergyList])
     {
-        energyList = eneryListTlv->GetValue();
+        energyList = eneryListTlv.GetValueAsByteArray();
     }
 
-    mCommissionerHandler.OnEnergyReport(peerAddr, channelMask, energyList);
+    DispatchToHandler([peerAddr, channelMask, energyList](CommissionerHandler &aHandler) {
+        aHandler.OnEnergyReport(peerAddr, channelMask, energyList);
+    });
 
 exit:
     if (error != ErrorCode::kNone)
@@ -2072,7 +1619,7 @@ Error CommissionerImpl::MakeChannelMask(ByteArray &aBuf, uint32_t aChannelMask)
     }
 
     VerifyOrExit(!entry.mMasks.empty(), error = ERROR_INVALID_ARGS("no valid Channel Masks provided"));
-    SuccessOrDie(EncodeChannelMask(aBuf, {entry}));
+    SuccessOrDie(dataset::EncodeChannelMask(aBuf, {entry}));
 
 exit:
     return error;
@@ -2080,84 +1627,125 @@ exit:
 
 void CommissionerImpl::HandleRlyRx(const coap::Request &aRlyRx)
 {
-    Error       error;
-    tlv::TlvSet tlvSet;
-    tlv::TlvPtr tlv;
+    Error         error;
+    tlv::TlvTable tlvTable;
 
-    std::string joinerPSKd;
-    uint16_t    joinerUdpPort;
-    uint16_t    joinerRouterLocator;
-    ByteArray   joinerIid;
-    ByteArray   joinerId;
-    ByteArray   dtlsRecords;
+    uint16_t     joinerUdpPort;
+    uint16_t     joinerRouterLocator;
+    ByteArray    joinerId;
+    tlv::TlvView dtlsRecords;
 
-    SuccessOrExit(error = GetTlvSet(tlvSet, aRlyRx));
+    SuccessOrExit(error = tlvTable.Parse(aRlyRx.GetPayload()));
 
-    VerifyOrExit((tlv = tlvSet[tlv::Type::kJoinerUdpPort]) != nullptr,
+    VerifyOrExit(tlvTable[tlv::Type::kJoinerUdpPort].IsPresent(),
                  error = ERROR_BAD_FORMAT("no valid Joiner UDP Port TLV found"));
-    joinerUdpPort = tlv->GetValueAsUint16();
+    joinerUdpPort = tlvTable[tlv::Type::kJoinerUdpPort].GetValueAsUint16();
 
-    VerifyOrExit((tlv = tlvSet[tlv::Type::kJoinerRouterLocator]) != nullptr,
+    VerifyOrExit(tlvTable[tlv::Type::kJoinerRouterLocator].IsPresent(),
                  error = ERROR_BAD_FORMAT("no valid Joiner Router Locator TLV found"));
-    joinerRouterLocator = tlv->GetValueAsUint16();
+    joinerRouterLocator = tlvTable[tlv::Type::kJoinerRouterLocator].GetValueAsUint16();
 
-    VerifyOrExit((tlv = tlvSet[tlv::Type::kJoinerIID]) != nullptr,
+    VerifyOrExit(tlvTable[tlv::Type::kJoinerIID].IsPresent(),
                  error = ERROR_BAD_FORMAT("no valid Joiner IID TLV found"));
-    joinerIid = tlv->GetValue();
+    joinerId = tlvTable[tlv::Type::kJoinerIID].GetValueAsByteArray();
 
-    VerifyOrExit((tlv = tlvSet[tlv::Type::kJoinerDtlsEncapsulation]) != nullptr,
+    VerifyOrExit((dtlsRecords = tlvTable[tlv::Type::kJoinerDtlsEncapsulation]).IsPresent(),
                  error = ERROR_BAD_FORMAT("no valid Joiner DTLS Encapsulation TLV found"));
-    dtlsRecords = tlv->GetValue();
 
-    joinerId = joinerIid;
     joinerId[0] ^= kLocalExternalAddrMask;
     LOG_DEBUG(LOG_REGION_JOINER_SESSION, "received RLY_RX.ntf: joinerID={}, joinerRouterLocator={}, length={}",
-              utils::Hex(joinerId), joinerRouterLocator, dtlsRecords.size());
-
-    joinerPSKd = mCommissionerHandler.OnJoinerRequest(joinerId);
-    if (joinerPSKd.empty())
-    {
-        LOG_INFO(LOG_REGION_JOINER_SESSION, "joiner(ID={}) is disabled", utils::Hex(joinerId));
-        ExitNow(error = ERROR_REJECTED("joiner(ID={}) is disabled", utils::Hex(joinerId)));
-    }
+              utils::Hex(joinerId), joinerRouterLocator, dtlsRecords.GetLength());
 
     {
         auto it = mJoinerSessions.find(joinerId);
-        if (it != mJoinerSessions.end() && it->second.Disabled())
+        if (it != mJoinerSessions.end() && !it->second.Disabled())
         {
-            mJoinerSessions.erase(it);
-            it = mJoinerSessions.end();
+            it->second.RecvJoinerDtlsRecords(dtlsRecords.GetValue(), dtlsRecords.GetLength());
+            ExitNow();
         }
+    }
 
-        if (it == mJoinerSessions.end())
-        {
-            Address localAddr;
+    RequestJoinerPSKd({joinerId,
+                       joinerUdpPort,
+                       joinerRouterLocator,
+                       aRlyRx.GetEndpoint()->GetPeerAddr(),
+                       aRlyRx.GetEndpoint()->GetPeerPort(),
+                       {dtlsRecords.GetValue(), dtlsRecords.GetValue() + dtlsRecords.GetLength()}});
+
+exit:
+    if (error != ErrorCode::kNone)
+    {
+        LOG_ERROR(LOG_REGION_JOINER_SESSION, "failed to handle RLY_RX.ntf message: {}", error.ToString());
+    }
+}
 
-            SuccessOrExit(error = mBrClient.GetLocalAddr(localAddr));
-            it = mJoinerSessions
-                     .emplace(std::piecewise_construct, std::forward_as_tuple(joinerId),
-                              std::forward_as_tuple(*this, joinerId, joinerPSKd, joinerUdpPort, joinerRouterLocator,
-                                                    aRlyRx.GetEndpoint()->GetPeerAddr(),
-                                                    aRlyRx.GetEndpoint()->GetPeerPort(), localAddr,
-                                                    kListeningJoinerPort))
-                     .first;
-            auto &session = it->second;
+void CommissionerImpl::RequestJoinerPSKd(const JoinerRequest &aRequest)
+{
+    const ByteArray &joinerId  = aRequest.mJoinerId;
+    uint64_t         requestId = mNextJoinerRequestId++;
 
-            std::string peerAddr = session.GetPeerAddr().ToString();
+    if (!mPendingJoinerRequests.emplace(joinerId, requestId).second)
+    {
+        LOG_DEBUG(LOG_REGION_JOINER_SESSION, "joiner(ID={}) is waiting for PSKd, DTLS records dropped",
+                  utils::Hex(joinerId));
+        ExitNow();
+    }
 
-            LOG_DEBUG(LOG_REGION_JOINER_SESSION, "received a new joiner(ID={}) DTLS connection from [{}]:{}",
-                      utils::Hex(joinerId), peerAddr, session.GetPeerPort());
+    // The session is created when the handler answers.
+    {
+        auto onPSKd = BindEventLoop<std::string>(mLifetime, [this, aRequest, requestId](std::string aPSKd) {
+            HandleJoinerPSKd(aRequest, requestId, aPSKd);
+        });
 
-            session.Connect();
+        DispatchToHandler(
+            [joinerId, onPSKd](CommissionerHandler &aHandler) { aHandler.OnJoinerRequestAsync(joinerId, onPSKd); });
+    }
 
-            LOG_INFO(LOG_REGION_JOINER_SESSION, "joiner session timer started, expiration-time={}",
-                     TimePointToString(session.GetExpirationTime()));
-            mJoinerSessionTimer.Start(session.GetExpirationTime());
-        }
+exit:
+    return;
+}
 
-        ASSERT(it != mJoinerSessions.end());
-        auto &session = it->second;
-        session.RecvJoinerDtlsRecords(dtlsRecords);
+void CommissionerImpl::HandleJoinerPSKd(const JoinerRequest &aRequest, uint64_t aRequestId, const std::string &aPSKd)
+{
+    Error   error;
+    Address localAddr;
+    auto    pending = mPendingJoinerRequests.find(aRequest.mJoinerId);
+
+    // The request has been cancelled, and the joiner may be waiting for a newer one.
+    VerifyOrExit(pending != mPendingJoinerRequests.end() && pending->second == aRequestId);
+    mPendingJoinerRequests.erase(pending);
+
+    if (aPSKd.empty())
+    {
+        LOG_INFO(LOG_REGION_JOINER_SESSION, "joiner(ID={}) is disabled", utils::Hex(aRequest.mJoinerId));
+        ExitNow(error = ERROR_REJECTED("joiner(ID={}) is disabled", utils::Hex(aRequest.mJoinerId)));
+    }
+
+    SuccessOrExit(error = mBrClient.GetLocalAddr(localAddr));
+
+    // Replaces the disabled session, if any.
+    mJoinerSessions.erase(aRequest.mJoinerId);
+
+    {
+        auto &session = mJoinerSessions
+                            .emplace(std::piecewise_construct, std::forward_as_tuple(aRequest.mJoinerId),
+                                     std::forward_as_tuple(*this, aRequest.mJoinerId, aPSKd, aRequest.mJoinerUdpPort,
+                                                           aRequest.mJoinerRouterLocator, aRequest.mJoinerAddr,
+                                                           aRequest.mJoinerPort, localAddr, kListeningJoinerPort))
+                            .first->second;
+
+        std::string peerAddr = session.GetPeerAddr().ToString();
+
+        LOG_DEBUG(LOG_REGION_JOINER_SESSION, "received a new joiner(ID={}) DTLS connection from [{}]:{}",
+                  utils::Hex(aRequest.mJoinerId), peerAddr, session.GetPeerPort());
+
+        session.Connect();
+
+        LOG_INFO(LOG_REGION_JOINER_SESSION, "joiner session timer started, expiration-time={}",
+                 TimePointToString(session.GetExpirationTime()));
+        mJoinerSessionTimer.Start(session.GetExpirationTime());
+
+        session.RecvJoinerDtlsRecords(aRequest.mDtlsRecords.data(), aRequest.mDtlsRecords.size());
     }
 
 exit:
@@ -2167,6 +1755,20 @@ exit:
     }
 }
 
+void CommissionerImpl::DispatchToHandler(std::function<void(CommissionerHandler &aHandler)> aCallback)
+{
+    if (mConfig.mHandlerExecutor != nullptr)
+    {
+        auto handler = &mCommissionerHandler;
+
+        mConfig.mHandlerExecutor([handler, aCallback]() { aCallback(*handler); });
+    }
+    else
+    {
+        aCallback(mCommissionerHandler);
+    }
+}
+
 void CommissionerImpl::HandleJoinerSessionTimer(Timer &aTimer)
 {
     TimePoint nextShot;
@@ -31,6 +31,8 @@
 
 #include <atomic>
 #include <memory>
+#include <map>
+#include <thread>
 
 #include <commissioner/commissioner.hpp>
 
@@ -66,9 +68,19 @@ namespace commissioner {
 class CommissionerImpl : public Commissioner
 {
     friend class JoinerSession;
+    friend class JoinerRequestTest;
 
 public:
-    explicit CommissionerImpl(CommissionerHandler &aHandler, struct event_base *aEventBase);
+    // @p aDtlsResources are shared with other commissioners running in the
+    // same event loop. If it is null, each DTLS session creates its own.
+    //
+    // @p aEventLoopExecutor runs tasks in the event loop and is called by
+    // completions of the asynchronous handlers from other threads. If it
+    // is null, the completions must be called in the event-loop thread.
+    explicit CommissionerImpl(CommissionerHandler &aHandler,
+                              struct event_base *  aEventBase,
+                              DtlsResourcesPtr     aDtlsResources     = nullptr,
+                              Executor             aEventLoopExecutor = nullptr);
 
     CommissionerImpl(const CommissionerImpl &aCommissioner) = delete;
     const CommissionerImpl &operator=(const CommissionerImpl &aCommissioner) = delete;
@@ -93,6 +105,8 @@ public:
 
     void  Connect(ErrorHandler aHandler, const std::string &aAddr, uint16_t aPort) override;
     Error Connect(const std::string &, uint16_t) override { return ERROR_UNIMPLEMENTED(""); }
+    void  Connect(Handler<ConnectResult> aHandler, const std::vector<BorderAgentAddr> &aBorderAgents) override;
+    Error Connect(ConnectResult &, const std::vector<BorderAgentAddr> &) override { return ERROR_UNIMPLEMENTED(""); }
 
     void Disconnect() override;
 
@@ -191,33 +205,40 @@ public:
 
     struct event_base *GetEventBase() { return mEventBase; }
 
+    const DtlsConfig &GetDtlsConfig() const { return mDtlsConfig; }
+
 private:
     using AsyncRequest = std::function<void()>;
 
+    // A joiner request waiting for the PSKd from the handler.
+    struct JoinerRequest
+    {
+        ByteArray mJoinerId;
+        uint16_t  mJoinerUdpPort;
+        uint16_t  mJoinerRouterLocator;
+        Address   mJoinerAddr;
+        uint16_t  mJoinerPort;
+        ByteArray mDtlsRecords;
+    };
+
     static Error ValidateConfig(const Config &aConfig);
     void         LoggingConfig();
 
     static Error HandleStateResponse(const coap::Response *aResponse, Error aError);
 
-    static ByteArray GetActiveOperationalDatasetTlvs(uint16_t aDatasetFlags);
-    static ByteArray GetPendingOperationalDatasetTlvs(uint16_t aDatasetFlags);
-
     static Error DecodeActiveOperationalDataset(ActiveOperationalDataset &aDataset, const ByteArray &aPayload);
+    static Error DecodeActiveOperationalDataset(ActiveOperationalDataset &aDataset, const tlv::TlvTable &aTlvTable);
     static Error DecodePendingOperationalDataset(PendingOperationalDataset &aDataset, const coap::Response &aResponse);
-    static Error DecodeChannelMask(ChannelMask &aChannelMask, const ByteArray &aBuf);
     static Error EncodeActiveOperationalDataset(coap::Request &aRequest, const ActiveOperationalDataset &aDataset);
     static Error EncodePendingOperationalDataset(coap::Request &aRequest, const PendingOperationalDataset &aDataset);
-    static Error EncodeChannelMask(ByteArray &aBuf, const ChannelMask &aChannelMask);
 
 #if OT_COMM_CONFIG_CCM_ENABLE
-    static Error     DecodeBbrDataset(BbrDataset &aDataset, const coap::Response &aResponse);
-    static Error     EncodeBbrDataset(coap::Request &aRequest, const BbrDataset &aDataset);
-    static ByteArray GetBbrDatasetTlvs(uint16_t aDatasetFlags);
+    static Error DecodeBbrDataset(BbrDataset &aDataset, const coap::Response &aResponse);
+    static Error EncodeBbrDataset(coap::Request &aRequest, const BbrDataset &aDataset);
 #endif
 
-    static Error     DecodeCommissionerDataset(CommissionerDataset &aDataset, const coap::Response &aResponse);
-    static Error     EncodeCommissionerDataset(coap::Request &aRequest, const CommissionerDataset &aDataset);
-    static ByteArray GetCommissionerDatasetTlvs(uint16_t aDatasetFlags);
+    static Error DecodeCommissionerDataset(CommissionerDataset &aDataset, const coap::Response &aResponse);
+    static Error EncodeCommissionerDataset(coap::Request &aRequest, const CommissionerDataset &aDataset);
 
     void SendPetition(PetitionHandler aHandler);
 
@@ -240,11 +261,49 @@ private:
 
     void HandleRlyRx(const coap::Request &aRequest);
 
+    // Asks the handler for the PSKd of a joiner without a session,
+    // unless the joiner is waiting for it already.
+    void RequestJoinerPSKd(const JoinerRequest &aRequest);
+    void HandleJoinerPSKd(const JoinerRequest &aRequest, uint64_t aRequestId, const std::string &aPSKd);
+
     void HandleJoinerSessionTimer(Timer &aTimer);
 
+    // Calls a handler callback, in the handler executor if there is one.
+    // The callback must not access this commissioner.
+    void DispatchToHandler(std::function<void(CommissionerHandler &aHandler)> aCallback);
+
+    // Returns a function which calls @p aTask in the event loop, it can be
+    // called in any thread. The task is dropped if @p aLifetime has expired
+    // by then. This must be called in the event-loop thread.
+    template <typename Arg, typename Task>
+    std::function<void(Arg)> BindEventLoop(std::weak_ptr<void> aLifetime, Task aTask)
+    {
+        auto eventLoop       = mEventLoopExecutor;
+        auto eventLoopThread = std::this_thread::get_id();
+
+        return [eventLoop, eventLoopThread, aLifetime, aTask](Arg aArg) {
+            std::function<void()> task = [aLifetime, aTask, aArg]() {
+                if (!aLifetime.expired())
+                {
+                    aTask(aArg);
+                }
+            };
+
+            if (eventLoop == nullptr || std::this_thread::get_id() == eventLoopThread)
+            {
+                task();
+            }
+            else
+            {
+                eventLoop(std::move(task));
+            }
+        };
+    }
+
 private:
-    State    mState;
-    uint16_t mSessionId; ///< The Commissioner Session ID.
+    // Read by IsActive() in any thread through CommissionerSafe.
+    std::atomic<State> mState;
+    uint16_t           mSessionId; ///< The Commissioner Session ID.
 
 private:
     /*
@@ -253,9 +312,17 @@ private:
 
     CommissionerHandler &mCommissionerHandler;
     struct event_base *  mEventBase;
+    Executor             mEventLoopExecutor;
+
+    // Expires when this commissioner is destroyed, completions
+    // of asynchronous handlers are dropped after that.
+    std::shared_ptr<void> mLifetime;
 
     Config mConfig;
 
+    DtlsResourcesPtr mDtlsResources;
+    DtlsConfig       mDtlsConfig;
+
     Timer mKeepAliveTimer;
 
     coap::CoapSecure mBrClient;
@@ -263,6 +330,12 @@ private:
     std::map<ByteArray, JoinerSession> mJoinerSessions;
     Timer                              mJoinerSessionTimer;
 
+    // Joiners waiting for the PSKd from the handler, and the ID of their
+    // requests. Their DTLS records are dropped meanwhile, the joiner
+    // retransmits them. Requests are cancelled when disconnected.
+    std::map<ByteArray, uint64_t> mPendingJoinerRequests;
+    uint64_t                      mNextJoinerRequestId = 0;
+
     coap::Resource mResourceUdpRx;
     coap::Resource mResourceRlyRx;
 
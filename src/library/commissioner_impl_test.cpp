@@ -36,6 +36,8 @@
 
 #include "library/commissioner_impl.hpp"
 
+#include <deque>
+
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch.hpp>
 
@@ -87,6 +89,24 @@ TEST_CASE("pskc-test-vector-from-thread-1.2.0-spec", "[pskc]")
     REQUIRE(utils::Hex(pskc) == "c3f59368445a1b6106be420a706d4cc9");
 }
 
+TEST_CASE("pskc-test-batch", "[pskc]")
+{
+    const ByteArray         extendedPanId = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07};
+    std::vector<ByteArray>  pskcList;
+    std::vector<PSKcParams> paramsList = {{"12SECRETPASSWORD34", "Test Network", extendedPanId},
+                                          {"12SECRETPASSWORD34", "Test Network 2", extendedPanId}};
+
+    REQUIRE(Commissioner::GeneratePSKc(pskcList, paramsList, 2, false) == ErrorCode::kNone);
+    REQUIRE(pskcList.size() == paramsList.size());
+    REQUIRE(utils::Hex(pskcList[0]) == "c3f59368445a1b6106be420a706d4cc9");
+
+    REQUIRE(Commissioner::GeneratePSKc(pskcList, paramsList, 2, true) == ErrorCode::kNone);
+    REQUIRE(utils::Hex(pskcList[0]) == "c3f59368445a1b6106be420a706d4cc9");
+
+    paramsList.push_back({"12S", "Test Network", extendedPanId});
+    REQUIRE(Commissioner::GeneratePSKc(pskcList, paramsList, 2, true).GetCode() == ErrorCode::kInvalidArgs);
+}
+
 TEST_CASE("pskc-test-invalid-args", "[pskc]")
 {
     SECTION("passphrase is too short")
@@ -123,6 +143,45 @@ TEST_CASE("pskc-test-invalid-args", "[pskc]")
     }
 }
 
+TEST_CASE("commissioner-handler-async-defaults", "[comm-impl]")
+{
+    class Handler : public CommissionerHandler
+    {
+    public:
+        std::string OnJoinerRequest(const ByteArray &aJoinerId) override { return aJoinerId.empty() ? "" : "ABCDEF"; }
+
+        bool OnJoinerFinalize(const ByteArray &,
+                              const std::string &aVendorName,
+                              const std::string &,
+                              const std::string &,
+                              const ByteArray &,
+                              const std::string &,
+                              const ByteArray &) override
+        {
+            return aVendorName == "OpenThread";
+        }
+    };
+
+    Handler     handler;
+    std::string pskd;
+    bool        accepted = false;
+
+    // The asynchronous variants answer with the synchronous ones by default.
+    handler.OnJoinerRequestAsync({0x01, 0x02}, [&pskd](const std::string &aPSKd) { pskd = aPSKd; });
+    REQUIRE(pskd == "ABCDEF");
+
+    handler.OnJoinerRequestAsync({}, [&pskd](const std::string &aPSKd) { pskd = aPSKd; });
+    REQUIRE(pskd.empty());
+
+    handler.OnJoinerFinalizeAsync({0x01, 0x02}, "OpenThread", "", "", {}, "", {},
+                                  [&accepted](bool aAccepted) { accepted = aAccepted; });
+    REQUIRE(accepted);
+
+    handler.OnJoinerFinalizeAsync({0x01, 0x02}, "Unknown", "", "", {}, "", {},
+                                  [&accepted](bool aAccepted) { accepted = aAccepted; });
+    REQUIRE_FALSE(accepted);
+}
+
 TEST_CASE("commissioner-impl-not-implemented-APIs", "[comm-impl]")
 {
     static const std::string kDstAddr = "fd00:7d03:7d03:7d03:d020:79b7:6a02:ab5e";
@@ -177,6 +236,113 @@ TEST_CASE("commissioner-impl-not-implemented-APIs", "[comm-impl]")
     event_base_free(eventBase);
 }
 
+// Reaches the joiner requests of a CommissionerImpl, which are otherwise
+// made only by RLY_RX.ntf messages from a connected border agent.
+class JoinerRequestTest
+{
+public:
+    static void Request(CommissionerImpl &aCommImpl, const ByteArray &aJoinerId)
+    {
+        aCommImpl.RequestJoinerPSKd({aJoinerId, 1000, 0x0400, Address{}, 1000, {0x16, 0xfe, 0xfd}});
+    }
+
+    static bool IsPending(const CommissionerImpl &aCommImpl, const ByteArray &aJoinerId)
+    {
+        return aCommImpl.mPendingJoinerRequests.count(aJoinerId) != 0;
+    }
+};
+
+TEST_CASE("commissioner-impl-joiner-request-pending-PSKd", "[comm-impl]")
+{
+    class Handler : public CommissionerHandler
+    {
+    public:
+        void OnJoinerRequestAsync(const ByteArray &aJoinerId, PSKdHandler aHandler) override
+        {
+            mJoinerIds.push_back(aJoinerId);
+            mPSKdHandlers.push_back(aHandler);
+        }
+
+        std::vector<ByteArray>   mJoinerIds;
+        std::vector<PSKdHandler> mPSKdHandlers;
+    };
+
+    const ByteArray kJoinerId1 = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+    const ByteArray kJoinerId2 = {0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18};
+
+    std::deque<std::function<void()>> handlerTasks;
+
+    Config config;
+    config.mEnableCcm = false;
+    config.mPSKc = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+    config.mHandlerExecutor = [&handlerTasks](std::function<void()> aTask) { handlerTasks.push_back(aTask); };
+
+    auto runHandlerTasks = [&handlerTasks]() {
+        while (!handlerTasks.empty())
+        {
+            handlerTasks.front()();
+            handlerTasks.pop_front();
+        }
+    };
+
+    Handler             handler;
+    struct event_base * eventBase = event_base_new();
+    CommissionerImpl    commImpl(handler, eventBase);
+    REQUIRE(commImpl.Init(config) == ErrorCode::kNone);
+
+    JoinerRequestTest::Request(commImpl, kJoinerId1);
+    REQUIRE(JoinerRequestTest::IsPending(commImpl, kJoinerId1));
+
+    SECTION("the handler is called on the handler executor")
+    {
+        REQUIRE(handlerTasks.size() == 1);
+        REQUIRE(handler.mJoinerIds.empty());
+
+        runHandlerTasks();
+        REQUIRE(handler.mJoinerIds == std::vector<ByteArray>{kJoinerId1});
+    }
+
+    SECTION("DTLS records replayed while the PSKd is pending are dropped")
+    {
+        JoinerRequestTest::Request(commImpl, kJoinerId1);
+        JoinerRequestTest::Request(commImpl, kJoinerId1);
+        JoinerRequestTest::Request(commImpl, kJoinerId2);
+        runHandlerTasks();
+        REQUIRE(handler.mJoinerIds == std::vector<ByteArray>{kJoinerId1, kJoinerId2});
+
+        // The joiner is asked for again once the handler answered.
+        handler.mPSKdHandlers[0]("");
+        REQUIRE_FALSE(JoinerRequestTest::IsPending(commImpl, kJoinerId1));
+        REQUIRE(JoinerRequestTest::IsPending(commImpl, kJoinerId2));
+
+        JoinerRequestTest::Request(commImpl, kJoinerId1);
+        runHandlerTasks();
+        REQUIRE(handler.mJoinerIds == std::vector<ByteArray>{kJoinerId1, kJoinerId2, kJoinerId1});
+    }
+
+    SECTION("pending requests are cancelled when disconnected")
+    {
+        runHandlerTasks();
+        REQUIRE(handler.mPSKdHandlers.size() == 1);
+
+        commImpl.Disconnect();
+        REQUIRE_FALSE(JoinerRequestTest::IsPending(commImpl, kJoinerId1));
+
+        JoinerRequestTest::Request(commImpl, kJoinerId1);
+        runHandlerTasks();
+        REQUIRE(handler.mPSKdHandlers.size() == 2);
+
+        // The answer to the cancelled request leaves the new one pending.
+        handler.mPSKdHandlers[0]("ABCDEF");
+        REQUIRE(JoinerRequestTest::IsPending(commImpl, kJoinerId1));
+
+        handler.mPSKdHandlers[1]("");
+        REQUIRE_FALSE(JoinerRequestTest::IsPending(commImpl, kJoinerId1));
+    }
+
+    event_base_free(eventBase);
+}
+
 } // namespace commissioner
 
 } // namespace ot
@@ -51,28 +51,34 @@ std::shared_ptr<Commissioner> Commissioner::Create(CommissionerHandler &aHandler
 
 Error CommissionerSafe::Init(const Config &aConfig)
 {
-    Error                             error;
-    std::shared_ptr<CommissionerImpl> impl;
+    Error error;
 
-    // The default timeout value (1 day) for non-IO events (events with fd < 0).
-    constexpr struct timeval kDefaultNonIoEventTimeout = {3600 * 24, 0};
-
-    VerifyOrExit(mEventBase.Get() != nullptr, error = ERROR_OUT_OF_MEMORY("failed to create event base"));
-
-    error = ERROR_UNKNOWN("failed to initialize event base");
-    VerifyOrExit(evthread_use_pthreads() == 0);
-    VerifyOrExit(evthread_make_base_notifiable(mEventBase.Get()) == 0);
-    VerifyOrExit(event_assign(&mInvokeEvent, mEventBase.Get(), -1, EV_PERSIST, Invoke, this) == 0);
-
-    // We add the event with a timeout value so that the event loop will not
-    // exit prematurely because of no events.
-    VerifyOrExit(event_add(&mInvokeEvent, &kDefaultNonIoEventTimeout) == 0);
+    if (mEventLoop == nullptr)
+    {
+        auto eventLoop = std::make_shared<EventLoop>();
 
-    impl = std::make_shared<CommissionerImpl>(mHandler, mEventBase.Get());
-    SuccessOrExit(error = impl->Init(aConfig));
-    mImpl = impl;
+        SuccessOrExit(error = eventLoop->Start());
+        mEventLoop = eventLoop;
+    }
 
-    StartEventLoopThread();
+    // The event loop may be running for other commissioners, the
+    // implementation must be created in the event-loop thread.
+    mEventLoop->PostAndWait([this, &aConfig, &error]() {
+        std::weak_ptr<EventLoop> eventLoop         = mEventLoop;
+        auto                     eventLoopExecutor = [eventLoop](std::function<void()> aTask) {
+            if (auto loop = eventLoop.lock())
+            {
+                loop->Post(std::move(aTask));
+            }
+        };
+        auto impl = std::make_shared<CommissionerImpl>(mHandler, mEventLoop->GetEventBase(),
+                                                       mEventLoop->GetDtlsResources(), eventLoopExecutor);
+
+        if ((error = impl->Init(aConfig)) == ErrorCode::kNone)
+        {
+            mImpl = impl;
+        }
+    });
 
 exit:
     return error;
@@ -80,7 +86,15 @@ exit:
 
 CommissionerSafe::~CommissionerSafe()
 {
-    StopEventLoopThread();
+    VerifyOrExit(mEventLoop != nullptr && mImpl != nullptr);
+
+    // Destroy the implementation in the event-loop thread after
+    // all requests issued before. The event loop is stopped when
+    // it is no longer used by any commissioner.
+    mEventLoop->PostAndWait([this]() { mImpl.reset(); });
+
+exit:
+    return;
 }
 
 const Config &CommissionerSafe::GetConfig() const
@@ -89,50 +103,37 @@ const Config &CommissionerSafe::GetConfig() const
     return mImpl->GetConfig();
 }
 
-void CommissionerSafe::StartEventLoopThread()
+void CommissionerSafe::Connect(ErrorHandler aHandler, const std::string &aAddr, uint16_t aPort)
 {
-    ASSERT(!mEventThread.joinable());
-
-    mEventThread = std::thread([this]() {
-        LOG_INFO(LOG_REGION_MESHCOP, "event loop started in background thread");
-        event_base_loop(mEventBase.Get(), 0);
-    });
+    PushAsyncRequest([=]() { mImpl->Connect(aHandler, aAddr, aPort); });
 }
 
-void CommissionerSafe::StopEventLoopThread(void)
+Error CommissionerSafe::Connect(const std::string &aAddr, uint16_t aPort)
 {
-    std::promise<void> pro;
-
-    VerifyOrExit(mEventBase.Get() != nullptr && mImpl != nullptr);
-    VerifyOrExit(mEventThread.joinable());
-
-    // Send `Stop` to the event loop to break it from inside.
-    // This makes sure the event loop has been started when we
-    // trying to break it.
-    PushAsyncRequest([&pro, this]() {
-        event_base_loopbreak(mEventBase.Get());
-        pro.set_value();
-    });
-
-    pro.get_future().wait();
-
-    mEventThread.join();
+    std::promise<Error> pro;
+    auto                wait = [&pro](Error aError) { pro.set_value(aError); };
 
-exit:
-    return;
+    Connect(wait, aAddr, aPort);
+    return pro.get_future().get();
 }
 
-void CommissionerSafe::Connect(ErrorHandler aHandler, const std::string &aAddr, uint16_t aPort)
+void CommissionerSafe::Connect(Handler<ConnectResult> aHandler, const std::vector<BorderAgentAddr> &aBorderAgents)
 {
-    PushAsyncRequest([=]() { mImpl->Connect(aHandler, aAddr, aPort); });
+    PushAsyncRequest([=]() { mImpl->Connect(aHandler, aBorderAgents); });
 }
 
-Error CommissionerSafe::Connect(const std::string &aAddr, uint16_t aPort)
+Error CommissionerSafe::Connect(ConnectResult &aResult, const std::vector<BorderAgentAddr> &aBorderAgents)
 {
     std::promise<Error> pro;
-    auto                wait = [&pro](Error aError) { pro.set_value(aError); };
+    auto                wait = [&pro, &aResult](const ConnectResult *result, Error error) {
+        if (result != nullptr)
+        {
+            aResult = *result;
+        }
+        pro.set_value(error);
+    };
 
-    Connect(wait, aAddr, aPort);
+    Connect(wait, aBorderAgents);
     return pro.get_future().get();
 }
 
@@ -540,54 +541,9 @@ Error CommissionerSafe::SetToken(const ByteArray &aSignedToken, const ByteArray
     return pro.get_future().get();
 }
 
-void CommissionerSafe::Invoke(evutil_socket_t, short, void *aContext)
-{
-    auto commissionerSafe = reinterpret_cast<CommissionerSafe *>(aContext);
-
-    VerifyOrDie(commissionerSafe != nullptr);
-
-    if (auto asyncReq = commissionerSafe->PopAsyncRequest())
-    {
-        asyncReq();
-    }
-}
-
 void CommissionerSafe::PushAsyncRequest(AsyncRequest &&aAsyncRequest)
 {
-    std::lock_guard<std::mutex> _(mInvokeMutex);
-
-    mAsyncRequestQueue.emplace(std::move(aAsyncRequest));
-
-    // Notify for new async request
-    event_active(&mInvokeEvent, 0, 0);
-}
-
-CommissionerSafe::AsyncRequest CommissionerSafe::PopAsyncRequest()
-{
-    std::lock_guard<std::mutex> _(mInvokeMutex);
-
-    if (!mAsyncRequestQueue.empty())
-    {
-        auto ret = mAsyncRequestQueue.front();
-        mAsyncRequestQueue.pop();
-        return ret;
-    }
-    return nullptr;
-}
-
-CommissionerSafe::EventBaseHolder::EventBaseHolder()
-    : mEventBase(event_base_new())
-{
-}
-
-CommissionerSafe::EventBaseHolder::~EventBaseHolder()
-{
-    event_base_free(mEventBase);
-}
-
-struct event_base *CommissionerSafe::EventBaseHolder::Get()
-{
-    return mEventBase;
+    mEventLoop->Post(std::move(aAsyncRequest));
 }
 
 } // namespace commissioner
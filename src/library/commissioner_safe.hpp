@@ -34,8 +34,7 @@
 #ifndef OT_COMM_LIBRARY_COMMISSIONER_SAFE_HPP_
 #define OT_COMM_LIBRARY_COMMISSIONER_SAFE_HPP_
 
-#include <mutex>
-#include <thread>
+#include <memory>
 
 #include <commissioner/commissioner.hpp>
 
@@ -44,6 +43,7 @@
 #include "library/commissioner_impl.hpp"
 #include "library/dtls.hpp"
 #include "library/event.hpp"
+#include "library/event_loop.hpp"
 #include "library/timer.hpp"
 #include "library/tlv.hpp"
 #include "library/token_manager.hpp"
@@ -62,12 +62,19 @@ namespace commissioner {
  * Commissioner API from a user thread. But it is not safe to
  * concurrently call a Commissioner API from multiple user threads.
  *
+ * The event loop can be shared with other commissioners (see
+ * CommissionerHost), in which case handlers of all of them are
+ * called in the same event-loop thread.
+ *
  */
 class CommissionerSafe : public Commissioner
 {
 public:
-    CommissionerSafe(CommissionerHandler &aHandler)
+    // The commissioner runs in @p aEventLoop if it is not null, which may be
+    // shared with other commissioners. Otherwise, it starts its own event loop.
+    explicit CommissionerSafe(CommissionerHandler &aHandler, EventLoopPtr aEventLoop = nullptr)
         : mHandler(aHandler)
+        , mEventLoop(aEventLoop)
     {
     }
 
@@ -94,6 +101,8 @@ public:
 
     void  Connect(ErrorHandler aHandler, const std::string &aAddr, uint16_t aPort) override;
     Error Connect(const std::string &aAddr, uint16_t aPort) override;
+    void  Connect(Handler<ConnectResult> aHandler, const std::vector<BorderAgentAddr> &aBorderAgents) override;
+    Error Connect(ConnectResult &aResult, const std::vector<BorderAgentAddr> &aBorderAgents) override;
 
     void Disconnect() override;
 
@@ -191,49 +200,17 @@ public:
 private:
     using AsyncRequest = std::function<void()>;
 
-    static void Invoke(evutil_socket_t aFd, short aFlags, void *aContext);
-
-    void         PushAsyncRequest(AsyncRequest &&aAsyncRequest);
-    AsyncRequest PopAsyncRequest();
-
-    void StartEventLoopThread();
-    void StopEventLoopThread();
+    void PushAsyncRequest(AsyncRequest &&aAsyncRequest);
 
 private:
-    class EventBaseHolder
-    {
-    public:
-        EventBaseHolder();
-        ~EventBaseHolder();
-        struct event_base *Get();
-
-    private:
-        struct event_base *mEventBase;
-    };
-
     CommissionerHandler &mHandler;
 
-    // The EventBaseHolder needs to be the first member so that
-    // it is constructed before any other members and destructed
-    // after any other members.
-    EventBaseHolder mEventBase;
+    // The event loop needs to be declared before the implementation
+    // so that it outlives the implementation.
+    EventLoopPtr mEventLoop;
 
+    // The implementation is created and destroyed in the event-loop thread.
     std::shared_ptr<CommissionerImpl> mImpl;
-
-    // The event used to synchronize between the mEventThread
-    // and user thread. It will be activated by user calls
-    // and the callback will be run in mEventThread to do the
-    // actual work.
-    struct event mInvokeEvent;
-
-    // Used for synchronization with event loop in background.
-    std::mutex mInvokeMutex;
-
-    // The schedule queue of all async requests.
-    std::queue<AsyncRequest> mAsyncRequestQueue;
-
-    // The even loop thread running in background.
-    std::thread mEventThread;
 };
 
 } // namespace commissioner
@@ -32,8 +32,14 @@
  *
  */
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
 #include <catch2/catch.hpp>
 
+#include "common/benchmark.hpp"
 #include "library/commissioner_safe.hpp"
 
 namespace ot {
@@ -54,6 +60,56 @@ TEST_CASE("stop-immediately-after-starting", "[commissioner]")
     REQUIRE(commissioner->Init(config) == ErrorCode::kNone);
 }
 
+// Measures throughput of the sync APIs called from multiple threads.
+TEST_CASE("sync-api-throughput", "[.benchmark]")
+{
+    constexpr int kProducerCount    = 8;
+    constexpr int kCallsPerProducer = 20000;
+
+    CommissionerHandler      dummyHandler;
+    Config                   config;
+    std::vector<std::thread> producers;
+    std::atomic<int>         failures{0};
+
+    config.mEnableCcm = false;
+    config.mPSKc = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+
+    auto commissioner = Commissioner::Create(dummyHandler);
+    REQUIRE(commissioner != nullptr);
+    REQUIRE(commissioner->Init(config) == ErrorCode::kNone);
+
+    auto elapsed = benchmark::Measure([&]() {
+        for (int i = 0; i < kProducerCount; ++i)
+        {
+            producers.emplace_back([&commissioner, &failures]() {
+                for (int j = 0; j < kCallsPerProducer; ++j)
+                {
+                    BbrDataset dataset;
+
+                    // The commissioner is not active, the request is
+                    // rejected right away by the event loop thread.
+                    if (commissioner->GetBbrDataset(dataset, 0xFFFF) == ErrorCode::kNone)
+                    {
+                        ++failures;
+                    }
+                }
+            });
+        }
+
+        for (auto &producer : producers)
+        {
+            producer.join();
+        }
+    });
+
+    REQUIRE(failures == 0);
+
+    WARN(kProducerCount * kCallsPerProducer
+         << " sync calls from " << kProducerCount << " threads in "
+         << std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() << " us, "
+         << benchmark::PerSecond(kProducerCount * kCallsPerProducer, elapsed) << " calls/s");
+}
+
 } // namespace commissioner
 
 } // namespace ot
@@ -0,0 +1,163 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases of the coroutine interface.
+ */
+
+#include <commissioner/coroutine.hpp>
+
+#include <catch2/catch.hpp>
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+
+#include <deque>
+
+#include "common/error_macros.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+namespace coroutine {
+
+namespace {
+
+// A single-threaded executor which runs tasks on demand.
+class ManualExecutor
+{
+public:
+    Executor Get()
+    {
+        return [this](std::function<void()> aTask) { mTasks.push_back(std::move(aTask)); };
+    }
+
+    size_t RunAll()
+    {
+        size_t count = 0;
+
+        while (!mTasks.empty())
+        {
+            auto task = std::move(mTasks.front());
+            mTasks.pop_front();
+            task();
+            ++count;
+        }
+        return count;
+    }
+
+private:
+    std::deque<std::function<void()>> mTasks;
+};
+
+} // namespace
+
+TEST_CASE("coroutine-awaitable-resumes-on-executor", "[coroutine]")
+{
+    ManualExecutor                     executor;
+    Commissioner::Handler<std::string> pending;
+    Result<std::string>                result;
+    bool                               done = false;
+
+    auto coro = [&]() -> DetachedTask {
+        result = co_await Awaitable<std::string>(
+            [&](Commissioner::Handler<std::string> aHandler) { pending = std::move(aHandler); }, executor.Get());
+        done = true;
+    };
+
+    coro();
+    REQUIRE(pending != nullptr);
+    REQUIRE_FALSE(done);
+
+    std::string existingId = "OT-Commissioner";
+    pending(&existingId, ERROR_REJECTED("petition rejected"));
+
+    // Not resumed until the executor runs the task.
+    REQUIRE_FALSE(done);
+    REQUIRE(executor.RunAll() == 1);
+    REQUIRE(done);
+    REQUIRE(result.mError.GetCode() == ErrorCode::kRejected);
+    REQUIRE(result.mValue == existingId);
+}
+
+TEST_CASE("coroutine-awaitable-without-executor", "[coroutine]")
+{
+    Error error = ERROR_UNKNOWN("not resumed");
+
+    auto coro = [&]() -> DetachedTask {
+        error = co_await Awaitable<void>([](Commissioner::ErrorHandler aHandler) { aHandler(ERROR_NONE); }, nullptr);
+    };
+
+    // Completed synchronously and resumed in place.
+    coro();
+    REQUIRE(error == ERROR_NONE);
+}
+
+TEST_CASE("coroutine-sequential-requests", "[coroutine]")
+{
+    ManualExecutor executor;
+    int            started = 0;
+    uint16_t       sum     = 0;
+
+    auto request = [&](uint16_t aValue) {
+        return Awaitable<uint16_t>(
+            [&started, aValue](Commissioner::Handler<uint16_t> aHandler) {
+                ++started;
+                aHandler(&aValue, ERROR_NONE);
+            },
+            executor.Get());
+    };
+
+    auto coro = [&]() -> DetachedTask {
+        for (uint16_t i = 1; i <= 3; ++i)
+        {
+            auto result = co_await request(i);
+            REQUIRE(result.mError == ERROR_NONE);
+            sum += result.mValue;
+        }
+    };
+
+    coro();
+
+    // Each request is started only after the previous one is resumed.
+    REQUIRE(started == 1);
+    REQUIRE(executor.RunAll() == 3);
+    REQUIRE(started == 3);
+    REQUIRE(sum == 6);
+}
+
+} // namespace coroutine
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // __has_include(<coroutine>)
+#endif // defined(__cpp_impl_coroutine) && defined(__has_include)
@@ -37,6 +37,7 @@
 
 #include <mbedtls/bignum.h>
 #include <mbedtls/ecp.h>
+#include <mbedtls/sha256.h>
 
 #include "common/error_macros.hpp"
 #include "common/utils.hpp"
@@ -97,20 +98,6 @@ exit:
     return error;
 }
 
-Error Sign1Message::Validate(const CborMap &aCborPublicKey)
-{
-    Error error;
-
-    VerifyOrExit(aCborPublicKey.IsValid(),
-                 error = ERROR_INVALID_ARGS("validate COSE SIGN1 message with invalid public key"));
-
-    VerifyOrExit(COSE_Sign0_validate(mSign, aCborPublicKey.GetImpl(), nullptr),
-                 error = ERROR_SECURITY("validate COSE SIGN1 message failed"));
-
-exit:
-    return error;
-}
-
 Error Sign1Message::Validate(const mbedtls_pk_context &aPubKey)
 {
     Error                             error;
@@ -225,6 +212,22 @@ exit:
     return error;
 }
 
+Error Sign1Message::GetAttribute(ByteArray &aValue, int aKey, int aFlags)
+{
+    Error    error;
+    cn_cbor *cbor;
+
+    cbor = COSE_Sign0_map_get_int(mSign, aKey, aFlags, nullptr);
+    VerifyOrExit(cbor != nullptr, error = ERROR_NOT_FOUND("cannot find COSE SIGN1 message attribute {}", aKey));
+    VerifyOrExit(cbor->type == CN_CBOR_BYTES,
+                 error = ERROR_BAD_FORMAT("COSE SIGN1 message attribute {} is not a byte string", aKey));
+
+    aValue.assign(cbor->v.bytes, cbor->v.bytes + cbor->length);
+
+exit:
+    return error;
+}
+
 static cn_cbor *CborArrayAt(cn_cbor *arr, size_t index)
 {
     cn_cbor *ele = nullptr;
@@ -261,37 +264,21 @@ exit:
     return ret;
 }
 
-Error MakeCoseKey(ByteArray &aEncodedCoseKey, const mbedtls_pk_context &aKey, const ByteArray &aKeyId)
+Error WriteCoseKey(CborWriter &aWriter, const mbedtls_pk_context &aKey, const ByteArray &aKeyId)
 {
-    static constexpr size_t kMaxCoseKeyLength = 1024;
-
     Error                             error;
     const struct mbedtls_ecp_keypair *eckey;
-    CborMap                           coseKey;
     int                               ec2Curve;
     uint8_t                           xPoint[MBEDTLS_ECP_MAX_PT_LEN];
     size_t                            xLength;
     uint8_t                           yPoint[MBEDTLS_ECP_MAX_PT_LEN];
     size_t                            yLength;
-    uint8_t                           encodedCoseKey[kMaxCoseKeyLength];
-    size_t                            encodedCoseKeyLength;
 
     if (!mbedtls_pk_can_do(&aKey, MBEDTLS_PK_ECDSA) || (eckey = mbedtls_pk_ec(aKey)) == nullptr)
     {
         ExitNow(error = ERROR_INVALID_ARGS("Make COSE key without valid EC key"));
     }
 
-    SuccessOrExit(error = coseKey.Init());
-
-    // Cose key id('kid')
-    if (!aKeyId.empty())
-    {
-        SuccessOrExit(error = coseKey.Put(kKeyId, aKeyId.data(), aKeyId.size()));
-    }
-
-    // Cose key type
-    SuccessOrExit(error = coseKey.Put(kKeyType, kKeyTypeEC2));
-
     // Cose key EC2 curve
     switch (eckey->grp.id)
     {
@@ -307,7 +294,6 @@ Error MakeCoseKey(ByteArray &aEncodedCoseKey, const mbedtls_pk_context &aKey, co
     default:
         ExitNow(error = ERROR_INVALID_ARGS("make COSE key with invalid EC2 curve group ID {}", eckey->grp.id));
     }
-    SuccessOrExit(error = coseKey.Put(kKeyEC2Curve, ec2Curve));
 
     // Cose key EC2 X
     if (int fail = mbedtls_mpi_write_binary(&eckey->Q.X, xPoint, sizeof(xPoint)))
@@ -317,7 +303,6 @@ Error MakeCoseKey(ByteArray &aEncodedCoseKey, const mbedtls_pk_context &aKey, co
 
     // 'mbedtls_mpi_write_binary' writes to the end of buffer
     xLength = mbedtls_mpi_size(&eckey->Q.X);
-    SuccessOrExit(error = coseKey.Put(kKeyEC2X, xPoint + sizeof(xPoint) - xLength, xLength));
 
     // TODO(wgtdkp): handle the situation that Y point is not presented.
     // Cose key EC2 Y
@@ -327,13 +312,212 @@ Error MakeCoseKey(ByteArray &aEncodedCoseKey, const mbedtls_pk_context &aKey, co
     }
 
     yLength = mbedtls_mpi_size(&eckey->Q.Y);
-    SuccessOrExit(error = coseKey.Put(kKeyEC2Y, yPoint + sizeof(yPoint) - yLength, yLength));
 
-    SuccessOrExit(error = coseKey.Serialize(encodedCoseKey, encodedCoseKeyLength, sizeof(encodedCoseKey)));
+    SuccessOrExit(error = aWriter.WriteMap(aKeyId.empty() ? 4 : 5));
+
+    // Cose key id('kid')
+    if (!aKeyId.empty())
+    {
+        SuccessOrExit(error = aWriter.WriteInt(kKeyId));
+        SuccessOrExit(error = aWriter.WriteBytes(aKeyId));
+    }
+
+    SuccessOrExit(error = aWriter.WriteInt(kKeyType));
+    SuccessOrExit(error = aWriter.WriteInt(kKeyTypeEC2));
+    SuccessOrExit(error = aWriter.WriteInt(kKeyEC2Curve));
+    SuccessOrExit(error = aWriter.WriteInt(ec2Curve));
+    SuccessOrExit(error = aWriter.WriteInt(kKeyEC2X));
+    SuccessOrExit(error = aWriter.WriteBytes(xPoint + sizeof(xPoint) - xLength, xLength));
+    SuccessOrExit(error = aWriter.WriteInt(kKeyEC2Y));
+    SuccessOrExit(error = aWriter.WriteBytes(yPoint + sizeof(yPoint) - yLength, yLength));
+
+exit:
+    return error;
+}
+
+Error MakeCoseKey(ByteArray &aEncodedCoseKey, const mbedtls_pk_context &aKey, const ByteArray &aKeyId)
+{
+    static constexpr size_t kMaxCoseKeyLength = 1024;
+
+    Error      error;
+    uint8_t    encodedCoseKey[kMaxCoseKeyLength];
+    CborWriter writer{encodedCoseKey, sizeof(encodedCoseKey)};
+
+    SuccessOrExit(error = WriteCoseKey(writer, aKey, aKeyId));
+
+    aEncodedCoseKey.assign(encodedCoseKey, encodedCoseKey + writer.GetLength());
+
+exit:
+    return error;
+}
+
+Error ReadCoseKey(mbedtls_pk_context &aKey, ByteArray &aKeyId, CborReader &aReader)
+{
+    Error                       error;
+    size_t                      count;
+    int64_t                     label;
+    int64_t                     keyType   = 0;
+    int64_t                     ec2Curve  = 0;
+    const uint8_t *             x         = nullptr;
+    size_t                      xLength   = 0;
+    const uint8_t *             y         = nullptr;
+    size_t                      yLength   = 0;
+    const uint8_t *             kid       = nullptr;
+    size_t                      kidLength = 0;
+    mbedtls_ecp_group_id        groupId;
+    mbedtls_pk_context          key;
+    struct mbedtls_ecp_keypair *eckey;
+
+    mbedtls_pk_init(&key);
+
+    SuccessOrExit(error = aReader.ReadMap(count));
+    while (count-- > 0)
+    {
+        SuccessOrExit(error = aReader.ReadInt(label));
+        if (label == kKeyType)
+        {
+            SuccessOrExit(error = aReader.ReadInt(keyType));
+        }
+        else if (label == kKeyEC2Curve)
+        {
+            SuccessOrExit(error = aReader.ReadInt(ec2Curve));
+        }
+        else if (label == kKeyEC2X)
+        {
+            SuccessOrExit(error = aReader.ReadBytes(x, xLength));
+        }
+        else if (label == kKeyEC2Y)
+        {
+            SuccessOrExit(error = aReader.ReadBytes(y, yLength));
+        }
+        else if (label == kKeyId)
+        {
+            SuccessOrExit(error = aReader.ReadBytes(kid, kidLength));
+        }
+        else
+        {
+            SuccessOrExit(error = aReader.Skip());
+        }
+    }
+
+    VerifyOrExit(keyType == kKeyTypeEC2, error = ERROR_BAD_FORMAT("COSE key type {} is not EC2", keyType));
+    VerifyOrExit(x != nullptr && y != nullptr, error = ERROR_BAD_FORMAT("COSE key has no EC2 X or Y point"));
+
+    switch (ec2Curve)
+    {
+    case kKeyEC2CurveP256:
+        groupId = MBEDTLS_ECP_DP_SECP256R1;
+        break;
+    case kKeyEC2CurveP384:
+        groupId = MBEDTLS_ECP_DP_SECP384R1;
+        break;
+    case kKeyEC2CurveP521:
+        groupId = MBEDTLS_ECP_DP_SECP521R1;
+        break;
+    default:
+        ExitNow(error = ERROR_BAD_FORMAT("COSE key has invalid EC2 curve {}", ec2Curve));
+    }
+
+    SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_pk_setup(&key, mbedtls_pk_info_from_type(MBEDTLS_PK_ECKEY))));
+    eckey = mbedtls_pk_ec(key);
+    SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_ecp_group_load(&eckey->grp, groupId)));
+    SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_mpi_read_binary(&eckey->Q.X, x, xLength)));
+    SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_mpi_read_binary(&eckey->Q.Y, y, yLength)));
+    SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_mpi_lset(&eckey->Q.Z, 1)));
+    VerifyOrExit(mbedtls_ecp_check_pubkey(&eckey->grp, &eckey->Q) == 0,
+                 error = ERROR_SECURITY("COSE key is not a valid EC public key"));
+
+    mbedtls_pk_free(&aKey);
+    aKey = key;
+    mbedtls_pk_init(&key);
+    aKeyId.assign(kid, kid + kidLength);
+
+exit:
+    mbedtls_pk_free(&key);
+    return error;
+}
+
+// The content of the protected headers bucket: {alg: ES256, IV: the 8-byte big-endian sequence number}.
+static Error WriteProtectedHeaders(CborWriter &aWriter, uint64_t aSequenceNumber)
+{
+    Error   error;
+    uint8_t iv[sizeof(aSequenceNumber)];
+
+    // The sequence number as the IV, in network byte order.
+    for (size_t i = 0; i < sizeof(iv); ++i)
+    {
+        iv[i] = static_cast<uint8_t>(aSequenceNumber >> (8 * (sizeof(iv) - 1 - i)));
+    }
+
+    SuccessOrExit(error = aWriter.WriteMap(2));
+    SuccessOrExit(error = aWriter.WriteInt(kHeaderAlgorithm));
+    SuccessOrExit(error = aWriter.WriteInt(kAlgEcdsaWithSha256));
+    SuccessOrExit(error = aWriter.WriteInt(kHeaderIV));
+    SuccessOrExit(error = aWriter.WriteBytes(iv, sizeof(iv)));
+
+exit:
+    return error;
+}
+
+Error MakeSign1Message(ByteArray &      aSign1Message,
+                       EcdsaSigner &    aSigner,
+                       const ByteArray &aKeyId,
+                       uint64_t         aSequenceNumber,
+                       const ByteArray &aExternalData)
+{
+    // The max length of CBOR heads and fixed-length items in the messages.
+    static constexpr size_t  kMaxOverhead  = 64;
+    static constexpr uint8_t kTagCoseSign1 = 18;
+    static const std::string kContext      = "Signature1";
+
+    Error                  error;
+    uint8_t                protectedHeaders[16];
+    CborWriter             headersWriter{protectedHeaders, sizeof(protectedHeaders)};
+    ByteArray              toBeSigned(kMaxOverhead + aExternalData.size());
+    CborWriter             toBeSignedWriter{toBeSigned.data(), toBeSigned.size()};
+    ByteArray              signature;
+    ByteArray              message(kMaxOverhead + aKeyId.size() + MBEDTLS_ECP_MAX_PT_LEN);
+    CborWriter             messageWriter{message.data(), message.size()};
+    uint8_t                hash[32];
+    mbedtls_sha256_context sha256;
+
+    mbedtls_sha256_init(&sha256);
+
+    VerifyOrExit(!aKeyId.empty(), error = ERROR_INVALID_ARGS("make COSE SIGN1 message with empty key ID"));
+    VerifyOrExit(!aExternalData.empty(),
+                 error = ERROR_INVALID_ARGS("make COSE SIGN1 message with empty external data"));
+
+    SuccessOrExit(error = WriteProtectedHeaders(headersWriter, aSequenceNumber));
+
+    // Sig_structure = ["Signature1", protected, external_aad, payload] (RFC 8152, 4.4).
+    SuccessOrExit(error = toBeSignedWriter.WriteArray(4));
+    SuccessOrExit(error = toBeSignedWriter.WriteText(kContext));
+    SuccessOrExit(error = toBeSignedWriter.WriteBytes(protectedHeaders, headersWriter.GetLength()));
+    SuccessOrExit(error = toBeSignedWriter.WriteBytes(aExternalData));
+    SuccessOrExit(error = toBeSignedWriter.WriteBytes(nullptr, 0));
+
+    SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_sha256_starts_ret(&sha256, 0)));
+    SuccessOrExit(error = ErrorFromMbedtlsError(
+                      mbedtls_sha256_update_ret(&sha256, toBeSigned.data(), toBeSignedWriter.GetLength())));
+    SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_sha256_finish_ret(&sha256, hash)));
+
+    SuccessOrExit(error = aSigner.Sign(signature, hash, sizeof(hash)));
+
+    // COSE_Sign1 = #6.18([protected, unprotected, payload, signature]) (RFC 8152, 4.2).
+    SuccessOrExit(error = messageWriter.WriteTag(kTagCoseSign1));
+    SuccessOrExit(error = messageWriter.WriteArray(4));
+    SuccessOrExit(error = messageWriter.WriteBytes(protectedHeaders, headersWriter.GetLength()));
+    SuccessOrExit(error = messageWriter.WriteMap(1));
+    SuccessOrExit(error = messageWriter.WriteInt(kHeaderKeyId));
+    SuccessOrExit(error = messageWriter.WriteBytes(aKeyId));
+    SuccessOrExit(error = messageWriter.WriteBytes(nullptr, 0));
+    SuccessOrExit(error = messageWriter.WriteBytes(signature));
 
-    aEncodedCoseKey.assign(encodedCoseKey, encodedCoseKey + encodedCoseKeyLength);
+    message.resize(messageWriter.GetLength());
+    aSign1Message = std::move(message);
 
 exit:
+    mbedtls_sha256_free(&sha256);
     return error;
 }
 
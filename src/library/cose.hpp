@@ -49,6 +49,8 @@
 #include <commissioner/error.hpp>
 
 #include "library/cbor.hpp"
+#include "library/cbor_stream.hpp"
+#include "library/ecdsa_signer.hpp"
 
 namespace ot {
 
@@ -93,9 +95,6 @@ public:
     // OpenThread hates destructor.
     void Free();
 
-    // Validate the COSE SIGN1 message with given public key encoded as a COSE key.
-    Error Validate(const CborMap &aCborPublicKey);
-
     Error Validate(const mbedtls_pk_context &aPublicKey);
 
     Error Sign(const mbedtls_pk_context &aPrivateKey);
@@ -107,6 +106,9 @@ public:
     Error AddAttribute(int aKey, int aValue, int aFlags);
     Error AddAttribute(int aKey, const ByteArray &aValue, int aFlags);
 
+    // Get the byte string attribute of @p aKey, ERROR_NOT_FOUND if there is no such attribute.
+    Error GetAttribute(ByteArray &aValue, int aKey, int aFlags);
+
     const uint8_t *GetPayload(size_t &aLength);
 
 private:
@@ -115,8 +117,28 @@ private:
     HCOSE_SIGN0 mSign;
 };
 
+// Write the public key of @p aKey as a COSE_Key map (RFC 8152, 13).
+// The key ID is omitted if @p aKeyId is empty.
+Error WriteCoseKey(CborWriter &aWriter, const mbedtls_pk_context &aKey, const ByteArray &aKeyId);
+
 Error MakeCoseKey(ByteArray &aEncodedCoseKey, const mbedtls_pk_context &aKey, const ByteArray &aKeyId);
 
+// Read a COSE_Key map of an EC2 public key into @p aKey.
+// @p aKeyId is empty if the COSE key has no key ID.
+Error ReadCoseKey(mbedtls_pk_context &aKey, ByteArray &aKeyId, CborReader &aReader);
+
+// Make a serialized COSE_Sign1 message of empty content, signed by
+// ES256 with @p aExternalData as the external AAD and @p aKeyId as the
+// unprotected key ID header. The protected headers are the algorithm and
+// the IV, which is @p aSequenceNumber as an 8-byte string in network byte
+// order. The message is signed by @p aSigner with a precomputed nonce, it
+// can be read and validated by Sign1Message.
+Error MakeSign1Message(ByteArray &      aSign1Message,
+                       EcdsaSigner &    aSigner,
+                       const ByteArray &aKeyId,
+                       uint64_t         aSequenceNumber,
+                       const ByteArray &aExternalData);
+
 } // namespace cose
 
 } // namespace commissioner
@@ -39,6 +39,7 @@
 
 #include <mbedtls/base64.h>
 
+#include "library/ecdsa_signer.hpp"
 #include "library/token_manager.hpp"
 
 namespace ot {
@@ -119,6 +120,30 @@ TEST_CASE("cose-sign-and-verify", "[cose]")
         REQUIRE(msg.Validate(publicKey) == ErrorCode::kNone);
     }
 
+    SECTION("cose sign with a precomputed nonce")
+    {
+        const ByteArray kKeyId = {0x01, 0x02, 0x03};
+        const ByteArray kIV    = {0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04};
+        ByteArray       signature;
+        ByteArray       iv;
+        ByteArray       keyId;
+        EcdsaSigner     signer;
+        Sign1Message    msg;
+
+        REQUIRE(signer.Init(privateKey) == ErrorCode::kNone);
+        REQUIRE(MakeSign1Message(signature, signer, kKeyId, 0x01020304, externalData) == ErrorCode::kNone);
+
+        REQUIRE(Sign1Message::Deserialize(msg, signature) == ErrorCode::kNone);
+        REQUIRE(msg.GetAttribute(iv, kHeaderIV, kProtectOnly) == ErrorCode::kNone);
+        REQUIRE(iv == kIV);
+        REQUIRE(msg.GetAttribute(keyId, kHeaderKeyId, kUnprotectOnly) == ErrorCode::kNone);
+        REQUIRE(keyId == kKeyId);
+
+        REQUIRE(msg.SetExternalData(externalData) == ErrorCode::kNone);
+        REQUIRE(msg.Validate(publicKey) == ErrorCode::kNone);
+        msg.Free();
+    }
+
     SECTION("cose key construction")
     {
         ByteArray keyId = {};
@@ -166,6 +191,26 @@ TEST_CASE("cose-sign-and-verify", "[cose]")
 
         coseKey.Free();
     }
+
+    SECTION("cose key round trip")
+    {
+        const ByteArray    keyId = {0x01, 0x02, 0x03};
+        ByteArray          encodedCoseKey;
+        ByteArray          decodedKeyId;
+        mbedtls_pk_context decodedKey;
+
+        mbedtls_pk_init(&decodedKey);
+
+        REQUIRE(MakeCoseKey(encodedCoseKey, publicKey, keyId) == ErrorCode::kNone);
+
+        CborReader reader{encodedCoseKey.data(), encodedCoseKey.size()};
+        REQUIRE(ReadCoseKey(decodedKey, decodedKeyId, reader) == ErrorCode::kNone);
+        REQUIRE(reader.IsEnd());
+        REQUIRE(decodedKeyId == keyId);
+        REQUIRE(mbedtls_ecp_point_cmp(&mbedtls_pk_ec(decodedKey)->Q, &mbedtls_pk_ec(publicKey)->Q) == 0);
+
+        mbedtls_pk_free(&decodedKey);
+    }
 }
 
 } // namespace cose
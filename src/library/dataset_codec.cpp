@@ -0,0 +1,649 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the MeshCoP TLV codecs of Thread datasets.
+ */
+
+#include "library/dataset_codec.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "common/address.hpp"
+#include "common/error_macros.hpp"
+#include "common/utils.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+namespace dataset {
+
+namespace {
+
+// A field of the dataset and how it is mapped to a MeshCoP TLV.
+template <typename Dataset> struct FieldCodec
+{
+    tlv::Type mType;
+    uint16_t  mPresentBit;
+
+    // Returns the length of the encoded TLV value.
+    size_t (*mGetLength)(const Dataset &aDataset);
+
+    // Writes the TLV value into @p aBuf which has at least `mGetLength()` bytes.
+    Error (*mEncode)(uint8_t *aBuf, const Dataset &aDataset);
+
+    // Reads the field from a TLV which is known to be valid.
+    Error (*mDecode)(Dataset &aDataset, const tlv::TlvView &aTlv);
+};
+
+template <typename Codec>
+constexpr FieldCodec<typename Codec::DatasetType> MakeField(tlv::Type aType, uint16_t aPresentBit)
+{
+    return {aType, aPresentBit, &Codec::GetLength, &Codec::Encode, &Codec::Decode};
+}
+
+template <typename T> void WriteInteger(uint8_t *aBuf, T aInteger)
+{
+    for (size_t i = 0; i < sizeof(T); ++i)
+    {
+        aBuf[i] = static_cast<uint8_t>(aInteger >> ((sizeof(T) - i - 1) * 8));
+    }
+}
+
+template <typename Dataset, typename T, T Dataset::*kField> struct IntegerField
+{
+    using DatasetType = Dataset;
+
+    static size_t GetLength(const Dataset &) { return sizeof(T); }
+
+    static Error Encode(uint8_t *aBuf, const Dataset &aDataset)
+    {
+        WriteInteger(aBuf, aDataset.*kField);
+        return ERROR_NONE;
+    }
+
+    static Error Decode(Dataset &aDataset, const tlv::TlvView &aTlv)
+    {
+        aDataset.*kField = utils::Decode<T>(aTlv.GetValue(), aTlv.GetLength());
+        return ERROR_NONE;
+    }
+};
+
+template <typename Dataset, Timestamp Dataset::*kField> struct TimestampField
+{
+    using DatasetType = Dataset;
+
+    static size_t GetLength(const Dataset &) { return sizeof(uint64_t); }
+
+    static Error Encode(uint8_t *aBuf, const Dataset &aDataset)
+    {
+        WriteInteger(aBuf, (aDataset.*kField).Encode());
+        return ERROR_NONE;
+    }
+
+    static Error Decode(Dataset &aDataset, const tlv::TlvView &aTlv)
+    {
+        aDataset.*kField = Timestamp::Decode(aTlv.GetValueAsUint64());
+        return ERROR_NONE;
+    }
+};
+
+template <typename Dataset, typename T, T Dataset::*kField> struct BytesField
+{
+    using DatasetType = Dataset;
+
+    static size_t GetLength(const Dataset &aDataset) { return (aDataset.*kField).size(); }
+
+    static Error Encode(uint8_t *aBuf, const Dataset &aDataset)
+    {
+        std::copy((aDataset.*kField).begin(), (aDataset.*kField).end(), aBuf);
+        return ERROR_NONE;
+    }
+
+    static Error Decode(Dataset &aDataset, const tlv::TlvView &aTlv)
+    {
+        (aDataset.*kField).assign(aTlv.GetValue(), aTlv.GetValue() + aTlv.GetLength());
+        return ERROR_NONE;
+    }
+};
+
+template <typename Dataset, ByteArray Dataset::*kField> using ByteArrayField = BytesField<Dataset, ByteArray, kField>;
+
+template <typename Dataset, std::string Dataset::*kField>
+using StringField = BytesField<Dataset, std::string, kField>;
+
+struct ChannelField
+{
+    using DatasetType = ActiveOperationalDataset;
+
+    static size_t GetLength(const DatasetType &) { return sizeof(uint8_t) + sizeof(uint16_t); }
+
+    static Error Encode(uint8_t *aBuf, const DatasetType &aDataset)
+    {
+        aBuf[0] = aDataset.mChannel.mPage;
+        WriteInteger(aBuf + 1, aDataset.mChannel.mNumber);
+        return ERROR_NONE;
+    }
+
+    static Error Decode(DatasetType &aDataset, const tlv::TlvView &aTlv)
+    {
+        aDataset.mChannel.mPage   = aTlv.GetValue()[0];
+        aDataset.mChannel.mNumber = utils::Decode<uint16_t>(aTlv.GetValue() + 1, aTlv.GetLength() - 1);
+        return ERROR_NONE;
+    }
+};
+
+struct ChannelMaskField
+{
+    using DatasetType = ActiveOperationalDataset;
+
+    static size_t GetLength(const DatasetType &aDataset)
+    {
+        size_t length = 0;
+
+        for (const auto &entry : aDataset.mChannelMask)
+        {
+            length += sizeof(uint8_t) * 2 + entry.mMasks.size();
+        }
+
+        return length;
+    }
+
+    static Error Encode(uint8_t *aBuf, const DatasetType &aDataset)
+    {
+        Error error;
+
+        for (const auto &entry : aDataset.mChannelMask)
+        {
+            VerifyOrExit(entry.mMasks.size() < tlv::kEscapeLength,
+                         error = ERROR_INVALID_ARGS("Channel Mask list is too long (>={})", tlv::kEscapeLength));
+
+            *aBuf++ = entry.mPage;
+            *aBuf++ = static_cast<uint8_t>(entry.mMasks.size());
+            aBuf    = std::copy(entry.mMasks.begin(), entry.mMasks.end(), aBuf);
+        }
+
+    exit:
+        return error;
+    }
+
+    static Error Decode(DatasetType &aDataset, const tlv::TlvView &aTlv)
+    {
+        return DecodeChannelMask(aDataset.mChannelMask, aTlv.GetValue(), aTlv.GetLength());
+    }
+};
+
+struct SecurityPolicyField
+{
+    using DatasetType = ActiveOperationalDataset;
+
+    static size_t GetLength(const DatasetType &aDataset)
+    {
+        return sizeof(uint16_t) + aDataset.mSecurityPolicy.mFlags.size();
+    }
+
+    static Error Encode(uint8_t *aBuf, const DatasetType &aDataset)
+    {
+        const auto &flags = aDataset.mSecurityPolicy.mFlags;
+
+        WriteInteger(aBuf, aDataset.mSecurityPolicy.mRotationTime);
+        std::copy(flags.begin(), flags.end(), aBuf + sizeof(uint16_t));
+        return ERROR_NONE;
+    }
+
+    static Error Decode(DatasetType &aDataset, const tlv::TlvView &aTlv)
+    {
+        auto value = aTlv.GetValue();
+
+        aDataset.mSecurityPolicy.mRotationTime = aTlv.GetValueAsUint16();
+        aDataset.mSecurityPolicy.mFlags        = {value + sizeof(uint16_t), value + aTlv.GetLength()};
+        return ERROR_NONE;
+    }
+};
+
+using Active       = ActiveOperationalDataset;
+using Pending      = PendingOperationalDataset;
+using Commissioner = CommissionerDataset;
+
+constexpr FieldCodec<Active> kActiveDatasetSchema[] = {
+    MakeField<TimestampField<Active, &Active::mActiveTimestamp>>(tlv::Type::kActiveTimestamp,
+                                                                 Active::kActiveTimestampBit),
+    MakeField<ChannelField>(tlv::Type::kChannel, Active::kChannelBit),
+    MakeField<ChannelMaskField>(tlv::Type::kChannelMask, Active::kChannelMaskBit),
+    MakeField<ByteArrayField<Active, &Active::mExtendedPanId>>(tlv::Type::kExtendedPanId, Active::kExtendedPanIdBit),
+    MakeField<ByteArrayField<Active, &Active::mMeshLocalPrefix>>(tlv::Type::kNetworkMeshLocalPrefix,
+                                                                 Active::kMeshLocalPrefixBit),
+    MakeField<ByteArrayField<Active, &Active::mNetworkMasterKey>>(tlv::Type::kNetworkMasterKey,
+                                                                  Active::kNetworkMasterKeyBit),
+    MakeField<StringField<Active, &Active::mNetworkName>>(tlv::Type::kNetworkName, Active::kNetworkNameBit),
+    MakeField<IntegerField<Active, uint16_t, &Active::mPanId>>(tlv::Type::kPanId, Active::kPanIdBit),
+    MakeField<ByteArrayField<Active, &Active::mPSKc>>(tlv::Type::kPSKc, Active::kPSKcBit),
+    MakeField<SecurityPolicyField>(tlv::Type::kSecurityPolicy, Active::kSecurityPolicyBit),
+};
+
+// The Pending Operational Dataset includes all fields of kActiveDatasetSchema.
+constexpr FieldCodec<Pending> kPendingDatasetSchema[] = {
+    MakeField<IntegerField<Pending, uint32_t, &Pending::mDelayTimer>>(tlv::Type::kDelayTimer,
+                                                                      Pending::kDelayTimerBit),
+    MakeField<TimestampField<Pending, &Pending::mPendingTimestamp>>(tlv::Type::kPendingTimestamp,
+                                                                    Pending::kPendingTimestampBit),
+};
+
+constexpr FieldCodec<Commissioner> kCommissionerDatasetSchema[] = {
+    MakeField<IntegerField<Commissioner, uint16_t, &Commissioner::mSessionId>>(tlv::Type::kCommissionerSessionId,
+                                                                               Commissioner::kSessionIdBit),
+    MakeField<IntegerField<Commissioner, uint16_t, &Commissioner::mBorderAgentLocator>>(
+        tlv::Type::kBorderAgentLocator, Commissioner::kBorderAgentLocatorBit),
+    MakeField<ByteArrayField<Commissioner, &Commissioner::mSteeringData>>(tlv::Type::kSteeringData,
+                                                                          Commissioner::kSteeringDataBit),
+    MakeField<ByteArrayField<Commissioner, &Commissioner::mAeSteeringData>>(tlv::Type::kAeSteeringData,
+                                                                            Commissioner::kAeSteeringDataBit),
+    MakeField<ByteArrayField<Commissioner, &Commissioner::mNmkpSteeringData>>(tlv::Type::kNmkpSteeringData,
+                                                                              Commissioner::kNmkpSteeringDataBit),
+    MakeField<IntegerField<Commissioner, uint16_t, &Commissioner::mJoinerUdpPort>>(tlv::Type::kJoinerUdpPort,
+                                                                                   Commissioner::kJoinerUdpPortBit),
+    MakeField<IntegerField<Commissioner, uint16_t, &Commissioner::mAeUdpPort>>(tlv::Type::kAeUdpPort,
+                                                                               Commissioner::kAeUdpPortBit),
+    MakeField<IntegerField<Commissioner, uint16_t, &Commissioner::mNmkpUdpPort>>(tlv::Type::kNmkpUdpPort,
+                                                                                 Commissioner::kNmkpUdpPortBit),
+};
+
+#if OT_COMM_CONFIG_CCM_ENABLE
+struct RegistrarIpv6AddrField
+{
+    using DatasetType = BbrDataset;
+
+    static size_t GetLength(const DatasetType &aDataset)
+    {
+        Address addr;
+
+        // A bad address has no valid length, it is reported by Encode().
+        return addr.Set(aDataset.mRegistrarIpv6Addr) == ErrorCode::kNone ? addr.GetRaw().size() : 0;
+    }
+
+    static Error Encode(uint8_t *aBuf, const DatasetType &aDataset)
+    {
+        Error   error;
+        Address addr;
+
+        SuccessOrExit(error = addr.Set(aDataset.mRegistrarIpv6Addr));
+        std::copy(addr.GetRaw().begin(), addr.GetRaw().end(), aBuf);
+
+    exit:
+        return error;
+    }
+
+    static Error Decode(DatasetType &aDataset, const tlv::TlvView &aTlv)
+    {
+        Error   error;
+        Address addr;
+
+        SuccessOrExit(error = addr.Set(aTlv.GetValueAsByteArray()));
+        aDataset.mRegistrarIpv6Addr = addr.ToString();
+
+    exit:
+        return error;
+    }
+};
+
+constexpr FieldCodec<BbrDataset> kBbrDatasetSchema[] = {
+    MakeField<StringField<BbrDataset, &BbrDataset::mTriHostname>>(tlv::Type::kTriHostname,
+                                                                  BbrDataset::kTriHostnameBit),
+    MakeField<StringField<BbrDataset, &BbrDataset::mRegistrarHostname>>(tlv::Type::kRegistrarHostname,
+                                                                        BbrDataset::kRegistrarHostnameBit),
+    MakeField<RegistrarIpv6AddrField>(tlv::Type::kRegistrarIpv6Address, BbrDataset::kRegistrarIpv6AddrBit),
+};
+#endif // OT_COMM_CONFIG_CCM_ENABLE
+
+size_t GetTlvHeaderLength(tlv::Type aType)
+{
+    // Type, escape length and extended length for extended TLVs.
+    return tlv::IsExtendedTlv(aType) ? 4 : 2;
+}
+
+size_t WriteTlvHeader(uint8_t *aBuf, tlv::Type aType, uint16_t aLength)
+{
+    aBuf[0] = utils::to_underlying(aType);
+
+    if (tlv::IsExtendedTlv(aType))
+    {
+        aBuf[1] = tlv::kEscapeLength;
+        WriteInteger(aBuf + 2, aLength);
+    }
+    else
+    {
+        aBuf[1] = static_cast<uint8_t>(aLength);
+    }
+
+    return GetTlvHeaderLength(aType);
+}
+
+template <typename Dataset, size_t kFieldNum>
+size_t GetFieldsLength(const FieldCodec<Dataset> (&aSchema)[kFieldNum], const Dataset &aDataset)
+{
+    size_t length = 0;
+
+    for (const auto &field : aSchema)
+    {
+        if (aDataset.mPresentFlags & field.mPresentBit)
+        {
+            length += GetTlvHeaderLength(field.mType) + field.mGetLength(aDataset);
+        }
+    }
+
+    return length;
+}
+
+// Writes TLVs of present fields at @p aBuf and advances it past the written TLVs.
+template <typename Dataset, size_t kFieldNum>
+Error WriteFields(uint8_t *&aBuf, const FieldCodec<Dataset> (&aSchema)[kFieldNum], const Dataset &aDataset)
+{
+    Error error;
+
+    for (const auto &field : aSchema)
+    {
+        if (aDataset.mPresentFlags & field.mPresentBit)
+        {
+            size_t length = field.mGetLength(aDataset);
+
+            VerifyOrExit(length <= std::numeric_limits<uint16_t>::max(),
+                         error = ERROR_INVALID_ARGS("the tlv(type={}) is in bad format",
+                                                    utils::to_underlying(field.mType)));
+
+            aBuf += WriteTlvHeader(aBuf, field.mType, static_cast<uint16_t>(length));
+            SuccessOrExit(error = field.mEncode(aBuf, aDataset));
+
+            VerifyOrExit(tlv::TlvView(field.mType, aBuf, static_cast<uint16_t>(length)).IsValid(),
+                         error = ERROR_INVALID_ARGS("the tlv(type={}) is in bad format",
+                                                    utils::to_underlying(field.mType)));
+            aBuf += length;
+        }
+    }
+
+exit:
+    return error;
+}
+
+template <typename Dataset, size_t kFieldNum>
+Error ReadFields(Dataset &aDataset, const FieldCodec<Dataset> (&aSchema)[kFieldNum], const tlv::TlvTable &aTlvTable)
+{
+    Error error;
+
+    for (const auto &field : aSchema)
+    {
+        if (const auto &tlvView = aTlvTable[field.mType])
+        {
+            SuccessOrExit(error = field.mDecode(aDataset, tlvView));
+            aDataset.mPresentFlags |= field.mPresentBit;
+        }
+    }
+
+exit:
+    return error;
+}
+
+template <typename Dataset, size_t kFieldNum>
+void AppendTlvTypes(ByteArray &aTlvTypes, const FieldCodec<Dataset> (&aSchema)[kFieldNum], uint16_t aDatasetFlags)
+{
+    for (const auto &field : aSchema)
+    {
+        if (aDatasetFlags & field.mPresentBit)
+        {
+            aTlvTypes.emplace_back(utils::to_underlying(field.mType));
+        }
+    }
+}
+
+// Appends all TLVs to @p aBuf which is resized only once.
+template <typename Dataset, typename Writer> Error Append(ByteArray &aBuf, const Dataset &aDataset, Writer aWriter)
+{
+    Error    error;
+    size_t   offset = aBuf.size();
+    uint8_t *cur;
+
+    aBuf.resize(offset + GetEncodedLength(aDataset));
+    cur = aBuf.data() + offset;
+
+    SuccessOrExit(error = aWriter(cur));
+    ASSERT(cur == aBuf.data() + aBuf.size());
+
+exit:
+    if (error != ErrorCode::kNone)
+    {
+        aBuf.resize(offset);
+    }
+    return error;
+}
+
+} // namespace
+
+size_t GetEncodedLength(const ActiveOperationalDataset &aDataset)
+{
+    return GetFieldsLength(kActiveDatasetSchema, aDataset);
+}
+
+size_t GetEncodedLength(const PendingOperationalDataset &aDataset)
+{
+    return GetFieldsLength(kActiveDatasetSchema, static_cast<const Active &>(aDataset)) +
+           GetFieldsLength(kPendingDatasetSchema, aDataset);
+}
+
+size_t GetEncodedLength(const CommissionerDataset &aDataset)
+{
+    return GetFieldsLength(kCommissionerDatasetSchema, aDataset);
+}
+
+Error Encode(ByteArray &aBuf, const ActiveOperationalDataset &aDataset)
+{
+    return Append(aBuf, aDataset, [&aDataset](uint8_t *&aCur) {
+        return WriteFields(aCur, kActiveDatasetSchema, aDataset);
+    });
+}
+
+Error Encode(ByteArray &aBuf, const PendingOperationalDataset &aDataset)
+{
+    return Append(aBuf, aDataset, [&aDataset](uint8_t *&aCur) {
+        Error error;
+
+        SuccessOrExit(error = WriteFields(aCur, kActiveDatasetSchema, static_cast<const Active &>(aDataset)));
+        SuccessOrExit(error = WriteFields(aCur, kPendingDatasetSchema, aDataset));
+
+    exit:
+        return error;
+    });
+}
+
+Error Encode(ByteArray &aBuf, const CommissionerDataset &aDataset)
+{
+    return Append(aBuf, aDataset, [&aDataset](uint8_t *&aCur) {
+        return WriteFields(aCur, kCommissionerDatasetSchema, aDataset);
+    });
+}
+
+Error Decode(ActiveOperationalDataset &aDataset, const tlv::TlvTable &aTlvTable)
+{
+    Error                    error;
+    ActiveOperationalDataset dataset;
+
+    // Clear all data fields
+    dataset.mPresentFlags = 0;
+
+    SuccessOrExit(error = ReadFields(dataset, kActiveDatasetSchema, aTlvTable));
+
+    aDataset = dataset;
+
+exit:
+    return error;
+}
+
+Error Decode(PendingOperationalDataset &aDataset, const tlv::TlvTable &aTlvTable)
+{
+    Error                     error;
+    PendingOperationalDataset dataset;
+
+    // Clear all data fields
+    dataset.mPresentFlags = 0;
+
+    SuccessOrExit(error = ReadFields(static_cast<Active &>(dataset), kActiveDatasetSchema, aTlvTable));
+    SuccessOrExit(error = ReadFields(dataset, kPendingDatasetSchema, aTlvTable));
+
+    aDataset = dataset;
+
+exit:
+    return error;
+}
+
+Error Decode(CommissionerDataset &aDataset, const tlv::TlvTable &aTlvTable)
+{
+    Error               error;
+    CommissionerDataset dataset;
+
+    SuccessOrExit(error = ReadFields(dataset, kCommissionerDatasetSchema, aTlvTable));
+
+    aDataset = dataset;
+
+exit:
+    return error;
+}
+
+ByteArray GetActiveDatasetTlvTypes(uint16_t aDatasetFlags)
+{
+    ByteArray tlvTypes;
+
+    AppendTlvTypes(tlvTypes, kActiveDatasetSchema, aDatasetFlags);
+    return tlvTypes;
+}
+
+ByteArray GetPendingDatasetTlvTypes(uint16_t aDatasetFlags)
+{
+    ByteArray tlvTypes;
+
+    AppendTlvTypes(tlvTypes, kActiveDatasetSchema, aDatasetFlags);
+    AppendTlvTypes(tlvTypes, kPendingDatasetSchema, aDatasetFlags);
+    return tlvTypes;
+}
+
+ByteArray GetCommissionerDatasetTlvTypes(uint16_t aDatasetFlags)
+{
+    ByteArray tlvTypes;
+
+    AppendTlvTypes(tlvTypes, kCommissionerDatasetSchema, aDatasetFlags);
+    return tlvTypes;
+}
+
+#if OT_COMM_CONFIG_CCM_ENABLE
+size_t GetEncodedLength(const BbrDataset &aDataset)
+{
+    return GetFieldsLength(kBbrDatasetSchema, aDataset);
+}
+
+Error Encode(ByteArray &aBuf, const BbrDataset &aDataset)
+{
+    return Append(aBuf, aDataset,
+                  [&aDataset](uint8_t *&aCur) { return WriteFields(aCur, kBbrDatasetSchema, aDataset); });
+}
+
+Error Decode(BbrDataset &aDataset, const tlv::TlvTable &aTlvTable)
+{
+    Error      error;
+    BbrDataset dataset;
+
+    SuccessOrExit(error = ReadFields(dataset, kBbrDatasetSchema, aTlvTable));
+
+    aDataset = dataset;
+
+exit:
+    return error;
+}
+
+ByteArray GetBbrDatasetTlvTypes(uint16_t aDatasetFlags)
+{
+    ByteArray tlvTypes;
+
+    AppendTlvTypes(tlvTypes, kBbrDatasetSchema, aDatasetFlags);
+    return tlvTypes;
+}
+#endif // OT_COMM_CONFIG_CCM_ENABLE
+
+Error EncodeChannelMask(ByteArray &aBuf, const ChannelMask &aChannelMask)
+{
+    Error error;
+
+    for (const auto &entry : aChannelMask)
+    {
+        VerifyOrExit(entry.mMasks.size() < tlv::kEscapeLength,
+                     error = ERROR_INVALID_ARGS("Channel Mask list is too long (>={})", tlv::kEscapeLength));
+
+        utils::Encode(aBuf, entry.mPage);
+        utils::Encode(aBuf, static_cast<uint8_t>(entry.mMasks.size()));
+        aBuf.insert(aBuf.end(), entry.mMasks.begin(), entry.mMasks.end());
+    }
+
+exit:
+    return error;
+}
+
+Error DecodeChannelMask(ChannelMask &aChannelMask, const uint8_t *aBuf, size_t aLength)
+{
+    Error       error;
+    ChannelMask channelMask;
+    size_t      offset = 0;
+    size_t      length = aLength;
+
+    while (offset < length)
+    {
+        ChannelMaskEntry entry;
+        uint8_t          entryLength;
+        VerifyOrExit(offset + 2 <= length, error = ERROR_BAD_FORMAT("premature end of Channel Mask Entry"));
+
+        entry.mPage = aBuf[offset++];
+        entryLength = aBuf[offset++];
+
+        VerifyOrExit(offset + entryLength <= length, error = ERROR_BAD_FORMAT("premature end of Channel Mask Entry"));
+        entry.mMasks = {aBuf + offset, aBuf + offset + entryLength};
+        channelMask.emplace_back(entry);
+
+        offset += entryLength;
+    }
+
+    ASSERT(offset == length);
+
+    aChannelMask = channelMask;
+
+exit:
+    return error;
+}
+
+} // namespace dataset
+
+} // namespace commissioner
+
+} // namespace ot
@@ -0,0 +1,89 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions of the MeshCoP TLV codecs of Thread datasets.
+ */
+
+#ifndef OT_COMM_LIBRARY_DATASET_CODEC_HPP_
+#define OT_COMM_LIBRARY_DATASET_CODEC_HPP_
+
+#include <commissioner/error.hpp>
+#include <commissioner/network_data.hpp>
+
+#include "library/tlv.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+namespace dataset {
+
+// The codecs are driven by a per-dataset schema table which maps each
+// data field to its TLV type, present bit and value codec. Only fields
+// whose present bits are set are encoded. Encode() computes the exact
+// length of the TLVs ahead and appends them to @p aBuf in a single pass;
+// @p aBuf is left unchanged if any field is in bad format.
+
+size_t GetEncodedLength(const ActiveOperationalDataset &aDataset);
+size_t GetEncodedLength(const PendingOperationalDataset &aDataset);
+size_t GetEncodedLength(const CommissionerDataset &aDataset);
+
+Error Encode(ByteArray &aBuf, const ActiveOperationalDataset &aDataset);
+Error Encode(ByteArray &aBuf, const PendingOperationalDataset &aDataset);
+Error Encode(ByteArray &aBuf, const CommissionerDataset &aDataset);
+
+// Decodes the dataset from TLVs which have been validated by @p aTlvTable.
+// @p aDataset is not touched if decoding fails.
+Error Decode(ActiveOperationalDataset &aDataset, const tlv::TlvTable &aTlvTable);
+Error Decode(PendingOperationalDataset &aDataset, const tlv::TlvTable &aTlvTable);
+Error Decode(CommissionerDataset &aDataset, const tlv::TlvTable &aTlvTable);
+
+// Returns the list of TLV types of the fields selected by @p aDatasetFlags.
+ByteArray GetActiveDatasetTlvTypes(uint16_t aDatasetFlags);
+ByteArray GetPendingDatasetTlvTypes(uint16_t aDatasetFlags);
+ByteArray GetCommissionerDatasetTlvTypes(uint16_t aDatasetFlags);
+
+#if OT_COMM_CONFIG_CCM_ENABLE
+size_t    GetEncodedLength(const BbrDataset &aDataset);
+Error     Encode(ByteArray &aBuf, const BbrDataset &aDataset);
+Error     Decode(BbrDataset &aDataset, const tlv::TlvTable &aTlvTable);
+ByteArray GetBbrDatasetTlvTypes(uint16_t aDatasetFlags);
+#endif
+
+Error EncodeChannelMask(ByteArray &aBuf, const ChannelMask &aChannelMask);
+Error DecodeChannelMask(ChannelMask &aChannelMask, const uint8_t *aBuf, size_t aLength);
+
+} // namespace dataset
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_LIBRARY_DATASET_CODEC_HPP_
@@ -0,0 +1,182 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases for the dataset codecs.
+ */
+
+#include "library/dataset_codec.hpp"
+
+#include <catch2/catch.hpp>
+
+#include "common/utils.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+namespace dataset {
+
+static ActiveOperationalDataset MakeActiveDataset()
+{
+    ActiveOperationalDataset dataset;
+
+    dataset.mChannel                      = {0, 19};
+    dataset.mChannelMask                  = {{0, {0x07, 0xFF, 0xF8, 0x00}}};
+    dataset.mExtendedPanId                = {0xDE, 0xAD, 0x00, 0xBE, 0xEF, 0x00, 0xCA, 0xFE};
+    dataset.mMeshLocalPrefix              = {0xFD, 0x00, 0x0D, 0xB8, 0x00, 0x00, 0x00, 0x00};
+    dataset.mNetworkMasterKey             = ByteArray(16, 0x11);
+    dataset.mNetworkName                  = "OpenThread";
+    dataset.mPanId                        = 0xFACE;
+    dataset.mPSKc                         = ByteArray(16, 0x22);
+    dataset.mSecurityPolicy.mRotationTime = 672;
+    dataset.mSecurityPolicy.mFlags        = {0xF7, 0xF8};
+    dataset.mPresentFlags                 = 0xFFFF;
+
+    return dataset;
+}
+
+TEST_CASE("dataset-codec-active-dataset", "[dataset]")
+{
+    ActiveOperationalDataset dataset = MakeActiveDataset();
+    ActiveOperationalDataset decoded;
+    ByteArray                buf;
+    ByteArray                expected;
+    ByteArray                channel;
+    ByteArray                channelMask;
+    ByteArray                securityPolicy;
+    tlv::TlvTable            tlvTable;
+
+    utils::Encode(channel, dataset.mChannel.mPage);
+    utils::Encode(channel, dataset.mChannel.mNumber);
+    REQUIRE(EncodeChannelMask(channelMask, dataset.mChannelMask) == ErrorCode::kNone);
+    utils::Encode(securityPolicy, dataset.mSecurityPolicy.mRotationTime);
+    securityPolicy.insert(securityPolicy.end(), dataset.mSecurityPolicy.mFlags.begin(),
+                          dataset.mSecurityPolicy.mFlags.end());
+
+    tlv::Tlv{tlv::Type::kActiveTimestamp, dataset.mActiveTimestamp.Encode()}.Serialize(expected);
+    tlv::Tlv{tlv::Type::kChannel, channel}.Serialize(expected);
+    tlv::Tlv{tlv::Type::kChannelMask, channelMask}.Serialize(expected);
+    tlv::Tlv{tlv::Type::kExtendedPanId, dataset.mExtendedPanId}.Serialize(expected);
+    tlv::Tlv{tlv::Type::kNetworkMeshLocalPrefix, dataset.mMeshLocalPrefix}.Serialize(expected);
+    tlv::Tlv{tlv::Type::kNetworkMasterKey, dataset.mNetworkMasterKey}.Serialize(expected);
+    tlv::Tlv{tlv::Type::kNetworkName, dataset.mNetworkName}.Serialize(expected);
+    tlv::Tlv{tlv::Type::kPanId, dataset.mPanId}.Serialize(expected);
+    tlv::Tlv{tlv::Type::kPSKc, dataset.mPSKc}.Serialize(expected);
+    tlv::Tlv{tlv::Type::kSecurityPolicy, securityPolicy}.Serialize(expected);
+
+    REQUIRE(GetEncodedLength(dataset) == expected.size());
+    REQUIRE(Encode(buf, dataset) == ErrorCode::kNone);
+    REQUIRE(buf == expected);
+
+    REQUIRE(tlvTable.Parse(buf) == ErrorCode::kNone);
+    REQUIRE(Decode(decoded, tlvTable) == ErrorCode::kNone);
+    REQUIRE(decoded.mPresentFlags == (ActiveOperationalDataset::kActiveTimestampBit | 0x7FC0));
+    REQUIRE(decoded.mActiveTimestamp.Encode() == dataset.mActiveTimestamp.Encode());
+    REQUIRE(decoded.mChannel.mNumber == 19);
+    REQUIRE(decoded.mChannelMask.size() == 1);
+    REQUIRE(decoded.mChannelMask[0].mMasks == dataset.mChannelMask[0].mMasks);
+    REQUIRE(decoded.mExtendedPanId == dataset.mExtendedPanId);
+    REQUIRE(decoded.mNetworkName == dataset.mNetworkName);
+    REQUIRE(decoded.mPanId == dataset.mPanId);
+    REQUIRE(decoded.mSecurityPolicy.mRotationTime == 672);
+    REQUIRE(decoded.mSecurityPolicy.mFlags == dataset.mSecurityPolicy.mFlags);
+}
+
+TEST_CASE("dataset-codec-pending-dataset", "[dataset]")
+{
+    PendingOperationalDataset dataset;
+    PendingOperationalDataset decoded;
+    ByteArray                 buf;
+    tlv::TlvTable             tlvTable;
+
+    dataset.mPanId        = 0xFACE;
+    dataset.mDelayTimer   = 30000;
+    dataset.mPresentFlags = ActiveOperationalDataset::kActiveTimestampBit | ActiveOperationalDataset::kPanIdBit |
+                            PendingOperationalDataset::kDelayTimerBit |
+                            PendingOperationalDataset::kPendingTimestampBit;
+
+    REQUIRE(Encode(buf, dataset) == ErrorCode::kNone);
+    REQUIRE(buf.size() == GetEncodedLength(dataset));
+    REQUIRE(buf.size() == (2 + 8) + (2 + 2) + (2 + 4) + (2 + 8));
+
+    REQUIRE(tlvTable.Parse(buf) == ErrorCode::kNone);
+    REQUIRE(Decode(decoded, tlvTable) == ErrorCode::kNone);
+    REQUIRE(decoded.mPresentFlags == dataset.mPresentFlags);
+    REQUIRE(decoded.mPanId == 0xFACE);
+    REQUIRE(decoded.mDelayTimer == 30000);
+    REQUIRE(decoded.mPendingTimestamp.Encode() == dataset.mPendingTimestamp.Encode());
+
+    REQUIRE(GetPendingDatasetTlvTypes(dataset.mPresentFlags) ==
+            ByteArray{utils::to_underlying(tlv::Type::kActiveTimestamp), utils::to_underlying(tlv::Type::kPanId),
+                      utils::to_underlying(tlv::Type::kDelayTimer),
+                      utils::to_underlying(tlv::Type::kPendingTimestamp)});
+}
+
+TEST_CASE("dataset-codec-bad-field", "[dataset]")
+{
+    ActiveOperationalDataset dataset = MakeActiveDataset();
+    ByteArray                buf     = {0xAB};
+
+    // Network Name longer than 16 bytes.
+    dataset.mNetworkName = "OpenThread-OpenThread";
+
+    REQUIRE(Encode(buf, dataset) == ErrorCode::kInvalidArgs);
+    REQUIRE(buf == ByteArray{0xAB});
+}
+
+TEST_CASE("dataset-codec-commissioner-dataset", "[dataset]")
+{
+    CommissionerDataset dataset;
+    CommissionerDataset decoded;
+    ByteArray           buf;
+    tlv::TlvTable       tlvTable;
+
+    dataset.mSessionId     = 0x1234;
+    dataset.mSteeringData  = {0xFF};
+    dataset.mJoinerUdpPort = 1000;
+    dataset.mPresentFlags  = CommissionerDataset::kSessionIdBit | CommissionerDataset::kSteeringDataBit |
+                            CommissionerDataset::kJoinerUdpPortBit;
+
+    REQUIRE(Encode(buf, dataset) == ErrorCode::kNone);
+    REQUIRE(buf.size() == (2 + 2) + (2 + 1) + (2 + 2));
+
+    REQUIRE(tlvTable.Parse(buf) == ErrorCode::kNone);
+    REQUIRE(Decode(decoded, tlvTable) == ErrorCode::kNone);
+    REQUIRE(decoded.mPresentFlags == dataset.mPresentFlags);
+    REQUIRE(decoded.mSessionId == 0x1234);
+    REQUIRE(decoded.mSteeringData == dataset.mSteeringData);
+    REQUIRE(decoded.mJoinerUdpPort == 1000);
+}
+
+} // namespace dataset
+
+} // namespace commissioner
+
+} // namespace ot
@@ -33,6 +33,8 @@
 
 #include "library/dtls.hpp"
 
+#include <algorithm>
+
 #include <mbedtls/debug.h>
 #include <mbedtls/error.h>
 #include <mbedtls/platform.h>
@@ -91,6 +93,121 @@ DtlsConfig GetDtlsConfig(const Config &aConfig)
     return dtlsConfig;
 }
 
+DtlsCredentials::DtlsCredentials()
+{
+    mbedtls_x509_crt_init(&mCaChain);
+    mbedtls_x509_crt_init(&mOwnCert);
+    mbedtls_pk_init(&mOwnKey);
+}
+
+DtlsCredentials::~DtlsCredentials()
+{
+    mbedtls_pk_free(&mOwnKey);
+    mbedtls_x509_crt_free(&mOwnCert);
+    mbedtls_x509_crt_free(&mCaChain);
+}
+
+Error DtlsCredentials::Parse(const DtlsConfig &aConfig)
+{
+    Error error;
+
+    if (int fail = mbedtls_x509_crt_parse(&mCaChain, aConfig.mCaChain.data(), aConfig.mCaChain.size()))
+    {
+        ExitNow(error = ERROR_INVALID_ARGS("bad CA certificate; {}", ErrorFromMbedtlsError(fail).GetMessage()));
+    }
+    if (int fail = mbedtls_x509_crt_parse(&mOwnCert, aConfig.mOwnCert.data(), aConfig.mOwnCert.size()))
+    {
+        ExitNow(error = ERROR_INVALID_ARGS("bad certificate; {}", ErrorFromMbedtlsError(fail).GetMessage()));
+    }
+    if (int fail = mbedtls_pk_parse_key(&mOwnKey, aConfig.mOwnKey.data(), aConfig.mOwnKey.size(), nullptr, 0))
+    {
+        ExitNow(error = ERROR_INVALID_ARGS("bad private key; {}", ErrorFromMbedtlsError(fail).GetMessage()));
+    }
+
+exit:
+    return error;
+}
+
+DtlsResources::DtlsResources()
+{
+    mbedtls_ctr_drbg_init(&mCtrDrbg);
+    mbedtls_entropy_init(&mEntropy);
+}
+
+DtlsResources::~DtlsResources()
+{
+    mbedtls_entropy_free(&mEntropy);
+    mbedtls_ctr_drbg_free(&mCtrDrbg);
+}
+
+Error DtlsResources::Init()
+{
+    Error error;
+
+    if (int fail = mbedtls_ctr_drbg_seed(&mCtrDrbg, mbedtls_entropy_func, &mEntropy, nullptr, 0))
+    {
+        ExitNow(error = ErrorFromMbedtlsError(fail));
+    }
+
+exit:
+    return error;
+}
+
+DtlsResources::CredentialsKey DtlsResources::GetCredentialsKey(const DtlsConfig &aConfig)
+{
+    Sha256  sha256;
+    uint8_t hash[Sha256::kHashSize];
+
+    sha256.Start();
+    for (const ByteArray *credential : {&aConfig.mCaChain, &aConfig.mOwnCert, &aConfig.mOwnKey})
+    {
+        // The length is hashed before each credential so that
+        // different splits of the same bytes have different keys.
+        ByteArray length = utils::Encode(static_cast<uint32_t>(credential->size()));
+        size_t    offset = 0;
+
+        sha256.Update(length.data(), static_cast<uint16_t>(length.size()));
+        while (offset < credential->size())
+        {
+            auto chunkLength = std::min<size_t>(credential->size() - offset, UINT16_MAX);
+
+            sha256.Update(credential->data() + offset, static_cast<uint16_t>(chunkLength));
+            offset += chunkLength;
+        }
+    }
+    sha256.Finish(hash);
+
+    return CredentialsKey{hash, hash + sizeof(hash)};
+}
+
+Error DtlsResources::GetCredentials(DtlsCredentialsPtr &aCredentials, const DtlsConfig &aConfig)
+{
+    Error              error;
+    CredentialsKey     key = GetCredentialsKey(aConfig);
+    DtlsCredentialsPtr credentials;
+
+    for (auto it = mCredentials.begin(); it != mCredentials.end();)
+    {
+        it = it->second.expired() ? mCredentials.erase(it) : std::next(it);
+    }
+
+    if (mCredentials.count(key) != 0)
+    {
+        credentials = mCredentials[key].lock();
+    }
+    else
+    {
+        credentials = std::make_shared<DtlsCredentials>();
+        SuccessOrExit(error = credentials->Parse(aConfig));
+        mCredentials[key] = credentials;
+    }
+
+    aCredentials = credentials;
+
+exit:
+    return error;
+}
+
 DtlsSession::DtlsSession(struct event_base *aEventBase, bool aIsServer, SocketPtr aSocket)
     : mSocket(aSocket)
     , mHandshakeTimer(aEventBase, [this](Timer &aTimer) { HandshakeTimerCallback(aTimer); })
@@ -110,24 +227,12 @@ void DtlsSession::InitMbedtls()
 {
     mbedtls_ssl_config_init(&mConfig);
     mbedtls_ssl_cookie_init(&mCookie);
-    mbedtls_ctr_drbg_init(&mCtrDrbg);
-    mbedtls_entropy_init(&mEntropy);
     mbedtls_ssl_init(&mSsl);
-
-    mbedtls_x509_crt_init(&mCaChain);
-    mbedtls_x509_crt_init(&mOwnCert);
-    mbedtls_pk_init(&mOwnKey);
 }
 
 void DtlsSession::FreeMbedtls()
 {
-    mbedtls_pk_free(&mOwnKey);
-    mbedtls_x509_crt_free(&mOwnCert);
-    mbedtls_x509_crt_free(&mCaChain);
-
     mbedtls_ssl_free(&mSsl);
-    mbedtls_entropy_free(&mEntropy);
-    mbedtls_ctr_drbg_free(&mCtrDrbg);
     mbedtls_ssl_cookie_free(&mCookie);
     mbedtls_ssl_config_free(&mConfig);
 }
@@ -164,26 +269,27 @@ Error DtlsSession::Init(const DtlsConfig &aConfig)
         mCipherSuites.push_back(MBEDTLS_TLS_ECJPAKE_WITH_AES_128_CCM_8);
     }
 
+    // RNG & Entropy
+    if (aConfig.mResources != nullptr)
+    {
+        mResources = aConfig.mResources;
+    }
+    else
+    {
+        mResources = std::make_shared<DtlsResources>();
+        SuccessOrExit(error = mResources->Init());
+    }
+    mbedtls_ssl_conf_rng(&mConfig, mbedtls_ctr_drbg_random, mResources->GetCtrDrbg());
+
     // X509
     if (aConfig.mCaChain.size() != 0 || aConfig.mOwnCert.size() != 0 || aConfig.mOwnKey.size() != 0)
     {
-        if (int fail = mbedtls_x509_crt_parse(&mCaChain, &aConfig.mCaChain[0], aConfig.mCaChain.size()))
-        {
-            ExitNow(error = ERROR_INVALID_ARGS("bad CA certificate; {}", ErrorFromMbedtlsError(fail).GetMessage()));
-        }
-        if (int fail = mbedtls_x509_crt_parse(&mOwnCert, &aConfig.mOwnCert[0], aConfig.mOwnCert.size()))
-        {
-            ExitNow(error = ERROR_INVALID_ARGS("bad certificate; {}", ErrorFromMbedtlsError(fail).GetMessage()));
-        }
-        if (int fail = mbedtls_pk_parse_key(&mOwnKey, &aConfig.mOwnKey[0], aConfig.mOwnKey.size(), nullptr, 0))
-        {
-            ExitNow(error = ERROR_INVALID_ARGS("bad private key; {}", ErrorFromMbedtlsError(fail).GetMessage()));
-        }
+        SuccessOrExit(error = mResources->GetCredentials(mCredentials, aConfig));
 
         mCipherSuites.push_back(MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_128_CCM_8);
 
-        mbedtls_ssl_conf_ca_chain(&mConfig, &mCaChain, nullptr);
-        if (int fail = mbedtls_ssl_conf_own_cert(&mConfig, &mOwnCert, &mOwnKey))
+        mbedtls_ssl_conf_ca_chain(&mConfig, mCredentials->GetCaChain(), nullptr);
+        if (int fail = mbedtls_ssl_conf_own_cert(&mConfig, mCredentials->GetOwnCert(), mCredentials->GetOwnKey()))
         {
             ExitNow(error = ErrorFromMbedtlsError(fail));
         }
@@ -194,17 +300,10 @@ Error DtlsSession::Init(const DtlsConfig &aConfig)
 
     mbedtls_ssl_conf_export_keys_cb(&mConfig, HandleMbedtlsExportKeys, this);
 
-    // RNG & Entropy
-    if (int fail = mbedtls_ctr_drbg_seed(&mCtrDrbg, mbedtls_entropy_func, &mEntropy, nullptr, 0))
-    {
-        ExitNow(error = ErrorFromMbedtlsError(fail));
-    }
-    mbedtls_ssl_conf_rng(&mConfig, mbedtls_ctr_drbg_random, &mCtrDrbg);
-
     // Cookie
     if (mIsServer)
     {
-        if (int fail = mbedtls_ssl_cookie_setup(&mCookie, mbedtls_ctr_drbg_random, &mCtrDrbg))
+        if (int fail = mbedtls_ssl_cookie_setup(&mCookie, mbedtls_ctr_drbg_random, mResources->GetCtrDrbg()))
         {
             ExitNow(error = ErrorFromMbedtlsError(fail));
         }
@@ -36,6 +36,8 @@
 
 #include <functional>
 #include <list>
+#include <map>
+#include <memory>
 #include <queue>
 #include <vector>
 
@@ -62,6 +64,8 @@ namespace commissioner {
 static constexpr uint32_t kDtlsHandshakeTimeoutMin = 8;
 static constexpr uint32_t kDtlsHandshakeTimeoutMax = 60;
 
+class DtlsResources;
+
 struct DtlsConfig
 {
     bool      mEnableDebugLogging = false;
@@ -70,8 +74,70 @@ struct DtlsConfig
     ByteArray mOwnKey;
     ByteArray mOwnCert;
     ByteArray mCaChain;
+
+    // Resources shared with other sessions of the same event loop.
+    // A session creates its own resources if this is not set.
+    std::shared_ptr<DtlsResources> mResources;
+};
+
+// Parsed X.509 certificates and private key of a DTLS config.
+class DtlsCredentials
+{
+public:
+    DtlsCredentials();
+    ~DtlsCredentials();
+    DtlsCredentials(const DtlsCredentials &aOther) = delete;
+    const DtlsCredentials &operator=(const DtlsCredentials &aOther) = delete;
+
+    Error Parse(const DtlsConfig &aConfig);
+
+    mbedtls_x509_crt *  GetCaChain() { return &mCaChain; }
+    mbedtls_x509_crt *  GetOwnCert() { return &mOwnCert; }
+    mbedtls_pk_context *GetOwnKey() { return &mOwnKey; }
+
+private:
+    mbedtls_x509_crt   mCaChain;
+    mbedtls_x509_crt   mOwnCert;
+    mbedtls_pk_context mOwnKey;
+};
+
+using DtlsCredentialsPtr = std::shared_ptr<DtlsCredentials>;
+
+// Resources which are expensive to set up and can be shared by DTLS
+// sessions: a seeded CTR-DRBG and parsed credentials. They are not
+// thread-safe (mbedtls may update EC group tables of a key in use),
+// so only sessions running in the same event loop can share them.
+class DtlsResources
+{
+public:
+    DtlsResources();
+    ~DtlsResources();
+    DtlsResources(const DtlsResources &aOther) = delete;
+    const DtlsResources &operator=(const DtlsResources &aOther) = delete;
+
+    Error Init();
+
+    mbedtls_ctr_drbg_context *GetCtrDrbg() { return &mCtrDrbg; }
+
+    // Returns credentials of the config, which are parsed only once
+    // and cached as long as they are used by any session.
+    Error GetCredentials(DtlsCredentialsPtr &aCredentials, const DtlsConfig &aConfig);
+
+private:
+    // A digest of the certificates and private key, so that
+    // the cache does not keep copies of the private key.
+    using CredentialsKey = ByteArray;
+
+    static CredentialsKey GetCredentialsKey(const DtlsConfig &aConfig);
+
+    mbedtls_ctr_drbg_context mCtrDrbg;
+    mbedtls_entropy_context  mEntropy;
+
+    std::map<CredentialsKey, std::weak_ptr<DtlsCredentials>> mCredentials;
 };
 
+using DtlsResourcesPtr = std::shared_ptr<DtlsResources>;
+
 DtlsConfig GetDtlsConfig(const Config &aConfig);
 
 class DtlsSession : public Endpoint
@@ -196,17 +262,17 @@ private:
 
     std::queue<std::pair<ByteArray, MessageSubType>> mSendQueue;
 
-    std::vector<int>         mCipherSuites;
-    mbedtls_ssl_config       mConfig;
-    mbedtls_ssl_cookie_ctx   mCookie;
-    mbedtls_ctr_drbg_context mCtrDrbg;
-    mbedtls_entropy_context  mEntropy;
-    mbedtls_ssl_context      mSsl;
+    // The config refers to the resources and credentials,
+    // they must be declared before it and outlive it.
+    DtlsResourcesPtr   mResources;
+    DtlsCredentialsPtr mCredentials;
 
-    ByteArray          mPSK;
-    mbedtls_x509_crt   mCaChain;
-    mbedtls_x509_crt   mOwnCert;
-    mbedtls_pk_context mOwnKey;
+    std::vector<int>       mCipherSuites;
+    mbedtls_ssl_config     mConfig;
+    mbedtls_ssl_cookie_ctx mCookie;
+    mbedtls_ssl_context    mSsl;
+
+    ByteArray mPSK;
 };
 
 using DtlsSessionPtr = std::shared_ptr<DtlsSession>;
@@ -0,0 +1,423 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the ECDSA signer with precomputed nonces.
+ */
+
+#include "library/ecdsa_signer.hpp"
+
+#if OT_COMM_CONFIG_CCM_ENABLE
+
+#include <algorithm>
+
+#include "common/error_macros.hpp"
+#include "common/utils.hpp"
+#include "library/logging.hpp"
+#include "library/mbedtls_error.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+EcdsaSigner::Nonce::Nonce()
+{
+    mbedtls_mpi_init(&mR);
+    mbedtls_mpi_init(&mBlinding);
+    mbedtls_mpi_init(&mBlindedInverse);
+}
+
+EcdsaSigner::Nonce::Nonce(Nonce &&aOther)
+    : Nonce()
+{
+    *this = std::move(aOther);
+}
+
+EcdsaSigner::Nonce &EcdsaSigner::Nonce::operator=(Nonce &&aOther)
+{
+    mbedtls_mpi_swap(&mR, &aOther.mR);
+    mbedtls_mpi_swap(&mBlinding, &aOther.mBlinding);
+    mbedtls_mpi_swap(&mBlindedInverse, &aOther.mBlindedInverse);
+    return *this;
+}
+
+EcdsaSigner::Nonce::~Nonce()
+{
+    mbedtls_mpi_free(&mBlindedInverse);
+    mbedtls_mpi_free(&mBlinding);
+    mbedtls_mpi_free(&mR);
+}
+
+EcdsaSigner::Random::Random()
+{
+    mbedtls_ctr_drbg_init(&mCtrDrbg);
+    mbedtls_entropy_init(&mEntropy);
+}
+
+EcdsaSigner::Random::~Random()
+{
+    mbedtls_entropy_free(&mEntropy);
+    mbedtls_ctr_drbg_free(&mCtrDrbg);
+}
+
+Error EcdsaSigner::Random::Init()
+{
+    return ErrorFromMbedtlsError(mbedtls_ctr_drbg_seed(&mCtrDrbg, mbedtls_entropy_func, &mEntropy, nullptr, 0));
+}
+
+EcdsaSigner::EcdsaSigner()
+{
+    mbedtls_ecp_group_init(&mGroup);
+    mbedtls_mpi_init(&mPrivateKey);
+    mbedtls_ecp_group_init(&mWorkerGroup);
+}
+
+EcdsaSigner::~EcdsaSigner()
+{
+    if (mWorker != nullptr)
+    {
+        mWorker->Remove(*this);
+        mWorker.reset();
+    }
+
+    mbedtls_ecp_group_free(&mWorkerGroup);
+    mbedtls_mpi_free(&mPrivateKey);
+    mbedtls_ecp_group_free(&mGroup);
+}
+
+Error EcdsaSigner::Init(const mbedtls_pk_context &aPrivateKey, size_t aPoolCapacity)
+{
+    Error                      error;
+    const mbedtls_ecp_keypair *eckey = nullptr;
+
+    VerifyOrExit(mGroup.id == MBEDTLS_ECP_DP_NONE,
+                 error = ERROR_INVALID_STATE("the ECDSA signer has been initialized"));
+
+    // Accepts only EC keys
+    VerifyOrExit(mbedtls_pk_can_do(&aPrivateKey, MBEDTLS_PK_ECDSA) && (eckey = mbedtls_pk_ec(aPrivateKey)) != nullptr,
+                 error = ERROR_INVALID_ARGS("ECDSA signing without valid EC private key"));
+
+    SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_ecp_group_copy(&mGroup, &eckey->grp)));
+    SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_ecp_group_copy(&mWorkerGroup, &eckey->grp)));
+    SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_mpi_copy(&mPrivateKey, &eckey->d)));
+    SuccessOrExit(error = mRandom.Init());
+
+    mPoolCapacity = aPoolCapacity;
+    if (mPoolCapacity > 0)
+    {
+        mWorker = Worker::Get();
+        mWorker->Add(*this);
+    }
+
+exit:
+    return error;
+}
+
+Error EcdsaSigner::Sign(ByteArray &aSignature, const uint8_t *aHash, size_t aHashLength)
+{
+    Error       error;
+    Nonce       nonce;
+    mbedtls_mpi e;
+    mbedtls_mpi s;
+    mbedtls_mpi tmp;
+    size_t      length = (mGroup.nbits + 7) / 8;
+    ByteArray   signature(length * 2);
+
+    mbedtls_mpi_init(&e);
+    mbedtls_mpi_init(&s);
+    mbedtls_mpi_init(&tmp);
+
+    VerifyOrExit(mGroup.id != MBEDTLS_ECP_DP_NONE, error = ERROR_INVALID_STATE("the ECDSA signer is not initialized"));
+    SuccessOrExit(error = HashToInteger(e, aHash, aHashLength));
+
+    do
+    {
+        if (!TakeNonce(nonce))
+        {
+            SuccessOrExit(error = MakeNonce(nonce, mGroup, mRandom));
+        }
+
+        // s = (k * t)^-1 * (e * t + r * d * t) mod n
+        SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_mpi_mul_mpi(&s, &e, &nonce.mBlinding)));
+        SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_mpi_mul_mpi(&tmp, &nonce.mR, &nonce.mBlinding)));
+        SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_mpi_mod_mpi(&tmp, &tmp, &mGroup.N)));
+        SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_mpi_mul_mpi(&tmp, &tmp, &mPrivateKey)));
+        SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_mpi_add_mpi(&s, &s, &tmp)));
+        SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_mpi_mod_mpi(&s, &s, &mGroup.N)));
+        SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_mpi_mul_mpi(&s, &s, &nonce.mBlindedInverse)));
+        SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_mpi_mod_mpi(&s, &s, &mGroup.N)));
+    } while (mbedtls_mpi_cmp_int(&s, 0) == 0);
+
+    SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_mpi_write_binary(&nonce.mR, &signature[0], length)));
+    SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_mpi_write_binary(&s, &signature[length], length)));
+
+    aSignature = std::move(signature);
+
+exit:
+    mbedtls_mpi_free(&tmp);
+    mbedtls_mpi_free(&s);
+    mbedtls_mpi_free(&e);
+    return error;
+}
+
+size_t EcdsaSigner::GetPoolSize() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    return mPool.size();
+}
+
+Error EcdsaSigner::MakeNonce(Nonce &aNonce, mbedtls_ecp_group &aGroup, Random &aRandom)
+{
+    Error             error;
+    mbedtls_mpi       k;
+    mbedtls_ecp_point point;
+
+    mbedtls_mpi_init(&k);
+    mbedtls_ecp_point_init(&point);
+
+    // The scalar multiplication uses the precomputed table of the
+    // generator, which is cached in the group after the first one.
+    do
+    {
+        SuccessOrExit(error = ErrorFromMbedtlsError(
+                          mbedtls_ecp_gen_keypair(&aGroup, &k, &point, mbedtls_ctr_drbg_random, &aRandom.mCtrDrbg)));
+        SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_mpi_mod_mpi(&aNonce.mR, &point.X, &aGroup.N)));
+    } while (mbedtls_mpi_cmp_int(&aNonce.mR, 0) == 0);
+
+    SuccessOrExit(error = ErrorFromMbedtlsError(
+                      mbedtls_ecp_gen_privkey(&aGroup, &aNonce.mBlinding, mbedtls_ctr_drbg_random, &aRandom.mCtrDrbg)));
+
+    SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_mpi_mul_mpi(&k, &k, &aNonce.mBlinding)));
+    SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_mpi_inv_mod(&aNonce.mBlindedInverse, &k, &aGroup.N)));
+
+exit:
+    mbedtls_ecp_point_free(&point);
+    mbedtls_mpi_free(&k);
+    return error;
+}
+
+Error EcdsaSigner::HashToInteger(mbedtls_mpi &aInteger, const uint8_t *aHash, size_t aHashLength) const
+{
+    Error  error;
+    size_t length = std::min(aHashLength, (mGroup.nbits + 7) / 8);
+
+    SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_mpi_read_binary(&aInteger, aHash, length)));
+    if (length * 8 > mGroup.nbits)
+    {
+        SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_mpi_shift_r(&aInteger, length * 8 - mGroup.nbits)));
+    }
+    if (mbedtls_mpi_cmp_mpi(&aInteger, &mGroup.N) >= 0)
+    {
+        SuccessOrExit(error = ErrorFromMbedtlsError(mbedtls_mpi_sub_mpi(&aInteger, &aInteger, &mGroup.N)));
+    }
+
+exit:
+    return error;
+}
+
+bool EcdsaSigner::TakeNonce(Nonce &aNonce)
+{
+    bool refill;
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        if (mPool.empty())
+        {
+            return false;
+        }
+
+        aNonce = std::move(mPool.front());
+        mPool.pop_front();
+        refill = mPool.size() <= mPoolCapacity / 2;
+    }
+
+    // The worker locks the pool with its own lock held,
+    // so it is notified after the pool is unlocked.
+    if (refill)
+    {
+        mWorker->Notify();
+    }
+    return true;
+}
+
+void EcdsaSigner::PutNonce(Nonce &&aNonce)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mPool.push_back(std::move(aNonce));
+}
+
+bool EcdsaSigner::IsRefilling()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if (mPool.size() <= mPoolCapacity / 2)
+    {
+        mRefilling = true;
+    }
+    else if (mPool.size() >= mPoolCapacity)
+    {
+        mRefilling = false;
+    }
+    return mRefilling;
+}
+
+EcdsaSigner::Worker::Worker()
+    : mThread([this]() { Run(); })
+{
+}
+
+EcdsaSigner::Worker::~Worker()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mStopped = true;
+    }
+    mCondition.notify_all();
+    mThread.join();
+}
+
+std::shared_ptr<EcdsaSigner::Worker> EcdsaSigner::Worker::Get()
+{
+    static std::mutex            sMutex;
+    static std::weak_ptr<Worker> sWorker;
+
+    std::lock_guard<std::mutex> lock(sMutex);
+    auto                        worker = sWorker.lock();
+
+    if (worker == nullptr)
+    {
+        worker  = std::make_shared<Worker>();
+        sWorker = worker;
+    }
+    return worker;
+}
+
+void EcdsaSigner::Worker::Add(EcdsaSigner &aSigner)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mSigners.push_back(&aSigner);
+        mNotified = true;
+    }
+    mCondition.notify_all();
+}
+
+void EcdsaSigner::Worker::Remove(EcdsaSigner &aSigner)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    mSigners.erase(std::remove(mSigners.begin(), mSigners.end(), &aSigner), mSigners.end());
+    mCondition.wait(lock, [this, &aSigner]() { return mBusySigner != &aSigner; });
+}
+
+void EcdsaSigner::Worker::Notify()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mNotified = true;
+    }
+    mCondition.notify_all();
+}
+
+EcdsaSigner *EcdsaSigner::Worker::NextSigner()
+{
+    // Signers are served in turn, so that a busy
+    // signer cannot starve the others.
+    for (size_t i = 0; i < mSigners.size(); ++i)
+    {
+        EcdsaSigner *signer = mSigners[(mNextSigner + i) % mSigners.size()];
+
+        if (signer->IsRefilling())
+        {
+            mNextSigner = (mNextSigner + i + 1) % mSigners.size();
+            return signer;
+        }
+    }
+    return nullptr;
+}
+
+void EcdsaSigner::Worker::Run()
+{
+    Error                        error;
+    Random                       random;
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    SuccessOrExit(error = random.Init());
+
+    while (!mStopped)
+    {
+        EcdsaSigner *signer = NextSigner();
+        Nonce        nonce;
+
+        if (signer == nullptr)
+        {
+            mCondition.wait(lock, [this]() { return mStopped || mNotified; });
+            mNotified = false;
+            continue;
+        }
+
+        mBusySigner = signer;
+        lock.unlock();
+
+        error = MakeNonce(nonce, signer->mWorkerGroup, random);
+        if (error == ErrorCode::kNone)
+        {
+            signer->PutNonce(std::move(nonce));
+        }
+
+        lock.lock();
+        mBusySigner = nullptr;
+        mCondition.notify_all();
+
+        if (error != ErrorCode::kNone)
+        {
+            // The signer computes nonces in place from now on.
+            LOG_WARN(LOG_REGION_TOKEN_MANAGER, "stopped precomputing ECDSA nonces of a signer: {}", error.ToString());
+            mSigners.erase(std::remove(mSigners.begin(), mSigners.end(), signer), mSigners.end());
+        }
+    }
+
+exit:
+    if (error != ErrorCode::kNone)
+    {
+        LOG_WARN(LOG_REGION_TOKEN_MANAGER, "stopped precomputing ECDSA nonces: {}", error.ToString());
+    }
+}
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_CONFIG_CCM_ENABLE
@@ -0,0 +1,192 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines the ECDSA signer with precomputed nonces.
+ */
+
+#ifndef OT_COMM_LIBRARY_ECDSA_SIGNER_HPP_
+#define OT_COMM_LIBRARY_ECDSA_SIGNER_HPP_
+
+#if OT_COMM_CONFIG_CCM_ENABLE
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <mbedtls/bignum.h>
+#include <mbedtls/ctr_drbg.h>
+#include <mbedtls/ecp.h>
+#include <mbedtls/entropy.h>
+#include <mbedtls/pk.h>
+
+#include <commissioner/defines.hpp>
+#include <commissioner/error.hpp>
+
+namespace ot {
+
+namespace commissioner {
+
+// ECDSA signing with precomputed nonces.
+//
+// An ECDSA signature is dominated by the scalar multiplication
+// R = k * G of the per-signature nonce k, which does not depend
+// on the message. The signer precomputes nonces in a background
+// thread, so that signing a message takes only a few modular
+// multiplications:
+//
+//     s = (k * t)^-1 * (e * t + r * d * t) mod n
+//
+// where r is the x-coordinate of R, d is the private key and t is
+// a random blinding value. A nonce is never used twice, signing
+// computes a nonce in place if the pool is drained.
+//
+// All signers share a single worker thread, which refills the pools
+// in turn, so commissioners sharing event loops do not add threads.
+class EcdsaSigner
+{
+public:
+    // The default number of precomputed nonces.
+    static constexpr size_t kDefaultPoolCapacity = 64;
+
+    EcdsaSigner();
+    ~EcdsaSigner();
+
+    EcdsaSigner(const EcdsaSigner &aOther) = delete;
+    EcdsaSigner &operator=(const EcdsaSigner &aOther) = delete;
+
+    // Initializes with an EC private key and starts precomputing
+    // nonces. A zero @p aPoolCapacity disables the precomputation.
+    Error Init(const mbedtls_pk_context &aPrivateKey, size_t aPoolCapacity = kDefaultPoolCapacity);
+
+    // Signs the hash of a message. @p aSignature is r || s, each
+    // has the length of the curve's order as required by COSE.
+    Error Sign(ByteArray &aSignature, const uint8_t *aHash, size_t aHashLength);
+
+    // Returns the number of precomputed nonces available.
+    size_t GetPoolSize() const;
+
+private:
+    // A nonce k precomputed as r and (k * t)^-1 mod n.
+    class Nonce
+    {
+    public:
+        Nonce();
+        Nonce(Nonce &&aOther);
+        Nonce &operator=(Nonce &&aOther);
+        ~Nonce();
+
+        mbedtls_mpi mR;
+        mbedtls_mpi mBlinding;
+        mbedtls_mpi mBlindedInverse;
+    };
+
+    // The random number generator, which is not thread-safe.
+    class Random
+    {
+    public:
+        Random();
+        ~Random();
+
+        Error Init();
+
+        mbedtls_ctr_drbg_context mCtrDrbg;
+        mbedtls_entropy_context  mEntropy;
+    };
+
+    // The thread precomputing nonces of all signers.
+    class Worker
+    {
+    public:
+        Worker();
+        ~Worker();
+
+        // Returns the worker shared by all signers, which
+        // is stopped when no signer is using it.
+        static std::shared_ptr<Worker> Get();
+
+        void Add(EcdsaSigner &aSigner);
+
+        // Removes the signer and waits until the worker is done with it.
+        void Remove(EcdsaSigner &aSigner);
+
+        // Wakes up the worker when a pool needs to be refilled.
+        void Notify();
+
+    private:
+        void         Run();
+        EcdsaSigner *NextSigner();
+
+        std::vector<EcdsaSigner *> mSigners;
+        size_t                     mNextSigner = 0;
+        EcdsaSigner *              mBusySigner = nullptr;
+        bool                       mStopped    = false;
+        bool                       mNotified   = false;
+        std::mutex                 mMutex;
+        std::condition_variable    mCondition;
+        std::thread                mThread;
+    };
+
+    static Error MakeNonce(Nonce &aNonce, mbedtls_ecp_group &aGroup, Random &aRandom);
+
+    // Converts the hash to an integer as described in 4.1.3 of SEC1.
+    Error HashToInteger(mbedtls_mpi &aInteger, const uint8_t *aHash, size_t aHashLength) const;
+
+    bool TakeNonce(Nonce &aNonce);
+    void PutNonce(Nonce &&aNonce);
+
+    // Returns true if the pool is being refilled, which starts when half
+    // of the pool is consumed and ends when the pool is full.
+    bool IsRefilling();
+
+    // Used by the signing thread only.
+    mbedtls_ecp_group mGroup;
+    mbedtls_mpi       mPrivateKey;
+    Random            mRandom;
+
+    // Used by the worker thread only.
+    mbedtls_ecp_group mWorkerGroup;
+
+    size_t                  mPoolCapacity = 0;
+    std::deque<Nonce>       mPool;
+    bool                    mRefilling = true;
+    mutable std::mutex      mMutex;
+    std::shared_ptr<Worker> mWorker;
+};
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_CONFIG_CCM_ENABLE
+
+#endif // OT_COMM_LIBRARY_ECDSA_SIGNER_HPP_
@@ -0,0 +1,207 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the event loop running in a background thread.
+ */
+
+#include "library/event_loop.hpp"
+
+#include <future>
+
+#include "common/error_macros.hpp"
+#include "library/logging.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+EventLoop::EventLoop()
+    : mEventBase(event_base_new())
+    , mDtlsResources(std::make_shared<DtlsResources>())
+{
+}
+
+// The event base of a loop destroyed in its own thread, which
+// is freed by the thread once the loop returns.
+static thread_local struct event_base *sOrphanedEventBase = nullptr;
+
+EventLoop::~EventLoop()
+{
+    if (mThread.joinable() && mThread.get_id() == std::this_thread::get_id())
+    {
+        // The last reference is released in the event-loop thread, which
+        // cannot wait for itself. Break the loop inline and let the thread
+        // exit on its own.
+        if (mIsDestroyed != nullptr)
+        {
+            *mIsDestroyed = true;
+        }
+        event_del(&mInvokeEvent);
+        event_base_loopbreak(mEventBase);
+        sOrphanedEventBase = mEventBase;
+        mThread.detach();
+        ExitNow();
+    }
+
+    Stop();
+
+    if (mEventBase != nullptr)
+    {
+        event_base_free(mEventBase);
+    }
+
+exit:
+    return;
+}
+
+Error EventLoop::Start()
+{
+    Error error;
+
+    // The default timeout value (1 day) for non-IO events (events with fd < 0).
+    constexpr struct timeval kDefaultNonIoEventTimeout = {3600 * 24, 0};
+
+    struct event_base *eventBase = mEventBase;
+
+    VerifyOrExit(!mThread.joinable(), error = ERROR_INVALID_STATE("the event loop has been started"));
+    VerifyOrExit(mEventBase != nullptr, error = ERROR_OUT_OF_MEMORY("failed to create event base"));
+
+    SuccessOrExit(error = mDtlsResources->Init());
+
+    error = ERROR_UNKNOWN("failed to initialize event base");
+    VerifyOrExit(evthread_use_pthreads() == 0);
+    VerifyOrExit(evthread_make_base_notifiable(mEventBase) == 0);
+    VerifyOrExit(event_assign(&mInvokeEvent, mEventBase, -1, EV_PERSIST, Invoke, this) == 0);
+
+    // We add the event with a timeout value so that the event loop will not
+    // exit prematurely because of no events.
+    VerifyOrExit(event_add(&mInvokeEvent, &kDefaultNonIoEventTimeout) == 0);
+    error = ERROR_NONE;
+
+    // The thread does not access this object after the loop returns,
+    // the object may have been destroyed in the thread.
+    mThread = std::thread([eventBase]() {
+        LOG_INFO(LOG_REGION_MESHCOP, "event loop started in background thread");
+        event_base_loop(eventBase, 0);
+
+        if (sOrphanedEventBase == eventBase)
+        {
+            event_base_free(eventBase);
+        }
+    });
+
+exit:
+    return error;
+}
+
+void EventLoop::Stop()
+{
+    VerifyOrExit(mThread.joinable());
+
+    // Break the event loop from inside. This makes sure the
+    // event loop has been started when we trying to break it.
+    PostAndWait([this]() { event_base_loopbreak(mEventBase); });
+
+    mThread.join();
+    event_del(&mInvokeEvent);
+
+exit:
+    return;
+}
+
+void EventLoop::Post(Task &&aTask)
+{
+    mTaskQueue.Push(std::move(aTask));
+
+    // Notify for new task. The event loop runs all pending
+    // tasks once activated, so only the first one needs to notify.
+    if (mPendingTasks.fetch_add(1) == 0)
+    {
+        event_active(&mInvokeEvent, 0, 0);
+    }
+}
+
+void EventLoop::PostAndWait(Task &&aTask)
+{
+    std::promise<void> pro;
+    Task               task = std::move(aTask);
+
+    ASSERT(mThread.get_id() != std::this_thread::get_id());
+
+    Post([&pro, &task]() {
+        task();
+        pro.set_value();
+    });
+
+    pro.get_future().wait();
+}
+
+void EventLoop::Invoke(evutil_socket_t, short, void *aContext)
+{
+    auto eventLoop = reinterpret_cast<EventLoop *>(aContext);
+
+    VerifyOrDie(eventLoop != nullptr);
+
+    eventLoop->RunTasks();
+}
+
+void EventLoop::RunTasks()
+{
+    // Yields with a zero timeout so that I/O events which are
+    // ready are processed before the rest of tasks.
+    static constexpr struct timeval kYieldTimeout = {0, 0};
+
+    Task    task;
+    int64_t count       = 0;
+    bool    isDestroyed = false;
+
+    // A task may release the last reference to this event loop.
+    mIsDestroyed = &isDestroyed;
+    while (count < kMaxTasksPerInvoke && mTaskQueue.Pop(task))
+    {
+        task();
+        task = nullptr;
+        VerifyOrExit(!isDestroyed);
+        ++count;
+    }
+    mIsDestroyed = nullptr;
+
+    if (mPendingTasks.fetch_sub(count) > count)
+    {
+        event_base_once(mEventBase, -1, EV_TIMEOUT, Invoke, this, &kYieldTimeout);
+    }
+
+exit:
+    return;
+}
+
+} // namespace commissioner
+
+} // namespace ot
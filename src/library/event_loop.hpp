@@ -0,0 +1,134 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines the event loop running in a background thread.
+ */
+
+#ifndef OT_COMM_LIBRARY_EVENT_LOOP_HPP_
+#define OT_COMM_LIBRARY_EVENT_LOOP_HPP_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+
+#include <commissioner/error.hpp>
+
+#include "library/dtls.hpp"
+#include "library/event.hpp"
+#include "library/mpsc_queue.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+/**
+ * This class runs a libevent loop in a background thread.
+ *
+ * Other threads access objects living in the event loop by posting
+ * tasks, which are run in the event-loop thread in posting order. An
+ * event loop can be shared by multiple commissioners, they also share
+ * the DTLS resources of the event loop.
+ *
+ */
+class EventLoop
+{
+public:
+    using Task = std::function<void()>;
+
+    EventLoop();
+
+    // The event loop may be destroyed in its own thread, in which
+    // case the thread is not joined but exits on its own.
+    ~EventLoop();
+
+    EventLoop(const EventLoop &aEventLoop) = delete;
+    const EventLoop &operator=(const EventLoop &aEventLoop) = delete;
+
+    // Starts the event-loop thread.
+    Error Start();
+
+    // Stops and joins the event-loop thread, it must not be called
+    // in the event-loop thread.
+    void Stop();
+
+    struct event_base *GetEventBase() { return mEventBase; }
+
+    const DtlsResourcesPtr &GetDtlsResources() const { return mDtlsResources; }
+
+    // Posts a task to the event loop, it is safe to be called by any thread.
+    void Post(Task &&aTask);
+
+    // Posts a task and waits for it to be done. It must not be called
+    // in the event-loop thread.
+    void PostAndWait(Task &&aTask);
+
+private:
+    // The number of preallocated cells of the task queue.
+    static constexpr size_t kTaskQueueCapacity = 1024;
+
+    // The max number of tasks run before yielding to
+    // other events of the event loop.
+    static constexpr int64_t kMaxTasksPerInvoke = 64;
+
+    static void Invoke(evutil_socket_t aFd, short aFlags, void *aContext);
+    void        RunTasks();
+
+    struct event_base *mEventBase;
+
+    // The event used to synchronize between the event-loop thread and
+    // other threads. It is activated by posting tasks and the callback
+    // runs the tasks in the event-loop thread.
+    struct event mInvokeEvent;
+
+    DtlsResourcesPtr mDtlsResources;
+
+    // The schedule queue of all tasks.
+    MpscQueue<Task> mTaskQueue{kTaskQueueCapacity};
+
+    // The number of tasks which are posted but not run. It may be
+    // transiently negative since a task is counted after it is
+    // pushed and the event loop could have run it in between.
+    std::atomic<int64_t> mPendingTasks{0};
+
+    // Set by the destructor if the event loop is destroyed
+    // by a task which is being run.
+    bool *mIsDestroyed = nullptr;
+
+    std::thread mThread;
+};
+
+using EventLoopPtr = std::shared_ptr<EventLoop>;
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_LIBRARY_EVENT_LOOP_HPP_
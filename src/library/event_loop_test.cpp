@@ -0,0 +1,92 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases of EventLoop.
+ */
+
+#include <future>
+
+#include <catch2/catch.hpp>
+
+#include "library/event_loop.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+TEST_CASE("event-loop-runs-tasks-in-order", "[event-loop]")
+{
+    constexpr int kTaskCount = 1000;
+
+    EventLoop        eventLoop;
+    std::vector<int> results;
+
+    REQUIRE(eventLoop.Start() == ErrorCode::kNone);
+
+    for (int i = 0; i < kTaskCount; ++i)
+    {
+        eventLoop.Post([&results, i]() { results.push_back(i); });
+    }
+    eventLoop.PostAndWait([]() {});
+
+    REQUIRE(results.size() == kTaskCount);
+    for (int i = 0; i < kTaskCount; ++i)
+    {
+        REQUIRE(results[i] == i);
+    }
+}
+
+TEST_CASE("event-loop-destroyed-in-its-own-thread", "[event-loop]")
+{
+    auto               eventLoop = std::make_shared<EventLoop>();
+    std::promise<void> released;
+    std::promise<void> destroyed;
+    auto               releasedFuture  = released.get_future();
+    auto               destroyedFuture = destroyed.get_future();
+
+    REQUIRE(eventLoop->Start() == ErrorCode::kNone);
+
+    // The task holds the last reference to the event loop and releases
+    // it in the event-loop thread. The tasks behind it are dropped.
+    eventLoop->Post([eventLoop, &releasedFuture, &destroyed]() mutable {
+        releasedFuture.wait();
+        eventLoop.reset();
+        destroyed.set_value();
+    });
+    eventLoop->Post([]() { FAIL("task run after the event loop is destroyed"); });
+    eventLoop.reset();
+    released.set_value();
+
+    REQUIRE(destroyedFuture.wait_for(std::chrono::seconds(1)) == std::future_status::ready);
+}
+
+} // namespace commissioner
+
+} // namespace ot
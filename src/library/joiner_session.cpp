@@ -68,7 +68,7 @@ void JoinerSession::Connect()
 {
     Error error;
 
-    auto dtlsConfig = GetDtlsConfig(mCommImpl.GetConfig());
+    auto dtlsConfig = mCommImpl.GetDtlsConfig();
     dtlsConfig.mPSK = {mJoinerPSKd.begin(), mJoinerPSKd.end()};
 
     mExpirationTime = Clock::now() + MilliSeconds(kDtlsHandshakeTimeoutMax * 1000 + kJoinerTimeout * 1000);
@@ -96,37 +96,43 @@ ByteArray JoinerSession::GetJoinerIid() const
 
 void JoinerSession::HandleConnect(Error aError)
 {
-    mCommImpl.mCommissionerHandler.OnJoinerConnected(mJoinerId, aError);
+    auto joinerId = mJoinerId;
+
+    mCommImpl.DispatchToHandler(
+        [joinerId, aError](CommissionerHandler &aHandler) { aHandler.OnJoinerConnected(joinerId, aError); });
 }
 
-void JoinerSession::RecvJoinerDtlsRecords(const ByteArray &aRecords)
+void JoinerSession::RecvJoinerDtlsRecords(const uint8_t *aRecords, size_t aLength)
 {
-    mRelaySocket->RecvJoinerDtlsRecords(aRecords);
+    mRelaySocket->RecvJoinerDtlsRecords(aRecords, aLength);
 }
 
-Error JoinerSession::SendRlyTx(const ByteArray &aDtlsMessage, bool aIncludeKek)
+Error JoinerSession::SendRlyTx(const uint8_t *aDtlsMessage, size_t aLength, bool aIncludeKek)
 {
-    Error         error;
-    coap::Request rlyTx{coap::Type::kNonConfirmable, coap::Code::kPost};
+    Error          error;
+    coap::Request  rlyTx{coap::Type::kNonConfirmable, coap::Code::kPost};
+    tlv::TlvWriter writer{rlyTx.GetPayload()};
 
     SuccessOrExit(error = rlyTx.SetUriPath(uri::kRelayTx));
 
-    SuccessOrExit(error = AppendTlv(rlyTx, {tlv::Type::kJoinerUdpPort, GetJoinerUdpPort()}));
-    SuccessOrExit(error = AppendTlv(rlyTx, {tlv::Type::kJoinerRouterLocator, GetJoinerRouterLocator()}));
-    SuccessOrExit(error = AppendTlv(rlyTx, {tlv::Type::kJoinerIID, GetJoinerIid()}));
-    SuccessOrExit(error = AppendTlv(rlyTx, {tlv::Type::kJoinerDtlsEncapsulation, aDtlsMessage}));
+    SuccessOrExit(error = writer.Write(tlv::Type::kJoinerUdpPort, GetJoinerUdpPort()));
+    SuccessOrExit(error = writer.Write(tlv::Type::kJoinerRouterLocator, GetJoinerRouterLocator()));
+    SuccessOrExit(error = writer.Write(tlv::Type::kJoinerIID, GetJoinerIid()));
+
+    // The DTLS records are copied only once, straight into the payload.
+    SuccessOrExit(error = writer.Write(tlv::Type::kJoinerDtlsEncapsulation, {{aDtlsMessage, aLength}}));
 
     if (aIncludeKek)
     {
         VerifyOrExit(!mDtlsSession->GetKek().empty(), error = ERROR_INVALID_STATE("DTLS KEK is not available"));
-        SuccessOrExit(error = AppendTlv(rlyTx, {tlv::Type::kJoinerRouterKEK, mDtlsSession->GetKek()}));
+        SuccessOrExit(error = writer.Write(tlv::Type::kJoinerRouterKEK, mDtlsSession->GetKek()));
     }
 
     mCommImpl.mBrClient.SendRequest(rlyTx, nullptr);
 
     LOG_DEBUG(LOG_REGION_JOINER_SESSION,
               "session(={}) sent RLY_TX.ntf: SessionState={}, joinerID={}, length={}, includeKek={}",
-              static_cast<void *>(this), mDtlsSession->GetStateString(), utils::Hex(GetJoinerId()), aDtlsMessage.size(),
+              static_cast<void *>(this), mDtlsSession->GetStateString(), utils::Hex(GetJoinerId()), aLength,
               aIncludeKek);
 
 exit:
@@ -135,7 +141,6 @@ exit:
 
 void JoinerSession::HandleJoinFin(const coap::Request &aJoinFin)
 {
-    bool        accepted = false;
     Error       error;
     tlv::TlvSet tlvSet;
     tlv::TlvPtr stateTlv              = nullptr;
@@ -180,22 +185,49 @@ void JoinerSession::HandleJoinFin(const coap::Request &aJoinFin)
              vendorSwVersionTlv->GetValueAsString(), utils::Hex(vendorStackVersionTlv->GetValue()), provisioningUrl,
              utils::Hex(vendorData));
 
+    // The joiner retransmits JOIN_FIN.req while the user is deciding.
+    VerifyOrExit(!mJoinFinPending);
+    mJoinFinPending = true;
+
     // Validation done, request commissioning by user.
-    accepted = mCommImpl.mCommissionerHandler.OnJoinerFinalize(
-        mJoinerId, vendorNameTlv->GetValueAsString(), vendorModelTlv->GetValueAsString(),
-        vendorSwVersionTlv->GetValueAsString(), vendorStackVersionTlv->GetValue(), provisioningUrl, vendorData);
-    VerifyOrExit(accepted, error = ERROR_REJECTED("joiner(ID={}) is rejected", utils::Hex(mJoinerId)));
+    {
+        coap::Request joinFin            = aJoinFin;
+        auto          joinerId           = mJoinerId;
+        auto          vendorName         = vendorNameTlv->GetValueAsString();
+        auto          vendorModel        = vendorModelTlv->GetValueAsString();
+        auto          vendorSwVersion    = vendorSwVersionTlv->GetValueAsString();
+        auto          vendorStackVersion = vendorStackVersionTlv->GetValue();
+        auto          onAccept           = mCommImpl.BindEventLoop<bool>(
+            mLifetime, [this, joinFin](bool aAccepted) { HandleJoinFinAccept(joinFin, aAccepted); });
+
+        mCommImpl.DispatchToHandler([=](CommissionerHandler &aHandler) {
+            aHandler.OnJoinerFinalizeAsync(joinerId, vendorName, vendorModel, vendorSwVersion, vendorStackVersion,
+                                           provisioningUrl, vendorData, onAccept);
+        });
+    }
 
 exit:
     if (error != ErrorCode::kNone)
     {
         LOG_WARN(LOG_REGION_JOINER_SESSION, "session(={}) handle JOIN_FIN.req failed: {}", static_cast<void *>(this),
                  error.ToString());
+        HandleJoinFinAccept(aJoinFin, false);
+    }
+}
+
+void JoinerSession::HandleJoinFinAccept(const coap::Request &aJoinFin, bool aAccepted)
+{
+    mJoinFinPending = false;
+
+    if (!aAccepted)
+    {
+        LOG_WARN(LOG_REGION_JOINER_SESSION, "session(={}) joiner(ID={}) is rejected", static_cast<void *>(this),
+                 utils::Hex(mJoinerId));
     }
 
-    IgnoreError(SendJoinFinResponse(aJoinFin, accepted));
+    IgnoreError(SendJoinFinResponse(aJoinFin, aAccepted));
     LOG_INFO(LOG_REGION_JOINER_SESSION, "session(={}) sent JOIN_FIN.rsp: accepted={}", static_cast<void *>(this),
-             accepted);
+             aAccepted);
 }
 
 Error JoinerSession::SendJoinFinResponse(const coap::Request &aJoinFinReq, bool aAccept)
@@ -247,7 +279,7 @@ int JoinerSession::RelaySocket::Send(const uint8_t *aBuf, size_t aLen)
     Error error;
     bool  includeKek = GetSubType() == MessageSubType::kJoinFinResponse;
 
-    SuccessOrExit(error = mJoinerSession.SendRlyTx({aBuf, aBuf + aLen}, includeKek));
+    SuccessOrExit(error = mJoinerSession.SendRlyTx(aBuf, aLen, includeKek));
 
 exit:
     if (error != ErrorCode::kNone)
@@ -272,9 +304,9 @@ exit:
     return rval;
 }
 
-void JoinerSession::RelaySocket::RecvJoinerDtlsRecords(const ByteArray &aRecords)
+void JoinerSession::RelaySocket::RecvJoinerDtlsRecords(const uint8_t *aRecords, size_t aLength)
 {
-    mRecvBuf.insert(mRecvBuf.end(), aRecords.begin(), aRecords.end());
+    mRecvBuf.insert(mRecvBuf.end(), aRecords, aRecords + aLength);
 
     // Notifies the DTLS session that there is incoming data.
     event_active(&mEvent, EV_READ, 0);
@@ -36,6 +36,7 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 
 #include <commissioner/error.hpp>
 
@@ -93,7 +94,7 @@ public:
 
     bool Disabled() const { return mDtlsSession->GetState() == DtlsSession::State::kOpen; }
 
-    void RecvJoinerDtlsRecords(const ByteArray &aRecords);
+    void RecvJoinerDtlsRecords(const uint8_t *aRecords, size_t aLength);
 
     const TimePoint &GetExpirationTime() const { return mExpirationTime; }
 
@@ -119,7 +120,7 @@ private:
         int Send(const uint8_t *aBuf, size_t aLen) override;
         int Receive(uint8_t *aBuf, size_t aMaxLen) override;
 
-        void RecvJoinerDtlsRecords(const ByteArray &aRecords);
+        void RecvJoinerDtlsRecords(const uint8_t *aRecords, size_t aLength);
 
     private:
         JoinerSession &mJoinerSession;
@@ -136,8 +137,9 @@ private:
 
     void HandleConnect(Error aError);
 
-    Error SendRlyTx(const ByteArray &aDtlsMessage, bool aIncludeKek);
+    Error SendRlyTx(const uint8_t *aDtlsMessage, size_t aLength, bool aIncludeKek);
     void  HandleJoinFin(const coap::Request &aJoinFin);
+    void  HandleJoinFinAccept(const coap::Request &aJoinFin, bool aAccepted);
     Error SendJoinFinResponse(const coap::Request &aJoinFinReq, bool aAccept);
 
     CommissionerImpl &mCommImpl;
@@ -154,6 +156,13 @@ private:
     coap::Resource mResourceJoinFin;
 
     TimePoint mExpirationTime;
+
+    // If waiting for the user to accept the joiner.
+    bool mJoinFinPending = false;
+
+    // Expires when this session is destroyed, a late answer
+    // to JOIN_FIN.req is dropped after that.
+    std::shared_ptr<void> mLifetime = std::make_shared<bool>(true);
 };
 
 } // namespace commissioner
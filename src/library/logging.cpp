@@ -33,15 +33,48 @@
 
 #include "library/logging.hpp"
 
+#include <chrono>
+
+#include <string.h>
+
+#include "common/error_macros.hpp"
+#include "common/utils.hpp"
+
 namespace ot {
 
 namespace commissioner {
 
+std::atomic<LogLevel> gLogLevels[kLogRegionNum];
+std::atomic<bool>     gBinaryLogEnabled{false};
+
 static std::shared_ptr<Logger> sLogger = nullptr;
 
+static std::atomic<const char *> sLogFormats[kMaxLogFormatNum];
+static std::atomic<uint32_t>     sLogFormatNum{0};
+
+namespace {
+
+// A decoded argument of a binary log record.
+struct LogArg
+{
+    LogArgType  mType;
+    uint64_t    mInteger;
+    double      mDouble;
+    std::string mString;
+};
+
+} // namespace
+
 void InitLogger(std::shared_ptr<Logger> aLogger)
 {
+    LogLevel level = aLogger ? aLogger->GetLogLevel() : LogLevel::kOff;
+
     sLogger = aLogger;
+    gBinaryLogEnabled.store(aLogger != nullptr && aLogger->IsBinary(), std::memory_order_relaxed);
+    for (auto &regionLevel : gLogLevels)
+    {
+        regionLevel.store(level, std::memory_order_relaxed);
+    }
 }
 
 std::shared_ptr<Logger> GetLogger(void)
@@ -49,14 +82,290 @@ std::shared_ptr<Logger> GetLogger(void)
     return sLogger;
 }
 
-void Log(LogLevel aLevel, const std::string &aRegion, const std::string &aMessage)
+void SetLogLevel(LogRegion aRegion, LogLevel aLevel)
+{
+    gLogLevels[static_cast<size_t>(aRegion)].store(aLevel, std::memory_order_relaxed);
+}
+
+const char *GetLogRegionName(LogRegion aRegion)
+{
+    static const char *const kRegionNames[] = {
+        "coap", "config", "dtls", "joiner-session", "mbedtls", "meshcop", "mgmt", "socket", "token-manager",
+    };
+    static_assert(sizeof(kRegionNames) / sizeof(kRegionNames[0]) == kLogRegionNum, "missing log region names");
+
+    return static_cast<size_t>(aRegion) < kLogRegionNum ? kRegionNames[static_cast<size_t>(aRegion)] : "unknown";
+}
+
+const char *GetLogLevelName(LogLevel aLevel)
+{
+    static const char *const kLevelNames[] = {"off", "critical", "error", "warn", "info", "debug"};
+
+    return static_cast<size_t>(aLevel) < sizeof(kLevelNames) / sizeof(kLevelNames[0])
+               ? kLevelNames[static_cast<size_t>(aLevel)]
+               : "unknown";
+}
+
+void Log(LogLevel aLevel, LogRegion aRegion, const std::string &aMessage)
 {
     if (GetLogger())
     {
-        GetLogger()->Log(aLevel, aRegion, aMessage);
+        GetLogger()->Log(aLevel, GetLogRegionName(aRegion), aMessage);
     }
 }
 
+uint32_t RegisterLogFormat(const char *aFormat)
+{
+    uint32_t formatId = sLogFormatNum.fetch_add(1, std::memory_order_relaxed);
+
+    if (formatId >= kMaxLogFormatNum)
+    {
+        sLogFormatNum.store(kMaxLogFormatNum, std::memory_order_relaxed);
+        formatId = kInvalidLogFormatId;
+    }
+    else
+    {
+        sLogFormats[formatId].store(aFormat, std::memory_order_release);
+    }
+
+    return formatId;
+}
+
+const char *GetLogFormat(uint32_t aFormatId)
+{
+    return aFormatId < kMaxLogFormatNum ? sLogFormats[aFormatId].load(std::memory_order_acquire) : nullptr;
+}
+
+ByteArray &BeginLogRecord(uint32_t aFormatId, size_t aArgNum)
+{
+    // Reused by all log messages of the thread to avoid allocations.
+    static thread_local ByteArray sRecord;
+
+    uint64_t timestamp = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+
+    sRecord.clear();
+    utils::Encode<uint32_t>(sRecord, aFormatId);
+    utils::Encode<uint64_t>(sRecord, timestamp);
+    utils::Encode<uint8_t>(sRecord, static_cast<uint8_t>(aArgNum));
+
+    return sRecord;
+}
+
+void LogRecord(LogLevel aLevel, LogRegion aRegion, const ByteArray &aRecord)
+{
+    if (GetLogger())
+    {
+        GetLogger()->LogRecord(aLevel, GetLogRegionName(aRegion), aRecord);
+    }
+}
+
+void EncodeLogArg(ByteArray &aRecord, bool aArg)
+{
+    EncodeLogArg(aRecord, LogArgType::kBool, aArg);
+}
+
+void EncodeLogArg(ByteArray &aRecord, char aArg)
+{
+    EncodeLogArg(aRecord, LogArgType::kChar, static_cast<uint8_t>(aArg));
+}
+
+void EncodeLogArg(ByteArray &aRecord, double aArg)
+{
+    uint64_t bits;
+
+    static_assert(sizeof(bits) == sizeof(aArg), "double is not 64 bits");
+    memcpy(&bits, &aArg, sizeof(bits));
+    EncodeLogArg(aRecord, LogArgType::kDouble, bits);
+}
+
+void EncodeLogArg(ByteArray &aRecord, const char *aArg)
+{
+    size_t length = strlen(aArg);
+
+    utils::Encode<uint8_t>(aRecord, static_cast<uint8_t>(LogArgType::kString));
+    utils::Encode<uint32_t>(aRecord, static_cast<uint32_t>(length));
+    aRecord.insert(aRecord.end(), aArg, aArg + length);
+}
+
+void EncodeLogArg(ByteArray &aRecord, const std::string &aArg)
+{
+    utils::Encode<uint8_t>(aRecord, static_cast<uint8_t>(LogArgType::kString));
+    utils::Encode<uint32_t>(aRecord, static_cast<uint32_t>(aArg.size()));
+    aRecord.insert(aRecord.end(), aArg.begin(), aArg.end());
+}
+
+void EncodeLogArg(ByteArray &aRecord, const void *aArg)
+{
+    EncodeLogArg(aRecord, LogArgType::kPointer, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(aArg)));
+}
+
+void EncodeLogArg(ByteArray &aRecord, LogArgType aType, uint64_t aValue)
+{
+    utils::Encode<uint8_t>(aRecord, static_cast<uint8_t>(aType));
+    utils::Encode<uint64_t>(aRecord, aValue);
+}
+
+Error ParseLogRecordHeader(uint32_t &aFormatId, uint64_t &aTimestamp, const uint8_t *aRecord, size_t aLength)
+{
+    Error error;
+
+    VerifyOrExit(aLength >= kLogRecordHeaderLength,
+                 error = ERROR_BAD_FORMAT("binary log record is too short: {} bytes", aLength));
+    aFormatId  = utils::Decode<uint32_t>(aRecord, aLength);
+    aTimestamp = utils::Decode<uint64_t>(aRecord + sizeof(uint32_t), aLength - sizeof(uint32_t));
+
+exit:
+    return error;
+}
+
+static Error ParseLogArgs(std::vector<LogArg> &aArgs, const uint8_t *aRecord, size_t aLength)
+{
+    Error  error;
+    size_t offset = kLogRecordHeaderLength;
+    size_t argNum;
+
+    VerifyOrExit(aLength >= kLogRecordHeaderLength,
+                 error = ERROR_BAD_FORMAT("binary log record is too short: {} bytes", aLength));
+    argNum = aRecord[kLogRecordHeaderLength - 1];
+
+    for (size_t i = 0; i < argNum; ++i)
+    {
+        LogArg arg;
+
+        VerifyOrExit(offset < aLength, error = ERROR_BAD_FORMAT("binary log record has too few arguments"));
+        arg.mType = static_cast<LogArgType>(aRecord[offset++]);
+
+        if (arg.mType == LogArgType::kString)
+        {
+            size_t length;
+
+            VerifyOrExit(aLength - offset >= sizeof(uint32_t), error = ERROR_BAD_FORMAT("truncated string argument"));
+            length = utils::Decode<uint32_t>(aRecord + offset, aLength - offset);
+            offset += sizeof(uint32_t);
+
+            VerifyOrExit(aLength - offset >= length, error = ERROR_BAD_FORMAT("truncated string argument"));
+            arg.mString.assign(reinterpret_cast<const char *>(aRecord + offset), length);
+            offset += length;
+        }
+        else
+        {
+            VerifyOrExit(arg.mType >= LogArgType::kInt && arg.mType <= LogArgType::kPointer,
+                         error = ERROR_BAD_FORMAT("unknown argument type: {}", static_cast<int>(arg.mType)));
+            VerifyOrExit(aLength - offset >= sizeof(uint64_t), error = ERROR_BAD_FORMAT("truncated argument"));
+            arg.mInteger = utils::Decode<uint64_t>(aRecord + offset, aLength - offset);
+            offset += sizeof(uint64_t);
+
+            memcpy(&arg.mDouble, &arg.mInteger, sizeof(arg.mDouble));
+        }
+
+        aArgs.push_back(std::move(arg));
+    }
+
+exit:
+    return error;
+}
+
+static std::string FormatLogArg(const std::string &aField, const LogArg &aArg)
+{
+    std::string ret;
+
+    try
+    {
+        switch (aArg.mType)
+        {
+        case LogArgType::kInt:
+        {
+            int64_t value = static_cast<int64_t>(aArg.mInteger);
+            ret           = fmt::vformat(aField, fmt::make_format_args(value));
+            break;
+        }
+        case LogArgType::kUint:
+            ret = fmt::vformat(aField, fmt::make_format_args(aArg.mInteger));
+            break;
+        case LogArgType::kDouble:
+            ret = fmt::vformat(aField, fmt::make_format_args(aArg.mDouble));
+            break;
+        case LogArgType::kBool:
+        {
+            bool value = aArg.mInteger != 0;
+            ret        = fmt::vformat(aField, fmt::make_format_args(value));
+            break;
+        }
+        case LogArgType::kChar:
+        {
+            char value = static_cast<char>(aArg.mInteger);
+            ret        = fmt::vformat(aField, fmt::make_format_args(value));
+            break;
+        }
+        case LogArgType::kString:
+            ret = fmt::vformat(aField, fmt::make_format_args(aArg.mString));
+            break;
+        case LogArgType::kPointer:
+        {
+            const void *value = reinterpret_cast<const void *>(static_cast<uintptr_t>(aArg.mInteger));
+            ret               = fmt::vformat(aField, fmt::make_format_args(value));
+            break;
+        }
+        }
+    } catch (const fmt::format_error &)
+    {
+        ret = "{?}";
+    }
+
+    return ret;
+}
+
+Error FormatLogRecord(std::string &aMessage, const std::string &aFormat, const uint8_t *aRecord, size_t aLength)
+{
+    Error               error;
+    std::vector<LogArg> args;
+    size_t              nextArg = 0;
+
+    SuccessOrExit(error = ParseLogArgs(args, aRecord, aLength));
+
+    aMessage.clear();
+    for (size_t i = 0; i < aFormat.size(); ++i)
+    {
+        size_t      end;
+        size_t      colon;
+        size_t      argIndex;
+        std::string index;
+
+        if (aFormat[i] == '}' || (aFormat[i] == '{' && i + 1 < aFormat.size() && aFormat[i + 1] == '{'))
+        {
+            // Escaped braces.
+            aMessage.push_back(aFormat[i]);
+            i += (i + 1 < aFormat.size() && aFormat[i + 1] == aFormat[i]) ? 1 : 0;
+            continue;
+        }
+
+        if (aFormat[i] != '{' || (end = aFormat.find('}', i)) == std::string::npos)
+        {
+            aMessage.push_back(aFormat[i]);
+            continue;
+        }
+
+        colon    = std::min(aFormat.find(':', i), end);
+        index    = aFormat.substr(i + 1, colon - i - 1);
+        argIndex = index.empty() ? nextArg++ : static_cast<size_t>(atoi(index.c_str()));
+
+        if (argIndex < args.size())
+        {
+            aMessage += FormatLogArg("{" + aFormat.substr(colon, end - colon) + "}", args[argIndex]);
+        }
+        else
+        {
+            aMessage += "{?}";
+        }
+        i = end;
+    }
+
+exit:
+    return error;
+}
+
 } // namespace commissioner
 
 } // namespace ot
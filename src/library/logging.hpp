@@ -34,24 +34,55 @@
 #ifndef OT_COMM_LIBRARY_LOGGING_HPP_
 #define OT_COMM_LIBRARY_LOGGING_HPP_
 
+#include <atomic>
+
 #include <fmt/format.h>
 
 #include <commissioner/commissioner.hpp>
 
-#define LOG_REGION_COAP "coap"
-#define LOG_REGION_CONFIG "config"
-#define LOG_REGION_DTLS "dtls"
-#define LOG_REGION_JOINER_SESSION "joiner-session"
-#define LOG_REGION_MBEDTLS "mbedtls"
-#define LOG_REGION_MESHCOP "meshcop"
-#define LOG_REGION_MGMT "mgmt"
-#define LOG_REGION_SOCKET "socket"
-#define LOG_REGION_TOKEN_MANAGER "token-manager"
-
-#define LOG(aLevel, aRegion, aFmt, ...)                                     \
-    do                                                                      \
-    {                                                                       \
-        Log(aLevel, aRegion, fmt::format(FMT_STRING(aFmt), ##__VA_ARGS__)); \
+/**
+ * The most verbose log level compiled into the library.
+ *
+ * Log messages more verbose than this level are removed at compile time.
+ * It is the numeric value of a LogLevel and defaults to LogLevel::kDebug.
+ */
+#ifndef OT_COMM_CONFIG_LOG_LEVEL
+#define OT_COMM_CONFIG_LOG_LEVEL 5
+#endif
+
+#define LOG_REGION_COAP ::ot::commissioner::LogRegion::kCoap
+#define LOG_REGION_CONFIG ::ot::commissioner::LogRegion::kConfig
+#define LOG_REGION_DTLS ::ot::commissioner::LogRegion::kDtls
+#define LOG_REGION_JOINER_SESSION ::ot::commissioner::LogRegion::kJoinerSession
+#define LOG_REGION_MBEDTLS ::ot::commissioner::LogRegion::kMbedtls
+#define LOG_REGION_MESHCOP ::ot::commissioner::LogRegion::kMeshcop
+#define LOG_REGION_MGMT ::ot::commissioner::LogRegion::kMgmt
+#define LOG_REGION_SOCKET ::ot::commissioner::LogRegion::kSocket
+#define LOG_REGION_TOKEN_MANAGER ::ot::commissioner::LogRegion::kTokenManager
+
+/**
+ * The level checks come before the arguments are evaluated, so a
+ * disabled log message costs no more than an atomic load.
+ *
+ * If the logger accepts binary records, the arguments are copied into a
+ * record with the ID of the format string and formatted offline.
+ */
+#define LOG(aLevel, aRegion, aFmt, ...)                                                            \
+    do                                                                                             \
+    {                                                                                              \
+        if (static_cast<int>(aLevel) <= OT_COMM_CONFIG_LOG_LEVEL && IsLogEnabled(aLevel, aRegion)) \
+        {                                                                                          \
+            static const uint32_t kLogFormatId = RegisterLogFormat(aFmt);                          \
+                                                                                                   \
+            if (IsBinaryLogEnabled() && kLogFormatId != kInvalidLogFormatId)                       \
+            {                                                                                      \
+                LogBinary(aLevel, aRegion, kLogFormatId, ##__VA_ARGS__);                           \
+            }                                                                                      \
+            else                                                                                   \
+            {                                                                                      \
+                Log(aLevel, aRegion, fmt::format(FMT_STRING(aFmt), ##__VA_ARGS__));                \
+            }                                                                                      \
+        }                                                                                          \
     } while (false)
 
 #define LOG_DEBUG(aRegion, aFmt, ...) LOG(LogLevel::kDebug, aRegion, aFmt, ##__VA_ARGS__)
@@ -64,12 +95,205 @@ namespace ot {
 
 namespace commissioner {
 
+enum class LogRegion : uint8_t
+{
+    kCoap = 0,
+    kConfig,
+    kDtls,
+    kJoinerSession,
+    kMbedtls,
+    kMeshcop,
+    kMgmt,
+    kSocket,
+    kTokenManager,
+};
+
+static constexpr size_t kLogRegionNum = static_cast<size_t>(LogRegion::kTokenManager) + 1;
+
+// The most verbose level logged by each region, indexed by LogRegion.
+extern std::atomic<LogLevel> gLogLevels[kLogRegionNum];
+
+// If the logger accepts binary log records.
+extern std::atomic<bool> gBinaryLogEnabled;
+
 // TODO(wgtdkp): add json format. This is useful for certification.
 
+/**
+ * This function sets the logger and resets the log level of
+ * all regions to the level of the logger.
+ *
+ * @param[in] aLogger  The logger. Logging is turned off if it is null.
+ *
+ */
 void                    InitLogger(std::shared_ptr<Logger> aLogger);
 std::shared_ptr<Logger> GetLogger(void);
 
-void Log(LogLevel aLevel, const std::string &aRegion, const std::string &aMessage);
+/**
+ * This function sets the most verbose level logged by a region.
+ *
+ * @param[in] aRegion  The log region.
+ * @param[in] aLevel   The log level.
+ *
+ */
+void SetLogLevel(LogRegion aRegion, LogLevel aLevel);
+
+const char *GetLogRegionName(LogRegion aRegion);
+const char *GetLogLevelName(LogLevel aLevel);
+
+inline bool IsLogEnabled(LogLevel aLevel, LogRegion aRegion)
+{
+    return aLevel <= gLogLevels[static_cast<size_t>(aRegion)].load(std::memory_order_relaxed);
+}
+
+inline bool IsBinaryLogEnabled()
+{
+    return gBinaryLogEnabled.load(std::memory_order_relaxed);
+}
+
+void Log(LogLevel aLevel, LogRegion aRegion, const std::string &aMessage);
+
+/*
+ * Binary log records.
+ *
+ * A binary log record is the ID of the format string followed by a
+ * monotonic timestamp and the raw arguments of the log message:
+ *
+ *   | format ID (4) | timestamp in nanoseconds (8) | argument number (1) | arguments ... |
+ *
+ * Each argument is a LogArgType followed by its value. Integers are in
+ * big endian and strings are prefixed by a 4-byte length. Arguments of
+ * other types are formatted to strings with "{}" at the call site.
+ */
+
+static constexpr uint32_t kInvalidLogFormatId    = 0xFFFFFFFF;
+static constexpr size_t   kMaxLogFormatNum       = 1024;
+static constexpr size_t   kLogRecordHeaderLength = sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint8_t);
+
+enum class LogArgType : uint8_t
+{
+    kInt = 1,
+    kUint,
+    kDouble,
+    kBool,
+    kChar,
+    kString,
+    kPointer,
+};
+
+/**
+ * This function registers a format string of log messages.
+ *
+ * It is lock-free and safe to be called by any thread.
+ *
+ * @param[in] aFormat  The format string, which must have static storage duration.
+ *
+ * @return The format ID, or kInvalidLogFormatId if there are already kMaxLogFormatNum formats.
+ *
+ */
+uint32_t RegisterLogFormat(const char *aFormat);
+
+/**
+ * This function returns the format string of given ID, or null if it is not registered.
+ *
+ * It is lock-free and async-signal-safe.
+ *
+ */
+const char *GetLogFormat(uint32_t aFormatId);
+
+/**
+ * This function parses the header of a binary log record.
+ *
+ * @retval ErrorCode::kNone       Successfully parsed the header.
+ * @retval ErrorCode::kBadFormat  The record is too short.
+ *
+ */
+Error ParseLogRecordHeader(uint32_t &aFormatId, uint64_t &aTimestamp, const uint8_t *aRecord, size_t aLength);
+
+/**
+ * This function formats the arguments of a binary log record with its format string.
+ *
+ * Replacement fields which cannot be formatted are replaced by "{?}".
+ *
+ * @retval ErrorCode::kNone       Successfully formatted the record.
+ * @retval ErrorCode::kBadFormat  The record is malformed.
+ *
+ */
+Error FormatLogRecord(std::string &aMessage, const std::string &aFormat, const uint8_t *aRecord, size_t aLength);
+
+// Starts a record in the buffer of the calling thread.
+ByteArray &BeginLogRecord(uint32_t aFormatId, size_t aArgNum);
+
+void LogRecord(LogLevel aLevel, LogRegion aRegion, const ByteArray &aRecord);
+
+void EncodeLogArg(ByteArray &aRecord, bool aArg);
+void EncodeLogArg(ByteArray &aRecord, char aArg);
+void EncodeLogArg(ByteArray &aRecord, double aArg);
+void EncodeLogArg(ByteArray &aRecord, const char *aArg);
+void EncodeLogArg(ByteArray &aRecord, const std::string &aArg);
+void EncodeLogArg(ByteArray &aRecord, const void *aArg);
+void EncodeLogArg(ByteArray &aRecord, LogArgType aType, uint64_t aValue);
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type EncodeLogArg(ByteArray &aRecord,
+                                                                                                      T          aArg)
+{
+    EncodeLogArg(aRecord, LogArgType::kInt, static_cast<uint64_t>(static_cast<int64_t>(aArg)));
+}
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type EncodeLogArg(
+    ByteArray &aRecord,
+    T          aArg)
+{
+    EncodeLogArg(aRecord, LogArgType::kUint, static_cast<uint64_t>(aArg));
+}
+
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value>::type EncodeLogArg(ByteArray &aRecord, T aArg)
+{
+    EncodeLogArg(aRecord, static_cast<double>(aArg));
+}
+
+template <typename T> struct IsCharPointer
+{
+    static constexpr bool value =
+        std::is_same<typename std::remove_cv<typename std::remove_pointer<T>::type>::type, char>::value;
+};
+
+// Pointers to characters are strings rather than addresses.
+template <typename T>
+typename std::enable_if<std::is_pointer<T>::value && !IsCharPointer<T>::value>::type EncodeLogArg(ByteArray &aRecord,
+                                                                                                   T          aArg)
+{
+    EncodeLogArg(aRecord, static_cast<const void *>(aArg));
+}
+
+template <typename T>
+typename std::enable_if<!std::is_arithmetic<T>::value && !std::is_pointer<T>::value &&
+                        !std::is_array<T>::value>::type
+EncodeLogArg(ByteArray &aRecord, const T &aArg)
+{
+    EncodeLogArg(aRecord, fmt::format("{}", aArg));
+}
+
+inline void EncodeLogArgs(ByteArray &)
+{
+}
+
+template <typename T, typename... Args> void EncodeLogArgs(ByteArray &aRecord, const T &aArg, const Args &... aArgs)
+{
+    EncodeLogArg(aRecord, aArg);
+    EncodeLogArgs(aRecord, aArgs...);
+}
+
+template <typename... Args>
+void LogBinary(LogLevel aLevel, LogRegion aRegion, uint32_t aFormatId, const Args &... aArgs)
+{
+    ByteArray &record = BeginLogRecord(aFormatId, sizeof...(aArgs));
+
+    EncodeLogArgs(record, aArgs...);
+    LogRecord(aLevel, aRegion, record);
+}
 
 } // namespace commissioner
 
@@ -0,0 +1,176 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases of the logging module.
+ */
+
+#include "library/logging.hpp"
+
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace ot {
+
+namespace commissioner {
+
+class MockLogger : public Logger
+{
+public:
+    explicit MockLogger(LogLevel aLogLevel, bool aIsBinary = false)
+        : mLogLevel(aLogLevel)
+        , mIsBinary(aIsBinary)
+    {
+    }
+
+    void Log(LogLevel, const std::string &aRegion, const std::string &aMsg) override
+    {
+        mMessages.emplace_back(aRegion + ": " + aMsg);
+    }
+
+    LogLevel GetLogLevel() const override { return mLogLevel; }
+
+    bool IsBinary() const override { return mIsBinary; }
+
+    void LogRecord(LogLevel, const std::string &aRegion, const ByteArray &aRecord) override
+    {
+        mRegions.push_back(aRegion);
+        mRecords.push_back(aRecord);
+    }
+
+    LogLevel                 mLogLevel;
+    bool                     mIsBinary;
+    std::vector<std::string> mMessages;
+    std::vector<std::string> mRegions;
+    std::vector<ByteArray>   mRecords;
+};
+
+static std::string FormatRecord(const ByteArray &aRecord)
+{
+    uint32_t    formatId;
+    uint64_t    timestamp;
+    std::string message;
+
+    REQUIRE(ParseLogRecordHeader(formatId, timestamp, aRecord.data(), aRecord.size()) == ErrorCode::kNone);
+    REQUIRE(GetLogFormat(formatId) != nullptr);
+    REQUIRE(FormatLogRecord(message, GetLogFormat(formatId), aRecord.data(), aRecord.size()) == ErrorCode::kNone);
+
+    return message;
+}
+
+static int Count(int &aCounter)
+{
+    return ++aCounter;
+}
+
+TEST_CASE("logging-level-threshold", "[logging]")
+{
+    auto logger  = std::make_shared<MockLogger>(LogLevel::kInfo);
+    int  counter = 0;
+
+    InitLogger(logger);
+
+    LOG_INFO(LOG_REGION_COAP, "info {}", Count(counter));
+    REQUIRE(counter == 1);
+    REQUIRE(logger->mMessages == std::vector<std::string>{"coap: info 1"});
+
+    // Arguments of a disabled log message are never evaluated.
+    LOG_DEBUG(LOG_REGION_COAP, "debug {}", Count(counter));
+    REQUIRE(counter == 1);
+    REQUIRE(logger->mMessages.size() == 1);
+
+    SetLogLevel(LogRegion::kDtls, LogLevel::kDebug);
+    LOG_DEBUG(LOG_REGION_DTLS, "debug {}", Count(counter));
+    LOG_DEBUG(LOG_REGION_COAP, "debug {}", Count(counter));
+    REQUIRE(counter == 2);
+    REQUIRE(logger->mMessages.back() == "dtls: debug 2");
+
+    SetLogLevel(LogRegion::kDtls, LogLevel::kOff);
+    LOG_CRIT(LOG_REGION_DTLS, "critical {}", Count(counter));
+    REQUIRE(counter == 2);
+
+    // Logging is turned off without a logger.
+    InitLogger(nullptr);
+    LOG_CRIT(LOG_REGION_COAP, "critical {}", Count(counter));
+    REQUIRE(counter == 2);
+    REQUIRE(logger->mMessages.size() == 2);
+}
+
+TEST_CASE("logging-binary-records", "[logging]")
+{
+    auto              logger  = std::make_shared<MockLogger>(LogLevel::kDebug, /* aIsBinary */ true);
+    int               counter = 0;
+    const std::string name    = "joiner";
+    const char *      literal = "literal";
+    int               local   = 0;
+    const void *      pointer = &local;
+
+    InitLogger(logger);
+
+    LOG_DEBUG(LOG_REGION_DTLS, "{} received {} bytes, id={:X}, ok={}, ratio={}, sign={}, last={}", name, 1024,
+              0xBEEFu, true, 0.5, -7, 'x');
+    LOG_INFO(LOG_REGION_MESHCOP, "{} at {}, {{escaped}}", literal, pointer);
+    LOG_WARN(LOG_REGION_COAP, "no arguments {}", Count(counter));
+
+    REQUIRE(logger->mMessages.empty());
+    REQUIRE(logger->mRegions == std::vector<std::string>{"dtls", "meshcop", "coap"});
+    REQUIRE(FormatRecord(logger->mRecords[0]) ==
+            "joiner received 1024 bytes, id=BEEF, ok=true, ratio=0.5, sign=-7, last=x");
+    REQUIRE(FormatRecord(logger->mRecords[1]) == fmt::format("literal at {}, {{escaped}}", pointer));
+    REQUIRE(FormatRecord(logger->mRecords[2]) == "no arguments 1");
+
+    SECTION("malformed records")
+    {
+        ByteArray   record = logger->mRecords[0];
+        std::string message;
+
+        record.pop_back();
+        REQUIRE(FormatLogRecord(message, "{}", record.data(), record.size()) == ErrorCode::kBadFormat);
+        REQUIRE(FormatLogRecord(message, "{}", record.data(), 4) == ErrorCode::kBadFormat);
+
+        // Mismatched replacement fields are not fatal.
+        REQUIRE(FormatLogRecord(message, "{:d} {} {}", logger->mRecords[2].data(), logger->mRecords[2].size()) ==
+                ErrorCode::kNone);
+        REQUIRE(message == "1 {?} {?}");
+    }
+
+    InitLogger(nullptr);
+}
+
+TEST_CASE("logging-region-names", "[logging]")
+{
+    REQUIRE(std::string{GetLogRegionName(LogRegion::kCoap)} == "coap");
+    REQUIRE(std::string{GetLogRegionName(LogRegion::kJoinerSession)} == "joiner-session");
+    REQUIRE(std::string{GetLogRegionName(LogRegion::kTokenManager)} == "token-manager");
+}
+
+} // namespace commissioner
+
+} // namespace ot
@@ -0,0 +1,149 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions of a LRU cache.
+ */
+
+#ifndef OT_COMM_LIBRARY_LRU_CACHE_HPP_
+#define OT_COMM_LIBRARY_LRU_CACHE_HPP_
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <utility>
+
+namespace ot {
+
+namespace commissioner {
+
+/**
+ * A cache of bounded size which evicts the least recently used entry.
+ *
+ * Entries are kept in a list ordered by use, and indexed by an ordered
+ * map of the keys. This class is not thread-safe.
+ *
+ * @tparam Key    The key type which must be less-than comparable.
+ * @tparam Value  The value type.
+ *
+ */
+template <typename Key, typename Value> class LruCache
+{
+public:
+    /**
+     * @param[in] aCapacity  The max number of entries. 0 disables the cache.
+     */
+    explicit LruCache(size_t aCapacity)
+        : mCapacity(aCapacity)
+    {
+    }
+
+    /**
+     * Returns the value of @p aKey and marks it the most recently used,
+     * or nullptr if there is no such entry. The pointer is valid until
+     * the entry is removed or evicted.
+     */
+    Value *Find(const Key &aKey)
+    {
+        auto entry = mIndex.find(aKey);
+
+        if (entry == mIndex.end())
+        {
+            return nullptr;
+        }
+
+        mEntries.splice(mEntries.begin(), mEntries, entry->second);
+        return &entry->second->second;
+    }
+
+    /**
+     * Sets the value of @p aKey and marks it the most recently used.
+     * The least recently used entries are evicted beyond the capacity.
+     */
+    void Put(const Key &aKey, Value aValue)
+    {
+        if (mCapacity == 0)
+        {
+            return;
+        }
+
+        auto entry = mIndex.find(aKey);
+        if (entry != mIndex.end())
+        {
+            entry->second->second = std::move(aValue);
+            mEntries.splice(mEntries.begin(), mEntries, entry->second);
+            return;
+        }
+
+        mEntries.emplace_front(aKey, std::move(aValue));
+        mIndex[aKey] = mEntries.begin();
+
+        while (mEntries.size() > mCapacity)
+        {
+            mIndex.erase(mEntries.back().first);
+            mEntries.pop_back();
+        }
+    }
+
+    void Remove(const Key &aKey)
+    {
+        auto entry = mIndex.find(aKey);
+
+        if (entry != mIndex.end())
+        {
+            mEntries.erase(entry->second);
+            mIndex.erase(entry);
+        }
+    }
+
+    void Clear()
+    {
+        mIndex.clear();
+        mEntries.clear();
+    }
+
+    size_t GetCapacity() const { return mCapacity; }
+
+    size_t GetSize() const { return mEntries.size(); }
+
+private:
+    using Entry = std::pair<Key, Value>;
+
+    const size_t mCapacity;
+
+    // The most recently used entry is at the front.
+    std::list<Entry>                                   mEntries;
+    std::map<Key, typename std::list<Entry>::iterator> mIndex;
+};
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_LIBRARY_LRU_CACHE_HPP_
@@ -0,0 +1,99 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases of the LRU cache.
+ */
+
+#include "library/lru_cache.hpp"
+
+#include <string>
+
+#include <catch2/catch.hpp>
+
+namespace ot {
+
+namespace commissioner {
+
+TEST_CASE("lru-cache-find-and-put", "[lru-cache]")
+{
+    LruCache<int, std::string> cache{2};
+
+    REQUIRE(cache.GetCapacity() == 2);
+    REQUIRE(cache.Find(1) == nullptr);
+
+    cache.Put(1, "one");
+    cache.Put(2, "two");
+    REQUIRE(cache.GetSize() == 2);
+    REQUIRE(*cache.Find(1) == "one");
+
+    SECTION("the least recently used entry is evicted")
+    {
+        // Entry 2 is the least recently used, as entry 1 has been found.
+        cache.Put(3, "three");
+        REQUIRE(cache.GetSize() == 2);
+        REQUIRE(cache.Find(2) == nullptr);
+        REQUIRE(*cache.Find(1) == "one");
+        REQUIRE(*cache.Find(3) == "three");
+    }
+
+    SECTION("putting an existing key replaces the value")
+    {
+        cache.Put(2, "deux");
+        cache.Put(3, "three");
+        REQUIRE(cache.GetSize() == 2);
+        REQUIRE(cache.Find(1) == nullptr);
+        REQUIRE(*cache.Find(2) == "deux");
+    }
+
+    SECTION("remove and clear")
+    {
+        cache.Remove(1);
+        cache.Remove(4);
+        REQUIRE(cache.GetSize() == 1);
+        REQUIRE(cache.Find(1) == nullptr);
+
+        cache.Clear();
+        REQUIRE(cache.GetSize() == 0);
+        REQUIRE(cache.Find(2) == nullptr);
+    }
+}
+
+TEST_CASE("lru-cache-zero-capacity", "[lru-cache]")
+{
+    LruCache<int, int> cache{0};
+
+    cache.Put(1, 1);
+    REQUIRE(cache.GetSize() == 0);
+    REQUIRE(cache.Find(1) == nullptr);
+}
+
+} // namespace commissioner
+
+} // namespace ot
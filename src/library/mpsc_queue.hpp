@@ -0,0 +1,223 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions of a multi-producer single-consumer queue.
+ */
+
+#ifndef OT_COMM_LIBRARY_MPSC_QUEUE_HPP_
+#define OT_COMM_LIBRARY_MPSC_QUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <queue>
+
+namespace ot {
+
+namespace commissioner {
+
+/**
+ * A multi-producer single-consumer FIFO queue.
+ *
+ * Elements are stored in a ring of preallocated cells which is lock-free
+ * for both producers and the consumer: a producer claims a cell with a
+ * single CAS and publishes the element by bumping the cell's sequence
+ * number. Producers which find the ring full fall back to a mutex-guarded
+ * overflow queue, so Push() never fails nor blocks on the consumer. The
+ * order of elements pushed by the same producer is always preserved.
+ *
+ * @tparam T  The element type which must be default constructible and
+ *            move assignable.
+ *
+ */
+template <typename T> class MpscQueue
+{
+public:
+    /**
+     * @param[in] aCapacity  The number of preallocated cells, which is
+     *                       rounded up to a power of two.
+     */
+    explicit MpscQueue(size_t aCapacity)
+        : mMask(RoundUpToPowerOfTwo(aCapacity) - 1)
+        , mCells(new Cell[mMask + 1])
+    {
+        for (size_t i = 0; i <= mMask; ++i)
+        {
+            mCells[i].mSequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    /**
+     * This method pushes an element, it is safe to be called by any thread.
+     */
+    void Push(T &&aElement)
+    {
+        // Keep going to the overflow queue until it is drained,
+        // otherwise a new element may overtake older ones.
+        if (mOverflowSize.load(std::memory_order_acquire) != 0 || !TryPushCell(aElement))
+        {
+            std::lock_guard<std::mutex> lock(mOverflowMutex);
+
+            mOverflow.emplace(std::move(aElement));
+            mOverflowSize.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    /**
+     * This method pops the oldest element, it must be called by only the consumer thread.
+     *
+     * @retval true   An element is popped to @p aElement.
+     * @retval false  There is no element (which has been completely pushed).
+     */
+    bool Pop(T &aElement)
+    {
+        bool popped = TryPopCell(aElement);
+
+        // An element in the overflow queue may be newer than elements in
+        // the ring, it is popped only if no cell is claimed by producers.
+        if (!popped && mEnqueuePos.mValue.load(std::memory_order_acquire) == mDequeuePos &&
+            mOverflowSize.load(std::memory_order_acquire) != 0)
+        {
+            std::lock_guard<std::mutex> lock(mOverflowMutex);
+
+            aElement = std::move(mOverflow.front());
+            mOverflow.pop();
+            mOverflowSize.fetch_sub(1, std::memory_order_release);
+            popped = true;
+        }
+
+        return popped;
+    }
+
+    size_t GetCapacity() const { return mMask + 1; }
+
+private:
+    // Pads the hot atomics to separate cache lines, so that
+    // producers do not bounce the line read by the consumer.
+    static constexpr size_t kCacheLineSize = 64;
+
+    struct Cell
+    {
+        std::atomic<size_t> mSequence;
+        T                   mElement;
+    };
+
+    struct PaddedPosition
+    {
+        std::atomic<size_t> mValue{0};
+        char                mPadding[kCacheLineSize - sizeof(std::atomic<size_t>)];
+    };
+
+    static size_t RoundUpToPowerOfTwo(size_t aValue)
+    {
+        size_t ret = 1;
+
+        while (ret < aValue)
+        {
+            ret <<= 1;
+        }
+        return ret;
+    }
+
+    bool TryPushCell(T &aElement)
+    {
+        size_t pos = mEnqueuePos.mValue.load(std::memory_order_relaxed);
+        Cell * cell;
+
+        while (true)
+        {
+            ptrdiff_t diff;
+
+            cell = &mCells[pos & mMask];
+            diff = static_cast<ptrdiff_t>(cell->mSequence.load(std::memory_order_acquire) - pos);
+
+            if (diff == 0)
+            {
+                if (mEnqueuePos.mValue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                // The cell has not been popped since last round, the ring is full.
+                return false;
+            }
+            else
+            {
+                pos = mEnqueuePos.mValue.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->mElement = std::move(aElement);
+        cell->mSequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPopCell(T &aElement)
+    {
+        Cell *cell = &mCells[mDequeuePos & mMask];
+
+        if (cell->mSequence.load(std::memory_order_acquire) != mDequeuePos + 1)
+        {
+            return false;
+        }
+
+        aElement = std::move(cell->mElement);
+
+        // Release the moved-from element, it may hold resources.
+        cell->mElement = T();
+        cell->mSequence.store(mDequeuePos + mMask + 1, std::memory_order_release);
+        ++mDequeuePos;
+        return true;
+    }
+
+    const size_t            mMask;
+    std::unique_ptr<Cell[]> mCells;
+
+    PaddedPosition mEnqueuePos;
+
+    // Accessed by only the consumer.
+    size_t mDequeuePos = 0;
+
+    std::atomic<size_t> mOverflowSize{0};
+    std::mutex          mOverflowMutex;
+    std::queue<T>       mOverflow;
+};
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_LIBRARY_MPSC_QUEUE_HPP_
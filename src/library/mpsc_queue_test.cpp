@@ -0,0 +1,139 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases of the multi-producer single-consumer queue.
+ */
+
+#include "library/mpsc_queue.hpp"
+
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace ot {
+
+namespace commissioner {
+
+TEST_CASE("mpsc-queue-single-producer", "[mpsc-queue]")
+{
+    MpscQueue<int> queue{6};
+    int            element;
+
+    REQUIRE(queue.GetCapacity() == 8);
+    REQUIRE_FALSE(queue.Pop(element));
+
+    SECTION("elements are popped in order")
+    {
+        for (int i = 0; i < 5; ++i)
+        {
+            queue.Push(int{i});
+        }
+        for (int i = 0; i < 5; ++i)
+        {
+            REQUIRE(queue.Pop(element));
+            REQUIRE(element == i);
+        }
+        REQUIRE_FALSE(queue.Pop(element));
+    }
+
+    SECTION("elements overflowing the ring are popped in order")
+    {
+        for (int round = 0; round < 3; ++round)
+        {
+            for (int i = 0; i < 20; ++i)
+            {
+                queue.Push(int{i});
+            }
+            for (int i = 0; i < 20; ++i)
+            {
+                REQUIRE(queue.Pop(element));
+                REQUIRE(element == i);
+
+                // Elements pushed while the overflow queue is not
+                // drained must not overtake the overflowed ones.
+                if (i == 10)
+                {
+                    queue.Push(int{20});
+                }
+            }
+            REQUIRE(queue.Pop(element));
+            REQUIRE(element == 20);
+            REQUIRE_FALSE(queue.Pop(element));
+        }
+    }
+}
+
+TEST_CASE("mpsc-queue-multiple-producers", "[mpsc-queue]")
+{
+    constexpr int kProducerCount     = 8;
+    constexpr int kElementsPerThread = 20000;
+
+    MpscQueue<std::pair<int, int>> queue{64};
+    std::vector<std::thread>       producers;
+    std::vector<int>               nextElements(kProducerCount, 0);
+    std::pair<int, int>            element;
+    int                            count = 0;
+
+    for (int producer = 0; producer < kProducerCount; ++producer)
+    {
+        producers.emplace_back([&queue, producer]() {
+            for (int i = 0; i < kElementsPerThread; ++i)
+            {
+                queue.Push({producer, i});
+            }
+        });
+    }
+
+    while (count < kProducerCount * kElementsPerThread)
+    {
+        if (!queue.Pop(element))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Elements of the same producer are in order.
+        REQUIRE(element.second == nextElements[element.first]);
+        ++nextElements[element.first];
+        ++count;
+    }
+
+    for (auto &producer : producers)
+    {
+        producer.join();
+    }
+
+    REQUIRE_FALSE(queue.Pop(element));
+}
+
+} // namespace commissioner
+
+} // namespace ot
@@ -34,15 +34,125 @@
 
 #include "library/openthread/pbkdf2_cmac.hpp"
 
-#include <assert.h>
 #include <memory.h>
 
-#include <mbedtls/cmac.h>
+#include <mbedtls/aes.h>
 
 namespace ot {
 
 namespace commissioner {
 
+namespace {
+
+const size_t kBlockSize = 16;
+
+/**
+ * This class implements AES-CMAC (RFC 4493) with the AES key expanded once.
+ *
+ * The PBKDF2 loop computes thousands of CMACs with the same key, so the key
+ * schedule and the CMAC subkeys are computed a single time in SetKey() and
+ * each PRF invocation costs only the block cipher calls on the message.
+ *
+ */
+class Cmac
+{
+public:
+    Cmac() { mbedtls_aes_init(&mAes); }
+    ~Cmac() { mbedtls_aes_free(&mAes); }
+
+    void SetKey(const uint8_t aKey[kBlockSize])
+    {
+        uint8_t zero[kBlockSize] = {0};
+        uint8_t l[kBlockSize];
+
+        mbedtls_aes_setkey_enc(&mAes, aKey, kBlockSize * 8);
+
+        mbedtls_aes_crypt_ecb(&mAes, MBEDTLS_AES_ENCRYPT, zero, l);
+        ShiftLeft(mSubkey1, l);
+        ShiftLeft(mSubkey2, mSubkey1);
+    }
+
+    void Compute(const uint8_t *aMessage, size_t aLength, uint8_t aMac[kBlockSize])
+    {
+        uint8_t x[kBlockSize] = {0};
+        uint8_t last[kBlockSize];
+        size_t  blockNum = (aLength + kBlockSize - 1) / kBlockSize;
+        size_t  lastLength;
+
+        if (blockNum == 0)
+        {
+            blockNum = 1;
+        }
+
+        for (size_t i = 0; i + 1 < blockNum; ++i)
+        {
+            Xor(x, aMessage + i * kBlockSize);
+            mbedtls_aes_crypt_ecb(&mAes, MBEDTLS_AES_ENCRYPT, x, x);
+        }
+
+        lastLength = aLength - (blockNum - 1) * kBlockSize;
+        memset(last, 0, sizeof(last));
+        memcpy(last, aMessage + (blockNum - 1) * kBlockSize, lastLength);
+        if (lastLength == kBlockSize)
+        {
+            Xor(last, mSubkey1);
+        }
+        else
+        {
+            last[lastLength] = 0x80;
+            Xor(last, mSubkey2);
+        }
+
+        Xor(x, last);
+        mbedtls_aes_crypt_ecb(&mAes, MBEDTLS_AES_ENCRYPT, x, aMac);
+    }
+
+    // The fast path for a message of exactly one complete block,
+    // which is the case of U_2 ... U_c in PBKDF2.
+    void ComputeBlock(const uint8_t aBlock[kBlockSize], uint8_t aMac[kBlockSize])
+    {
+        uint8_t x[kBlockSize];
+
+        for (size_t i = 0; i < kBlockSize; ++i)
+        {
+            x[i] = aBlock[i] ^ mSubkey1[i];
+        }
+
+        mbedtls_aes_crypt_ecb(&mAes, MBEDTLS_AES_ENCRYPT, x, aMac);
+    }
+
+private:
+    static void Xor(uint8_t aDst[kBlockSize], const uint8_t aSrc[kBlockSize])
+    {
+        for (size_t i = 0; i < kBlockSize; ++i)
+        {
+            aDst[i] ^= aSrc[i];
+        }
+    }
+
+    static void ShiftLeft(uint8_t aDst[kBlockSize], const uint8_t aSrc[kBlockSize])
+    {
+        uint8_t msb = aSrc[0] & 0x80;
+
+        for (size_t i = 0; i + 1 < kBlockSize; ++i)
+        {
+            aDst[i] = static_cast<uint8_t>((aSrc[i] << 1) | (aSrc[i + 1] >> 7));
+        }
+        aDst[kBlockSize - 1] = static_cast<uint8_t>(aSrc[kBlockSize - 1] << 1);
+
+        if (msb)
+        {
+            aDst[kBlockSize - 1] ^= 0x87;
+        }
+    }
+
+    mbedtls_aes_context mAes;
+    uint8_t             mSubkey1[kBlockSize];
+    uint8_t             mSubkey2[kBlockSize];
+};
+
+} // namespace
+
 void otPbkdf2Cmac(const uint8_t *aPassword,
                   uint16_t       aPasswordLen,
                   const uint8_t *aSalt,
@@ -51,19 +161,32 @@ void otPbkdf2Cmac(const uint8_t *aPassword,
                   uint16_t       aKeyLen,
                   uint8_t *      aKey)
 {
-    const size_t kBlockSize = MBEDTLS_CIPHER_BLKSIZE_MAX;
-    uint8_t      prfInput[OT_PBKDF2_SALT_MAX_LEN + 4]; // Salt || INT(), for U1 calculation
-    long         prfOne[kBlockSize / sizeof(long)];
-    long         prfTwo[kBlockSize / sizeof(long)];
-    long         keyBlock[kBlockSize / sizeof(long)];
-    uint32_t     blockCounter = 0;
-    uint8_t *    key          = aKey;
-    uint16_t     keyLen       = aKeyLen;
-    uint16_t     useLen       = 0;
+    uint8_t  prfInput[OT_PBKDF2_SALT_MAX_LEN + 4]; // Salt || INT(), for U1 calculation
+    uint8_t  prfKey[kBlockSize];
+    uint8_t  prf[kBlockSize];
+    uint8_t  keyBlock[kBlockSize];
+    uint32_t blockCounter = 0;
+    uint8_t *key          = aKey;
+    uint16_t keyLen       = aKeyLen;
+    uint16_t useLen       = 0;
+    Cmac     cmac;
+
+    // AES-CMAC-PRF-128 (RFC 4615): a password of other than 128 bits
+    // is first reduced to a 128-bit key with CMAC under the zero key.
+    if (aPasswordLen == kBlockSize)
+    {
+        memcpy(prfKey, aPassword, kBlockSize);
+    }
+    else
+    {
+        memset(prfKey, 0, sizeof(prfKey));
+        cmac.SetKey(prfKey);
+        cmac.Compute(aPassword, aPasswordLen, prfKey);
+    }
+
+    cmac.SetKey(prfKey);
 
     memcpy(prfInput, aSalt, aSaltLen);
-    assert(aIterationCounter % 2 == 0);
-    aIterationCounter /= 2;
 
     while (keyLen)
     {
@@ -74,30 +197,17 @@ void otPbkdf2Cmac(const uint8_t *aPassword,
         prfInput[aSaltLen + 3] = static_cast<uint8_t>(blockCounter);
 
         // Calculate U_1
-        mbedtls_aes_cmac_prf_128(aPassword, aPasswordLen, prfInput, aSaltLen + 4,
-                                 reinterpret_cast<uint8_t *>(keyBlock));
-
-        // Calculate U_2
-        mbedtls_aes_cmac_prf_128(aPassword, aPasswordLen, reinterpret_cast<const uint8_t *>(keyBlock), kBlockSize,
-                                 reinterpret_cast<uint8_t *>(prfOne));
-
-        for (uint32_t j = 0; j < kBlockSize / sizeof(long); ++j)
-        {
-            keyBlock[j] ^= prfOne[j];
-        }
+        cmac.Compute(prfInput, aSaltLen + 4, prf);
+        memcpy(keyBlock, prf, kBlockSize);
 
+        // Calculate U_2 ... U_c, each of them is a single-block CMAC of the previous one.
         for (uint32_t i = 1; i < aIterationCounter; ++i)
         {
-            // Calculate U_{2 * i - 1}
-            mbedtls_aes_cmac_prf_128(aPassword, aPasswordLen, reinterpret_cast<const uint8_t *>(prfOne), kBlockSize,
-                                     reinterpret_cast<uint8_t *>(prfTwo));
-            // Calculate U_{2 * i}
-            mbedtls_aes_cmac_prf_128(aPassword, aPasswordLen, reinterpret_cast<const uint8_t *>(prfTwo), kBlockSize,
-                                     reinterpret_cast<uint8_t *>(prfOne));
-
-            for (uint32_t j = 0; j < kBlockSize / sizeof(long); ++j)
+            cmac.ComputeBlock(prf, prf);
+
+            for (size_t j = 0; j < kBlockSize; ++j)
             {
-                keyBlock[j] ^= prfOne[j] ^ prfTwo[j];
+                keyBlock[j] ^= prf[j];
             }
         }
 
@@ -106,6 +216,8 @@ void otPbkdf2Cmac(const uint8_t *aPassword,
         key += useLen;
         keyLen -= useLen;
     }
+
+    memset(prfKey, 0, sizeof(prfKey));
 }
 
 } // namespace commissioner
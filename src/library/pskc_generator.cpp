@@ -0,0 +1,224 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the batch PSKc generator.
+ */
+
+#include "library/pskc_generator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "common/error_macros.hpp"
+#include "common/utils.hpp"
+#include "library/openthread/pbkdf2_cmac.hpp"
+#include "library/openthread/sha256.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+static constexpr uint32_t kPSKcIterationCounter = 16384;
+
+PSKcGenerator::PSKcGenerator(size_t aCacheCapacity)
+    : mCache(aCacheCapacity)
+{
+}
+
+Error PSKcGenerator::Generate(std::vector<ByteArray> &       aPSKcList,
+                              const std::vector<PSKcParams> &aParamsList,
+                              size_t                         aThreadNum)
+{
+    Error                    error;
+    std::vector<ByteArray>   pskcList(aParamsList.size());
+    std::vector<ByteArray>   cacheKeys(aParamsList.size());
+    std::vector<size_t>      pending;
+    std::atomic<size_t>      next{0};
+    std::vector<std::thread> workers;
+
+    auto work = [&pending, &next, &pskcList, &aParamsList]() {
+        size_t n;
+
+        while ((n = next++) < pending.size())
+        {
+            Compute(pskcList[pending[n]], aParamsList[pending[n]]);
+        }
+    };
+
+    for (size_t i = 0; i < aParamsList.size(); ++i)
+    {
+        if ((error = Validate(aParamsList[i])) != ErrorCode::kNone)
+        {
+            ExitNow(error = ERROR_INVALID_ARGS("invalid PSKc params at index {}: {}", i, error.GetMessage()));
+        }
+
+        if (mCache.GetCapacity() > 0)
+        {
+            cacheKeys[i] = ComputeCacheKey(aParamsList[i]);
+            if (LookupCache(pskcList[i], cacheKeys[i]))
+            {
+                continue;
+            }
+        }
+
+        pending.push_back(i);
+    }
+
+    if (aThreadNum == 0)
+    {
+        aThreadNum = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    aThreadNum = std::min(aThreadNum, pending.size());
+
+    // The caller thread is one of the workers.
+    for (size_t i = 1; i < aThreadNum; ++i)
+    {
+        workers.emplace_back(work);
+    }
+    work();
+
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+
+    if (mCache.GetCapacity() > 0)
+    {
+        for (auto i : pending)
+        {
+            UpdateCache(cacheKeys[i], pskcList[i]);
+        }
+    }
+
+    aPSKcList = std::move(pskcList);
+
+exit:
+    return error;
+}
+
+size_t PSKcGenerator::GetCacheSize() const
+{
+    std::lock_guard<std::mutex> _(mCacheMutex);
+
+    return mCache.GetSize();
+}
+
+Error PSKcGenerator::Derive(ByteArray &aPSKc, const PSKcParams &aParams)
+{
+    Error error;
+
+    SuccessOrExit(error = Validate(aParams));
+    Compute(aPSKc, aParams);
+
+exit:
+    return error;
+}
+
+Error PSKcGenerator::Validate(const PSKcParams &aParams)
+{
+    Error error;
+
+    VerifyOrExit((aParams.mPassphrase.size() >= kMinCommissionerCredentialLength) &&
+                     (aParams.mPassphrase.size() <= kMaxCommissionerCredentialLength),
+                 error = ERROR_INVALID_ARGS("passphrase length={} exceeds range [{}, {}]", aParams.mPassphrase.size(),
+                                            kMinCommissionerCredentialLength, kMaxCommissionerCredentialLength));
+    VerifyOrExit(aParams.mNetworkName.size() <= kMaxNetworkNameLength,
+                 error = ERROR_INVALID_ARGS("network name length={} > {}", aParams.mNetworkName.size(),
+                                            kMaxNetworkNameLength));
+    VerifyOrExit(aParams.mExtendedPanId.size() == kExtendedPanIdLength,
+                 error = ERROR_INVALID_ARGS("extended PAN ID length={} != {}", aParams.mExtendedPanId.size(),
+                                            kExtendedPanIdLength));
+
+exit:
+    return error;
+}
+
+void PSKcGenerator::Compute(ByteArray &aPSKc, const PSKcParams &aParams)
+{
+    const std::string saltPrefix = "Thread";
+    ByteArray         salt;
+
+    salt.insert(salt.end(), saltPrefix.begin(), saltPrefix.end());
+    salt.insert(salt.end(), aParams.mExtendedPanId.begin(), aParams.mExtendedPanId.end());
+    salt.insert(salt.end(), aParams.mNetworkName.begin(), aParams.mNetworkName.end());
+
+    aPSKc.resize(kMaxPSKcLength);
+    otPbkdf2Cmac(reinterpret_cast<const uint8_t *>(aParams.mPassphrase.data()),
+                 static_cast<uint16_t>(aParams.mPassphrase.size()), salt.data(), static_cast<uint16_t>(salt.size()),
+                 kPSKcIterationCounter, static_cast<uint16_t>(aPSKc.size()), aPSKc.data());
+}
+
+ByteArray PSKcGenerator::ComputeCacheKey(const PSKcParams &aParams)
+{
+    Sha256  sha256;
+    uint8_t hash[Sha256::kHashSize];
+
+    // Each field is prefixed by its length so that
+    // different inputs never have the same encoding.
+    sha256.Start();
+    for (const auto &field : {ByteArray{aParams.mPassphrase.begin(), aParams.mPassphrase.end()},
+                              ByteArray{aParams.mNetworkName.begin(), aParams.mNetworkName.end()},
+                              aParams.mExtendedPanId})
+    {
+        uint8_t length = static_cast<uint8_t>(field.size());
+
+        sha256.Update(&length, sizeof(length));
+        sha256.Update(field.data(), static_cast<uint16_t>(field.size()));
+    }
+    sha256.Finish(hash);
+
+    return {hash, hash + sizeof(hash)};
+}
+
+bool PSKcGenerator::LookupCache(ByteArray &aPSKc, const ByteArray &aKey)
+{
+    std::lock_guard<std::mutex> _(mCacheMutex);
+    const ByteArray *           pskc = mCache.Find(aKey);
+
+    if (pskc == nullptr)
+    {
+        return false;
+    }
+
+    aPSKc = *pskc;
+    return true;
+}
+
+void PSKcGenerator::UpdateCache(const ByteArray &aKey, const ByteArray &aPSKc)
+{
+    std::lock_guard<std::mutex> _(mCacheMutex);
+
+    mCache.Put(aKey, aPSKc);
+}
+
+} // namespace commissioner
+
+} // namespace ot
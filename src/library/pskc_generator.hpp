@@ -0,0 +1,86 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions of the batch PSKc generator.
+ */
+
+#ifndef OT_COMM_LIBRARY_PSKC_GENERATOR_HPP_
+#define OT_COMM_LIBRARY_PSKC_GENERATOR_HPP_
+
+#include <mutex>
+#include <vector>
+
+#include <commissioner/commissioner.hpp>
+#include <commissioner/error.hpp>
+
+#include "library/lru_cache.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+// Derives PSKc for batches of networks on a pool of worker threads
+// and remembers recent results in a LRU cache keyed by the SHA-256
+// hash of the inputs.
+class PSKcGenerator
+{
+public:
+    // @param[in] aCacheCapacity  The max number of cached PSKc. 0 disables the cache.
+    explicit PSKcGenerator(size_t aCacheCapacity);
+
+    // Generate PSKc for each element of @p aParamsList with @p aThreadNum
+    // worker threads (including the caller thread). 0 means the number of
+    // hardware threads. @p aPSKcList is not touched if any input is invalid.
+    Error Generate(std::vector<ByteArray> &aPSKcList, const std::vector<PSKcParams> &aParamsList, size_t aThreadNum);
+
+    size_t GetCacheSize() const;
+
+    // Validate the inputs and derive the PSKc on the caller thread, without the cache.
+    static Error Derive(ByteArray &aPSKc, const PSKcParams &aParams);
+
+    static Error Validate(const PSKcParams &aParams);
+
+private:
+    static void      Compute(ByteArray &aPSKc, const PSKcParams &aParams);
+    static ByteArray ComputeCacheKey(const PSKcParams &aParams);
+
+    bool LookupCache(ByteArray &aPSKc, const ByteArray &aKey);
+    void UpdateCache(const ByteArray &aKey, const ByteArray &aPSKc);
+
+    // The PSKc of each cache key.
+    mutable std::mutex             mCacheMutex;
+    LruCache<ByteArray, ByteArray> mCache;
+};
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_LIBRARY_PSKC_GENERATOR_HPP_
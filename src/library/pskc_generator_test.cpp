@@ -0,0 +1,110 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases of the batch PSKc generator.
+ */
+
+#include "library/pskc_generator.hpp"
+
+#include <catch2/catch.hpp>
+
+#include "common/utils.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+static const PSKcParams kSpecParams = {"12SECRETPASSWORD34", "Test Network",
+                                       ByteArray{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07}};
+
+TEST_CASE("pskc-generator-batch", "[pskc]")
+{
+    std::vector<PSKcParams> paramsList;
+    std::vector<ByteArray>  pskcList;
+    ByteArray               pskc;
+
+    for (size_t i = 0; i < 8; ++i)
+    {
+        paramsList.push_back({kSpecParams.mPassphrase, "Network " + std::to_string(i), kSpecParams.mExtendedPanId});
+    }
+    paramsList.push_back(kSpecParams);
+
+    PSKcGenerator generator(0);
+    REQUIRE(generator.Generate(pskcList, paramsList, 4) == ErrorCode::kNone);
+    REQUIRE(pskcList.size() == paramsList.size());
+    REQUIRE(utils::Hex(pskcList.back()) == "c3f59368445a1b6106be420a706d4cc9");
+    REQUIRE(generator.GetCacheSize() == 0);
+
+    for (size_t i = 0; i < paramsList.size(); ++i)
+    {
+        REQUIRE(PSKcGenerator::Derive(pskc, paramsList[i]) == ErrorCode::kNone);
+        REQUIRE(pskc == pskcList[i]);
+    }
+}
+
+TEST_CASE("pskc-generator-invalid-args", "[pskc]")
+{
+    std::vector<ByteArray> pskcList;
+    PSKcGenerator          generator(16);
+
+    REQUIRE(generator.Generate(pskcList, {kSpecParams, {"12S", "Test Network", kSpecParams.mExtendedPanId}}, 2)
+                .GetCode() == ErrorCode::kInvalidArgs);
+    REQUIRE(pskcList.empty());
+    REQUIRE(generator.GetCacheSize() == 0);
+}
+
+TEST_CASE("pskc-generator-lru-cache", "[pskc]")
+{
+    std::vector<ByteArray> pskcList;
+    PSKcGenerator          generator(2);
+
+    PSKcParams params1 = kSpecParams;
+    PSKcParams params2 = kSpecParams;
+    PSKcParams params3 = kSpecParams;
+    params2.mNetworkName += "2";
+    params3.mNetworkName += "3";
+
+    REQUIRE(generator.Generate(pskcList, {kSpecParams, kSpecParams}, 0) == ErrorCode::kNone);
+    REQUIRE(generator.GetCacheSize() == 1);
+    REQUIRE(utils::Hex(pskcList[0]) == "c3f59368445a1b6106be420a706d4cc9");
+    REQUIRE(pskcList[0] == pskcList[1]);
+
+    REQUIRE(generator.Generate(pskcList, {params2, params3}, 0) == ErrorCode::kNone);
+    REQUIRE(generator.GetCacheSize() == 2);
+
+    // 'params1' has been evicted by 'params2' and 'params3'.
+    REQUIRE(generator.Generate(pskcList, {params1, params3}, 0) == ErrorCode::kNone);
+    REQUIRE(generator.GetCacheSize() == 2);
+    REQUIRE(utils::Hex(pskcList[0]) == "c3f59368445a1b6106be420a706d4cc9");
+}
+
+} // namespace commissioner
+
+} // namespace ot
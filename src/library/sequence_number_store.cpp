@@ -0,0 +1,418 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the persistent store of COSE sequence numbers.
+ */
+
+#include "library/sequence_number_store.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "common/error_macros.hpp"
+#include "common/utils.hpp"
+#include "library/logging.hpp"
+#include "library/openthread/crc16.hpp"
+#include "library/openthread/sha256.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+// A journal record is the SHA-256 hash of the key, the upper bound of the
+// reserved block and the CRC16 of them, all in network byte order.
+static constexpr size_t kRecordSize = Sha256::kHashSize + sizeof(uint64_t) + sizeof(uint16_t);
+
+constexpr uint64_t SequenceNumberStore::kDefaultBlockSize;
+constexpr size_t   SequenceNumberStore::kDefaultMaxRecordCount;
+constexpr size_t   SequenceNumberStore::kKeyHashSize;
+
+static uint16_t ComputeCrc(const uint8_t *aBuf, size_t aLength)
+{
+    Crc16 crc16(Crc16::Polynomial::kCcitt);
+
+    crc16.Init();
+    for (size_t i = 0; i < aLength; ++i)
+    {
+        crc16.Update(aBuf[i]);
+    }
+
+    return crc16.Get();
+}
+
+// Syncs the directory entry of @p aFilename, so that a rename survives a crash.
+static void SyncDirectory(const std::string &aFilename)
+{
+    size_t      slash     = aFilename.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : aFilename.substr(0, std::max<size_t>(slash, 1));
+    int         fd        = open(directory.c_str(), O_RDONLY);
+
+    if (fd >= 0)
+    {
+        if (fsync(fd) != 0)
+        {
+            LOG_WARN(LOG_REGION_TOKEN_MANAGER, "cannot sync directory '{}', {}", directory, strerror(errno));
+        }
+        close(fd);
+    }
+}
+
+SequenceNumberStore::SequenceNumberStore(uint64_t aBlockSize, size_t aMaxRecordCount)
+    : mBlockSize(std::max<uint64_t>(aBlockSize, 1))
+    , mMaxRecordCount(std::max<size_t>(aMaxRecordCount, 1))
+{
+}
+
+SequenceNumberStore::~SequenceNumberStore()
+{
+    Stop();
+
+    if (mFd >= 0)
+    {
+        close(mFd);
+    }
+}
+
+Error SequenceNumberStore::Open(const std::string &aFilename)
+{
+    Error error;
+
+    VerifyOrExit(mFd < 0 && !mStarted, error = ERROR_INVALID_STATE("the sequence number store has been opened"));
+    VerifyOrExit(!aFilename.empty(), error = ERROR_INVALID_ARGS("the sequence number journal is empty"));
+
+    mFilename = aFilename;
+    SuccessOrExit(error = Recover());
+
+    mWorker = std::thread([this]() { RunWorker(); });
+
+exit:
+    return error;
+}
+
+Error SequenceNumberStore::Start(const ByteArray &aKey)
+{
+    Error                        error;
+    ByteArray                    keyHash = HashKey(aKey);
+    std::unique_lock<std::mutex> lock(mMutex);
+    uint64_t                     next;
+
+    mCondition.wait(lock, [this]() { return !mReserving; });
+
+    VerifyOrExit(!mStarted || keyHash != mKeyHash);
+
+    if (mFd >= 0)
+    {
+        // Continue the sequence of the last block reserved in the journal.
+        auto limit = mLimits.find(keyHash);
+
+        next = limit == mLimits.end() ? 0 : limit->second;
+        SuccessOrExit(error = WriteRecord(keyHash, next + mBlockSize));
+        mLimit = next + mBlockSize;
+    }
+    else
+    {
+        next   = 0;
+        mLimit = UINT64_MAX;
+    }
+
+    mKeyHash      = keyHash;
+    mNext         = next;
+    mStarted      = true;
+    mReserveError = ERROR_NONE;
+
+exit:
+    return error;
+}
+
+Error SequenceNumberStore::Next(uint64_t &aSequenceNumber)
+{
+    Error                        error;
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    VerifyOrExit(mStarted, error = ERROR_INVALID_STATE("the sequence number is not started"));
+
+    if (mNext >= mLimit)
+    {
+        // The next block is not reserved in time, wait for it.
+        mReserving = true;
+        mCondition.notify_all();
+        mCondition.wait(lock, [this]() { return !mReserving; });
+
+        VerifyOrExit(mNext < mLimit, error = mReserveError);
+    }
+
+    aSequenceNumber = mNext++;
+
+    if (mFd >= 0 && !mReserving && mLimit - mNext <= mBlockSize / 2)
+    {
+        mReserving = true;
+        mCondition.notify_all();
+    }
+
+exit:
+    return error;
+}
+
+ByteArray SequenceNumberStore::HashKey(const ByteArray &aKey)
+{
+    Sha256  sha256;
+    uint8_t hash[Sha256::kHashSize];
+
+    sha256.Start();
+    for (size_t offset = 0; offset < aKey.size(); offset += UINT16_MAX)
+    {
+        size_t chunkLength = std::min<size_t>(aKey.size() - offset, UINT16_MAX);
+
+        sha256.Update(aKey.data() + offset, static_cast<uint16_t>(chunkLength));
+    }
+    sha256.Finish(hash);
+
+    return {hash, hash + sizeof(hash)};
+}
+
+ByteArray SequenceNumberStore::EncodeRecord(const ByteArray &aKeyHash, uint64_t aLimit)
+{
+    ByteArray record = aKeyHash;
+
+    utils::Encode<uint64_t>(record, aLimit);
+    utils::Encode<uint16_t>(record, ComputeCrc(record.data(), record.size()));
+
+    return record;
+}
+
+Error SequenceNumberStore::Recover()
+{
+    Error       error;
+    int         fd = open(mFilename.c_str(), O_RDWR | O_CREAT | O_APPEND, 0600);
+    struct stat status;
+    ByteArray   journal;
+    size_t      count = 0;
+
+    VerifyOrExit(fd >= 0, error = ERROR_IO_ERROR("cannot open file '{}', {}", mFilename, strerror(errno)));
+
+    // Two stores appending to the same journal would hand out the same numbers.
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0)
+    {
+        if (errno == EWOULDBLOCK)
+        {
+            ExitNow(error = ERROR_BUSY("file '{}' is used by another sequence number store", mFilename));
+        }
+        else
+        {
+            ExitNow(error = ERROR_IO_ERROR("cannot lock file '{}', {}", mFilename, strerror(errno)));
+        }
+    }
+
+    VerifyOrExit(fstat(fd, &status) == 0,
+                 error = ERROR_IO_ERROR("cannot stat file '{}', {}", mFilename, strerror(errno)));
+
+    journal.resize(static_cast<size_t>(status.st_size));
+    VerifyOrExit(pread(fd, journal.data(), journal.size(), 0) == static_cast<ssize_t>(journal.size()),
+                 error = ERROR_IO_ERROR("cannot read file '{}', {}", mFilename, strerror(errno)));
+
+    // Records after a torn or corrupted one are never acknowledged, as
+    // each record is synced before the next one is written.
+    while ((count + 1) * kRecordSize <= journal.size())
+    {
+        const uint8_t *record = &journal[count * kRecordSize];
+
+        if (utils::Decode<uint16_t>(record + kRecordSize - sizeof(uint16_t), sizeof(uint16_t)) !=
+            ComputeCrc(record, kRecordSize - sizeof(uint16_t)))
+        {
+            break;
+        }
+
+        mLimits[ByteArray(record, record + kKeyHashSize)] =
+            utils::Decode<uint64_t>(record + kKeyHashSize, sizeof(uint64_t));
+        ++count;
+    }
+
+    // Drop the broken tail, so that new records are appended to valid ones.
+    if (count * kRecordSize != journal.size())
+    {
+        VerifyOrExit(ftruncate(fd, static_cast<off_t>(count * kRecordSize)) == 0 && fsync(fd) == 0,
+                     error = ERROR_IO_ERROR("cannot truncate file '{}', {}", mFilename, strerror(errno)));
+    }
+
+    mFd          = fd;
+    mRecordCount = count;
+
+exit:
+    if (error != ErrorCode::kNone && fd >= 0)
+    {
+        close(fd);
+    }
+    return error;
+}
+
+Error SequenceNumberStore::WriteRecord(const ByteArray &aKeyHash, uint64_t aLimit)
+{
+    Error     error;
+    ByteArray record = EncodeRecord(aKeyHash, aLimit);
+
+    // Compact only if it drops at least half of the records, as
+    // the compacted journal keeps one record of each key.
+    if (mRecordCount >= std::max(mMaxRecordCount, 2 * mLimits.size()))
+    {
+        ExitNow(error = Compact(aKeyHash, aLimit));
+    }
+
+    if (write(mFd, record.data(), record.size()) != static_cast<ssize_t>(record.size()))
+    {
+        error = ERROR_IO_ERROR("cannot write file '{}', {}", mFilename, strerror(errno));
+
+        // Keep the journal aligned to records.
+        if (ftruncate(mFd, static_cast<off_t>(mRecordCount * kRecordSize)) != 0)
+        {
+            LOG_WARN(LOG_REGION_TOKEN_MANAGER, "cannot truncate file '{}', {}", mFilename, strerror(errno));
+        }
+        ExitNow();
+    }
+
+    ++mRecordCount;
+    VerifyOrExit(fsync(mFd) == 0, error = ERROR_IO_ERROR("cannot sync file '{}', {}", mFilename, strerror(errno)));
+    mLimits[aKeyHash] = aLimit;
+
+exit:
+    return error;
+}
+
+Error SequenceNumberStore::Compact(const ByteArray &aKeyHash, uint64_t aLimit)
+{
+    Error       error;
+    std::string tempFilename = mFilename + ".tmp";
+    ByteArray   journal;
+    ByteArray   record;
+    size_t      count = 0;
+    int         fd    = -1;
+
+    // The new record is the last one, so that it is the current
+    // block if the journal is recovered.
+    for (const auto &limit : mLimits)
+    {
+        if (limit.first != aKeyHash)
+        {
+            record = EncodeRecord(limit.first, limit.second);
+            journal.insert(journal.end(), record.begin(), record.end());
+            ++count;
+        }
+    }
+    record = EncodeRecord(aKeyHash, aLimit);
+    journal.insert(journal.end(), record.begin(), record.end());
+    ++count;
+
+    // Opened for appending as the journal, so that a write after a
+    // failed one which is truncated starts at the end of the file.
+    fd = open(tempFilename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0600);
+    VerifyOrExit(fd >= 0, error = ERROR_IO_ERROR("cannot open file '{}', {}", tempFilename, strerror(errno)));
+
+    // The lock is held by the file descriptor, take it on the compacted
+    // journal before it replaces the locked one.
+    VerifyOrExit(flock(fd, LOCK_EX | LOCK_NB) == 0,
+                 error = ERROR_IO_ERROR("cannot lock file '{}', {}", tempFilename, strerror(errno)));
+    VerifyOrExit(write(fd, journal.data(), journal.size()) == static_cast<ssize_t>(journal.size()) && fsync(fd) == 0,
+                 error = ERROR_IO_ERROR("cannot write file '{}', {}", tempFilename, strerror(errno)));
+    VerifyOrExit(rename(tempFilename.c_str(), mFilename.c_str()) == 0,
+                 error = ERROR_IO_ERROR("cannot rename file '{}', {}", tempFilename, strerror(errno)));
+    SyncDirectory(mFilename);
+
+    // The file descriptor now refers to the compacted journal.
+    close(mFd);
+    mFd               = fd;
+    fd                = -1;
+    mRecordCount      = count;
+    mLimits[aKeyHash] = aLimit;
+
+exit:
+    if (fd >= 0)
+    {
+        close(fd);
+        unlink(tempFilename.c_str());
+    }
+    return error;
+}
+
+void SequenceNumberStore::RunWorker()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    while (true)
+    {
+        Error     error;
+        ByteArray keyHash;
+        uint64_t  limit;
+
+        mCondition.wait(lock, [this]() { return mStopped || mReserving; });
+        if (mStopped)
+        {
+            break;
+        }
+
+        // The key doesn't change while reserving, as Start() waits for it.
+        keyHash = mKeyHash;
+        limit   = mLimit + mBlockSize;
+
+        lock.unlock();
+        error = WriteRecord(keyHash, limit);
+        lock.lock();
+
+        if (error == ErrorCode::kNone)
+        {
+            mLimit = limit;
+        }
+        mReserveError = error;
+        mReserving    = false;
+        mCondition.notify_all();
+    }
+}
+
+void SequenceNumberStore::Stop()
+{
+    {
+        std::lock_guard<std::mutex> _(mMutex);
+        mStopped = true;
+    }
+    mCondition.notify_all();
+
+    if (mWorker.joinable())
+    {
+        mWorker.join();
+    }
+}
+
+} // namespace commissioner
+
+} // namespace ot
@@ -0,0 +1,132 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions of the persistent store of COSE sequence numbers.
+ */
+
+#ifndef OT_COMM_LIBRARY_SEQUENCE_NUMBER_STORE_HPP_
+#define OT_COMM_LIBRARY_SEQUENCE_NUMBER_STORE_HPP_
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <commissioner/defines.hpp>
+#include <commissioner/error.hpp>
+
+namespace ot {
+
+namespace commissioner {
+
+// Allocates sequence numbers which are never reused for the same key (the
+// Commissioner Token), even across restarts.
+//
+// Sequence numbers are reserved in blocks: a record of the key and the
+// upper bound of the reserved block is appended to a journal file and
+// synced before any number in the block is handed out. The next block
+// is reserved by a background thread when half of the current block is
+// used, so allocating a number doesn't wait for the disk. After a crash
+// or restart, the sequence of each key continues from its last reserved
+// bound, which skips at most one block.
+//
+// The journal is compacted to the last record of each key when it has
+// @p aMaxRecordCount records.
+class SequenceNumberStore
+{
+public:
+    static constexpr uint64_t kDefaultBlockSize      = 1000;
+    static constexpr size_t   kDefaultMaxRecordCount = 4096;
+
+    explicit SequenceNumberStore(uint64_t aBlockSize      = kDefaultBlockSize,
+                                 size_t   aMaxRecordCount = kDefaultMaxRecordCount);
+    ~SequenceNumberStore();
+
+    SequenceNumberStore(const SequenceNumberStore &aOther) = delete;
+    SequenceNumberStore &operator=(const SequenceNumberStore &aOther) = delete;
+
+    // Opens the journal file and recovers the last reserved block of each key.
+    // Without a journal, sequence numbers are kept only in memory. The journal
+    // is locked while it is open, ERROR_BUSY is returned if it is locked by
+    // another store.
+    Error Open(const std::string &aFilename);
+
+    // Starts the sequence of @p aKey. The sequence continues if @p aKey is
+    // the current key, or has a reserved block in the journal; otherwise
+    // it starts from 0.
+    Error Start(const ByteArray &aKey);
+
+    // Allocates the next sequence number of the current key.
+    Error Next(uint64_t &aSequenceNumber);
+
+private:
+    static constexpr size_t kKeyHashSize = 32;
+
+    static ByteArray HashKey(const ByteArray &aKey);
+    static ByteArray EncodeRecord(const ByteArray &aKeyHash, uint64_t aLimit);
+
+    Error Recover();
+    Error WriteRecord(const ByteArray &aKeyHash, uint64_t aLimit);
+    Error Compact(const ByteArray &aKeyHash, uint64_t aLimit);
+    void  RunWorker();
+    void  Stop();
+
+    const uint64_t mBlockSize;
+    const size_t   mMaxRecordCount;
+    std::string    mFilename;
+    int            mFd          = -1;
+    size_t         mRecordCount = 0;
+
+    // The upper bound of the last reserved block of each key in the journal.
+    std::map<ByteArray, uint64_t> mLimits;
+
+    // The hash of the current key, and the sequence numbers
+    // in [mNext, mLimit) are reserved for it.
+    ByteArray mKeyHash;
+    uint64_t  mNext    = 0;
+    uint64_t  mLimit   = 0;
+    bool      mStarted = false;
+
+    // The error of the last reservation by the worker.
+    Error mReserveError;
+
+    bool                    mReserving = false;
+    bool                    mStopped   = false;
+    std::mutex              mMutex;
+    std::condition_variable mCondition;
+    std::thread             mWorker;
+};
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_LIBRARY_SEQUENCE_NUMBER_STORE_HPP_
@@ -0,0 +1,212 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases of the persistent store of COSE sequence numbers.
+ */
+
+#include "library/sequence_number_store.hpp"
+
+#include <stdio.h>
+
+#include <catch2/catch.hpp>
+
+namespace ot {
+
+namespace commissioner {
+
+static const std::string kJournal = "sequence_number_store_test.journal";
+
+static uint64_t NextSequenceNumber(SequenceNumberStore &aStore)
+{
+    uint64_t sequenceNumber = 0;
+
+    REQUIRE(aStore.Next(sequenceNumber) == ErrorCode::kNone);
+    return sequenceNumber;
+}
+
+TEST_CASE("sequence-number-store-in-memory", "[sequence-number]")
+{
+    SequenceNumberStore store;
+    uint64_t            sequenceNumber;
+
+    REQUIRE(store.Next(sequenceNumber).GetCode() == ErrorCode::kInvalidState);
+
+    REQUIRE(store.Start({0x01}) == ErrorCode::kNone);
+    REQUIRE(NextSequenceNumber(store) == 0);
+    REQUIRE(NextSequenceNumber(store) == 1);
+
+    // The same key continues the sequence.
+    REQUIRE(store.Start({0x01}) == ErrorCode::kNone);
+    REQUIRE(NextSequenceNumber(store) == 2);
+
+    REQUIRE(store.Start({0x02}) == ErrorCode::kNone);
+    REQUIRE(NextSequenceNumber(store) == 0);
+}
+
+TEST_CASE("sequence-number-store-journal", "[sequence-number]")
+{
+    constexpr uint64_t kBlockSize = 10;
+
+    remove(kJournal.c_str());
+
+    {
+        SequenceNumberStore store{kBlockSize};
+
+        REQUIRE(store.Open(kJournal) == ErrorCode::kNone);
+        REQUIRE(store.Start({0x01}) == ErrorCode::kNone);
+        for (uint64_t i = 0; i < 3; ++i)
+        {
+            REQUIRE(NextSequenceNumber(store) == i);
+        }
+    }
+
+    SECTION("restart skips the rest of the reserved block")
+    {
+        SequenceNumberStore store{kBlockSize};
+
+        REQUIRE(store.Open(kJournal) == ErrorCode::kNone);
+        REQUIRE(store.Start({0x01}) == ErrorCode::kNone);
+        REQUIRE(NextSequenceNumber(store) == kBlockSize);
+
+        // Blocks are reserved ahead, and no number is handed out twice.
+        for (uint64_t i = kBlockSize + 1; i < kBlockSize * 10; ++i)
+        {
+            REQUIRE(NextSequenceNumber(store) == i);
+        }
+    }
+
+    SECTION("restart with another key")
+    {
+        SequenceNumberStore store{kBlockSize};
+
+        REQUIRE(store.Open(kJournal) == ErrorCode::kNone);
+        REQUIRE(store.Start({0x02}) == ErrorCode::kNone);
+        REQUIRE(NextSequenceNumber(store) == 0);
+
+        // Each key continues its own sequence.
+        REQUIRE(store.Start({0x01}) == ErrorCode::kNone);
+        REQUIRE(NextSequenceNumber(store) == kBlockSize);
+    }
+
+    SECTION("torn record is ignored")
+    {
+        FILE *journal = fopen(kJournal.c_str(), "ab");
+        REQUIRE(journal != nullptr);
+        REQUIRE(fwrite("torn", 1, 4, journal) == 4);
+        REQUIRE(fclose(journal) == 0);
+
+        SequenceNumberStore store{kBlockSize};
+
+        REQUIRE(store.Open(kJournal) == ErrorCode::kNone);
+        REQUIRE(store.Start({0x01}) == ErrorCode::kNone);
+        REQUIRE(NextSequenceNumber(store) == kBlockSize);
+    }
+
+    remove(kJournal.c_str());
+}
+
+TEST_CASE("sequence-number-store-locked-journal", "[sequence-number]")
+{
+    remove(kJournal.c_str());
+
+    {
+        SequenceNumberStore store;
+        SequenceNumberStore other;
+
+        REQUIRE(store.Open(kJournal) == ErrorCode::kNone);
+        REQUIRE(other.Open(kJournal) == ErrorCode::kBusy);
+    }
+
+    // The lock is released when the store is destroyed.
+    {
+        SequenceNumberStore store;
+
+        REQUIRE(store.Open(kJournal) == ErrorCode::kNone);
+    }
+
+    remove(kJournal.c_str());
+}
+
+TEST_CASE("sequence-number-store-compaction", "[sequence-number]")
+{
+    constexpr uint64_t kBlockSize      = 2;
+    constexpr size_t   kMaxRecordCount = 8;
+    constexpr uint64_t kCount          = 100;
+
+    remove(kJournal.c_str());
+
+    {
+        SequenceNumberStore store{kBlockSize, kMaxRecordCount};
+
+        REQUIRE(store.Open(kJournal) == ErrorCode::kNone);
+        REQUIRE(store.Start({0x01}) == ErrorCode::kNone);
+        for (uint64_t i = 0; i < kCount; ++i)
+        {
+            REQUIRE(NextSequenceNumber(store) == i);
+        }
+
+        // Reserves blocks of another key, which compacts the journal a few times.
+        REQUIRE(store.Start({0x02}) == ErrorCode::kNone);
+        for (uint64_t i = 0; i < kCount; ++i)
+        {
+            REQUIRE(NextSequenceNumber(store) == i);
+        }
+    }
+
+    SequenceNumberStore store{kBlockSize, kMaxRecordCount};
+    SequenceNumberStore other;
+    uint64_t            next;
+
+    REQUIRE(store.Open(kJournal) == ErrorCode::kNone);
+
+    // Both keys survive compaction.
+    REQUIRE(store.Start({0x01}) == ErrorCode::kNone);
+    next = NextSequenceNumber(store);
+    REQUIRE(next >= kCount);
+    REQUIRE(next <= kCount + 2 * kBlockSize);
+
+    REQUIRE(store.Start({0x02}) == ErrorCode::kNone);
+    next = NextSequenceNumber(store);
+    REQUIRE(next >= kCount);
+    REQUIRE(next <= kCount + 2 * kBlockSize);
+
+    // The compacted journal is still locked.
+    for (uint64_t i = 0; i < kCount; ++i)
+    {
+        NextSequenceNumber(store);
+    }
+    REQUIRE(other.Open(kJournal) == ErrorCode::kBusy);
+
+    remove(kJournal.c_str());
+}
+
+} // namespace commissioner
+
+} // namespace ot
@@ -33,6 +33,7 @@
 
 #include "library/tlv.hpp"
 
+#include <algorithm>
 #include <set>
 
 #include "common/error_macros.hpp"
@@ -179,159 +180,162 @@ exit:
     return tlv;
 }
 
-bool Tlv::IsValid() const
+static bool IsValidTlv(Scope aScope, Type aType, uint16_t aLength)
 {
-    auto length = GetLength();
-
-    // The length is cutted off.
-    if (length != mValue.size())
-    {
-        return false;
-    }
-
-    if (mScope == Scope::kThread)
+    if (aScope == Scope::kThread)
     {
-        switch (mType)
+        switch (aType)
         {
         // Thread Network Layer TLVs
         case Type::kThreadStatus:
-            return length == 1;
+            return aLength == 1;
         case Type::kThreadTimeout:
-            return length == 4;
+            return aLength == 4;
         case Type::kThreadIpv6Addresses:
-            return (length % 16 == 0) && (length / 16 >= 1 && length / 16 <= 15);
+            return (aLength % 16 == 0) && (aLength / 16 >= 1 && aLength / 16 <= 15);
         case Type::kThreadCommissionerSessionId:
-            return length == 2;
+            return aLength == 2;
         case Type::kThreadCommissionerToken:
             return true;
         case Type::kThreadCommissionerSignature:
-            return length < kEscapeLength;
+            return aLength < kEscapeLength;
         default:
             return false;
         }
     }
-    else if (mScope == Scope::kMeshLink)
+    else if (aScope == Scope::kMeshLink)
     {
         return false;
     }
 
-    switch (mType)
+    switch (aType)
     {
     // Network Management TLVs
     case Type::kChannel:
-        return length == 3;
+        return aLength == 3;
     case Type::kPanId:
-        return length == 2;
+        return aLength == 2;
     case Type::kExtendedPanId:
-        return length == 8;
+        return aLength == 8;
     case Type::kNetworkName:
-        return length <= 16;
+        return aLength <= 16;
     case Type::kPSKc:
-        return length <= 16;
+        return aLength <= 16;
     case Type::kNetworkMasterKey:
-        return length == 16;
+        return aLength == 16;
     case Type::kNetworkKeySequenceCounter:
-        return length == 4;
+        return aLength == 4;
     case Type::kNetworkMeshLocalPrefix:
-        return length == 8;
+        return aLength == 8;
     case Type::kSteeringData:
-        return length <= 16;
+        return aLength <= 16;
     case Type::kBorderAgentLocator:
-        return length == 2;
+        return aLength == 2;
     case Type::kCommissionerId:
-        return length <= 64;
+        return aLength <= 64;
     case Type::kCommissionerSessionId:
-        return length == 2;
+        return aLength == 2;
     case Type::kActiveTimestamp:
-        return length == 8;
+        return aLength == 8;
     case Type::kCommissionerUdpPort:
-        return length == 2;
+        return aLength == 2;
     case Type::kSecurityPolicy:
-        return length == 3 || length == 4;
+        return aLength == 3 || aLength == 4;
     case Type::kPendingTimestamp:
-        return length == 8;
+        return aLength == 8;
     case Type::kDelayTimer:
-        return length == 4;
+        return aLength == 4;
     case Type::kChannelMask:
-        return length < kEscapeLength;
+        return aLength < kEscapeLength;
 
     // MeshCoP Protocol Command TLVs
     case Type::kGet:
-        return length < kEscapeLength;
+        return aLength < kEscapeLength;
     case Type::kState:
-        return length == 1;
+        return aLength == 1;
     case Type::kJoinerDtlsEncapsulation:
         return true;
     case Type::kJoinerUdpPort:
-        return length == 2;
+        return aLength == 2;
     case Type::kJoinerIID:
-        return length == 8;
+        return aLength == 8;
     case Type::kJoinerRouterLocator:
-        return length == 2;
+        return aLength == 2;
     case Type::kJoinerRouterKEK:
-        return length == kJoinerRouterKekLength;
+        return aLength == kJoinerRouterKekLength;
     case Type::kCount:
-        return length == 1;
+        return aLength == 1;
     case Type::kPeriod:
-        return length == 2;
+        return aLength == 2;
     case Type::kScanDuration:
-        return length == 2;
+        return aLength == 2;
     case Type::kEnergyList:
-        return length < kEscapeLength;
+        return aLength < kEscapeLength;
     case Type::kSecureDissemination:
-        return length < kEscapeLength;
+        return aLength < kEscapeLength;
 
     // TMF Provisioning and Discovery TLVs
     case Type::kProvisioningURL:
-        return length <= 64;
+        return aLength <= 64;
     case Type::kVendorName:
-        return length <= 32;
+        return aLength <= 32;
     case Type::kVendorModel:
-        return length <= 32;
+        return aLength <= 32;
     case Type::kVendorSWVersion:
-        return length <= 16;
+        return aLength <= 16;
     case Type::kVendorData:
-        return length <= 64;
+        return aLength <= 64;
     case Type::kVendorStackVersion:
-        return length < kEscapeLength;
+        return aLength < kEscapeLength;
     case Type::kUdpEncapsulation:
-        return length >= 4;
+        return aLength >= 4;
     case Type::kIpv6Address:
-        return length == 16;
+        return aLength == 16;
     case Type::kDomainName:
-        return length <= 16;
+        return aLength <= 16;
     case Type::kDomainPrefix:
         return true; // Reserved.
     case Type::kAeSteeringData:
-        return length <= 16;
+        return aLength <= 16;
     case Type::kNmkpSteeringData:
-        return length <= 16;
+        return aLength <= 16;
     case Type::kCommissionerToken:
         return true;
     case Type::kCommissionerSignature:
-        return length < kEscapeLength;
+        return aLength < kEscapeLength;
     case Type::kAeUdpPort:
-        return length == 2;
+        return aLength == 2;
     case Type::kNmkpUdpPort:
-        return length == 2;
+        return aLength == 2;
     case Type::kTriHostname:
-        return length < kEscapeLength;
+        return aLength < kEscapeLength;
     case Type::kRegistrarIpv6Address:
-        return length == 16;
+        return aLength == 16;
     case Type::kRegistrarHostname:
-        return length < kEscapeLength;
+        return aLength < kEscapeLength;
     case Type::kCommissionerPenSignature:
-        return length < kEscapeLength;
+        return aLength < kEscapeLength;
     case Type::kDiscoveryRequest:
-        return length == 2;
+        return aLength == 2;
     case Type::kDiscoveryResponse:
-        return length == 2;
+        return aLength == 2;
 
     default:
         return false;
     }
 }
 
+bool Tlv::IsValid() const
+{
+    // The length is cutted off.
+    if (GetLength() != mValue.size())
+    {
+        return false;
+    }
+
+    return IsValidTlv(mScope, mType, GetLength());
+}
+
 Type Tlv::GetType() const
 {
     return mType;
@@ -390,6 +394,139 @@ ByteArray &Tlv::GetValue()
     return mValue;
 }
 
+TlvView::TlvView(Type aType, const uint8_t *aValue, uint16_t aLength, Scope aScope)
+    : mPresent(true)
+    , mScope(aScope)
+    , mType(aType)
+    , mLength(aLength)
+    , mValue(aValue)
+{
+}
+
+bool TlvView::IsValid() const
+{
+    return mPresent && IsValidTlv(mScope, mType, mLength);
+}
+
+int8_t TlvView::GetValueAsInt8() const
+{
+    VerifyOrDie(mLength >= sizeof(int8_t));
+    return static_cast<int8_t>(mValue[0]);
+}
+
+uint8_t TlvView::GetValueAsUint8() const
+{
+    VerifyOrDie(mLength >= sizeof(uint8_t));
+    return utils::Decode<uint8_t>(mValue, mLength);
+}
+
+uint16_t TlvView::GetValueAsUint16() const
+{
+    VerifyOrDie(mLength >= sizeof(uint16_t));
+    return utils::Decode<uint16_t>(mValue, mLength);
+}
+
+uint32_t TlvView::GetValueAsUint32() const
+{
+    VerifyOrDie(mLength >= sizeof(uint32_t));
+    return utils::Decode<uint32_t>(mValue, mLength);
+}
+
+uint64_t TlvView::GetValueAsUint64() const
+{
+    VerifyOrDie(mLength >= sizeof(uint64_t));
+    return utils::Decode<uint64_t>(mValue, mLength);
+}
+
+std::string TlvView::GetValueAsString() const
+{
+    return std::string{mValue, mValue + mLength};
+}
+
+ByteArray TlvView::GetValueAsByteArray() const
+{
+    return ByteArray{mValue, mValue + mLength};
+}
+
+TlvReader::TlvReader(const uint8_t *aBuf, size_t aLength, Scope aScope)
+    : mBuf(aBuf)
+    , mLength(aLength)
+    , mOffset(0)
+    , mScope(aScope)
+{
+}
+
+TlvReader::TlvReader(const ByteArray &aBuf, Scope aScope)
+    : TlvReader(aBuf.data(), aBuf.size(), aScope)
+{
+}
+
+Error TlvReader::Next(TlvView &aTlv)
+{
+    Error    error;
+    size_t   offset = mOffset;
+    uint8_t  type;
+    uint16_t length;
+
+    VerifyOrExit(offset < mLength, error = ERROR_NOT_FOUND("no more TLVs"));
+    VerifyOrExit(offset + 2 <= mLength, error = ERROR_BAD_FORMAT("premature end of TLV"));
+    type   = mBuf[offset++];
+    length = mBuf[offset++];
+    if (length == kEscapeLength)
+    {
+        VerifyOrExit(offset + 2 <= mLength, error = ERROR_BAD_FORMAT("premature end of Extended TLV(type={})", type));
+
+        length = (mBuf[offset++] << 8) & 0xFF00;
+        length |= (mBuf[offset++]) & 0x00FF;
+    }
+
+    VerifyOrExit(offset + length <= mLength,
+                 error = ERROR_BAD_FORMAT("premature end of TLV(type={}, length={})", type, length));
+
+    aTlv = TlvView{utils::from_underlying<Type>(type), mBuf + offset, length, mScope};
+    mOffset = offset + length;
+
+exit:
+    return error;
+}
+
+Error TlvTable::Parse(const uint8_t *aBuf, size_t aLength, Scope aScope)
+{
+    Error     error;
+    TlvReader reader{aBuf, aLength, aScope};
+    TlvView   tlv;
+
+    mTlvs.fill(TlvView{});
+
+    while (!reader.IsEnd())
+    {
+        SuccessOrExit(error = reader.Next(tlv));
+
+        if (tlv.IsValid())
+        {
+            mTlvs[utils::to_underlying(tlv.GetType())] = tlv;
+        }
+        else
+        {
+            // Drop invalid TLVs
+            LOG_WARN(LOG_REGION_COAP, "dropping invalid/unknown TLV(type={}, value={})",
+                     utils::to_underlying(tlv.GetType()), utils::Hex(tlv.GetValueAsByteArray()));
+        }
+    }
+
+exit:
+    if (error != ErrorCode::kNone)
+    {
+        mTlvs.fill(TlvView{});
+    }
+    return error;
+}
+
+Error TlvTable::Parse(const ByteArray &aBuf, Scope aScope)
+{
+    return Parse(aBuf.data(), aBuf.size(), aScope);
+}
+
 Error GetTlvSet(TlvSet &aTlvSet, const ByteArray &aBuf, Scope aScope)
 {
     Error  error;
@@ -430,6 +567,112 @@ exit:
     return ret;
 }
 
+TlvWriter::TlvWriter(ByteArray &aBuf, Scope aScope)
+    : mBuf(aBuf)
+    , mScope(aScope)
+{
+}
+
+Error TlvWriter::Write(Type aType, const uint8_t *aValue, size_t aLength)
+{
+    return Write(aType, {ValueSegment{aValue, aLength}});
+}
+
+Error TlvWriter::Write(Type aType, const ByteArray &aValue)
+{
+    return Write(aType, aValue.data(), aValue.size());
+}
+
+Error TlvWriter::Write(Type aType, const std::string &aValue)
+{
+    return Write(aType, reinterpret_cast<const uint8_t *>(aValue.data()), aValue.size());
+}
+
+Error TlvWriter::Write(Type aType, int8_t aValue)
+{
+    return WriteInteger(aType, static_cast<uint8_t>(aValue));
+}
+
+Error TlvWriter::Write(Type aType, uint8_t aValue)
+{
+    return WriteInteger(aType, aValue);
+}
+
+Error TlvWriter::Write(Type aType, uint16_t aValue)
+{
+    return WriteInteger(aType, aValue);
+}
+
+Error TlvWriter::Write(Type aType, uint32_t aValue)
+{
+    return WriteInteger(aType, aValue);
+}
+
+Error TlvWriter::Write(Type aType, uint64_t aValue)
+{
+    return WriteInteger(aType, aValue);
+}
+
+template <typename T> Error TlvWriter::WriteInteger(Type aType, T aValue)
+{
+    uint8_t value[sizeof(T)];
+
+    for (size_t i = 0; i < sizeof(T); ++i)
+    {
+        value[i] = static_cast<uint8_t>(aValue >> ((sizeof(T) - i - 1) * 8));
+    }
+
+    return Write(aType, value, sizeof(value));
+}
+
+Error TlvWriter::Write(Type aType, std::initializer_list<ValueSegment> aSegments)
+{
+    Error    error;
+    size_t   offset   = mBuf.size();
+    size_t   length   = 0;
+    bool     extended = IsExtendedTlv(aType);
+    uint8_t *value;
+
+    for (const auto &segment : aSegments)
+    {
+        length += segment.mLength;
+    }
+
+    // See Tlv::Serialize() for why base TLVs are never in extended format.
+    VerifyOrExit(length <= std::numeric_limits<uint16_t>::max() && (extended || length < kEscapeLength),
+                 error = ERROR_INVALID_ARGS("the tlv(type={}) is in bad format", utils::to_underlying(aType)));
+
+    mBuf.resize(offset + (extended ? 4 : 2) + length);
+    value = mBuf.data() + offset;
+
+    *value++ = utils::to_underlying(aType);
+    if (extended)
+    {
+        *value++ = kEscapeLength;
+        *value++ = static_cast<uint8_t>(length >> 8);
+        *value++ = static_cast<uint8_t>(length & 0xFF);
+    }
+    else
+    {
+        *value++ = static_cast<uint8_t>(length);
+    }
+
+    for (const auto &segment : aSegments)
+    {
+        value = std::copy(segment.mData, segment.mData + segment.mLength, value);
+    }
+
+    VerifyOrExit(TlvView(aType, value - length, static_cast<uint16_t>(length), mScope).IsValid(),
+                 error = ERROR_INVALID_ARGS("the tlv(type={}) is in bad format", utils::to_underlying(aType)));
+
+exit:
+    if (error != ErrorCode::kNone)
+    {
+        mBuf.resize(offset);
+    }
+    return error;
+}
+
 bool IsDatasetParameter(bool aIsActiveDataset, tlv::Type aTlvType)
 {
     static const std::set<tlv::Type> kActiveSet = {tlv::Type::kActiveTimestamp,
@@ -34,6 +34,8 @@
 #ifndef OT_COMM_LIBRARY_TLV_HPP_
 #define OT_COMM_LIBRARY_TLV_HPP_
 
+#include <array>
+#include <initializer_list>
 #include <limits>
 #include <list>
 #include <map>
@@ -163,6 +165,7 @@ public:
 
     bool     IsValid() const;
     Type     GetType() const;
+    Scope    GetScope() const { return mScope; }
     void     SetValue(const uint8_t *aBuf, size_t aLength);
     void     SetValue(const ByteArray &aValue);
     uint16_t GetLength() const;
@@ -182,9 +185,117 @@ private:
     ByteArray mValue;
 };
 
+// A non-owning view of a TLV in a serialized buffer. The view
+// is valid only as long as the underlying buffer is not modified.
+class TlvView
+{
+public:
+    TlvView() = default;
+    TlvView(Type aType, const uint8_t *aValue, uint16_t aLength, Scope aScope = Scope::kMeshCoP);
+
+    // A default constructed view references no TLV.
+    bool IsPresent() const { return mPresent; }
+    explicit operator bool() const { return mPresent; }
+
+    bool           IsValid() const;
+    Type           GetType() const { return mType; }
+    uint16_t       GetLength() const { return mLength; }
+    const uint8_t *GetValue() const { return mValue; }
+
+    // It is the caller that make sure the tlv is valid.
+    int8_t      GetValueAsInt8() const;
+    uint8_t     GetValueAsUint8() const;
+    uint16_t    GetValueAsUint16() const;
+    uint32_t    GetValueAsUint32() const;
+    uint64_t    GetValueAsUint64() const;
+    std::string GetValueAsString() const;
+    ByteArray   GetValueAsByteArray() const;
+
+private:
+    bool           mPresent = false;
+    Scope          mScope   = Scope::kMeshCoP;
+    Type           mType    = Type::kChannel;
+    uint16_t       mLength  = 0;
+    const uint8_t *mValue   = nullptr;
+};
+
+// Iterates TLVs of a serialized buffer in place, both the base
+// and the extended (escaped 2-bytes length) format are accepted.
+class TlvReader
+{
+public:
+    TlvReader(const uint8_t *aBuf, size_t aLength, Scope aScope = Scope::kMeshCoP);
+    explicit TlvReader(const ByteArray &aBuf, Scope aScope = Scope::kMeshCoP);
+
+    bool IsEnd() const { return mOffset >= mLength; }
+
+    // Read the next TLV into @p aTlv, the TLV is not validated.
+    // Returns ErrorCode::kNotFound at the end of the buffer.
+    Error Next(TlvView &aTlv);
+
+private:
+    const uint8_t *mBuf;
+    size_t         mLength;
+    size_t         mOffset;
+    Scope          mScope;
+};
+
+// A fixed-size lookup table of the valid TLVs in a serialized
+// buffer, indexed by the type byte. Invalid TLVs are dropped
+// and a later TLV overrides an earlier one of the same type.
+class TlvTable
+{
+public:
+    Error Parse(const uint8_t *aBuf, size_t aLength, Scope aScope = Scope::kMeshCoP);
+    Error Parse(const ByteArray &aBuf, Scope aScope = Scope::kMeshCoP);
+
+    // Returns a view which is not present if there is no such TLV.
+    const TlvView &operator[](Type aType) const { return mTlvs[static_cast<uint8_t>(aType)]; }
+
+private:
+    std::array<TlvView, std::numeric_limits<uint8_t>::max() + 1> mTlvs;
+};
+
+// A piece of TLV value which is not owned by the writer.
+struct ValueSegment
+{
+    const uint8_t *mData;
+    size_t         mLength;
+};
+
+// Serializes TLVs in place at the end of a buffer (e.g. the CoAP
+// payload) without building intermediate Tlv objects. A TLV in
+// bad format is rejected and the buffer is left unchanged.
+class TlvWriter
+{
+public:
+    explicit TlvWriter(ByteArray &aBuf, Scope aScope = Scope::kMeshCoP);
+
+    Error Write(Type aType, const uint8_t *aValue, size_t aLength);
+    Error Write(Type aType, const ByteArray &aValue);
+    Error Write(Type aType, const std::string &aValue);
+    Error Write(Type aType, int8_t aValue);
+    Error Write(Type aType, uint8_t aValue);
+    Error Write(Type aType, uint16_t aValue);
+    Error Write(Type aType, uint32_t aValue);
+    Error Write(Type aType, uint64_t aValue);
+
+    // Writes a TLV whose value is the concatenation of @p aSegments.
+    // Each segment is copied only once, straight into the buffer. The
+    // segments must not reference the buffer being written.
+    Error Write(Type aType, std::initializer_list<ValueSegment> aSegments);
+
+private:
+    template <typename T> Error WriteInteger(Type aType, T aValue);
+
+    ByteArray &mBuf;
+    Scope      mScope;
+};
+
 Error  GetTlvSet(TlvSet &aTlvSet, const ByteArray &aBuf, Scope aScope = Scope::kMeshCoP);
 TlvPtr GetTlv(tlv::Type aTlvType, const ByteArray &aBuf, Scope aScope = Scope::kMeshCoP);
 bool   IsDatasetParameter(bool aIsActiveDataset, tlv::Type aTlvType);
+bool   IsExtendedTlv(Type aType);
 
 } // namespace tlv
 
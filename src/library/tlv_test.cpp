@@ -0,0 +1,162 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases for Thread TLVs.
+ */
+
+#include "library/tlv.hpp"
+
+#include <catch2/catch.hpp>
+
+#include "common/utils.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+namespace tlv {
+
+TEST_CASE("tlv-reader-base-and-extended-format", "[tlv]")
+{
+    ByteArray buf;
+    ByteArray dtlsRecords(300, 0xAB);
+    TlvView   tlv;
+
+    Tlv{Type::kJoinerUdpPort, static_cast<uint16_t>(1000)}.Serialize(buf);
+    Tlv{Type::kJoinerDtlsEncapsulation, dtlsRecords}.Serialize(buf);
+    Tlv{Type::kNetworkName, std::string{"OpenThread"}}.Serialize(buf);
+
+    TlvReader reader{buf};
+
+    REQUIRE(reader.Next(tlv) == ErrorCode::kNone);
+    REQUIRE(tlv.GetType() == Type::kJoinerUdpPort);
+    REQUIRE(tlv.GetValueAsUint16() == 1000);
+
+    REQUIRE(reader.Next(tlv) == ErrorCode::kNone);
+    REQUIRE(tlv.GetType() == Type::kJoinerDtlsEncapsulation);
+    REQUIRE(tlv.GetLength() == dtlsRecords.size());
+    REQUIRE(tlv.GetValue() == &buf[2 + 2 + 4]);
+
+    REQUIRE(reader.Next(tlv) == ErrorCode::kNone);
+    REQUIRE(tlv.GetValueAsString() == "OpenThread");
+
+    REQUIRE(reader.IsEnd());
+    REQUIRE(reader.Next(tlv) == ErrorCode::kNotFound);
+}
+
+TEST_CASE("tlv-reader-premature-end", "[tlv]")
+{
+    TlvView tlv;
+
+    SECTION("truncated header")
+    {
+        ByteArray buf = {utils::to_underlying(Type::kPanId)};
+        REQUIRE(TlvReader{buf}.Next(tlv) == ErrorCode::kBadFormat);
+    }
+
+    SECTION("truncated extended length")
+    {
+        ByteArray buf = {utils::to_underlying(Type::kUdpEncapsulation), kEscapeLength, 0x01};
+        REQUIRE(TlvReader{buf}.Next(tlv) == ErrorCode::kBadFormat);
+    }
+
+    SECTION("truncated value")
+    {
+        ByteArray buf = {utils::to_underlying(Type::kPanId), 2, 0xFA};
+        REQUIRE(TlvReader{buf}.Next(tlv) == ErrorCode::kBadFormat);
+    }
+}
+
+TEST_CASE("tlv-table-lookup", "[tlv]")
+{
+    ByteArray buf;
+    TlvTable  tlvTable;
+
+    Tlv{Type::kPanId, static_cast<uint16_t>(0xFACE)}.Serialize(buf);
+    Tlv{Type::kExtendedPanId, utils::Encode<uint64_t>(0x0001020304050607)}.Serialize(buf);
+
+    // An invalid Channel TLV is dropped.
+    buf.insert(buf.end(), {utils::to_underlying(Type::kChannel), 1, 0x00});
+
+    REQUIRE(tlvTable.Parse(buf) == ErrorCode::kNone);
+    REQUIRE(tlvTable[Type::kPanId].IsPresent());
+    REQUIRE(tlvTable[Type::kPanId].GetValueAsUint16() == 0xFACE);
+    REQUIRE(tlvTable[Type::kExtendedPanId].GetValueAsUint64() == 0x0001020304050607);
+    REQUIRE_FALSE(tlvTable[Type::kChannel].IsPresent());
+    REQUIRE_FALSE(tlvTable[Type::kNetworkName].IsPresent());
+
+    // The table is reset by parsing another buffer.
+    REQUIRE(tlvTable.Parse(ByteArray{}) == ErrorCode::kNone);
+    REQUIRE_FALSE(tlvTable[Type::kPanId].IsPresent());
+}
+
+TEST_CASE("tlv-writer-matches-serialize", "[tlv]")
+{
+    ByteArray buf;
+    ByteArray expected;
+    ByteArray dtlsHeader(13, 0x16);
+    ByteArray dtlsBody(300, 0xAB);
+    ByteArray dtlsRecords = dtlsHeader;
+    TlvWriter writer{buf};
+
+    dtlsRecords.insert(dtlsRecords.end(), dtlsBody.begin(), dtlsBody.end());
+
+    Tlv{Type::kJoinerUdpPort, static_cast<uint16_t>(1000)}.Serialize(expected);
+    Tlv{Type::kNetworkName, std::string{"OpenThread"}}.Serialize(expected);
+    Tlv{Type::kState, kStateAccept}.Serialize(expected);
+    Tlv{Type::kJoinerDtlsEncapsulation, dtlsRecords}.Serialize(expected);
+
+    REQUIRE(writer.Write(Type::kJoinerUdpPort, static_cast<uint16_t>(1000)) == ErrorCode::kNone);
+    REQUIRE(writer.Write(Type::kNetworkName, std::string{"OpenThread"}) == ErrorCode::kNone);
+    REQUIRE(writer.Write(Type::kState, kStateAccept) == ErrorCode::kNone);
+    REQUIRE(writer.Write(Type::kJoinerDtlsEncapsulation, {{dtlsHeader.data(), dtlsHeader.size()},
+                                                          {dtlsBody.data(), dtlsBody.size()}}) == ErrorCode::kNone);
+    REQUIRE(buf == expected);
+}
+
+TEST_CASE("tlv-writer-rejects-bad-tlv", "[tlv]")
+{
+    ByteArray buf = {0xAB};
+    TlvWriter writer{buf};
+
+    // The Network Name is longer than 16 bytes.
+    REQUIRE(writer.Write(Type::kNetworkName, std::string(17, 'a')) == ErrorCode::kInvalidArgs);
+
+    // A base TLV cannot hold more than 254 bytes.
+    REQUIRE(writer.Write(Type::kSteeringData, ByteArray(255, 0xFF)) == ErrorCode::kInvalidArgs);
+
+    REQUIRE(buf == ByteArray{0xAB});
+}
+
+} // namespace tlv
+
+} // namespace commissioner
+
+} // namespace ot
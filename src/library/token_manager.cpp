@@ -35,6 +35,10 @@
 
 #include "library/token_manager.hpp"
 
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+
 #include <mbedtls/x509_crt.h>
 
 #include "library/cose.hpp"
@@ -54,10 +58,12 @@ TokenManager::TokenManager(struct event_base *aEventBase)
     mbedtls_pk_init(&mPublicKey);
     mbedtls_pk_init(&mPrivateKey);
     mbedtls_pk_init(&mDomainCAPublicKey);
+    mbedtls_pk_init(&mTokenPublicKey);
 }
 
 TokenManager::~TokenManager()
 {
+    mbedtls_pk_free(&mTokenPublicKey);
     mbedtls_pk_free(&mPrivateKey);
     mbedtls_pk_free(&mPublicKey);
     mbedtls_pk_free(&mDomainCAPublicKey);
@@ -87,6 +93,15 @@ Error TokenManager::Init(const Config &aConfig)
     MoveMbedtlsKey(mPublicKey, publicKey);
     MoveMbedtlsKey(mPrivateKey, privateKey);
     MoveMbedtlsKey(mDomainCAPublicKey, trustAnchorPublicKey);
+    mTrustAnchor = aConfig.mTrustAnchor;
+    mVerificationCache.Clear();
+
+    SuccessOrExit(error = mSigner.Init(mPrivateKey));
+
+    if (!aConfig.mSequenceNumberJournal.empty())
+    {
+        SuccessOrExit(error = mSequenceNumbers.Open(aConfig.mSequenceNumberJournal));
+    }
 
 exit:
     mbedtls_pk_free(&trustAnchorPublicKey);
@@ -95,17 +110,24 @@ exit:
     return error;
 }
 
-Error TokenManager::VerifyToken(CborMap &aToken, const ByteArray &aSignedToken, const mbedtls_pk_context &aPublicKey)
+Error TokenManager::VerifyToken(mbedtls_pk_context &      aTokenPublicKey,
+                                ByteArray &               aKeyId,
+                                TimePoint &               aExpiration,
+                                const ByteArray &         aSignedToken,
+                                const mbedtls_pk_context *aSignerPublicKey)
 {
     Error              error;
     cose::Sign1Message coseSign;
-    CborMap            token;
+    CborReader         reader{nullptr, 0};
     const uint8_t *    payload;
     size_t             payloadLength;
-    const char *       domainName;
-    size_t             domainNameLength;
-    const char *       expire;
-    size_t             expireLength;
+    size_t             claimCount;
+    size_t             cnfCount;
+    int64_t            key;
+    const char *       domainName       = nullptr;
+    size_t             domainNameLength = 0;
+    const char *       expire           = nullptr;
+    size_t             expireLength     = 0;
 
     LOG_INFO(LOG_REGION_TOKEN_MANAGER, "received token, length = {}, {}", aSignedToken.size(),
              utils::Hex(aSignedToken));
@@ -113,20 +135,60 @@ Error TokenManager::VerifyToken(CborMap &aToken, const ByteArray &aSignedToken,
     VerifyOrExit(!aSignedToken.empty(), error = ERROR_INVALID_ARGS("the signed COM_TOK is empty"));
     SuccessOrExit(error = cose::Sign1Message::Deserialize(coseSign, aSignedToken));
 
-    SuccessOrExit(error = coseSign.Validate(aPublicKey));
+    if (aSignerPublicKey != nullptr)
+    {
+        SuccessOrExit(error = coseSign.Validate(*aSignerPublicKey));
+    }
 
     VerifyOrExit((payload = coseSign.GetPayload(payloadLength)) != nullptr,
                  error = ERROR_BAD_FORMAT("cannot find payload in the signed COM_TOK"));
 
-    SuccessOrExit(error = CborValue::Deserialize(token, payload, payloadLength));
-
-    SuccessOrExit(error = token.Get(cwt::kAud, domainName, domainNameLength));
+    aKeyId.clear();
+    reader = CborReader{payload, payloadLength};
+    SuccessOrExit(error = reader.ReadMap(claimCount));
+    while (claimCount-- > 0)
+    {
+        SuccessOrExit(error = reader.ReadInt(key));
+        if (key == cwt::kAud)
+        {
+            SuccessOrExit(error = reader.ReadText(domainName, domainNameLength));
+        }
+        else if (key == cwt::kExp)
+        {
+            SuccessOrExit(error = reader.ReadText(expire, expireLength));
+        }
+        else if (key == cwt::kCnf)
+        {
+            SuccessOrExit(error = reader.ReadMap(cnfCount));
+            while (cnfCount-- > 0)
+            {
+                SuccessOrExit(error = reader.ReadInt(key));
+                if (key == cwt::kCoseKey)
+                {
+                    SuccessOrExit(error = cose::ReadCoseKey(aTokenPublicKey, aKeyId, reader));
+                }
+                else
+                {
+                    SuccessOrExit(error = reader.Skip());
+                }
+            }
+        }
+        else
+        {
+            // Ignore the "iss" (issuer) claim
+            SuccessOrExit(error = reader.Skip());
+        }
+    }
 
-    SuccessOrExit(error = token.Get(cwt::kExp, expire, expireLength));
+    VerifyOrExit(domainName != nullptr, error = ERROR_NOT_FOUND("cannot find the audience claim in COM_TOK"));
+    VerifyOrExit(expire != nullptr, error = ERROR_NOT_FOUND("cannot find the expiration claim in COM_TOK"));
+    VerifyOrExit(!aKeyId.empty(), error = ERROR_NOT_FOUND("cannot find the COSE key ID in COM_TOK"));
 
     // TODO(wgtdkp): make sure it is not expired
-
-    // Ignore the "iss" (issuer) claim
+    if (ParseExpiration(aExpiration, {expire, expireLength}) != ErrorCode::kNone)
+    {
+        aExpiration = TimePoint::min();
+    }
 
     if (std::string{domainName, domainNameLength} != mDomainName)
     {
@@ -134,10 +196,7 @@ Error TokenManager::VerifyToken(CborMap &aToken, const ByteArray &aSignedToken,
                                        std::string{domainName, domainNameLength}, mDomainName));
     }
 
-    CborValue::Move(aToken, token);
-
 exit:
-    token.Free();
     coseSign.Free();
     return error;
 }
@@ -181,7 +240,7 @@ void TokenManager::SendTokenRequest(Commissioner::Handler<ByteArray> aHandler)
             contentFormat == coap::ContentFormat::kCoseSign1,
             error = ERROR_BAD_FORMAT("CoAP Content Format requires to be application/cose; cose-type=\"cose-sign1\""));
 
-        SuccessOrExit(error = SetToken(aResponse->GetPayload(), mDomainCAPublicKey));
+        SuccessOrExit(error = SetToken(aResponse->GetPayload(), mTrustAnchor, &mDomainCAPublicKey));
 
     exit:
         if (error != ErrorCode::kNone)
@@ -212,53 +271,86 @@ exit:
 }
 
 Error TokenManager::SetToken(const ByteArray &aSignedToken, const ByteArray &aCert)
+{
+    return SetToken(aSignedToken, aCert, nullptr);
+}
+
+Error TokenManager::SetToken(const ByteArray &         aSignedToken,
+                             const ByteArray &         aCert,
+                             const mbedtls_pk_context *aPublicKey)
 {
     Error              error;
     mbedtls_pk_context publicKey;
+    bool               verified = mVerificationCache.Contains(aSignedToken, aCert);
 
     mbedtls_pk_init(&publicKey);
 
-    // TODO(wgtdkp): verify the certificate with our trust anchor?
-    SuccessOrExit(error = ParsePublicKey(publicKey, aCert));
-    SuccessOrExit(error = SetToken(aSignedToken, publicKey));
+    // The sequence numbers of the same token continue.
+    VerifyOrExit(!verified || aSignedToken != mSignedToken);
+
+    if (!verified && aPublicKey == nullptr)
+    {
+        // TODO(wgtdkp): verify the certificate with our trust anchor?
+        SuccessOrExit(error = ParsePublicKey(publicKey, aCert));
+        aPublicKey = &publicKey;
+    }
+
+    SuccessOrExit(error = UpdateToken(aSignedToken, verified ? nullptr : aPublicKey));
+    mVerificationCache.Add(aSignedToken, aCert, mTokenExpiration);
 
 exit:
     mbedtls_pk_free(&publicKey);
     return error;
 }
 
-Error TokenManager::SetToken(const ByteArray &aSignedToken, const mbedtls_pk_context &aPublicKey)
+Error TokenManager::UpdateToken(const ByteArray &aSignedToken, const mbedtls_pk_context *aPublicKey)
 {
-    Error          error;
-    ByteArray      oldSignedToken;
-    CborMap        oldToken;
-    CborMap        cnf;
-    CborMap        coseKey;
-    const uint8_t *kid       = nullptr;
-    size_t         kidLength = 0;
-
-    oldSignedToken = mSignedToken;
-    mSignedToken   = aSignedToken;
-    CborValue::Move(oldToken, mToken);
-
-    // Commissioner Token as a CBOR object references to raw data in the signed Token buffer.
-    // So we need to verify on 'mSignedToken' rather than 'aSignedToken'.
-    SuccessOrExit(error = VerifyToken(mToken, mSignedToken, aPublicKey));
-    SuccessOrExit(error = mToken.Get(cwt::kCnf, cnf));
-    SuccessOrExit(error = cnf.Get(cwt::kCoseKey, coseKey));
-    SuccessOrExit(error = coseKey.Get(cose::kKeyId, kid, kidLength));
-
-    // The mSequenceNumber is always associated with mToken & mSignedToken.
-    mSequenceNumber = 0;
-    mKeyId          = {kid, kid + kidLength};
+    Error              error;
+    mbedtls_pk_context tokenPublicKey;
+    ByteArray          keyId;
+    TimePoint          expiration;
+
+    mbedtls_pk_init(&tokenPublicKey);
+
+    SuccessOrExit(error = VerifyToken(tokenPublicKey, keyId, expiration, aSignedToken, aPublicKey));
+
+    // The sequence numbers are always associated with mSignedToken.
+    SuccessOrExit(error = mSequenceNumbers.Start(aSignedToken));
+
+    mSignedToken     = aSignedToken;
+    mKeyId           = std::move(keyId);
+    mTokenExpiration = expiration;
+    MoveMbedtlsKey(mTokenPublicKey, tokenPublicKey);
 
 exit:
-    if (error != ErrorCode::kNone)
+    mbedtls_pk_free(&tokenPublicKey);
+    return error;
+}
+
+Error TokenManager::ParseExpiration(TimePoint &aExpiration, const std::string &aExpire)
+{
+    Error       error;
+    struct tm   time   = {};
+    int         length = 0;
+    std::string zone;
+
+    VerifyOrExit(sscanf(aExpire.c_str(), "%4d-%2d-%2dT%2d:%2d:%2d%n", &time.tm_year, &time.tm_mon, &time.tm_mday,
+                        &time.tm_hour, &time.tm_min, &time.tm_sec, &length) == 6,
+                 error = ERROR_BAD_FORMAT("invalid COM_TOK expiration time: {}", aExpire));
+
+    // Fractional seconds are ignored.
+    zone = aExpire.substr(length);
+    if (!zone.empty() && zone[0] == '.')
     {
-        mSignedToken = oldSignedToken;
-        CborValue::Move(mToken, oldToken);
+        zone.erase(0, std::min(zone.find_first_not_of("0123456789", 1), zone.size()));
     }
+    VerifyOrExit(zone == "Z", error = ERROR_BAD_FORMAT("COM_TOK expiration time is not in UTC: {}", aExpire));
+
+    time.tm_year -= 1900;
+    time.tm_mon -= 1;
+    aExpiration = Clock::from_time_t(timegm(&time));
 
+exit:
     return error;
 }
 
@@ -269,13 +361,9 @@ Error TokenManager::MakeTokenRequest(ByteArray &               aBuf,
 {
     static constexpr size_t kMaxTokenRequestSize = 1024;
 
-    Error     error;
-    CborMap   tokenRequest;
-    CborMap   reqCnf;
-    ByteArray encodedCoseKey;
-    CborMap   coseKey;
-    size_t    encodedLength = 0;
-    uint8_t   tokenBuf[kMaxTokenRequestSize];
+    Error      error;
+    uint8_t    tokenBuf[kMaxTokenRequestSize];
+    CborWriter writer{tokenBuf, sizeof(tokenBuf)};
 
     // Use the commissioner Id as kid(truncated to kMaxCoseKeyIdLength)
     const ByteArray kid = {aId.begin(), aId.begin() + std::min(aId.size(), (size_t)kMaxCoseKeyIdLength)};
@@ -285,32 +373,29 @@ Error TokenManager::MakeTokenRequest(ByteArray &               aBuf,
     VerifyOrExit(!aId.empty(), error = ERROR_INVALID_ARGS("the ID is empty"));
     VerifyOrExit(!aDomainName.empty(), error = ERROR_INVALID_ARGS("the Domain Name is empty"));
 
-    SuccessOrExit(error = tokenRequest.Init());
+    SuccessOrExit(error = writer.WriteMap(4));
 
     // CWT grant type = CLIENT_CRED
-    SuccessOrExit(error = tokenRequest.Put(cwt::kGrantType, cwt::kGrantTypeClientCred));
+    SuccessOrExit(error = writer.WriteInt(cwt::kGrantType));
+    SuccessOrExit(error = writer.WriteInt(cwt::kGrantTypeClientCred));
 
     // CWT client id
-    SuccessOrExit(error = tokenRequest.Put(cwt::kClientId, aId.c_str()));
+    SuccessOrExit(error = writer.WriteInt(cwt::kClientId));
+    SuccessOrExit(error = writer.WriteText(aId));
 
     // CWT request audience
-    SuccessOrExit(error = tokenRequest.Put(cwt::kAud, aDomainName.c_str()));
+    SuccessOrExit(error = writer.WriteInt(cwt::kAud));
+    SuccessOrExit(error = writer.WriteText(aDomainName));
 
     // CWT req_cnf
-    SuccessOrExit(error = reqCnf.Init());
-    SuccessOrExit(error = cose::MakeCoseKey(encodedCoseKey, aPublicKey, kid));
-    SuccessOrExit(error = CborMap::Deserialize(coseKey, &encodedCoseKey[0], encodedCoseKey.size()));
-    SuccessOrExit(error = reqCnf.Put(cwt::kCoseKey, coseKey));
-    SuccessOrExit(error = tokenRequest.Put(cwt::kReqCnf, reqCnf));
+    SuccessOrExit(error = writer.WriteInt(cwt::kReqCnf));
+    SuccessOrExit(error = writer.WriteMap(1));
+    SuccessOrExit(error = writer.WriteInt(cwt::kCoseKey));
+    SuccessOrExit(error = cose::WriteCoseKey(writer, aPublicKey, kid));
 
-    SuccessOrExit(error = tokenRequest.Serialize(tokenBuf, encodedLength, sizeof(tokenBuf)));
-
-    aBuf.assign(tokenBuf, tokenBuf + encodedLength);
+    aBuf.assign(tokenBuf, tokenBuf + writer.GetLength());
 
 exit:
-    coseKey.Free();
-    reqCnf.Free();
-    tokenRequest.Free();
     return error;
 }
 
@@ -334,33 +419,23 @@ static inline bool ShouldBeSerialized(tlv::Type aTlvType, bool aIsActiveSet, boo
 
 Error TokenManager::SignMessage(ByteArray &aSignature, const coap::Message &aMessage)
 {
-    Error              error;
-    ByteArray          externalData;
-    cose::Sign1Message sign1Msg;
+    Error     error;
+    ByteArray externalData;
+    uint64_t  sequenceNumber;
 
     VerifyOrExit(IsValid(), error = ERROR_INVALID_STATE("has no valid Commissioner Token"));
 
     SuccessOrExit(error = PrepareSigningContent(externalData, aMessage));
 
-    SuccessOrExit(error = sign1Msg.Init(cose::kInitFlagsNone));
-    SuccessOrExit(error = sign1Msg.AddAttribute(cose::kHeaderAlgorithm, cose::kAlgEcdsaWithSha256, cose::kProtectOnly));
-    SuccessOrExit(error = sign1Msg.AddAttribute(cose::kHeaderKeyId, mKeyId, cose::kUnprotectOnly));
-
-    // TODO(wgtdkp): set cose::kHeaderIV to mSequenceNumber.
-    // SuccessOrExit(error = sign1Msg.AddAttribute(cose::kHeaderIV, , cose::kProtectOnly));
-    SuccessOrExit(error = sign1Msg.SetContent({}));
-
-    // The serialized message as external data for COSE signing.
-    SuccessOrExit(error = sign1Msg.SetExternalData(externalData));
-
-    SuccessOrExit(error = sign1Msg.Sign(mPrivateKey));
-    SuccessOrExit(error = sign1Msg.Serialize(aSignature));
+    // The sequence number is reserved in the journal, if any,
+    // before it is used. This never waits on the disk.
+    SuccessOrExit(error = mSequenceNumbers.Next(sequenceNumber));
 
-    // TODO(wgtdkp): synchronize to persist store.
-    ++mSequenceNumber;
+    // The serialized message as external data for COSE signing. The
+    // ECDSA nonce has been precomputed, only the final step is left.
+    SuccessOrExit(error = cose::MakeSign1Message(aSignature, mSigner, mKeyId, sequenceNumber, externalData));
 
 exit:
-    sign1Msg.Free();
     return error;
 }
 
@@ -401,35 +476,30 @@ exit:
     return error;
 }
 
-Error TokenManager::GetPublicKey(CborMap &aPublicKey) const
-{
-    Error   error;
-    CborMap cnf;
-
-    VerifyOrExit(mToken.IsValid(), error = ERROR_INVALID_STATE("has no valid Commissioner Token"));
-
-    SuccessOrExit(error = mToken.Get(cwt::kCnf, cnf));
-    SuccessOrExit(error = cnf.Get(cwt::kCoseKey, aPublicKey));
-
-exit:
-    return error;
-}
-
 Error TokenManager::VerifySignature(const ByteArray &aSignature, const coap::Message &aSignedMessage)
 {
     Error              error;
     ByteArray          externalData;
+    ByteArray          signedData;
     cose::Sign1Message sign1Msg;
-    CborMap            publicKey;
 
     VerifyOrExit(!aSignature.empty(), error = ERROR_INVALID_ARGS("the signature is empty"));
-    SuccessOrExit(error = cose::Sign1Message::Deserialize(sign1Msg, aSignature));
-
     SuccessOrExit(error = PrepareSigningContent(externalData, aSignedMessage));
+
+    // The signed object is the signature over the signing content, and
+    // both of the signing keys are determined by the Commissioner Token.
+    utils::Encode<uint32_t>(signedData, static_cast<uint32_t>(externalData.size()));
+    signedData.insert(signedData.end(), externalData.begin(), externalData.end());
+    signedData.insert(signedData.end(), aSignature.begin(), aSignature.end());
+    VerifyOrExit(!mVerificationCache.Contains(signedData, mSignedToken));
+
+    SuccessOrExit(error = cose::Sign1Message::Deserialize(sign1Msg, aSignature));
     SuccessOrExit(error = sign1Msg.SetExternalData(externalData));
     SuccessOrExit(error = sign1Msg.Validate(mPublicKey));
-    SuccessOrExit(error = GetPublicKey(publicKey));
-    SuccessOrExit(error = sign1Msg.Validate(publicKey));
+    VerifyOrExit(IsValid(), error = ERROR_INVALID_STATE("has no valid Commissioner Token"));
+    SuccessOrExit(error = sign1Msg.Validate(mTokenPublicKey));
+
+    mVerificationCache.Add(signedData, mSignedToken, mTokenExpiration);
 
 exit:
     sign1Msg.Free();
@@ -36,8 +36,10 @@
 #include <commissioner/commissioner.hpp>
 #include <commissioner/error.hpp>
 
-#include "library/cbor.hpp"
 #include "library/coap_secure.hpp"
+#include "library/ecdsa_signer.hpp"
+#include "library/sequence_number_store.hpp"
+#include "library/verification_cache.hpp"
 
 namespace ot {
 
@@ -53,7 +55,7 @@ public:
     // Initialized with Commissioner configuration.
     Error Init(const Config &aConfig);
 
-    bool IsValid() const { return mToken.IsValid(); }
+    bool IsValid() const { return !mSignedToken.empty(); }
 
     // Set the signed Commissioner Token when the signature verification succeed.
     // @param[in] aSignedToken  A COSE-signed Commissioner Token.
@@ -62,6 +64,9 @@ public:
 
     const ByteArray &GetToken() const { return mSignedToken; }
 
+    // The verified tokens and signed messages which are not verified again.
+    const VerificationCache &GetVerificationCache() const { return mVerificationCache; }
+
     const std::string &GetDomainName() const;
 
     void CancelRequests() { mRegistrarClient.CancelRequests(); }
@@ -84,6 +89,9 @@ public:
     // Parse the private key from the PEM/DER encoded private key.
     static Error ParsePrivateKey(mbedtls_pk_context &aPrivateKey, const ByteArray &aPrivateKeyRaw);
 
+    // Parse the "exp" claim in the form of "2019-12-06T09:20:01.726Z".
+    static Error ParseExpiration(TimePoint &aExpiration, const std::string &aExpire);
+
 private:
     /*
      * Thread Constants.
@@ -94,8 +102,18 @@ private:
     static void MoveMbedtlsKey(mbedtls_pk_context &aDes, mbedtls_pk_context &aSrc);
 
     // Verifying the signature in the signed Commissioner Token
-    // with the public key of the signer.
-    Error VerifyToken(CborMap &aToken, const ByteArray &aSignedToken, const mbedtls_pk_context &aPublicKey);
+    // with the public key of the signer, and decode the claims.
+    // The signature is not verified if @p aSignerPublicKey is null
+    // (it has been verified before).
+    // @param[out] aTokenPublicKey  The public key in the "cnf" claim.
+    // @param[out] aKeyId           The key ID of @p aTokenPublicKey.
+    // @param[out] aExpiration      The expiration time of the token, or the min
+    //                              time point if its "exp" claim can't be parsed.
+    Error VerifyToken(mbedtls_pk_context &      aTokenPublicKey,
+                      ByteArray &               aKeyId,
+                      TimePoint &               aExpiration,
+                      const ByteArray &         aSignedToken,
+                      const mbedtls_pk_context *aSignerPublicKey);
 
     void         SendTokenRequest(Commissioner::Handler<ByteArray> aHandler);
     static Error MakeTokenRequest(ByteArray &               aBuf,
@@ -107,17 +125,21 @@ private:
     // Described in 12.5.5 of Thread 1.2 spec.
     static Error PrepareSigningContent(ByteArray &aContent, const coap::Message &aMessage);
 
-    // Get the authorized Commissioner Public Key in the Commissioner Token.
-    Error GetPublicKey(CborMap &aPublicKey) const;
-
     // Set the signed Commissioner Token when the signature verification succeed.
+    // The verification is skipped if the same token has been verified with
+    // the same certificate before and has not expired.
     // @param[in] aSignedToken  A COSE-signed Commissioner Token.
-    // @param[in] aPublicKey    A public key associates to the signing key of @p aSignedToken.
-    Error SetToken(const ByteArray &aSignedToken, const mbedtls_pk_context &aPublicKey);
+    // @param[in] aCert         A certificate associates to the signing key of @p aSignedToken.
+    // @param[in] aPublicKey    The public key parsed from @p aCert, or null if it is not parsed yet.
+    Error SetToken(const ByteArray &aSignedToken, const ByteArray &aCert, const mbedtls_pk_context *aPublicKey);
 
-    // The sequence number of this commissioner token.
+    // Replace the current token with @p aSignedToken, which is verified with
+    // @p aPublicKey if it is not null. The current token is kept on failure.
+    Error UpdateToken(const ByteArray &aSignedToken, const mbedtls_pk_context *aPublicKey);
+
+    // The sequence numbers of this commissioner token.
     // Increased 1 for each signing operation.
-    uint64_t mSequenceNumber = 0;
+    SequenceNumberStore mSequenceNumbers;
 
     // Take the KID from COM_TOK's COSE_Key in the CNF claim.
     ByteArray mKeyId;
@@ -125,14 +147,24 @@ private:
     // The cose signed commissioner token.
     ByteArray mSignedToken;
 
-    // The parsed commissioner token in CBOR structure.
-    CborMap mToken;
+    // The authorized Commissioner Public Key in the "cnf" claim of mSignedToken.
+    mbedtls_pk_context mTokenPublicKey;
+
+    // The expiration time of mSignedToken.
+    TimePoint mTokenExpiration;
 
     std::string        mCommissionerId;
     std::string        mDomainName;
     mbedtls_pk_context mPublicKey;
     mbedtls_pk_context mPrivateKey;
     mbedtls_pk_context mDomainCAPublicKey;
+    ByteArray          mTrustAnchor;
+
+    // Signs messages with the private key and precomputed nonces.
+    EcdsaSigner mSigner;
+
+    // Verified tokens and signatures of signed messages.
+    VerificationCache mVerificationCache;
 
     coap::CoapSecure mRegistrarClient;
 };
@@ -35,9 +35,19 @@
 
 #include "library/token_manager.hpp"
 
+#include <chrono>
+#include <thread>
+
+#include <time.h>
+
 #include <catch2/catch.hpp>
 
+#include "common/benchmark.hpp"
+#include "common/utils.hpp"
+#include "library/cbor_stream.hpp"
 #include "library/commissioner_impl.hpp"
+#include "library/cose.hpp"
+#include "library/cwt.hpp"
 #include "library/uri.hpp"
 
 namespace ot {
@@ -86,6 +96,43 @@ static const std::string kSignedToken = "d28443a10126a058b0a40366546872656164047
                                         "19664ed999313665d02f976e5290d6e48597da77963009e57cfd083fea4e07ca"
                                         "78fc6fa25239a7a1c3b54a4b761947a9e9e29782955c2d00d8c9f6";
 
+// Returns the sequence number in the protected IV header of a COSE_Sign1 message.
+static uint64_t GetSequenceNumber(const ByteArray &aSign1Message)
+{
+    CborReader     reader{aSign1Message.data(), aSign1Message.size()};
+    uint64_t       tag;
+    size_t         count;
+    const uint8_t *headers;
+    size_t         headersLength;
+    const uint8_t *iv       = nullptr;
+    size_t         ivLength = 0;
+
+    REQUIRE(reader.ReadTag(tag) == ErrorCode::kNone);
+    REQUIRE(reader.ReadArray(count) == ErrorCode::kNone);
+    REQUIRE(reader.ReadBytes(headers, headersLength) == ErrorCode::kNone);
+
+    CborReader headersReader{headers, headersLength};
+
+    REQUIRE(headersReader.ReadMap(count) == ErrorCode::kNone);
+    for (size_t i = 0; i < count; ++i)
+    {
+        int64_t key;
+
+        REQUIRE(headersReader.ReadInt(key) == ErrorCode::kNone);
+        if (key == cose::kHeaderIV)
+        {
+            REQUIRE(headersReader.ReadBytes(iv, ivLength) == ErrorCode::kNone);
+        }
+        else
+        {
+            REQUIRE(headersReader.Skip() == ErrorCode::kNone);
+        }
+    }
+
+    REQUIRE(ivLength == sizeof(uint64_t));
+    return utils::Decode<uint64_t>(iv, ivLength);
+}
+
 TEST_CASE("signing-message", "[token]")
 {
     Config config;
@@ -114,6 +161,101 @@ TEST_CASE("signing-message", "[token]")
     REQUIRE(tokenManager.SetToken(signedToken, config.mTrustAnchor) == ErrorCode::kNone);
     REQUIRE(tokenManager.IsValid());
     REQUIRE(tokenManager.GetToken() == signedToken);
+    REQUIRE(tokenManager.GetVerificationCache().GetSize() == 0);
+
+    coap::Message pet{coap::Type::kConfirmable, coap::Code::kPost};
+    REQUIRE(pet.SetUriPath(uri::kPetitioning) == ErrorCode::kNone);
+    REQUIRE(AppendTlv(pet, {tlv::Type::kCommissionerId, config.mId}) == ErrorCode::kNone);
+
+    ByteArray signature;
+    REQUIRE(tokenManager.SignMessage(signature, pet) == ErrorCode::kNone);
+    REQUIRE(tokenManager.VerifySignature(signature, pet) == ErrorCode::kNone);
+    REQUIRE(GetSequenceNumber(signature) == 0);
+
+    ByteArray nextSignature;
+    REQUIRE(tokenManager.SignMessage(nextSignature, pet) == ErrorCode::kNone);
+    REQUIRE(tokenManager.VerifySignature(nextSignature, pet) == ErrorCode::kNone);
+    REQUIRE(GetSequenceNumber(nextSignature) == 1);
+
+    // Setting the same token again and verifying the same signature again
+    // should give the same results. The token has expired, so nothing is
+    // cached and both are verified again.
+    REQUIRE(tokenManager.SetToken(signedToken, config.mTrustAnchor) == ErrorCode::kNone);
+    REQUIRE(tokenManager.GetToken() == signedToken);
+    REQUIRE(tokenManager.VerifySignature(signature, pet) == ErrorCode::kNone);
+    REQUIRE(tokenManager.SetToken(signedToken, config.mCertificate) != ErrorCode::kNone);
+    REQUIRE(tokenManager.GetToken() == signedToken);
+
+    // The same token continues its sequence.
+    REQUIRE(tokenManager.SignMessage(nextSignature, pet) == ErrorCode::kNone);
+    REQUIRE(GetSequenceNumber(nextSignature) == 2);
+}
+
+// Makes a Commissioner Token of the key in @p aKey, signed by the same key.
+static ByteArray MakeSignedToken(const mbedtls_pk_context &aKey, const std::string &aExpire)
+{
+    uint8_t            claims[256];
+    CborWriter         writer{claims, sizeof(claims)};
+    cose::Sign1Message sign1Msg;
+    ByteArray          signedToken;
+
+    REQUIRE(writer.WriteMap(3) == ErrorCode::kNone);
+    REQUIRE(writer.WriteInt(cwt::kAud) == ErrorCode::kNone);
+    REQUIRE(writer.WriteText("Thread") == ErrorCode::kNone);
+    REQUIRE(writer.WriteInt(cwt::kExp) == ErrorCode::kNone);
+    REQUIRE(writer.WriteText(aExpire) == ErrorCode::kNone);
+    REQUIRE(writer.WriteInt(cwt::kCnf) == ErrorCode::kNone);
+    REQUIRE(writer.WriteMap(1) == ErrorCode::kNone);
+    REQUIRE(writer.WriteInt(cwt::kCoseKey) == ErrorCode::kNone);
+    REQUIRE(cose::WriteCoseKey(writer, aKey, {'t', 'e', 's', 't'}) == ErrorCode::kNone);
+
+    REQUIRE(sign1Msg.Init(cose::kInitFlagsNone) == ErrorCode::kNone);
+    REQUIRE(sign1Msg.AddAttribute(cose::kHeaderAlgorithm, cose::kAlgEcdsaWithSha256, cose::kProtectOnly) ==
+            ErrorCode::kNone);
+    REQUIRE(sign1Msg.SetContent({claims, claims + writer.GetLength()}) == ErrorCode::kNone);
+    REQUIRE(sign1Msg.Sign(aKey) == ErrorCode::kNone);
+    REQUIRE(sign1Msg.Serialize(signedToken) == ErrorCode::kNone);
+    sign1Msg.Free();
+
+    return signedToken;
+}
+
+TEST_CASE("signing-message-verification-cache", "[token]")
+{
+    Config             config;
+    mbedtls_pk_context privateKey;
+    time_t             tomorrow = Clock::to_time_t(Clock::now() + std::chrono::hours(24));
+    struct tm          expireTime;
+    char               expire[32];
+    ByteArray          signedToken;
+
+    config.mDomainName  = "Thread";
+    config.mTrustAnchor = {kCommTrustAnchor.begin(), kCommTrustAnchor.end()};
+    config.mTrustAnchor.push_back(0);
+    config.mCertificate = {kCommCert.begin(), kCommCert.end()};
+    config.mCertificate.push_back(0);
+    config.mPrivateKey = {kCommKey.begin(), kCommKey.end()};
+    config.mPrivateKey.push_back(0);
+
+    REQUIRE(gmtime_r(&tomorrow, &expireTime) != nullptr);
+    REQUIRE(strftime(expire, sizeof(expire), "%Y-%m-%dT%H:%M:%SZ", &expireTime) > 0);
+
+    mbedtls_pk_init(&privateKey);
+    REQUIRE(TokenManager::ParsePrivateKey(privateKey, config.mPrivateKey) == ErrorCode::kNone);
+    signedToken = MakeSignedToken(privateKey, expire);
+    mbedtls_pk_free(&privateKey);
+
+    struct event_base *eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    TokenManager tokenManager{eventBase};
+
+    REQUIRE(tokenManager.Init(config) == ErrorCode::kNone);
+
+    // The token is signed by the commissioner key, so
+    // the commissioner certificate is its signer.
+    REQUIRE(tokenManager.SetToken(signedToken, config.mCertificate) == ErrorCode::kNone);
+    REQUIRE(tokenManager.GetVerificationCache().GetSize() == 1);
 
     coap::Message pet{coap::Type::kConfirmable, coap::Code::kPost};
     REQUIRE(pet.SetUriPath(uri::kPetitioning) == ErrorCode::kNone);
@@ -122,6 +264,107 @@ TEST_CASE("signing-message", "[token]")
     ByteArray signature;
     REQUIRE(tokenManager.SignMessage(signature, pet) == ErrorCode::kNone);
     REQUIRE(tokenManager.VerifySignature(signature, pet) == ErrorCode::kNone);
+    REQUIRE(tokenManager.GetVerificationCache().GetSize() == 2);
+
+    // Both are found in the cache this time.
+    REQUIRE(tokenManager.VerifySignature(signature, pet) == ErrorCode::kNone);
+    REQUIRE(tokenManager.SetToken(signedToken, config.mCertificate) == ErrorCode::kNone);
+    REQUIRE(tokenManager.GetVerificationCache().GetSize() == 2);
+    REQUIRE(GetSequenceNumber(signature) == 0);
+
+    // A signature of another message is not.
+    REQUIRE(AppendTlv(pet, {tlv::Type::kCommissionerSessionId, uint16_t{0x1234}}) == ErrorCode::kNone);
+    REQUIRE(tokenManager.VerifySignature(signature, pet) != ErrorCode::kNone);
+    REQUIRE(tokenManager.GetVerificationCache().GetSize() == 2);
+
+    // A token of another signer is verified again and rejected.
+    REQUIRE(tokenManager.SetToken(signedToken, config.mTrustAnchor) != ErrorCode::kNone);
+}
+
+TEST_CASE("token-expiration-parsing", "[token]")
+{
+    TimePoint expiration;
+
+    REQUIRE(TokenManager::ParseExpiration(expiration, "2019-12-06T09:20:01.726Z") == ErrorCode::kNone);
+    REQUIRE(Clock::to_time_t(expiration) == 1575624001);
+
+    REQUIRE(TokenManager::ParseExpiration(expiration, "2019-12-06T09:20:01Z") == ErrorCode::kNone);
+    REQUIRE(Clock::to_time_t(expiration) == 1575624001);
+
+    REQUIRE(TokenManager::ParseExpiration(expiration, "1970-01-01T00:00:00Z") == ErrorCode::kNone);
+    REQUIRE(Clock::to_time_t(expiration) == 0);
+
+    // Only UTC time is accepted.
+    REQUIRE(TokenManager::ParseExpiration(expiration, "2019-12-06T09:20:01").GetCode() == ErrorCode::kBadFormat);
+    REQUIRE(TokenManager::ParseExpiration(expiration, "2019-12-06T09:20:01+01:00").GetCode() ==
+            ErrorCode::kBadFormat);
+    REQUIRE(TokenManager::ParseExpiration(expiration, "2019-12-06T09:20:01.Z1").GetCode() == ErrorCode::kBadFormat);
+
+    REQUIRE(TokenManager::ParseExpiration(expiration, "").GetCode() == ErrorCode::kBadFormat);
+    REQUIRE(TokenManager::ParseExpiration(expiration, "2019-12-06").GetCode() == ErrorCode::kBadFormat);
+    REQUIRE(TokenManager::ParseExpiration(expiration, "Fri, 06 Dec 2019 09:20:01 GMT").GetCode() ==
+            ErrorCode::kBadFormat);
+}
+
+// Signatures per second of signing CCM requests, compared with a
+// full ECDSA signature by COSE-C.
+TEST_CASE("signing-message-throughput", "[.benchmark]")
+{
+    constexpr int kSignatureCount = 2000;
+
+    Config config;
+
+    config.mDomainName  = "Thread";
+    config.mTrustAnchor = {kCommTrustAnchor.begin(), kCommTrustAnchor.end()};
+    config.mTrustAnchor.push_back(0);
+    config.mCertificate = {kCommCert.begin(), kCommCert.end()};
+    config.mCertificate.push_back(0);
+    config.mPrivateKey = {kCommKey.begin(), kCommKey.end()};
+    config.mPrivateKey.push_back(0);
+
+    struct event_base *eventBase = event_base_new();
+    REQUIRE(eventBase != nullptr);
+
+    TokenManager tokenManager{eventBase};
+    ByteArray    signedToken;
+
+    REQUIRE(tokenManager.Init(config) == ErrorCode::kNone);
+    REQUIRE(utils::Hex(signedToken, kSignedToken) == ErrorCode::kNone);
+    REQUIRE(tokenManager.SetToken(signedToken, config.mTrustAnchor) == ErrorCode::kNone);
+
+    coap::Message request{coap::Type::kConfirmable, coap::Code::kPost};
+    REQUIRE(request.SetUriPath(uri::kMgmtCommissionerGet) == ErrorCode::kNone);
+    REQUIRE(AppendTlv(request, {tlv::Type::kCommissionerSessionId, uint16_t{0x1234}}) == ErrorCode::kNone);
+
+    // Let the background thread fill the nonce pool.
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+
+    double precomputed = benchmark::MeasureRate(kSignatureCount, [&tokenManager, &request]() {
+        ByteArray signature;
+        REQUIRE(tokenManager.SignMessage(signature, request) == ErrorCode::kNone);
+    });
+
+    mbedtls_pk_context privateKey;
+    mbedtls_pk_init(&privateKey);
+    REQUIRE(TokenManager::ParsePrivateKey(privateKey, config.mPrivateKey) == ErrorCode::kNone);
+
+    double full = benchmark::MeasureRate(kSignatureCount, [&privateKey]() {
+        cose::Sign1Message sign1Msg;
+        ByteArray          signature;
+
+        REQUIRE(sign1Msg.Init(cose::kInitFlagsNone) == ErrorCode::kNone);
+        REQUIRE(sign1Msg.AddAttribute(cose::kHeaderAlgorithm, cose::kAlgEcdsaWithSha256, cose::kProtectOnly) ==
+                ErrorCode::kNone);
+        REQUIRE(sign1Msg.SetContent({}) == ErrorCode::kNone);
+        REQUIRE(sign1Msg.SetExternalData({0x01, 0x02, 0x03}) == ErrorCode::kNone);
+        REQUIRE(sign1Msg.Sign(privateKey) == ErrorCode::kNone);
+        REQUIRE(sign1Msg.Serialize(signature) == ErrorCode::kNone);
+        sign1Msg.Free();
+    });
+
+    mbedtls_pk_free(&privateKey);
+
+    WARN("signatures per second: precomputed nonces = " << precomputed << ", COSE-C = " << full);
 }
 
 } // namespace commissioner
@@ -100,25 +100,30 @@ void ProxyClient::SendEmptyChanged(const coap::Request &aRequest)
  */
 void ProxyClient::HandleUdpRx(const coap::Request &aUdpRx)
 {
-    Error       error;
-    Address     peerAddr;
-    uint16_t    peerPort;
-    tlv::TlvPtr srcAddr  = nullptr;
-    tlv::TlvPtr udpEncap = nullptr;
+    Error         error;
+    Address       peerAddr;
+    uint16_t      peerPort;
+    tlv::TlvTable tlvTable;
+    tlv::TlvView  srcAddr;
+    tlv::TlvView  udpEncap;
+
+    SuccessOrExit(error = tlvTable.Parse(aUdpRx.GetPayload()));
+
+    srcAddr  = tlvTable[tlv::Type::kIpv6Address];
+    udpEncap = tlvTable[tlv::Type::kUdpEncapsulation];
 
-    VerifyOrExit((srcAddr = GetTlv(tlv::Type::kIpv6Address, aUdpRx)) != nullptr,
-                 error = ERROR_BAD_FORMAT("no valid IPv6 Address TLV found"));
-    VerifyOrExit((udpEncap = GetTlv(tlv::Type::kUdpEncapsulation, aUdpRx)) != nullptr,
-                 error = ERROR_BAD_FORMAT("no valid UDP Encapsulation TLV found"));
+    VerifyOrExit(srcAddr.IsPresent(), error = ERROR_BAD_FORMAT("no valid IPv6 Address TLV found"));
+    VerifyOrExit(udpEncap.IsPresent(), error = ERROR_BAD_FORMAT("no valid UDP Encapsulation TLV found"));
 
-    SuccessOrExit(error = peerAddr.Set(srcAddr->GetValue()));
+    SuccessOrExit(error = peerAddr.Set(srcAddr.GetValueAsByteArray()));
 
-    peerPort = utils::Decode<uint16_t>(udpEncap->GetValue());
+    peerPort = udpEncap.GetValueAsUint16();
 
     mEndpoint.SetPeerAddr(peerAddr);
     mEndpoint.SetPeerPort(peerPort);
 
-    mCoap.Receive({udpEncap->GetValue().begin() + 4, udpEncap->GetValue().end()});
+    // Skip the source and destination port.
+    mCoap.Receive({udpEncap.GetValue() + 4, udpEncap.GetValue() + udpEncap.GetLength()});
 
 exit:
     if (error != ErrorCode::kNone)
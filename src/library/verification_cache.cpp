@@ -0,0 +1,119 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the cache of verified signed objects.
+ */
+
+#include "library/verification_cache.hpp"
+
+#include <algorithm>
+
+#include "library/openthread/sha256.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+constexpr size_t VerificationCache::kDefaultCapacity;
+
+VerificationCache::VerificationCache(size_t aCapacity)
+    : mExpirations(aCapacity)
+{
+}
+
+bool VerificationCache::Contains(const ByteArray &aSignedData, const ByteArray &aSignerKey)
+{
+    ByteArray  key        = ComputeKey(aSignedData, aSignerKey);
+    TimePoint *expiration = mExpirations.Find(key);
+
+    if (expiration == nullptr)
+    {
+        return false;
+    }
+
+    if (*expiration <= Clock::now())
+    {
+        mExpirations.Remove(key);
+        return false;
+    }
+
+    return true;
+}
+
+void VerificationCache::Add(const ByteArray &aSignedData, const ByteArray &aSignerKey, const TimePoint &aExpiration)
+{
+    if (mExpirations.GetCapacity() == 0 || aExpiration <= Clock::now())
+    {
+        return;
+    }
+
+    mExpirations.Put(ComputeKey(aSignedData, aSignerKey), aExpiration);
+}
+
+void VerificationCache::Remove(const ByteArray &aSignedData, const ByteArray &aSignerKey)
+{
+    mExpirations.Remove(ComputeKey(aSignedData, aSignerKey));
+}
+
+void VerificationCache::Clear()
+{
+    mExpirations.Clear();
+}
+
+ByteArray VerificationCache::ComputeKey(const ByteArray &aSignedData, const ByteArray &aSignerKey)
+{
+    Sha256  sha256;
+    uint8_t hash[Sha256::kHashSize];
+
+    // Each field is prefixed by its length so that
+    // different inputs never have the same encoding.
+    sha256.Start();
+    for (const auto *field : {&aSignedData, &aSignerKey})
+    {
+        uint32_t length        = static_cast<uint32_t>(field->size());
+        uint8_t  lengthBytes[] = {static_cast<uint8_t>(length >> 24), static_cast<uint8_t>(length >> 16),
+                                 static_cast<uint8_t>(length >> 8), static_cast<uint8_t>(length)};
+
+        sha256.Update(lengthBytes, sizeof(lengthBytes));
+        for (size_t offset = 0; offset < field->size(); offset += UINT16_MAX)
+        {
+            size_t chunkLength = std::min<size_t>(field->size() - offset, UINT16_MAX);
+
+            sha256.Update(field->data() + offset, static_cast<uint16_t>(chunkLength));
+        }
+    }
+    sha256.Finish(hash);
+
+    return {hash, hash + sizeof(hash)};
+}
+
+} // namespace commissioner
+
+} // namespace ot
@@ -0,0 +1,85 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions of the cache of verified signed objects.
+ */
+
+#ifndef OT_COMM_LIBRARY_VERIFICATION_CACHE_HPP_
+#define OT_COMM_LIBRARY_VERIFICATION_CACHE_HPP_
+
+#include <commissioner/defines.hpp>
+
+#include "common/time.hpp"
+#include "library/lru_cache.hpp"
+
+namespace ot {
+
+namespace commissioner {
+
+// Remembers signed objects which have been successfully verified, so that
+// verifying the same object again is a hash lookup rather than certificate
+// parsing and ECDSA verification. Entries are keyed by the SHA-256 hash of
+// the signed bytes and the signer key, kept in a LRU list of bounded size
+// and dropped once the verified object (e.g. a Commissioner Token) expires.
+//
+// This class is not thread-safe.
+class VerificationCache
+{
+public:
+    static constexpr size_t kDefaultCapacity = 16;
+
+    // @param[in] aCapacity  The max number of cached objects. 0 disables the cache.
+    explicit VerificationCache(size_t aCapacity = kDefaultCapacity);
+
+    // Returns true if @p aSignedData has been verified with @p aSignerKey and
+    // has not expired yet. An expired entry is removed.
+    bool Contains(const ByteArray &aSignedData, const ByteArray &aSignerKey);
+
+    // Records that @p aSignedData has been verified with @p aSignerKey and
+    // is valid until @p aExpiration. Nothing is added if it has already expired.
+    void Add(const ByteArray &aSignedData, const ByteArray &aSignerKey, const TimePoint &aExpiration);
+
+    void Remove(const ByteArray &aSignedData, const ByteArray &aSignerKey);
+
+    void Clear();
+
+    size_t GetSize() const { return mExpirations.GetSize(); }
+
+private:
+    static ByteArray ComputeKey(const ByteArray &aSignedData, const ByteArray &aSignerKey);
+
+    LruCache<ByteArray, TimePoint> mExpirations;
+};
+
+} // namespace commissioner
+
+} // namespace ot
+
+#endif // OT_COMM_LIBRARY_VERIFICATION_CACHE_HPP_
@@ -0,0 +1,109 @@
+/*
+ *    Copyright (c) 2019, The OpenThread Commissioner Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines test cases of the cache of verified signed objects.
+ */
+
+#include "library/verification_cache.hpp"
+
+#include <thread>
+
+#include <catch2/catch.hpp>
+
+namespace ot {
+
+namespace commissioner {
+
+TEST_CASE("verification-cache-lookup", "[verification-cache]")
+{
+    const ByteArray   token{0x01, 0x02, 0x03};
+    const ByteArray   cert{0x04, 0x05};
+    const TimePoint   later = Clock::now() + std::chrono::hours(1);
+    VerificationCache cache;
+
+    REQUIRE_FALSE(cache.Contains(token, cert));
+
+    cache.Add(token, cert, later);
+    REQUIRE(cache.GetSize() == 1);
+    REQUIRE(cache.Contains(token, cert));
+
+    // Both the signed data and the signer key are part of the key,
+    // and the boundary between them matters.
+    REQUIRE_FALSE(cache.Contains(token, ByteArray{0x04}));
+    REQUIRE_FALSE(cache.Contains(ByteArray{0x01, 0x02}, ByteArray{0x03, 0x04, 0x05}));
+
+    cache.Remove(token, cert);
+    REQUIRE_FALSE(cache.Contains(token, cert));
+    REQUIRE(cache.GetSize() == 0);
+}
+
+TEST_CASE("verification-cache-expiration", "[verification-cache]")
+{
+    const ByteArray   token{0x01, 0x02, 0x03};
+    const ByteArray   cert{0x04, 0x05};
+    VerificationCache cache;
+
+    cache.Add(token, cert, Clock::now() - std::chrono::seconds(1));
+    REQUIRE(cache.GetSize() == 0);
+
+    cache.Add(token, cert, Clock::now() + std::chrono::milliseconds(20));
+    REQUIRE(cache.Contains(token, cert));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    REQUIRE_FALSE(cache.Contains(token, cert));
+    REQUIRE(cache.GetSize() == 0);
+}
+
+TEST_CASE("verification-cache-eviction", "[verification-cache]")
+{
+    const ByteArray   cert{0x04, 0x05};
+    const TimePoint   later = Clock::now() + std::chrono::hours(1);
+    VerificationCache cache(2);
+
+    cache.Add({0x01}, cert, later);
+    cache.Add({0x02}, cert, later);
+
+    // Touch the oldest entry so that the other one is evicted.
+    REQUIRE(cache.Contains({0x01}, cert));
+    cache.Add({0x03}, cert, later);
+
+    REQUIRE(cache.GetSize() == 2);
+    REQUIRE(cache.Contains({0x01}, cert));
+    REQUIRE_FALSE(cache.Contains({0x02}, cert));
+    REQUIRE(cache.Contains({0x03}, cert));
+
+    VerificationCache disabled(0);
+    disabled.Add({0x01}, cert, later);
+    REQUIRE(disabled.GetSize() == 0);
+}
+
+} // namespace commissioner
+
+} // namespace ot